@@ -4,6 +4,10 @@
 #include <stdlib.h>
 #include <string>
 #include <algorithm> // std::sort
+#include <type_traits>
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include "Array.h"
 #include "TypeRegistry.h"
@@ -52,6 +56,176 @@ namespace Hail
 }
 
 
+namespace
+{
+	// Arrays smaller than this are sorted with std::sort, the radix sort only pays off for its extra passes on larger arrays.
+	constexpr asUINT g_radixSortThreshold = 256u;
+
+	// Maps a 4 byte primitive to an unsigned key with the same ordering, so all 32 bit types can share one radix sort.
+	template<typename T>
+	asDWORD ToRadixKey(asDWORD bits);
+	template<> asDWORD ToRadixKey<asDWORD>(asDWORD bits) { return bits; }
+	template<> asDWORD ToRadixKey<asINT32>(asDWORD bits) { return bits ^ 0x80000000u; }
+	template<> asDWORD ToRadixKey<float>(asDWORD bits) { return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u; }
+
+	template<typename T>
+	asDWORD FromRadixKey(asDWORD key);
+	template<> asDWORD FromRadixKey<asDWORD>(asDWORD key) { return key; }
+	template<> asDWORD FromRadixKey<asINT32>(asDWORD key) { return key ^ 0x80000000u; }
+	template<> asDWORD FromRadixKey<float>(asDWORD key) { return (key & 0x80000000u) ? key & 0x7fffffffu : ~key; }
+
+	// LSD radix sort with 8 bit digits, sorts ascending. Returns false if the scratch memory could not be allocated.
+	template<typename T>
+	bool RadixSort32(T* pData, asUINT count)
+	{
+		static_assert(sizeof(T) == sizeof(asDWORD), "Radix sort only supports 4 byte types.");
+		asDWORD* pKeys = reinterpret_cast<asDWORD*>(pData);
+		asDWORD* pScratch = reinterpret_cast<asDWORD*>(userAlloc(sizeof(asDWORD) * count));
+		if (!pScratch)
+			return false;
+
+		for (asUINT i = 0; i < count; i++)
+			pKeys[i] = ToRadixKey<T>(pKeys[i]);
+
+		asDWORD* pSrc = pKeys;
+		asDWORD* pDst = pScratch;
+		for (asUINT shift = 0; shift < 32; shift += 8)
+		{
+			asUINT histogram[256] = {};
+			for (asUINT i = 0; i < count; i++)
+				histogram[(pSrc[i] >> shift) & 0xff]++;
+
+			// Every key has the same digit, this pass would not move anything.
+			if (histogram[(pSrc[0] >> shift) & 0xff] == count)
+				continue;
+
+			asUINT offset = 0;
+			for (asUINT digit = 0; digit < 256; digit++)
+			{
+				const asUINT digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+
+			for (asUINT i = 0; i < count; i++)
+				pDst[histogram[(pSrc[i] >> shift) & 0xff]++] = pSrc[i];
+
+			asDWORD* pTemp = pSrc;
+			pSrc = pDst;
+			pDst = pTemp;
+		}
+
+		if (pSrc != pKeys)
+			memcpy(pKeys, pSrc, sizeof(asDWORD) * count);
+
+		for (asUINT i = 0; i < count; i++)
+			pKeys[i] = FromRadixKey<T>(pKeys[i]);
+
+		userFree(pScratch);
+		return true;
+	}
+
+	// NaN compares false against everything so < is not a strict weak ordering with it, which std::sort requires.
+	// NaNs are moved to the end of the range and only the rest is sorted.
+	template<typename T>
+	T* PartitionNaNsLast(T* pBegin, T* pEnd)
+	{
+		if constexpr (std::is_floating_point<T>::value)
+			return std::partition(pBegin, pEnd, [](const T& value) { return value == value; });
+		else
+			return pEnd;
+	}
+
+	template<typename T>
+	void SortPrimitive(T* pBegin, T* pEnd, bool asc)
+	{
+		pEnd = PartitionNaNsLast(pBegin, pEnd);
+		if (asc)
+			std::sort(pBegin, pEnd);
+		else
+			std::sort(pBegin, pEnd, [](const T& a, const T& b) { return b < a; });
+	}
+
+	template<typename T>
+	void SortPrimitive32(T* pBegin, T* pEnd, bool asc)
+	{
+		pEnd = PartitionNaNsLast(pBegin, pEnd);
+		const asUINT count = (asUINT)(pEnd - pBegin);
+		if (count < g_radixSortThreshold || !RadixSort32(pBegin, count))
+		{
+			SortPrimitive(pBegin, pEnd, asc);
+			return;
+		}
+		if (!asc)
+			std::reverse(pBegin, pEnd);
+	}
+
+	template<typename T>
+	int FindPrimitive(const T* pData, asUINT startAt, asUINT count, const T value)
+	{
+		for (asUINT i = startAt; i < count; i++)
+		{
+			if (pData[i] == value)
+				return (int)i;
+		}
+		return -1;
+	}
+
+#if defined(_M_X64) || defined(__SSE2__)
+	// 4 wide compare, a movemask of the result gives us the first matching lane.
+	int FindPrimitive32(const asDWORD* pData, asUINT startAt, asUINT count, asDWORD value)
+	{
+		const __m128i needle = _mm_set1_epi32((int)value);
+		// The caller makes sure startAt < count, so count - i can not wrap.
+		asUINT i = startAt;
+		for (; count - i >= 4; i += 4)
+		{
+			const __m128i elements = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pData + i));
+			const int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(elements, needle)));
+			if (mask)
+			{
+				for (asUINT lane = 0; lane < 4; lane++)
+				{
+					if (mask & (1 << lane))
+						return (int)(i + lane);
+				}
+			}
+		}
+		return FindPrimitive(pData, i, count, value);
+	}
+
+	int FindPrimitive32(const float* pData, asUINT startAt, asUINT count, float value)
+	{
+		// Float compare keeps the same semantics as operator==, -0 equals 0 and NaN equals nothing.
+		const __m128 needle = _mm_set1_ps(value);
+		asUINT i = startAt;
+		for (; count - i >= 4; i += 4)
+		{
+			const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(pData + i), needle));
+			if (mask)
+			{
+				for (asUINT lane = 0; lane < 4; lane++)
+				{
+					if (mask & (1 << lane))
+						return (int)(i + lane);
+				}
+			}
+		}
+		return FindPrimitive(pData, i, count, value);
+	}
+#else
+	int FindPrimitive32(const asDWORD* pData, asUINT startAt, asUINT count, asDWORD value)
+	{
+		return FindPrimitive(pData, startAt, count, value);
+	}
+
+	int FindPrimitive32(const float* pData, asUINT startAt, asUINT count, float value)
+	{
+		return FindPrimitive(pData, startAt, count, value);
+	}
+#endif
+}
+
 // We just define a number here that we assume nobody else is using for
 // object type user data. The add-ons have reserved the numbers 1000
 // through 1999 for this purpose, so we should be fine.
@@ -280,14 +454,7 @@ static Variable GetScriptArrayVariableData(void* pObj)
 	variableToReturn.m_type = StringL::Format("Array %s", pTypeInfo->GetEngine()->GetTypeInfoById(pArray->GetElementTypeId())->GetName());
 	uint32 count = pArray->GetCount();
 	variableToReturn.m_value = StringL::Format("Count : %u", count);
-
-	int subTypeID = pArray->GetElementTypeId();
-	for (uint32 i = 0; i < count; i++)
-	{
-		Variable& member = variableToReturn.m_members.Add();
-		member = ASTypeToVariable(pArray->At(i), subTypeID, 1, pTypeInfo->GetEngine(), g_pTypeRegistry);
-		member.m_name = StringL::Format("[%u]", i);
-	}
+	// The elements are expanded by the debugger a page at a time when the client requests them.
 	return variableToReturn;
 }
 
@@ -339,6 +506,8 @@ static void RegisterScriptArray_Native(TypeRegistry* pTypeRegistry)
 	r = engine->RegisterObjectMethod("Array<T>", "uint Count() const", asMETHOD(ScriptArray, GetCount), asCALL_THISCALL); H_ASSERT( r >= 0 );
 #endif
 	r = engine->RegisterObjectMethod("Array<T>", "void Reserve(uint length)", asMETHOD(ScriptArray, Reserve), asCALL_THISCALL); H_ASSERT( r >= 0 );
+	r = engine->RegisterObjectMethod("Array<T>", "void ShrinkToFit()", asMETHOD(ScriptArray, ShrinkToFit), asCALL_THISCALL); H_ASSERT( r >= 0 );
+	r = engine->RegisterObjectMethod("Array<T>", "uint Capacity() const", asMETHOD(ScriptArray, GetCapacity), asCALL_THISCALL); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void Resize(uint length)", asMETHODPR(ScriptArray, Resize, (asUINT), void), asCALL_THISCALL); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void SortAsc()", asMETHODPR(ScriptArray, SortAsc, (), void), asCALL_THISCALL); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void SortAsc(uint startAt, uint count)", asMETHODPR(ScriptArray, SortAsc, (asUINT, asUINT), void), asCALL_THISCALL); H_ASSERT( r >= 0 );
@@ -686,6 +855,39 @@ void ScriptArray::Reserve(asUINT maxElements)
 	buffer = newBuffer;
 }
 
+void ScriptArray::ShrinkToFit()
+{
+	if( buffer->maxElements == buffer->numElements )
+		return;
+
+	ArrayBuffer *newBuffer = reinterpret_cast<ArrayBuffer*>(userAlloc(sizeof(ArrayBuffer)-1 + elementSize*buffer->numElements));
+	if( newBuffer )
+	{
+		newBuffer->numElements = buffer->numElements;
+		newBuffer->maxElements = buffer->numElements;
+	}
+	else
+	{
+		// Out of memory, keep the old buffer as it is still valid
+		asIScriptContext *ctx = asGetActiveContext();
+		if( ctx )
+			ctx->SetException("Out of memory");
+		return;
+	}
+
+	// Objects are not stored inline, so moving the pointers with memcpy is safe.
+	memcpy(newBuffer->data, buffer->data, buffer->numElements*elementSize);
+
+	userFree(buffer);
+
+	buffer = newBuffer;
+}
+
+asUINT ScriptArray::GetCapacity() const
+{
+	return buffer->maxElements;
+}
+
 void ScriptArray::Resize(asUINT numElements)
 {
 	if( !CheckMaxSize(numElements) )
@@ -746,12 +948,15 @@ void ScriptArray::Resize(int delta, asUINT at)
 
 	if( buffer->maxElements < buffer->numElements + delta )
 	{
+		// Grow geometrically so repeated Add calls from script are amortized O(1) instead of reallocating every time.
+		const asUINT newMaxElements = GetGrownCapacity(buffer->numElements + delta);
+
 		// Allocate memory for the buffer
-		ArrayBuffer *newBuffer = reinterpret_cast<ArrayBuffer*>(userAlloc(sizeof(ArrayBuffer)-1 + elementSize*(buffer->numElements + delta)));
+		ArrayBuffer *newBuffer = reinterpret_cast<ArrayBuffer*>(userAlloc(sizeof(ArrayBuffer)-1 + elementSize*newMaxElements));
 		if( newBuffer )
 		{
 			newBuffer->numElements = buffer->numElements + delta;
-			newBuffer->maxElements = newBuffer->numElements;
+			newBuffer->maxElements = newMaxElements;
 		}
 		else
 		{
@@ -817,6 +1022,25 @@ bool ScriptArray::CheckMaxSize(asUINT numElements)
 	return true;
 }
 
+// internal
+asUINT ScriptArray::GetGrownCapacity(asUINT requiredElements) const
+{
+	const asUINT minimumCapacity = 8;
+	asUINT maxSize = 0xFFFFFFFFul - sizeof(ArrayBuffer) + 1;
+	if( elementSize > 0 )
+		maxSize /= elementSize;
+
+	asUINT newCapacity = buffer->maxElements < minimumCapacity ? minimumCapacity : buffer->maxElements;
+	while( newCapacity < requiredElements && newCapacity <= maxSize / 2 )
+		newCapacity *= 2;
+
+	// Either the doubling would overflow or the request is larger than the doubled size
+	if( newCapacity < requiredElements || newCapacity > maxSize )
+		newCapacity = requiredElements;
+
+	return newCapacity;
+}
+
 asITypeInfo *ScriptArray::GetArrayObjectType() const
 {
 	return objType;
@@ -1336,6 +1560,32 @@ int ScriptArray::Find(asUINT startAt, void *value) const
 		}
 	}
 
+	// Primitives are compared directly on the typed buffer without going through Equals per element.
+	if( !(subTypeId & ~asTYPEID_MASK_SEQNBR) )
+	{
+		const asUINT count = GetCount();
+		if( startAt >= count )
+			return -1;
+
+		const void* pData = buffer->data;
+		switch( subTypeId )
+		{
+			#define FIND(T) FindPrimitive((const T*)pData, startAt, count, *(const T*)value)
+			case asTYPEID_BOOL:   return FIND(bool);
+			case asTYPEID_INT8:   return FIND(asINT8);
+			case asTYPEID_INT16:  return FIND(asINT16);
+			case asTYPEID_INT64:  return FIND(asINT64);
+			case asTYPEID_UINT8:  return FIND(asBYTE);
+			case asTYPEID_UINT16: return FIND(asWORD);
+			case asTYPEID_UINT64: return FIND(asQWORD);
+			case asTYPEID_DOUBLE: return FIND(double);
+			#undef FIND
+			case asTYPEID_FLOAT:  return FindPrimitive32((const float*)pData, startAt, count, *(const float*)value);
+			// Int32, uint32 and all enums compare equal on their bit pattern.
+			default: return FindPrimitive32((const asDWORD*)pData, startAt, count, *(const asDWORD*)value);
+		}
+	}
+
 	// Find the matching element
 	int ret = -1;
 	asUINT size = GetCount();
@@ -1574,23 +1824,24 @@ void ScriptArray::Sort(asUINT startAt, asUINT count, bool asc)
 	}
 	else
 	{
-		// TODO: Use std::sort for primitive types too
-
-		// Insertion sort
-		asBYTE tmp[16];
-		for( int i = start + 1; i < end; i++ )
+		// Sort the typed range directly, 4 byte types use a radix sort for larger arrays.
+		void* pBegin = GetArrayItemPointer(start);
+		void* pEnd = GetArrayItemPointer(end);
+		switch( subTypeId )
 		{
-			Copy(tmp, GetArrayItemPointer(i));
-
-			int j = i - 1;
-
-			while( j >= start && Less(GetDataPointer(tmp), At(j), asc) )
-			{
-				Copy(GetArrayItemPointer(j + 1), GetArrayItemPointer(j));
-				j--;
-			}
-
-			Copy(GetArrayItemPointer(j + 1), tmp);
+			#define SORT(T) SortPrimitive((T*)pBegin, (T*)pEnd, asc); break
+			case asTYPEID_BOOL:   SORT(bool);
+			case asTYPEID_INT8:   SORT(asINT8);
+			case asTYPEID_INT16:  SORT(asINT16);
+			case asTYPEID_INT64:  SORT(asINT64);
+			case asTYPEID_UINT8:  SORT(asBYTE);
+			case asTYPEID_UINT16: SORT(asWORD);
+			case asTYPEID_UINT64: SORT(asQWORD);
+			case asTYPEID_DOUBLE: SORT(double);
+			#undef SORT
+			case asTYPEID_UINT32: SortPrimitive32((asDWORD*)pBegin, (asDWORD*)pEnd, asc); break;
+			case asTYPEID_FLOAT:  SortPrimitive32((float*)pBegin, (float*)pEnd, asc); break;
+			default: SortPrimitive32((asINT32*)pBegin, (asINT32*)pEnd, asc); break; // Int32 and all enums fall here, same as in Less.
 		}
 	}
 }
@@ -2123,6 +2374,18 @@ static void ScriptArrayReserve_Generic(asIScriptGeneric *gen)
 	self->Reserve(size);
 }
 
+static void ScriptArrayShrinkToFit_Generic(asIScriptGeneric *gen)
+{
+	ScriptArray *self = (ScriptArray*)gen->GetObject();
+	self->ShrinkToFit();
+}
+
+static void ScriptArrayCapacity_Generic(asIScriptGeneric *gen)
+{
+	ScriptArray *self = (ScriptArray*)gen->GetObject();
+	gen->SetReturnDWord(self->GetCapacity());
+}
+
 static void ScriptArraySortAsc_Generic(asIScriptGeneric *gen)
 {
 	ScriptArray *self = (ScriptArray*)gen->GetObject();
@@ -2249,6 +2512,8 @@ static void RegisterScriptArray_Generic(TypeRegistry* pTypeRegistry)
 	r = engine->RegisterObjectMethod("Array<T>", "uint Count() const", asFUNCTION(ScriptArrayCount_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
 #endif
 	r = engine->RegisterObjectMethod("Array<T>", "void Reserve(uint length)", asFUNCTION(ScriptArrayReserve_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
+	r = engine->RegisterObjectMethod("Array<T>", "void ShrinkToFit()", asFUNCTION(ScriptArrayShrinkToFit_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
+	r = engine->RegisterObjectMethod("Array<T>", "uint Capacity() const", asFUNCTION(ScriptArrayCapacity_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void Resize(uint length)", asFUNCTION(ScriptArrayResize_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void SortAsc()", asFUNCTION(ScriptArraySortAsc_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
 	r = engine->RegisterObjectMethod("Array<T>", "void SortAsc(uint startAt, uint count)", asFUNCTION(ScriptArraySortAsc2_Generic), asCALL_GENERIC); H_ASSERT( r >= 0 );
@@ -39,6 +39,12 @@ namespace Hail
 			// Pre-allocates memory for elements
 			void   Reserve(asUINT maxElements);
 
+			// Releases the reserved memory that is not used by any element
+			void   ShrinkToFit();
+
+			// Number of elements that fit before the buffer has to grow
+			asUINT GetCapacity() const;
+
 			// Resize the array
 			void   Resize(asUINT numElements);
 
@@ -109,6 +115,7 @@ namespace Hail
 			void  Swap(void* a, void* b);
 			void  Precache();
 			bool  CheckMaxSize(asUINT numElements);
+			asUINT GetGrownCapacity(asUINT requiredElements) const;
 			void  Resize(int delta, asUINT at);
 			void  CreateBuffer(ArrayBuffer** buf, asUINT numElements);
 			void  DeleteBuffer(ArrayBuffer* buf);
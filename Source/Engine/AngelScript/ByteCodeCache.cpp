@@ -0,0 +1,199 @@
+#include "Engine_PCH.h"
+#include "ByteCodeCache.h"
+
+#include "angelscript.h"
+#include "Scriptbuilder.h"
+#include "TypeRegistry.h"
+#include "Hashing\MemoryHash.h"
+#include "Hashing\xxh64_en.hpp"
+#include "Utility\InOutStream.h"
+
+using namespace Hail;
+
+namespace
+{
+	constexpr uint32 g_byteCodeCacheIdentifier = 0x43534148; // "HASC"
+	constexpr uint32 g_byteCodeCacheVersion = 1u;
+	bool ReadWholeFile(const FilePath& filePath, GrowingArray<uint8>& bufferToFill)
+	{
+		InOutStream stream;
+		if (!stream.OpenFile(filePath, FILE_OPEN_TYPE::READ, true))
+			return false;
+
+		const size_t fileSize = stream.GetFileSize();
+		bufferToFill.RemoveAll();
+		if (fileSize == 0)
+			return true;
+
+		bufferToFill.PrepareAndFill(fileSize);
+		return stream.Read(bufferToFill.Data(), fileSize);
+	}
+
+	bool HashSourceFile(const char* pSourceFile, GrowingArray<uint8>& sourceBuffer, uint64& hashOut)
+	{
+		if (!ReadWholeFile(FilePath(pSourceFile), sourceBuffer))
+			return false;
+
+		hashOut = HashMemory(sourceBuffer.Data(), sourceBuffer.Size());
+		return true;
+	}
+
+	class MemoryReadStream : public asIBinaryStream
+	{
+	public:
+		MemoryReadStream(const uint8* pData, size_t size) : m_pData(pData), m_size(size), m_position(0) {}
+
+		int Read(void* ptr, asUINT size) override
+		{
+			if (m_position + size > m_size)
+				return -1;
+			memcpy(ptr, m_pData + m_position, size);
+			m_position += size;
+			return 0;
+		}
+		int Write(const void* ptr, asUINT size) override { return -1; }
+
+	private:
+		const uint8* m_pData;
+		size_t m_size;
+		size_t m_position;
+	};
+
+	// Writes in to the buffer, the buffer is filled to its capacity and the stream keeps track of the written size.
+	class MemoryWriteStream : public asIBinaryStream
+	{
+	public:
+		explicit MemoryWriteStream(GrowingArray<uint8>& buffer) : m_buffer(buffer), m_size(0) {}
+
+		int Read(void* ptr, asUINT size) override { return -1; }
+		int Write(const void* ptr, asUINT size) override
+		{
+			if (m_size + size > m_buffer.Size())
+			{
+				const size_t doubledSize = m_buffer.Size() * 2;
+				const size_t requiredSize = m_size + size;
+				m_buffer.PrepareAndFill(doubledSize > requiredSize ? doubledSize : requiredSize);
+			}
+			memcpy(m_buffer.Data() + m_size, ptr, size);
+			m_size += size;
+			return 0;
+		}
+
+		size_t GetSize() const { return m_size; }
+
+	private:
+		GrowingArray<uint8>& m_buffer;
+		size_t m_size;
+	};
+}
+
+void Hail::AngelScript::ByteCodeCache::Initialize(TypeRegistry* pTypeRegistry)
+{
+	m_registrationSignature = pTypeRegistry->CalculateRegistrationSignature();
+}
+
+bool Hail::AngelScript::ByteCodeCache::TryLoadModule(asIScriptModule* pModule, const FilePath& pathToScript)
+{
+	if (!ReadWholeFile(GetCachePath(pathToScript), m_fileBuffer))
+		return false;
+
+	const uint8* pData = m_fileBuffer.Data();
+	const size_t fileSize = m_fileBuffer.Size();
+	if (fileSize < sizeof(CacheHeader))
+		return false;
+
+	CacheHeader header;
+	memcpy(&header, pData, sizeof(CacheHeader));
+	if (header.m_identifier != g_byteCodeCacheIdentifier || header.m_version != g_byteCodeCacheVersion || header.m_registrationSignature != m_registrationSignature)
+		return false;
+
+	// Every source file that was a part of the module must be unchanged
+	size_t position = sizeof(CacheHeader);
+	GrowingArray<uint8> sourceBuffer;
+	for (uint32 i = 0; i < header.m_numberOfSourceFiles; i++)
+	{
+		uint32 pathLength = 0;
+		if (position + sizeof(pathLength) > fileSize)
+			return false;
+		memcpy(&pathLength, pData + position, sizeof(pathLength));
+		position += sizeof(pathLength);
+
+		if (pathLength >= MAX_FILE_LENGTH || position + pathLength + sizeof(uint64) > fileSize)
+			return false;
+		char sourcePath[MAX_FILE_LENGTH];
+		memcpy(sourcePath, pData + position, pathLength);
+		sourcePath[pathLength] = '\0';
+		position += pathLength;
+
+		uint64 storedHash = 0;
+		memcpy(&storedHash, pData + position, sizeof(storedHash));
+		position += sizeof(storedHash);
+
+		uint64 currentHash = 0;
+		if (!HashSourceFile(sourcePath, sourceBuffer, currentHash) || currentHash != storedHash)
+			return false;
+	}
+
+	if (position + header.m_byteCodeSize != fileSize)
+		return false;
+
+	MemoryReadStream byteCodeStream(pData + position, header.m_byteCodeSize);
+	if (pModule->LoadByteCode(&byteCodeStream) < 0)
+	{
+		H_WARNING(StringL::Format("Failed to load cached bytecode for module %s, compiling from source.", pModule->GetName()));
+		return false;
+	}
+	return true;
+}
+
+void Hail::AngelScript::ByteCodeCache::StoreModule(asIScriptModule* pModule, const FilePath& pathToScript, const CScriptBuilder& builder)
+{
+	MemoryWriteStream stream(m_fileBuffer);
+
+	CacheHeader header;
+	header.m_identifier = g_byteCodeCacheIdentifier;
+	header.m_version = g_byteCodeCacheVersion;
+	header.m_registrationSignature = m_registrationSignature;
+	header.m_numberOfSourceFiles = builder.GetSectionCount();
+	header.m_byteCodeSize = 0;
+	stream.Write(&header, sizeof(CacheHeader));
+
+	GrowingArray<uint8> sourceBuffer;
+	for (uint32 i = 0; i < header.m_numberOfSourceFiles; i++)
+	{
+		const std::string sectionName = builder.GetSectionName(i);
+		const uint32 pathLength = (uint32)sectionName.length();
+		uint64 sourceHash = 0;
+		if (pathLength >= MAX_FILE_LENGTH || !HashSourceFile(sectionName.c_str(), sourceBuffer, sourceHash))
+			return;
+
+		stream.Write(&pathLength, sizeof(pathLength));
+		stream.Write(sectionName.c_str(), pathLength);
+		stream.Write(&sourceHash, sizeof(sourceHash));
+	}
+
+	const size_t byteCodeStart = stream.GetSize();
+	// Debug info is kept so the debugger still gets line numbers and section names from cached modules.
+	if (pModule->SaveByteCode(&stream, false) < 0)
+	{
+		H_WARNING(StringL::Format("Failed to save bytecode for module %s", pModule->GetName()));
+		return;
+	}
+	header.m_byteCodeSize = (uint32)(stream.GetSize() - byteCodeStart);
+	memcpy(m_fileBuffer.Data(), &header, sizeof(CacheHeader));
+
+	InOutStream outStream;
+	if (!outStream.OpenFile(GetCachePath(pathToScript), FILE_OPEN_TYPE::WRITE, true))
+	{
+		H_WARNING(StringL::Format("Failed to write bytecode cache for module %s", pModule->GetName()));
+		return;
+	}
+	outStream.Write(m_fileBuffer.Data(), stream.GetSize());
+}
+
+FilePath Hail::AngelScript::ByteCodeCache::GetCachePath(const FilePath& pathToScript) const
+{
+	// The full path is part of the name so scripts with the same name in different folders get their own cache.
+	const uint64 pathHash = xxh64::hash(reinterpret_cast<const char*>(pathToScript.Data()), pathToScript.Length() * sizeof(wchar_t), 0);
+	return FilePath::GetAngelscriptCompiledDirectory() + WString64::Format(L"%.32ls_%016llx.asbc", (const wchar_t*)pathToScript.Object().Name(), pathHash).Data();
+}
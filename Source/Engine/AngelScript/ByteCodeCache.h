@@ -0,0 +1,44 @@
+#pragma once
+#include "Types.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+#include "Utility\FilePath.hpp"
+
+class asIScriptModule;
+class CScriptBuilder;
+
+namespace Hail
+{
+	namespace AngelScript
+	{
+		class TypeRegistry;
+
+		// Stores the compiled bytecode of script modules on disk so unchanged scripts skip preprocessing and compilation.
+		// A cache file is only used if the registration signature of the engine and the hash of every source file that
+		// was part of the module are the same as when the bytecode was saved.
+		class ByteCodeCache
+		{
+		public:
+			void Initialize(TypeRegistry* pTypeRegistry);
+
+			// Returns true if the module was filled with cached bytecode, the module must be empty.
+			bool TryLoadModule(asIScriptModule* pModule, const FilePath& pathToScript);
+			// Saves a module that was built from source with the builder, the builder knows all included files.
+			void StoreModule(asIScriptModule* pModule, const FilePath& pathToScript, const CScriptBuilder& builder);
+
+		private:
+			struct CacheHeader
+			{
+				uint32 m_identifier;
+				uint32 m_version;
+				uint64 m_registrationSignature;
+				uint32 m_numberOfSourceFiles;
+				uint32 m_byteCodeSize;
+			};
+
+			FilePath GetCachePath(const FilePath& pathToScript) const;
+
+			uint64 m_registrationSignature = 0;
+			GrowingArray<uint8> m_fileBuffer;
+		};
+	}
+}
@@ -5,6 +5,7 @@
 
 #include "TypeRegistry.h"
 #include "Handler.h"
+#include "Array.h"
 
 #include "HailEngine.h"
 
@@ -24,9 +25,16 @@
 #include <arpa/inet.h>
 #include <netdb.h>  /* Needed for getaddrinfo() and freeaddrinfo() */
 #include <unistd.h> /* Needed for close() */
+#include <errno.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 #endif
 
 #include "MathUtils.h"
+#include "Hashing\xxh64_en.hpp"
+
+#include <algorithm>
 
 namespace Hail
 {
@@ -206,26 +214,64 @@ namespace
 
     int SocketClose(Hail::H_Socket socketHandle)
     {
+        // Shutdown fails for sockets that are not connected, like the listening socket, the handle is closed either way.
+#ifdef _WIN32
+        shutdown(socketHandle, SD_SEND);
+        return closesocket(socketHandle);
+#else
+        shutdown(socketHandle, SHUT_RDWR);
+        return close(socketHandle);
+#endif
+    }
 
-        int status = 0;
+    int GetLastSocketError()
+    {
+#ifdef _WIN32
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
 
+    bool IsWouldBlockError(int error)
+    {
 #ifdef _WIN32
-        status = shutdown(socketHandle, SD_SEND);
-        if (status == SOCKET_ERROR)
-        { 
-            status = closesocket(socketHandle); 
-        }
+        return error == WSAEWOULDBLOCK;
 #else
-        status = shutdown(socketHandle, SHUT_RDWR);
-        if (status == 0) 
-        { 
-            status = close(socketHandle); 
-        }
+        return error == EWOULDBLOCK || error == EAGAIN || error == EINTR;
 #endif
+    }
 
-        return status;
+    bool SetSocketNonBlocking(Hail::H_Socket socketHandle)
+    {
+#ifdef _WIN32
+        unsigned long iMode = 1;
+        return ioctlsocket(socketHandle, FIONBIO, &iMode) == NO_ERROR;
+#else
+        const int flags = fcntl(socketHandle, F_GETFL, 0);
+        return flags != -1 && fcntl(socketHandle, F_SETFL, flags | O_NONBLOCK) != -1;
+#endif
+    }
+
+    void AppendBytes(GrowingArray<char>& buffer, const void* pData, uint32 numberOfBytes)
+    {
+        const uint32 offset = buffer.Size();
+        buffer.AddN(numberOfBytes);
+        memcpy(buffer.Data() + offset, pData, numberOfBytes);
     }
 
+#ifdef __linux__
+    // A client that closed its end should not raise SIGPIPE on the game thread.
+    constexpr int SendFlags = MSG_NOSIGNAL;
+#else
+    constexpr int SendFlags = 0;
+#endif
+
+    // Receive buffers are compacted when this much has been handled, as a client streaming partial messages never empties the buffer.
+    constexpr uint32 ReceiveBufferCompactionSize = 64u * 1024u;
+    // How long the game thread sleeps on the sockets per iteration while stopped at a breakpoint.
+    constexpr uint32 StoppedExecutionWaitTimeInMs = 10u;
+
     Hail::H_Socket CreateSocket()
     {
 #define DEFAULT_PORT "27015"
@@ -260,12 +306,39 @@ namespace
         const int bindResult = bind(returnSocket, result->ai_addr, (int)result->ai_addrlen);
         H_ASSERT(bindResult != -1, "Failed to bind server socket");
       
-        unsigned long iMode = 1;
-        iResult = ioctlsocket(returnSocket, FIONBIO, &iMode);
-        H_ASSERT(iResult == NO_ERROR, "ioctlsocket failed with error.");
+        freeaddrinfo(result);
+
+        const bool bIsNonBlocking = SetSocketNonBlocking(returnSocket);
+        H_ASSERT(bIsNonBlocking, "ioctlsocket failed with error.");
 #else
-        // TODO: POSIX sockets
+        struct addrinfo* result = nullptr;
+        struct addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_protocol = IPPROTO_TCP;
+        hints.ai_flags = AI_PASSIVE;
+
+        const int iResult = getaddrinfo(nullptr, DEFAULT_PORT, &hints, &result);
+        if (iResult != 0)
+        {
+            H_ERROR(StringL::Format("getaddrinfo failed: %s", gai_strerror(iResult)));
+            return InvalidSocket;
+        }
+
+        returnSocket = socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+        H_ASSERT(returnSocket != InvalidSocket, "Failed to create server socket.");
+
+        // Lets the server restart on the port while the old connections are in TIME_WAIT.
+        int reuseAddress = 1;
+        setsockopt(returnSocket, SOL_SOCKET, SO_REUSEADDR, &reuseAddress, sizeof(reuseAddress));
 
+        const int bindResult = bind(returnSocket, result->ai_addr, result->ai_addrlen);
+        H_ASSERT(bindResult != -1, "Failed to bind server socket");
+        freeaddrinfo(result);
+
+        const bool bIsNonBlocking = SetSocketNonBlocking(returnSocket);
+        H_ASSERT(bIsNonBlocking, "Failed to set the server socket to non blocking.");
 #endif
 
         return returnSocket;
@@ -285,13 +358,24 @@ DebuggerServer::DebuggerServer(TypeDebuggerRegistry* pTypeDebuggerRegistry)
     m_socketHandle = CreateSocket();
     // listening to the assigned socket 
     int iListenResult = listen(m_socketHandle, 4096);
-    H_ASSERT(iListenResult == NO_ERROR, "Failed with listen.");
+    H_ASSERT(iListenResult == 0, "Failed with listen.");
+#ifdef __linux__
+    m_epollHandle = epoll_create1(0);
+    H_ASSERT(m_epollHandle != -1, "Failed to create the debugger epoll instance.");
+#endif
 }
 
 DebuggerServer::~DebuggerServer()
 {
-    SendDebuggerMessage(CreateStopDebugSessionMessage());
+    DebuggerMessage stopMessage = CreateStopDebugSessionMessage();
+    SendDebuggerMessage(stopMessage);
+    FlushMessages();
+    for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
+        SocketClose(m_clients[iClient].m_clientData.m_socket);
 
+#ifdef __linux__
+    close(m_epollHandle);
+#endif
     H_ASSERT(SocketClose(m_socketHandle) == 0, "Failed to close socket properly");
     //Close Winsock / socket use.
     SockQuit();
@@ -300,6 +384,8 @@ DebuggerServer::~DebuggerServer()
 Hail::AngelScript::ScriptDebugger::ScriptDebugger()
     : m_bIsDebugging(false)
     , m_pScriptContext(nullptr)
+    , m_pCurrentSectionName(nullptr)
+    , m_currentSectionIndex(0)
     , m_executionStatus(eScriptExecutionStatus::Normal)
     , m_bGeneratedStackData(false)
     , m_bGeneratedVariables(false)
@@ -310,11 +396,16 @@ Hail::AngelScript::ScriptDebugger::ScriptDebugger()
     m_clientData.m_socket = InvalidSocket;
     m_clientData.m_bConnectedForDebugging = false;
     m_clientData.m_bDisconnected = true;
+    m_clientData.m_bReadable = false;
+    m_clientData.m_receiveOffset = 0;
+    m_clientData.m_sendOffset = 0;
 }
 
 Hail::AngelScript::ScriptDebugger::ScriptDebugger(asIScriptContext* pContext, DebuggerServer* pDebugServer, TypeRegistry* pTypeRegistry)
     : m_bIsDebugging(false)
     , m_pScriptContext(pContext)
+    , m_pCurrentSectionName(nullptr)
+    , m_currentSectionIndex(0)
     , m_executionStatus(eScriptExecutionStatus::Normal)
     , m_bGeneratedStackData(false)
     , m_bGeneratedVariables(false)
@@ -325,11 +416,15 @@ Hail::AngelScript::ScriptDebugger::ScriptDebugger(asIScriptContext* pContext, De
     m_clientData.m_socket = InvalidSocket;
     m_clientData.m_bConnectedForDebugging = false;
     m_clientData.m_bDisconnected = true;
+    m_clientData.m_bReadable = false;
+    m_clientData.m_receiveOffset = 0;
+    m_clientData.m_sendOffset = 0;
 }
 
 void Hail::AngelScript::ScriptDebugger::SetContext(asIScriptContext* pContext)
 {
     m_pScriptContext = pContext;
+    InvalidateSectionBreakPointLines();
 }
 
 void ScriptDebugger::LineCallback(asIScriptContext* pContext)
@@ -344,30 +439,20 @@ void ScriptDebugger::LineCallback(asIScriptContext* pContext)
         return;
 
     m_currentLine = lineNbr;
-    const FilePath scriptObjectPath = file;
-    FileBreakPoints* pFileBreakPoints = nullptr;
-    for (uint16 i = 0; i < m_breakPoints.Size(); i++)
+    if (file != m_pCurrentSectionName || m_sectionBreakPointLines.Empty())
     {
-        if (StringCompareCaseInsensitive(m_breakPoints[i].fileName.Data(), scriptObjectPath.Object().Name().CharString()))
-        {
-            pFileBreakPoints = &m_breakPoints[i];
-            break;
-        }
+        m_currentSectionIndex = ResolveSectionBreakPointLines(file);
+        m_pCurrentSectionName = file;
     }
 
     bool bHitBreakpoint = false;
-    if (pFileBreakPoints)
+    const GrowingArray<uint64>& lineBits = m_sectionBreakPointLines[m_currentSectionIndex].m_lineBits;
+    const uint32 lineWord = (uint32)lineNbr / 64u;
+    if (lineNbr >= 0 && lineWord < lineBits.Size() && (lineBits[lineWord] >> ((uint32)lineNbr % 64u)) & 1u)
     {
-        for (size_t i = 0; i < pFileBreakPoints->breakPoints.Size(); i++)
-        {
-            if (pFileBreakPoints->breakPoints[i].line == lineNbr)
-            {
-                H_DEBUGMESSAGE("Hit breakpoint in file");
-                m_executionStatus = eScriptExecutionStatus::StoppedExecution;
-                bHitBreakpoint = true;
-                break;
-            }
-        }
+        H_DEBUGMESSAGE("Hit breakpoint in file");
+        m_executionStatus = eScriptExecutionStatus::StoppedExecution;
+        bHitBreakpoint = true;
     }
 
     if (m_executionStatus == eScriptExecutionStatus::Normal)
@@ -399,11 +484,12 @@ void ScriptDebugger::LineCallback(asIScriptContext* pContext)
     {
         m_bGeneratedStackData = false;
         CreateCallstack(pContext, file);
+        // The variables are created when the client requests them.
         m_bGeneratedVariables = false;
-        CreateVariables(pContext);
 
         if (bHitBreakpoint)
         {
+            const FilePath scriptObjectPath = file;
             StringLW fileName = scriptObjectPath.Data();
             m_messages.Add(CreateHitBreakpointMessage(lineNbr, fileName.ToCharString()));
             H_DEBUGMESSAGE("Sending hit breakpoint message.");
@@ -421,6 +507,47 @@ void ScriptDebugger::LineCallback(asIScriptContext* pContext)
     m_pDebuggerServer->UpdateDuringScriptExecution();
 }
 
+uint32 Hail::AngelScript::ScriptDebugger::ResolveSectionBreakPointLines(const char* pSectionName)
+{
+    for (uint32 i = 0; i < m_sectionBreakPointLines.Size(); i++)
+    {
+        if (m_sectionBreakPointLines[i].m_pSectionName == pSectionName)
+            return i;
+    }
+
+    SectionBreakPointLines& sectionLines = m_sectionBreakPointLines.Add();
+    sectionLines.m_pSectionName = pSectionName;
+    if (pSectionName == nullptr)
+        return m_sectionBreakPointLines.Size() - 1;
+
+    const FilePath scriptObjectPath = pSectionName;
+    for (uint32 i = 0; i < m_breakPoints.Size(); i++)
+    {
+        if (!StringCompareCaseInsensitive(m_breakPoints[i].fileName.Data(), scriptObjectPath.Object().Name().CharString()))
+            continue;
+
+        const GrowingArray<BreakPoint>& breakPoints = m_breakPoints[i].breakPoints;
+        for (uint32 iBreakPoint = 0; iBreakPoint < breakPoints.Size(); iBreakPoint++)
+        {
+            if (breakPoints[iBreakPoint].line < 0)
+                continue;
+            const uint32 line = (uint32)breakPoints[iBreakPoint].line;
+            while (sectionLines.m_lineBits.Size() <= line / 64u)
+                sectionLines.m_lineBits.Add(0ull);
+            sectionLines.m_lineBits[line / 64u] |= 1ull << (line % 64u);
+        }
+        break;
+    }
+    return m_sectionBreakPointLines.Size() - 1;
+}
+
+void Hail::AngelScript::ScriptDebugger::InvalidateSectionBreakPointLines()
+{
+    m_sectionBreakPointLines.RemoveAll();
+    m_pCurrentSectionName = nullptr;
+    m_currentSectionIndex = 0;
+}
+
 void Hail::AngelScript::ScriptDebugger::SetLineCallback()
 {
     if (m_bIsDebugging)
@@ -459,6 +586,7 @@ void Hail::AngelScript::ScriptDebugger::StopDebuggingScript()
     ClearLineCallback();
     m_registeredObjects.RemoveAll();
     m_breakPoints.RemoveAll();
+    InvalidateSectionBreakPointLines();
     m_bGeneratedVariables = false;
     m_bGeneratedStackData = false;
 
@@ -477,6 +605,7 @@ void Hail::AngelScript::ScriptDebugger::AddBreakpoints(const FileBreakPoints& br
     }
 
     m_breakPoints.Add(breakPoints);
+    InvalidateSectionBreakPointLines();
 }
 
 void Hail::AngelScript::ScriptDebugger::RemoveBreakpoints(const FileBreakPoints& breakPoints)
@@ -489,11 +618,13 @@ void Hail::AngelScript::ScriptDebugger::RemoveBreakpoints(const FileBreakPoints&
             break;
         }
     }
+    InvalidateSectionBreakPointLines();
 }
 
 void Hail::AngelScript::ScriptDebugger::RemoveBreakpoints()
 {
     m_breakPoints.RemoveAll();
+    InvalidateSectionBreakPointLines();
     H_DEBUGMESSAGE("Remove breakpoints");
 }
 
@@ -523,6 +654,8 @@ void Hail::AngelScript::ScriptDebugger::SendGeneratedCallstack()
 
 void Hail::AngelScript::ScriptDebugger::SendVariables(eCallStack callStackToSend)
 {
+    if (m_executionStatus == eScriptExecutionStatus::StoppedExecution)
+        CreateVariables(m_pScriptContext);
 
     if (!m_bGeneratedVariables)
     {
@@ -538,34 +671,135 @@ void Hail::AngelScript::ScriptDebugger::SendVariables(eCallStack callStackToSend
 
 void Hail::AngelScript::ScriptDebugger::SendVariable(eCallStack callStackToSend, StringL variableRequested)
 {
+    if (m_executionStatus == eScriptExecutionStatus::StoppedExecution)
+        CreateVariables(m_pScriptContext);
+
     const Variable* pVarToSend = nullptr;
     if (m_bGeneratedVariables)
     {
-        for (size_t i = 0; i < m_variables[(uint32)callStackToSend].Size(); i++)
+        pVarToSend = FindVariable(callStackToSend, variableRequested);
+        // Also search local scope
+        if (!pVarToSend)
+            pVarToSend = FindVariable(eCallStack::local, variableRequested);
+    }
+    H_DEBUGMESSAGE("Sending specific variable message.");
+    m_messages.Add(CreateVariableMessage(pVarToSend));
+}
+
+void Hail::AngelScript::ScriptDebugger::SendVariableChildren(uint32 handle, uint32 firstChild, uint32 numberOfChildren)
+{
+    constexpr uint32 defaultPageSize = 100u;
+    GrowingArray<Variable> children;
+    if (!m_bGeneratedVariables || handle == 0u || handle > m_variableHandles.Size())
+    {
+        H_WARNING(StringL::Format("Requested children of an invalid variable handle %u.", handle));
+        m_messages.Add(CreateVariablesMessage(&children));
+        return;
+    }
+
+    const VariableHandle variableHandle = m_variableHandles[handle - 1u];
+    asIScriptEngine* pEngine = m_pScriptContext->GetEngine();
+    void* pValue = variableHandle.m_pValue;
+    if (variableHandle.m_typeId & asTYPEID_OBJHANDLE)
+        pValue = *(void**)pValue;
+    if (numberOfChildren == 0u)
+        numberOfChildren = defaultPageSize;
+
+    if (pValue && (variableHandle.m_typeId & asTYPEID_SCRIPTOBJECT))
+    {
+        asIScriptObject* pObject = (asIScriptObject*)pValue;
+        asITypeInfo* pType = pObject->GetObjectType();
+        const uint32 lastChild = Math::Min(firstChild + numberOfChildren, (uint32)pObject->GetPropertyCount());
+        for (uint32 n = firstChild; n < lastChild; n++)
         {
-            const Variable& var = m_variables[(uint32)callStackToSend][i];
-            if (StringCompare(var.m_name, variableRequested))
-            {
-                pVarToSend = &var;
-                break;
-            }
+            Variable& member = children.Add();
+            member = CreateVariable(pObject->GetAddressOfProperty(n), pObject->GetPropertyTypeId(n), pEngine);
+            member.m_name = RemoveTypeInformationFromDeclaration(pType->GetPropertyDeclaration(n));
         }
-        if (!pVarToSend)
+    }
+    else if (pValue && m_pTypeRegistry->IsArrayType(variableHandle.m_typeId & ~asTYPEID_OBJHANDLE))
+    {
+        ScriptArray* pArray = (ScriptArray*)pValue;
+        const int elementTypeId = pArray->GetElementTypeId();
+        const uint32 lastChild = Math::Min(firstChild + numberOfChildren, (uint32)pArray->GetCount());
+        for (uint32 i = firstChild; i < lastChild; i++)
         {
-            // Also search local scope
-            for (size_t i = 0; i < m_variables[(uint32)eCallStack::local].Size(); i++)
-            {
-                const Variable& var = m_variables[(uint32)eCallStack::local][i];
-                if (StringCompare(var.m_name, variableRequested))
-                {
-                    pVarToSend = &var;
-                    break;
-                }
-            }
+            Variable& element = children.Add();
+            element = CreateVariable(pArray->At(i), elementTypeId, pEngine);
+            element.m_name = StringL::Format("[%u]", i);
         }
     }
-    H_DEBUGMESSAGE("Sending specific variable message.");
-    m_messages.Add(CreateVariableMessage(pVarToSend));
+
+    m_messages.Add(CreateVariablesMessage(&children));
+    H_DEBUGMESSAGE("Sending variable children message.");
+}
+
+void Hail::AngelScript::ScriptDebugger::CreateVariableLookups()
+{
+    for (uint32 iScope = 0; iScope < (uint32)eCallStack::count; iScope++)
+    {
+        const GrowingArray<Variable>& variables = m_variables[iScope];
+        GrowingArray<VariableLookup>& lookups = m_variableLookups[iScope];
+        lookups.RemoveAll();
+        lookups.Prepare(variables.Size());
+        for (uint32 iVariable = 0; iVariable < variables.Size(); iVariable++)
+        {
+            const StringL& name = variables[iVariable].m_name;
+            lookups.Add(VariableLookup{ xxh64::hash(name.Data(), name.Length(), 0), iVariable });
+        }
+        std::sort(lookups.Data(), lookups.Data() + lookups.Size(), [](const VariableLookup& a, const VariableLookup& b)
+            {
+                return a.m_nameHash < b.m_nameHash;
+            });
+    }
+}
+
+const Variable* Hail::AngelScript::ScriptDebugger::FindVariable(eCallStack scope, const StringL& name) const
+{
+    const GrowingArray<VariableLookup>& lookups = m_variableLookups[(uint32)scope];
+    const uint64 nameHash = xxh64::hash(name.Data(), name.Length(), 0);
+    const VariableLookup* pEnd = lookups.Data() + lookups.Size();
+    const VariableLookup* pLookup = std::lower_bound(lookups.Data(), pEnd, nameHash, [](const VariableLookup& lookup, uint64 hash)
+        {
+            return lookup.m_nameHash < hash;
+        });
+    // The names are compared as well since different names can have the same hash.
+    for (; pLookup != pEnd && pLookup->m_nameHash == nameHash; pLookup++)
+    {
+        const Variable& variable = m_variables[(uint32)scope][pLookup->m_variableIndex];
+        if (StringCompare(variable.m_name, name))
+            return &variable;
+    }
+    return nullptr;
+}
+
+Variable Hail::AngelScript::ScriptDebugger::CreateVariable(void* pValue, int32 typeId, asIScriptEngine* pEngine)
+{
+    Variable variable = ASTypeToVariable(pValue, typeId, 0, pEngine, GetTypeRegistry());
+    // Registered types that fill in their members are sent as they are, objects and arrays get a handle to expand on request.
+    if (!variable.m_members.Empty() || pValue == nullptr)
+        return variable;
+
+    void* pObject = (typeId & asTYPEID_OBJHANDLE) ? *(void**)pValue : pValue;
+    if (pObject == nullptr)
+        return variable;
+
+    uint32 numberOfChildren = 0u;
+    if (typeId & asTYPEID_SCRIPTOBJECT)
+        numberOfChildren = ((asIScriptObject*)pObject)->GetPropertyCount();
+    // Handles have the handle flag in the type id, array<T>@ has to be checked as the array type.
+    else if ((typeId & asTYPEID_MASK_OBJECT) && m_pTypeRegistry->IsArrayType(typeId & ~asTYPEID_OBJHANDLE))
+        numberOfChildren = ((ScriptArray*)pObject)->GetCount();
+
+    if (numberOfChildren)
+    {
+        VariableHandle& handle = m_variableHandles.Add();
+        handle.m_pValue = pValue;
+        handle.m_typeId = typeId;
+        variable.m_handle = m_variableHandles.Size();
+        variable.m_numberOfChildren = numberOfChildren;
+    }
+    return variable;
 }
 
 void Hail::AngelScript::ScriptDebugger::CreateCallstack(asIScriptContext* pContext, const char* pFileName)
@@ -737,14 +971,13 @@ void Hail::AngelScript::ScriptDebugger::CreateVariables(asIScriptContext* pConte
     //	Output("Invalid expression. Expected identifier\n");
     //}
     //ListMemberProperties
+    m_variableHandles.RemoveAll();
     m_variables[(int)eCallStack::self].RemoveAll();
     void* ptr = pContext->GetThisPointer();
     if (ptr)
     {
-        // TODO: Allow user to define if members should be expanded or not
-        // Expand members by default to 3 recursive levels only
         Variable& thisVariable = m_variables[(int)eCallStack::self].Add();
-        thisVariable = ASTypeToVariable(ptr, pContext->GetThisTypeId(), 3, pContext->GetEngine(), GetTypeRegistry());
+        thisVariable = CreateVariable(ptr, pContext->GetThisTypeId(), pContext->GetEngine());
         thisVariable.m_name = "this";
     }
 
@@ -757,10 +990,8 @@ void Hail::AngelScript::ScriptDebugger::CreateVariables(asIScriptContext* pConte
     {
         int typeId = 0;
         mod->GetGlobalVar(n, 0, 0, &typeId);
-        // TODO: Allow user to set how many recursive expansions should be done
-        // Expand members by default to 3 recursive levels only
         Variable& globalVariable = m_variables[(int)eCallStack::global].Add();
-        globalVariable = ASTypeToVariable(mod->GetAddressOfGlobalVar(n), typeId, 3, pContext->GetEngine(), GetTypeRegistry());
+        globalVariable = CreateVariable(mod->GetAddressOfGlobalVar(n), typeId, pContext->GetEngine());
         globalVariable.m_name = RemoveTypeInformationFromDeclaration(mod->GetGlobalVarDeclaration(n));
 
     }
@@ -780,17 +1011,16 @@ void Hail::AngelScript::ScriptDebugger::CreateVariables(asIScriptContext* pConte
 
             if (pContext->IsVarInScope(n))
             {
-                // TODO: Allow user to set if members should be expanded or not
-                // Expand members by default to 3 recursive levels only
                 int typeId;
                 pContext->GetVar(n, 0, 0, &typeId);
                 Variable& localVariable = m_variables[(int)eCallStack::local].Add();
-                localVariable = ASTypeToVariable(pContext->GetAddressOfVar(n), typeId, 3, pContext->GetEngine(), GetTypeRegistry());
+                localVariable = CreateVariable(pContext->GetAddressOfVar(n), typeId, pContext->GetEngine());
                 localVariable.m_name = RemoveTypeInformationFromDeclaration(localFunc->GetVarDecl(n));
             }
         }
     }
 
+    CreateVariableLookups();
     m_bGeneratedVariables = true;
 }
 
@@ -801,14 +1031,27 @@ void Hail::AngelScript::DebuggerServer::Update(bool bAreScriptsReloading)
         const H_Socket connectingSocket = accept(m_socketHandle, nullptr, nullptr);
         if (connectingSocket != InvalidSocket)
         {
+            // Accepted sockets only inherit non blocking from the server socket on Windows.
+            SetSocketNonBlocking(connectingSocket);
+#ifdef __linux__
+            epoll_event socketEvent{};
+            socketEvent.events = EPOLLIN;
+            socketEvent.data.fd = connectingSocket;
+            epoll_ctl(m_epollHandle, EPOLL_CTL_ADD, connectingSocket, &socketEvent);
+#endif
             ScriptDebugger& newClient = m_clients.Add();
             newClient.m_clientData.m_socket = connectingSocket;
             newClient.m_clientData.m_bConnectedForDebugging = false;
             newClient.m_clientData.m_bDisconnected = false;
+            newClient.m_clientData.m_bReadable = false;
+            newClient.m_clientData.m_receiveBuffer.RemoveAll();
+            newClient.m_clientData.m_receiveOffset = 0;
+            newClient.m_clientData.m_sendBuffer.RemoveAll();
+            newClient.m_clientData.m_sendOffset = 0;
         }
     }
 
-    ListenToMessages();
+    ListenToMessages(0);
     if (m_bIsDebugging && m_pActiveScript)
     {
         GrowingArray<DebuggerMessage>& debuggerMessages = m_pActiveScript->m_pDebugger->GetMessages();
@@ -859,7 +1102,7 @@ void Hail::AngelScript::DebuggerServer::Update(bool bAreScriptsReloading)
         m_returnRequests.RemoveAll();
         m_registeredBuildErrors.RemoveAll();
     }
-
+    FlushMessages();
 }
 
 void Hail::AngelScript::DebuggerServer::UpdateDuringScriptExecution()
@@ -876,7 +1119,7 @@ void Hail::AngelScript::DebuggerServer::UpdateDuringScriptExecution()
 
         while (m_pActiveScript->m_pDebugger->GetStatus() == eScriptExecutionStatus::StoppedExecution && !IsApplicationTerminated())
         {
-            ListenToMessages();
+            ListenToMessages(StoppedExecutionWaitTimeInMs);
 
             GrowingArray<DebuggerMessage>& debuggerMessages = m_pActiveScript->m_pDebugger->GetMessages();
             for (size_t iDebugMessage = 0; iDebugMessage < debuggerMessages.Size(); iDebugMessage++)
@@ -884,6 +1127,7 @@ void Hail::AngelScript::DebuggerServer::UpdateDuringScriptExecution()
                 SendDebuggerMessage(debuggerMessages[iDebugMessage]);
             }
             debuggerMessages.RemoveAll();
+            FlushMessages();
         }
 
         // Reset engine state
@@ -974,6 +1218,12 @@ void Hail::AngelScript::DebuggerServer::FindVariable(eCallStack callStackType, S
         m_pActiveScript->m_pDebugger->SendVariable(callStackType, variableToFind);
 }
 
+void Hail::AngelScript::DebuggerServer::SendVariableChildren(uint32 handle, uint32 firstChild, uint32 numberOfChildren)
+{
+    if (m_pActiveScript)
+        m_pActiveScript->m_pDebugger->SendVariableChildren(handle, firstChild, numberOfChildren);
+}
+
 void Hail::AngelScript::DebuggerServer::SendCallstack()
 {
     if (m_pActiveScript)
@@ -1013,22 +1263,124 @@ void Hail::AngelScript::DebuggerServer::SendDebuggerMessage(DebuggerMessage& mes
 {
     for (int iClient = 0; iClient < m_clients.Size(); iClient++)
     {
-        if (m_clients[iClient].m_clientData.m_bConnectedForDebugging)
+        ScriptDebugger::Client& client = m_clients[iClient].m_clientData;
+        if (client.m_bConnectedForDebugging)
         {
-            int iSendResult = send(m_clients[iClient].m_clientData.m_socket, (const char*)(&messageToSend.m_header), sizeof(MessageHeader), 0);
+            AppendBytes(client.m_sendBuffer, &messageToSend.m_header, sizeof(MessageHeader));
             if (messageToSend.m_header.messageLength)
-                iSendResult = send(m_clients[iClient].m_clientData.m_socket, (messageToSend.m_data.GetMessageData()), messageToSend.m_header.messageLength, 0);
-            if (iSendResult == SOCKET_ERROR) {
-                H_ERROR(StringL::Format("send failed: %d\n", WSAGetLastError()));
+                AppendBytes(client.m_sendBuffer, messageToSend.m_data.GetMessageData(), messageToSend.m_header.messageLength);
+        }
+    }
+}
+
+void Hail::AngelScript::DebuggerServer::FlushMessages()
+{
+    for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
+    {
+        ScriptDebugger::Client& client = m_clients[iClient].m_clientData;
+        // All queued messages go out in as few sends as the socket buffer allows, what does not fit is sent on the next flush.
+        while (client.m_sendOffset < client.m_sendBuffer.Size())
+        {
+            const int iSendResult = send(client.m_socket, client.m_sendBuffer.Data() + client.m_sendOffset, (int)(client.m_sendBuffer.Size() - client.m_sendOffset), SendFlags);
+            if (iSendResult < 0)
+            {
+                const int error = GetLastSocketError();
+                if (!IsWouldBlockError(error))
+                {
+                    H_ERROR(StringL::Format("send failed: %d\n", error));
+                    client.m_sendBuffer.RemoveAll();
+                    client.m_sendOffset = 0;
+                }
+                break;
             }
+            client.m_sendOffset += iSendResult;
+        }
+        if (client.m_sendOffset == client.m_sendBuffer.Size())
+        {
+            client.m_sendBuffer.RemoveAll();
+            client.m_sendOffset = 0;
         }
     }
+}
+
+void Hail::AngelScript::DebuggerServer::WaitForSocketEvents(uint32 waitTimeInMs)
+{
+#ifdef __linux__
+    for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
+        m_clients[iClient].m_clientData.m_bReadable = false;
 
+    epoll_event socketEvents[MAX_ATTACHED_DEBUGGERS];
+    const int numberOfEvents = epoll_wait(m_epollHandle, socketEvents, MAX_ATTACHED_DEBUGGERS, m_clients.Size() ? (int)waitTimeInMs : 0);
+    for (int iEvent = 0; iEvent < numberOfEvents; iEvent++)
+    {
+        for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
+        {
+            if (m_clients[iClient].m_clientData.m_socket == socketEvents[iEvent].data.fd)
+                m_clients[iClient].m_clientData.m_bReadable = true;
+        }
+    }
+#else
+    // Without an event loop every client is read, the sockets are non blocking.
+    for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
+        m_clients[iClient].m_clientData.m_bReadable = true;
+#endif
 }
 
-void Hail::AngelScript::DebuggerServer::ListenToMessages()
+void Hail::AngelScript::DebuggerServer::ReceiveMessages(ScriptDebugger& script, bool& bOutDisconnected)
 {
-    char buffer[4096] = { 0 };
+    ScriptDebugger::Client& client = script.m_clientData;
+    bOutDisconnected = false;
+    char buffer[4096];
+    while (true)
+    {
+        const int iResult = recv(client.m_socket, buffer, sizeof(buffer), 0);
+        if (iResult > 0)
+        {
+            AppendBytes(client.m_receiveBuffer, buffer, iResult);
+            continue;
+        }
+        if (iResult == 0 || !IsWouldBlockError(GetLastSocketError()))
+        {
+            H_DEBUGMESSAGE("Client connection closing...");
+            bOutDisconnected = true;
+        }
+        break;
+    }
+
+    // Only whole messages are handled, a message split over several reads waits in the buffer.
+    uint32 completeMessagesEnd = client.m_receiveOffset;
+    while (client.m_receiveBuffer.Size() - completeMessagesEnd >= sizeof(MessageHeader))
+    {
+        MessageHeader header;
+        memcpy(&header, client.m_receiveBuffer.Data() + completeMessagesEnd, sizeof(MessageHeader));
+        if (client.m_receiveBuffer.Size() - completeMessagesEnd - sizeof(MessageHeader) < header.messageLength)
+            break;
+        completeMessagesEnd += sizeof(MessageHeader) + header.messageLength;
+    }
+
+    if (completeMessagesEnd != client.m_receiveOffset)
+    {
+        HandleDebuggerMessage(this, completeMessagesEnd - client.m_receiveOffset, client.m_receiveBuffer.Data() + client.m_receiveOffset);
+        client.m_receiveOffset = completeMessagesEnd;
+    }
+
+    if (client.m_receiveOffset == client.m_receiveBuffer.Size())
+    {
+        client.m_receiveBuffer.RemoveAll();
+        client.m_receiveOffset = 0;
+    }
+    else if (client.m_receiveOffset >= ReceiveBufferCompactionSize)
+    {
+        GrowingArray<char> remainingBytes;
+        AppendBytes(remainingBytes, client.m_receiveBuffer.Data() + client.m_receiveOffset, client.m_receiveBuffer.Size() - client.m_receiveOffset);
+        client.m_receiveBuffer = std::move(remainingBytes);
+        client.m_receiveOffset = 0;
+    }
+}
+
+void Hail::AngelScript::DebuggerServer::ListenToMessages(uint32 waitTimeInMs)
+{
+    WaitForSocketEvents(waitTimeInMs);
 
     VectorOnStack<uint32, MAX_ATTACHED_DEBUGGERS> disconnectingSockets;
     const bool wasDebugging = m_bIsDebugging;
@@ -1036,18 +1388,17 @@ void Hail::AngelScript::DebuggerServer::ListenToMessages()
 
     for (uint32 iClient = 0; iClient < m_clients.Size(); iClient++)
     {
-        buffer[0] = 0;
         ScriptDebugger& script = m_clients[iClient];
-        const int iResult = recv(script.m_clientData.m_socket, buffer, sizeof(buffer), 0);
         m_currentClient = iClient;
-        if (iResult > 0)
+        if (script.m_clientData.m_bReadable)
         {
-            HandleDebuggerMessage(this, iResult, buffer);
-        }
-        else if (iResult == 0)
-        {
-            H_DEBUGMESSAGE("Client connection closing...");
-            disconnectingSockets.Add(iClient);
+            bool bDisconnected = false;
+            ReceiveMessages(script, bDisconnected);
+            if (bDisconnected)
+            {
+                disconnectingSockets.Add(iClient);
+                continue;
+            }
         }
         if (script.m_clientData.m_bConnectedForDebugging)
         {
@@ -1065,6 +1416,7 @@ void Hail::AngelScript::DebuggerServer::ListenToMessages()
                     SendDebuggerMessage(debuggerMessages[iDebugMessage]);
                 }
                 debuggerMessages.RemoveAll();
+                FlushMessages();
                 script.m_clientData.m_bConnectedForDebugging = false;
                 disconnectingSockets.Add(iClient);
             }
@@ -1080,8 +1432,10 @@ void Hail::AngelScript::DebuggerServer::ListenToMessages()
     {
         H_Socket socket = m_clients[disconnectingSockets[i - 1]].m_clientData.m_socket;
         m_clients[disconnectingSockets[i - 1]].m_clientData.m_socket = InvalidSocket;
-        const int iResult = recv(socket, buffer, sizeof(buffer), 0);
-        closesocket(socket);
+#ifdef __linux__
+        epoll_ctl(m_epollHandle, EPOLL_CTL_DEL, socket, nullptr);
+#endif
+        SocketClose(socket);
         m_clients.RemoveCyclicAtIndex(disconnectingSockets[i - 1]);
     }
     if (wasDebugging && !m_bIsDebugging && m_pActiveScript)
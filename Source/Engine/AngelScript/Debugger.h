@@ -52,6 +52,8 @@ namespace Hail
 			void SendWarningMessage(const char* section, int row, const char* message);
 			void SendVariables(eCallStack callStackToSend);
 			void SendVariable(eCallStack callStackToSend, StringL variableRequested);
+			// Sends a page of the children of a variable, a count of 0 sends the default page size.
+			void SendVariableChildren(uint32 handle, uint32 firstChild, uint32 numberOfChildren);
 
 			TypeRegistry* GetTypeRegistry() { return m_pTypeRegistry; }
 
@@ -60,12 +62,30 @@ namespace Hail
 			friend class DebuggerServer;
 
 			void CreateCallstack(asIScriptContext* pContext, const char* pFileName);
+			// Only the variables of the scopes are created, their children are created when the client expands them.
 			void CreateVariables(asIScriptContext* pContext);
+			Variable CreateVariable(void* pValue, int32 typeId, asIScriptEngine* pEngine);
+			void CreateVariableLookups();
+			const Variable* FindVariable(eCallStack scope, const StringL& name) const;
+
+			// Breakpoints of a script section as one bit per line, resolved the first time a line of the section runs.
+			struct SectionBreakPointLines
+			{
+				// The section name from AngelScript, which keeps the same pointer for a section while the engine lives.
+				const char* m_pSectionName;
+				GrowingArray<uint64> m_lineBits;
+			};
+			uint32 ResolveSectionBreakPointLines(const char* pSectionName);
+			// Has to be called when the breakpoints change or the script is reloaded.
+			void InvalidateSectionBreakPointLines();
 
 			bool m_bIsDebugging;
 			asIScriptContext* m_pScriptContext;
-			// TODO add these breakpoints to a hashmap
 			GrowingArray<FileBreakPoints> m_breakPoints;
+			GrowingArray<SectionBreakPointLines> m_sectionBreakPointLines;
+			// The section of the last line callback, as consecutive lines are almost always in the same section.
+			const char* m_pCurrentSectionName;
+			uint32 m_currentSectionIndex;
 			eScriptExecutionStatus m_executionStatus;
 			int m_currentLine;
 
@@ -74,6 +94,20 @@ namespace Hail
 			GrowingArray<StackFrame> m_callStack;
 			bool m_bGeneratedVariables;
 			StaticArray<GrowingArray<Variable>, (uint32)eCallStack::count> m_variables;
+			// Values that can be expanded, handle n is index n - 1. Only valid while execution is stopped, cleared when the variables are recreated.
+			struct VariableHandle
+			{
+				void* m_pValue;
+				int32 m_typeId;
+			};
+			GrowingArray<VariableHandle> m_variableHandles;
+			// The variables of every scope sorted by the hash of their name, so a variable is found by name with a binary search.
+			struct VariableLookup
+			{
+				uint64 m_nameHash;
+				uint32 m_variableIndex;
+			};
+			StaticArray<GrowingArray<VariableLookup>, (uint32)eCallStack::count> m_variableLookups;
 
 			// TODO: make a map to add this too
 			GrowingArray<asITypeInfo*> m_registeredObjects;
@@ -84,7 +118,15 @@ namespace Hail
 			{
 				bool m_bConnectedForDebugging;
 				bool m_bDisconnected;
+				// Set when the socket has data to read, always set on platforms without an event loop.
+				bool m_bReadable;
 				H_Socket m_socket;
+				// Received bytes, only whole messages are handled and the rest waits for the next read.
+				GrowingArray<char> m_receiveBuffer;
+				uint32 m_receiveOffset;
+				// Queued messages, sent together when the server flushes.
+				GrowingArray<char> m_sendBuffer;
+				uint32 m_sendOffset;
 			};
 			Client m_clientData;
 		};
@@ -109,6 +151,7 @@ namespace Hail
 			void AddBreakpoints(const FileBreakPoints& breakpointsToAdd);
 			void SendVariables(eCallStack callStackType);
 			void FindVariable(eCallStack callStackType, StringL variableToFind);
+			void SendVariableChildren(uint32 handle, uint32 firstChild, uint32 numberOfChildren);
 			void ContinueDebugging();
 			void PauseDebugging();
 			void StepIn();
@@ -121,12 +164,21 @@ namespace Hail
 
 		private:
 
+			// Queues the message for every client connected for debugging, sent on the next FlushMessages.
 			void SendDebuggerMessage(DebuggerMessage& messageToSend);
-			void ListenToMessages();
+			// Sends as much of the queued messages as the sockets take without blocking.
+			void FlushMessages();
+			// Waits at most waitTimeInMs for a client socket to have data, with an event loop the wait sleeps the thread.
+			void ListenToMessages(uint32 waitTimeInMs);
+			void WaitForSocketEvents(uint32 waitTimeInMs);
+			void ReceiveMessages(ScriptDebugger& script, bool& bOutDisconnected);
 
 			VectorOnStack<ScriptDebugger, MAX_ATTACHED_DEBUGGERS> m_clients;
 			Script* m_pActiveScript;
 			H_Socket m_socketHandle;
+#ifdef __linux__
+			int m_epollHandle;
+#endif
 			uint32 m_currentClient;
 			bool m_bIsDebugging;
 			TypeDebuggerRegistry* m_pTypeDebuggerRegistry;
@@ -101,10 +101,21 @@ namespace ReadMessages
 			pDebugger->SendVariables(eCallStack::global);
 		}
 
-		// TODO: fix for child fetching
-		if (StringContains(stackType, '.'))
+		else if (strncmp(stackType, "children", 8) == 0)
 		{
-
+			// children:handle:first:count
+			const char* pArguments = stackType + 8;
+			uint32 arguments[3] = { 0u, 0u, 0u };
+			for (uint32 iArgument = 0; iArgument < 3u && *pArguments == ':'; iArgument++)
+			{
+				pArguments++;
+				arguments[iArgument] = (uint32)StringUtility::IntFromConstChar(pArguments, 0);
+				const int32 nextSeparator = StringUtility::FindFirstOfSymbol(pArguments, ':');
+				if (nextSeparator < 0)
+					break;
+				pArguments += nextSeparator;
+			}
+			pDebugger->SendVariableChildren(arguments[0], arguments[1], arguments[2]);
 		}
 	}
 
@@ -181,11 +192,12 @@ namespace ReadMessages
 
 namespace WriteMessages
 {
-	MessageHeader WriteHeader(int sizeOfMessage, eDebuggerMessageType type, const char* uuid)
+	MessageHeader WriteHeader(uint32 sizeOfMessage, eDebuggerMessageType type, const char* uuid)
 	{
 		MessageHeader header;
 		header.messageLength = sizeOfMessage;
 		header.type = type;
+		header.padding = 0;
 		if (uuid)
 		{
 			memcpy(header.uuid, uuid, 32u);
@@ -223,7 +235,7 @@ void Hail::AngelScript::HandleDebuggerMessage(DebuggerServer* pDebugger, uint32
 	while (currentPosition < messageLength)
 	{
 		MessageHeader header;
-		ReadMessages::ReadAndIncrementReadPoint(&header, messageStream, currentPosition, 4 + 32);
+		ReadMessages::ReadAndIncrementReadPoint(&header, messageStream, currentPosition, sizeof(MessageHeader));
 
 		ReadMessages::HandleDebuggerMessageInternal(pDebugger, header, (uint8*)messageStream + currentPosition);
 		currentPosition += header.messageLength;
@@ -280,6 +292,8 @@ void EncodeVariable(const Variable& variableToEncode, uint32& currentOffset, Mes
 	currentOffset += WriteMessages::EncodeString(messageToFill, variableToEncode.m_name);
 	currentOffset += WriteMessages::EncodeString(messageToFill, variableToEncode.m_type);
 	currentOffset += WriteMessages::EncodeString(messageToFill, variableToEncode.m_value);
+	WriteMessages::EncodeBaseType(messageToFill, currentOffset, variableToEncode.m_handle);
+	WriteMessages::EncodeBaseType(messageToFill, currentOffset, variableToEncode.m_numberOfChildren);
 	uint32 numberOfMembers = variableToEncode.m_members.Size();
 	WriteMessages::EncodeBaseType(messageToFill, currentOffset, numberOfMembers);
 	for (size_t i = 0; i < numberOfMembers; i++)
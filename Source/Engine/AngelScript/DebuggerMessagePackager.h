@@ -33,12 +33,15 @@ namespace Hail
 			End
 		};
 
+		// Every message on the socket is a header followed by messageLength bytes of payload.
 		struct MessageHeader
 		{
-			int16 messageLength;
+			uint32 messageLength;
 			eDebuggerMessageType type;
+			uint16 padding;
 			char uuid[32u];
 		};
+		static_assert(sizeof(MessageHeader) == 40u, "The header is read and written as raw bytes by the extension.");
 
 		struct MessageData
 		{
@@ -60,6 +63,7 @@ namespace Hail
 		DebuggerMessage CreateStopDebugSessionMessage();
 		DebuggerMessage CreateHitBreakpointMessage(int line, const StringL& file);
 		DebuggerMessage CreateCallstackMessage(const GrowingArray<StackFrame>& callstackToSend);
+		// Also used for the children of a variable handle, a request string of "frame:children:handle:first:count".
 		DebuggerMessage CreateVariablesMessage(const GrowingArray<Variable>* variableScopeToSend);
 		DebuggerMessage CreateVariableMessage(const Variable* variableToSend);
 		DebuggerMessage CreateBuildErrorMessage(const MessageHeader& header, const GrowingArray<BuildErrorInfo>& buildErrorsToSend);
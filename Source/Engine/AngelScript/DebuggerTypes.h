@@ -43,6 +43,9 @@ namespace Hail
 			StringL m_value;
 			StringL m_type;
 			GrowingArray<Variable> m_members;
+			// Handle the client requests the children with, 0 if the children are in m_members or there are none.
+			uint32 m_handle = 0u;
+			uint32 m_numberOfChildren = 0u;
 		};
 
 		typedef Variable(*ToVariableCallback)(void* obj);
@@ -2,6 +2,7 @@
 #include "Handler.h"
 #include "angelscript.h"
 #include "Scriptstdstring.h"
+#include "ScriptString.h"
 #include "Array.h"
 #include "Math.h"
 #include "TypeRegistry.h"
@@ -72,18 +73,17 @@ namespace
 		return g_pInputActionMap->GetGamepadTriggerInput(actionToGet, gamepadToCheck);
 	}
 
-	//TODO: replace with cusotm string class
-	void localPrint(std::string& stringToPrint)
+	void localPrint(const ScriptString& stringToPrint)
 	{
-		H_DEBUGMESSAGE(stringToPrint.c_str());
+		H_DEBUGMESSAGE(stringToPrint.Data());
 	}
-	void localPrintError(std::string& stringToPrint)
+	void localPrintError(const ScriptString& stringToPrint)
 	{
-		H_ERROR(stringToPrint.c_str());
+		H_ERROR(stringToPrint.Data());
 	}
-	void localPrintWarning(std::string& stringToPrint)
+	void localPrintWarning(const ScriptString& stringToPrint)
 	{
-		H_WARNING(stringToPrint.c_str());
+		H_WARNING(stringToPrint.Data());
 	}
 
 	// All non normalized functions work in pixel coordinates.
@@ -491,7 +491,7 @@ Hail::AngelScript::Handler::Handler(InputActionMap* pInputActionMap, ThreadSyncr
 	m_errorHandler.Init(m_pScriptEngine, m_bEnableDebugger);
 	m_pTypeRegistry = new TypeRegistry(m_pScriptEngine, m_bEnableDebugger);
 	RegisterScriptArray(m_pTypeRegistry, true);
-	RegisterStdString(m_pScriptEngine, m_pTypeRegistry);
+	RegisterScriptString(m_pScriptEngine, m_pTypeRegistry);
 	RegisterGlobalMessages();
 }
 
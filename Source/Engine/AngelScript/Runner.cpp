@@ -1,9 +1,12 @@
 #include "Engine_PCH.h"
 #include "Runner.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 
 #include "TypeRegistry.h"
 #include "Scriptbuilder.h"
 #include "Debugger.h"
+#include "Timer.h"
 
 using namespace Hail;
 
@@ -14,6 +17,8 @@ void Hail::AngelScript::Runner::Initialize(asIScriptEngine* pScriptEngine, TypeR
 {
 	m_pScriptEngine = pScriptEngine;
 	m_pTypeRegistry = pTypeRegistry;
+	// All types are registered by the handler before the runner is initialized.
+	m_byteCodeCache.Initialize(pTypeRegistry);
 	
 	//TODO: Disable on non debug
 	m_pDebuggerServer = new DebuggerServer(pTypeRegistry->GetDebuggerRegistry());
@@ -21,9 +26,10 @@ void Hail::AngelScript::Runner::Initialize(asIScriptEngine* pScriptEngine, TypeR
 
 void Hail::AngelScript::Runner::ImportAndBuildScript(const FilePath& filePath, String64 scriptName)
 {
+	const PathHandle pathHandle = PathTable::GetInstance().Intern(filePath);
 	for (int i = 0; i < m_scripts.Size(); i++)
 	{
-		if (m_scripts[i].m_filePath == filePath)
+		if (m_scripts[i].m_pathHandle == pathHandle)
 			return;
 	}
 
@@ -35,6 +41,8 @@ void Hail::AngelScript::Runner::ImportAndBuildScript(const FilePath& filePath, S
 
 void Hail::AngelScript::Runner::RunScript(String64 scriptName)
 {
+	H_PROFILE_FUNCTION();
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Scripting);
 	H_ASSERT(m_pScriptEngine, "Must have a script engine on the script runner.");
 
 	int scriptIndex = -1;
@@ -101,6 +109,8 @@ void Hail::AngelScript::Runner::RunScript(String64 scriptName)
 
 void Hail::AngelScript::Runner::Update()
 {
+	H_PROFILE_FUNCTION();
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Scripting);
 	bool bAreScriptsReloading = false;
 	// Reloading logic below
 	for (int i = 0; i < m_scripts.Size(); i++)
@@ -230,6 +240,14 @@ bool Hail::AngelScript::Runner::CreateScript(String64 scriptName, Script& script
 
 bool Hail::AngelScript::Runner::CreateScriptModule(String64 scriptName, const FilePath& pathToScript)
 {
+	Timer loadTimer;
+	asIScriptModule* pCachedModule = m_pScriptEngine->GetModule(scriptName.Data(), asGM_ALWAYS_CREATE);
+	if (pCachedModule && m_byteCodeCache.TryLoadModule(pCachedModule, pathToScript))
+	{
+		H_DEBUGMESSAGE(StringL::Format("Script %s loaded from bytecode cache in %.2fms", scriptName.Data(), loadTimer.GetTotalTime() * 1000.0));
+		return true;
+	}
+
 	CScriptBuilder builder;
 	int r = builder.StartNewModule(m_pScriptEngine, scriptName.Data());
 	if (r < 0)
@@ -269,6 +287,9 @@ bool Hail::AngelScript::Runner::CreateScriptModule(String64 scriptName, const Fi
 		H_ERROR("The script must have the function 'void main()'. Please add it and try again.");
 		return false;
 	}
+
+	m_byteCodeCache.StoreModule(mod, pathToScript, builder);
+	H_DEBUGMESSAGE(StringL::Format("Script %s compiled from source in %.2fms", scriptName.Data(), loadTimer.GetTotalTime() * 1000.0));
 	return true;
 }
 
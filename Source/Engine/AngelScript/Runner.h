@@ -3,6 +3,7 @@
 #include "Containers\GrowingArray\GrowingArray.h"
 #include "DebuggerTypes.h"
 #include "Script.h"
+#include "ByteCodeCache.h"
 
 class asIScriptEngine;
 class asIScriptContext;
@@ -41,6 +42,7 @@ namespace Hail
 			asIScriptEngine* m_pScriptEngine;
 			DebuggerServer* m_pDebuggerServer;
 			TypeRegistry* m_pTypeRegistry;
+			ByteCodeCache m_byteCodeCache;
 			GrowingArray<Script> m_scripts;
 		};
 	}
@@ -3,6 +3,7 @@
 
 #include "Containers\GrowingArray\GrowingArray.h"
 #include "Utility\FilePath.hpp"
+#include "Utility\PathTable.h"
 
 class asIScriptContext;
 
@@ -40,6 +41,7 @@ namespace Hail
 				, m_reloadDelay(0)
 				, m_bIsDirty(false)
 				, m_pDebugger(nullptr)
+				, m_pathHandle(InvalidPathHandle)
 			{}
 			Script(const FilePath& filePath)
 				: m_lastWriteTime(0)
@@ -49,9 +51,12 @@ namespace Hail
 				, m_bIsDirty(false)
 				, m_pDebugger(nullptr)
 				, m_filePath(filePath)
+				, m_pathHandle(PathTable::GetInstance().Intern(filePath))
 			{}
 
 			FilePath m_filePath;
+			// Interned m_filePath, used to find the script without comparing paths.
+			PathHandle m_pathHandle;
 			uint64 m_lastWriteTime;
 			asIScriptContext* m_pScriptContext;
 			String64 m_name;
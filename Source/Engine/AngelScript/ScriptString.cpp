@@ -0,0 +1,569 @@
+#include "Engine_PCH.h"
+#include "ScriptString.h"
+
+#include <new>
+#include "StringMemoryAllocator.h"
+#include "Hashing\xxh64_en.hpp"
+
+using namespace Hail;
+using namespace AngelScript;
+
+namespace
+{
+	bool localContainsCharacter(const char* pCharacters, uint32 numberOfCharacters, char character)
+	{
+		return memchr(pCharacters, character, numberOfCharacters) != nullptr;
+	}
+
+	uint32 localGrowCapacity(uint32 currentCapacity, uint32 requiredCapacity)
+	{
+		uint32 newCapacity = currentCapacity + currentCapacity / 2u;
+		return newCapacity > requiredCapacity ? newCapacity : requiredCapacity;
+	}
+}
+
+ScriptString::SharedBuffer* ScriptString::CreateBuffer(uint32 capacity)
+{
+	// The allocator hands out unaligned character memory, so we over allocate and align the header ourselves.
+	const uint32 allocationSize = sizeof(SharedBuffer) + alignof(SharedBuffer) + capacity + 1u;
+	char* pAllocation = nullptr;
+	// Large strings would fragment the fixed string block, and a full block falls back to the heap instead of failing.
+	const bool bIsHeapAllocation = capacity > MaxStringAllocatorCapacity || !StringMemoryAllocator::GetInstance().AllocateString(nullptr, allocationSize, &pAllocation);
+	if (bIsHeapAllocation)
+		pAllocation = (char*)H_TRACKED_ALLOCATE(allocationSize, alignof(SharedBuffer), eMemoryTag::Strings);
+
+	const uintptr_t alignedAddress = ((uintptr_t)pAllocation + alignof(SharedBuffer) - 1u) & ~((uintptr_t)alignof(SharedBuffer) - 1u);
+	SharedBuffer* pBuffer = new ((void*)alignedAddress) SharedBuffer();
+	pBuffer->m_pAllocation = pAllocation;
+	pBuffer->m_bIsHeapAllocation = bIsHeapAllocation;
+	pBuffer->m_refCount = 1u;
+	pBuffer->m_capacity = capacity;
+	pBuffer->Data()[0] = 0;
+	return pBuffer;
+}
+
+void ScriptString::ReleaseBuffer(SharedBuffer* pBuffer)
+{
+	if (pBuffer->m_refCount.fetch_sub(1u) != 1u)
+		return;
+
+	char* pAllocation = pBuffer->m_pAllocation;
+	const bool bIsHeapAllocation = pBuffer->m_bIsHeapAllocation;
+	pBuffer->~SharedBuffer();
+	if (bIsHeapAllocation)
+		MemoryTracker::Deallocate(pAllocation);
+	else
+		StringMemoryAllocator::GetInstance().DeallocateString(&pAllocation);
+}
+
+ScriptString::ScriptString()
+	: m_length(0u)
+	, m_bIsShort(true)
+{
+	m_memory.m_shortString[0] = 0;
+}
+
+ScriptString::ScriptString(const char* pString)
+	: ScriptString()
+{
+	Assign(pString, (uint32)StringLength(pString));
+}
+
+ScriptString::ScriptString(const char* pString, uint32 length)
+	: ScriptString()
+{
+	Assign(pString, length);
+}
+
+ScriptString::ScriptString(const ScriptString& other)
+	: m_length(other.m_length)
+	, m_bIsShort(other.m_bIsShort)
+{
+	if (m_bIsShort)
+	{
+		memcpy(m_memory.m_shortString, other.m_memory.m_shortString, m_length + 1u);
+	}
+	else
+	{
+		m_memory.m_pShared = other.m_memory.m_pShared;
+		m_memory.m_pShared->m_refCount++;
+	}
+}
+
+ScriptString::ScriptString(ScriptString&& other)
+	: m_memory(other.m_memory)
+	, m_length(other.m_length)
+	, m_bIsShort(other.m_bIsShort)
+{
+	other.m_bIsShort = true;
+	other.m_length = 0u;
+	other.m_memory.m_shortString[0] = 0;
+}
+
+ScriptString::~ScriptString()
+{
+	Release();
+}
+
+ScriptString& ScriptString::operator=(const ScriptString& other)
+{
+	if (this == &other)
+		return *this;
+
+	if (other.m_bIsShort)
+	{
+		// Copy in to our own memory if we can, this avoids dropping a buffer only to allocate it again later.
+		if (!m_bIsShort && !IsShared())
+		{
+			Assign(other.m_memory.m_shortString, other.m_length);
+			return *this;
+		}
+		Release();
+		memcpy(m_memory.m_shortString, other.m_memory.m_shortString, other.m_length + 1u);
+	}
+	else
+	{
+		other.m_memory.m_pShared->m_refCount++;
+		Release();
+		m_memory.m_pShared = other.m_memory.m_pShared;
+	}
+	m_bIsShort = other.m_bIsShort;
+	m_length = other.m_length;
+	return *this;
+}
+
+ScriptString& ScriptString::operator=(ScriptString&& other)
+{
+	if (this == &other)
+		return *this;
+
+	Release();
+	m_memory = other.m_memory;
+	m_length = other.m_length;
+	m_bIsShort = other.m_bIsShort;
+	other.m_bIsShort = true;
+	other.m_length = 0u;
+	other.m_memory.m_shortString[0] = 0;
+	return *this;
+}
+
+ScriptString& ScriptString::operator=(const char* pString)
+{
+	Assign(pString, (uint32)StringLength(pString));
+	return *this;
+}
+
+ScriptString& ScriptString::operator+=(const ScriptString& other)
+{
+	if (m_length == 0u)
+		return *this = other;
+
+	// Appending a string to itself, keep the source alive while we grow.
+	const ScriptString source = other;
+	Append(source.Data(), source.m_length);
+	return *this;
+}
+
+ScriptString& ScriptString::operator+=(const char* pString)
+{
+	Append(pString, (uint32)StringLength(pString));
+	return *this;
+}
+
+void ScriptString::Assign(const char* pString, uint32 length)
+{
+	if (IsShared() || length > Capacity())
+	{
+		Release();
+		if (length > ShortStringCapacity)
+		{
+			m_memory.m_pShared = CreateBuffer(length);
+			m_bIsShort = false;
+		}
+	}
+	char* pData = m_bIsShort ? m_memory.m_shortString : m_memory.m_pShared->Data();
+	if (length)
+		memmove(pData, pString, length);
+	pData[length] = 0;
+	m_length = length;
+}
+
+void ScriptString::Append(const char* pString, uint32 length)
+{
+	if (length == 0u)
+		return;
+
+	const uint32 newLength = m_length + length;
+	if (newLength > Capacity() || IsShared())
+		MakeUniqueAndReserve(newLength > Capacity() ? localGrowCapacity(Capacity(), newLength) : Capacity());
+
+	char* pData = m_bIsShort ? m_memory.m_shortString : m_memory.m_pShared->Data();
+	memcpy(pData + m_length, pString, length);
+	pData[newLength] = 0;
+	m_length = newLength;
+}
+
+void ScriptString::Insert(uint32 position, const ScriptString& other)
+{
+	if (position > m_length)
+		position = m_length;
+	if (other.m_length == 0u)
+		return;
+
+	const ScriptString source = other;
+	const uint32 newLength = m_length + source.m_length;
+	MakeUniqueAndReserve(newLength > Capacity() ? localGrowCapacity(Capacity(), newLength) : Capacity());
+
+	char* pData = MutableData();
+	memmove(pData + position + source.m_length, pData + position, m_length - position + 1u);
+	memcpy(pData + position, source.Data(), source.m_length);
+	m_length = newLength;
+}
+
+void ScriptString::Erase(uint32 position, uint32 count)
+{
+	if (position >= m_length || count == 0u)
+		return;
+
+	if (count > m_length - position)
+		count = m_length - position;
+
+	char* pData = MutableData();
+	memmove(pData + position, pData + position + count, m_length - position - count + 1u);
+	m_length -= count;
+}
+
+void ScriptString::Resize(uint32 length)
+{
+	if (length > Capacity() || IsShared())
+		MakeUniqueAndReserve(length > Capacity() ? length : Capacity());
+
+	char* pData = m_bIsShort ? m_memory.m_shortString : m_memory.m_pShared->Data();
+	if (length > m_length)
+		memset(pData + m_length, 0, length - m_length);
+	pData[length] = 0;
+	m_length = length;
+}
+
+void ScriptString::Reserve(uint32 capacity)
+{
+	if (capacity > Capacity())
+		MakeUniqueAndReserve(capacity);
+}
+
+void ScriptString::Clear()
+{
+	Release();
+	m_memory.m_shortString[0] = 0;
+}
+
+int ScriptString::Find(const ScriptString& subString, uint32 start) const
+{
+	if (start > m_length || subString.m_length > m_length - start)
+		return -1;
+
+	const char* pData = Data();
+	const char* pSub = subString.Data();
+	if (subString.m_length == 0u)
+		return (int)start;
+
+	const uint32 lastStart = m_length - subString.m_length;
+	for (uint32 i = start; i <= lastStart; i++)
+	{
+		// Skip ahead to the next occurance of the first character before comparing the whole sub string.
+		const char* pFound = (const char*)memchr(pData + i, pSub[0], lastStart - i + 1u);
+		if (!pFound)
+			return -1;
+		i = (uint32)(pFound - pData);
+		if (memcmp(pFound, pSub, subString.m_length) == 0)
+			return (int)i;
+	}
+	return -1;
+}
+
+int ScriptString::FindLast(const ScriptString& subString, uint32 start) const
+{
+	if (subString.m_length > m_length)
+		return -1;
+
+	uint32 i = m_length - subString.m_length;
+	if (start < i)
+		i = start;
+
+	const char* pData = Data();
+	const char* pSub = subString.Data();
+	while (true)
+	{
+		if (memcmp(pData + i, pSub, subString.m_length) == 0)
+			return (int)i;
+		if (i == 0u)
+			return -1;
+		--i;
+	}
+}
+
+int ScriptString::FindFirstOf(const ScriptString& characters, uint32 start) const
+{
+	const char* pData = Data();
+	for (uint32 i = start; i < m_length; i++)
+	{
+		if (localContainsCharacter(characters.Data(), characters.m_length, pData[i]))
+			return (int)i;
+	}
+	return -1;
+}
+
+int ScriptString::FindFirstNotOf(const ScriptString& characters, uint32 start) const
+{
+	const char* pData = Data();
+	for (uint32 i = start; i < m_length; i++)
+	{
+		if (!localContainsCharacter(characters.Data(), characters.m_length, pData[i]))
+			return (int)i;
+	}
+	return -1;
+}
+
+int ScriptString::FindLastOf(const ScriptString& characters, uint32 start) const
+{
+	if (m_length == 0u)
+		return -1;
+
+	const char* pData = Data();
+	uint32 i = start < m_length ? start : m_length - 1u;
+	while (true)
+	{
+		if (localContainsCharacter(characters.Data(), characters.m_length, pData[i]))
+			return (int)i;
+		if (i == 0u)
+			return -1;
+		--i;
+	}
+}
+
+int ScriptString::FindLastNotOf(const ScriptString& characters, uint32 start) const
+{
+	if (m_length == 0u)
+		return -1;
+
+	const char* pData = Data();
+	uint32 i = start < m_length ? start : m_length - 1u;
+	while (true)
+	{
+		if (!localContainsCharacter(characters.Data(), characters.m_length, pData[i]))
+			return (int)i;
+		if (i == 0u)
+			return -1;
+		--i;
+	}
+}
+
+ScriptString ScriptString::SubString(uint32 start, uint32 count) const
+{
+	if (start >= m_length || count == 0u)
+		return ScriptString();
+
+	if (count > m_length - start)
+		count = m_length - start;
+
+	// The whole string, share the memory instead of copying.
+	if (start == 0u && count == m_length)
+		return *this;
+
+	return ScriptString(Data() + start, count);
+}
+
+int ScriptString::Compare(const ScriptString& other) const
+{
+	if (!m_bIsShort && !other.m_bIsShort && m_memory.m_pShared == other.m_memory.m_pShared)
+		return 0;
+
+	const uint32 minLength = m_length < other.m_length ? m_length : other.m_length;
+	const int result = memcmp(Data(), other.Data(), minLength);
+	if (result != 0)
+		return result;
+	return m_length < other.m_length ? -1 : (m_length > other.m_length ? 1 : 0);
+}
+
+bool ScriptString::operator==(const ScriptString& other) const
+{
+	if (m_length != other.m_length)
+		return false;
+	// Copies and interned strings longer than ShortStringCapacity share their buffer, so comparing them is a pointer compare.
+	if (!m_bIsShort && !other.m_bIsShort && m_memory.m_pShared == other.m_memory.m_pShared)
+		return true;
+	return memcmp(Data(), other.Data(), m_length) == 0;
+}
+
+const char* ScriptString::Data() const
+{
+	return m_bIsShort ? m_memory.m_shortString : m_memory.m_pShared->Data();
+}
+
+char* ScriptString::MutableData()
+{
+	if (IsShared())
+		MakeUniqueAndReserve(Capacity());
+	return m_bIsShort ? m_memory.m_shortString : m_memory.m_pShared->Data();
+}
+
+uint32 ScriptString::Capacity() const
+{
+	return m_bIsShort ? ShortStringCapacity : m_memory.m_pShared->m_capacity;
+}
+
+bool ScriptString::IsShared() const
+{
+	return !m_bIsShort && m_memory.m_pShared->m_refCount.load() > 1u;
+}
+
+uint64 ScriptString::GetHash() const
+{
+	return xxh64::hash(Data(), m_length, 0u);
+}
+
+void ScriptString::MakeUniqueAndReserve(uint32 capacity)
+{
+	if (capacity < m_length)
+		capacity = m_length;
+
+	if (capacity <= ShortStringCapacity)
+	{
+		if (m_bIsShort)
+			return;
+
+		// Shrinking a shared string in to the short string buffer.
+		char shortString[ShortStringCapacity + 1];
+		memcpy(shortString, m_memory.m_pShared->Data(), m_length + 1u);
+		ReleaseBuffer(m_memory.m_pShared);
+		memcpy(m_memory.m_shortString, shortString, m_length + 1u);
+		m_bIsShort = true;
+		return;
+	}
+
+	if (!m_bIsShort && !IsShared() && m_memory.m_pShared->m_capacity >= capacity)
+		return;
+
+	SharedBuffer* pNewBuffer = CreateBuffer(capacity);
+	memcpy(pNewBuffer->Data(), Data(), m_length + 1u);
+	if (!m_bIsShort)
+		ReleaseBuffer(m_memory.m_pShared);
+	m_memory.m_pShared = pNewBuffer;
+	m_bIsShort = false;
+}
+
+void ScriptString::Release()
+{
+	if (!m_bIsShort)
+		ReleaseBuffer(m_memory.m_pShared);
+	m_bIsShort = true;
+	m_length = 0u;
+}
+
+ScriptStringInternTable::~ScriptStringInternTable()
+{
+	for (uint32 i = 0; i < m_numberOfBuckets; i++)
+	{
+		Entry* pEntry = m_ppBuckets[i];
+		while (pEntry)
+		{
+			Entry* pNext = pEntry->m_pNext;
+			delete pEntry;
+			pEntry = pNext;
+		}
+	}
+	SAFEDELETE_ARRAY(m_ppBuckets);
+}
+
+const ScriptString* ScriptStringInternTable::AcquireConstant(const char* pString, uint32 length)
+{
+	Entry* pEntry = FindOrCreate(pString, length);
+	pEntry->m_numberOfReferences++;
+	return &pEntry->m_string;
+}
+
+bool ScriptStringInternTable::ReleaseConstant(const ScriptString* pString)
+{
+	if (!pString || m_numberOfBuckets == 0u)
+		return false;
+
+	const uint64 hash = pString->GetHash();
+	for (Entry* pEntry = m_ppBuckets[hash & (m_numberOfBuckets - 1u)]; pEntry; pEntry = pEntry->m_pNext)
+	{
+		if (&pEntry->m_string != pString)
+			continue;
+
+		H_ASSERT(pEntry->m_numberOfReferences > 0u, "Released a string constant more times than it was acquired.");
+		pEntry->m_numberOfReferences--;
+		if (pEntry->m_numberOfReferences == 0u && !pEntry->m_bPinned)
+			Remove(pEntry);
+		return true;
+	}
+	return false;
+}
+
+ScriptString ScriptStringInternTable::Intern(const ScriptString& string)
+{
+	Entry* pEntry = FindOrCreate(string.Data(), string.Length());
+	pEntry->m_bPinned = true;
+	return pEntry->m_string;
+}
+
+ScriptStringInternTable::Entry* ScriptStringInternTable::FindOrCreate(const char* pString, uint32 length)
+{
+	const uint64 hash = xxh64::hash(pString, length, 0u);
+	if (m_numberOfBuckets)
+	{
+		for (Entry* pEntry = m_ppBuckets[hash & (m_numberOfBuckets - 1u)]; pEntry; pEntry = pEntry->m_pNext)
+		{
+			if (pEntry->m_hash == hash && pEntry->m_string.Length() == length && memcmp(pEntry->m_string.Data(), pString, length) == 0)
+				return pEntry;
+		}
+	}
+
+	// Keep the load factor below 1
+	if (m_numberOfEntries + 1u > m_numberOfBuckets)
+		Rehash(m_numberOfBuckets ? m_numberOfBuckets * 2u : 64u);
+
+	Entry* pEntry = new Entry();
+	pEntry->m_string.Assign(pString, length);
+	pEntry->m_hash = hash;
+	pEntry->m_numberOfReferences = 0u;
+	pEntry->m_bPinned = false;
+	Entry*& pBucket = m_ppBuckets[hash & (m_numberOfBuckets - 1u)];
+	pEntry->m_pNext = pBucket;
+	pBucket = pEntry;
+	m_numberOfEntries++;
+	return pEntry;
+}
+
+void ScriptStringInternTable::Remove(Entry* pEntry)
+{
+	Entry** ppLink = &m_ppBuckets[pEntry->m_hash & (m_numberOfBuckets - 1u)];
+	while (*ppLink != pEntry)
+		ppLink = &(*ppLink)->m_pNext;
+	*ppLink = pEntry->m_pNext;
+	delete pEntry;
+	m_numberOfEntries--;
+}
+
+void ScriptStringInternTable::Rehash(uint32 numberOfBuckets)
+{
+	Entry** ppNewBuckets = new Entry*[numberOfBuckets];
+	memset(ppNewBuckets, 0, sizeof(Entry*) * numberOfBuckets);
+	for (uint32 i = 0; i < m_numberOfBuckets; i++)
+	{
+		Entry* pEntry = m_ppBuckets[i];
+		while (pEntry)
+		{
+			Entry* pNext = pEntry->m_pNext;
+			Entry*& pBucket = ppNewBuckets[pEntry->m_hash & (numberOfBuckets - 1u)];
+			pEntry->m_pNext = pBucket;
+			pBucket = pEntry;
+			pEntry = pNext;
+		}
+	}
+	SAFEDELETE_ARRAY(m_ppBuckets);
+	m_ppBuckets = ppNewBuckets;
+	m_numberOfBuckets = numberOfBuckets;
+}
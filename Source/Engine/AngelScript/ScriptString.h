@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include "Types.h"
+#include "String.hpp"
+
+namespace Hail
+{
+	namespace AngelScript
+	{
+		// The string type registered to AngelScript as "string".
+		// Short strings are stored inline, longer strings live in a reference counted buffer from the StringMemoryAllocator
+		// that is shared between copies and only duplicated when a shared string gets modified (copy-on-write).
+		// Large strings, and strings that do not fit in the StringMemoryAllocator any more, get their buffer from the tracked heap.
+		class ScriptString
+		{
+		public:
+			static constexpr uint32 ShortStringCapacity = 23u;
+			static constexpr uint32 MaxStringAllocatorCapacity = 4096u;
+
+			ScriptString();
+			ScriptString(const char* pString);
+			ScriptString(const char* pString, uint32 length);
+			ScriptString(const ScriptString& other);
+			ScriptString(ScriptString&& other);
+			~ScriptString();
+
+			ScriptString& operator=(const ScriptString& other);
+			ScriptString& operator=(ScriptString&& other);
+			ScriptString& operator=(const char* pString);
+			ScriptString& operator+=(const ScriptString& other);
+			ScriptString& operator+=(const char* pString);
+
+			void Assign(const char* pString, uint32 length);
+			void Append(const char* pString, uint32 length);
+			void Insert(uint32 position, const ScriptString& other);
+			// Removes count characters from position, a count of MAX_UINT removes the rest of the string.
+			void Erase(uint32 position, uint32 count);
+			void Resize(uint32 length);
+			void Reserve(uint32 capacity);
+			void Clear();
+
+			// All find functions return -1 if nothing was found, a start of MAX_UINT means the end of the string for the reverse searches.
+			int Find(const ScriptString& subString, uint32 start) const;
+			int FindLast(const ScriptString& subString, uint32 start) const;
+			int FindFirstOf(const ScriptString& characters, uint32 start) const;
+			int FindFirstNotOf(const ScriptString& characters, uint32 start) const;
+			int FindLastOf(const ScriptString& characters, uint32 start) const;
+			int FindLastNotOf(const ScriptString& characters, uint32 start) const;
+			ScriptString SubString(uint32 start, uint32 count) const;
+
+			// Returns < 0, 0 or > 0 like strcmp.
+			int Compare(const ScriptString& other) const;
+			bool operator==(const ScriptString& other) const;
+			bool operator!=(const ScriptString& other) const { return !(*this == other); }
+
+			const char* Data() const;
+			// Makes the string unique before returning the pointer, so do not hold on to the pointer over copies.
+			char* MutableData();
+			uint32 Length() const { return m_length; }
+			bool Empty() const { return m_length == 0; }
+			uint32 Capacity() const;
+			// True if the string shares its memory with another string.
+			bool IsShared() const;
+
+			uint64 GetHash() const;
+			StringL ToStringL() const { return StringL(Data()); }
+
+		private:
+			struct SharedBuffer
+			{
+				char* m_pAllocation;
+				std::atomic_uint32_t m_refCount;
+				uint32 m_capacity;
+				bool m_bIsHeapAllocation;
+				char* Data() { return reinterpret_cast<char*>(this + 1); }
+			};
+
+			static SharedBuffer* CreateBuffer(uint32 capacity);
+			static void ReleaseBuffer(SharedBuffer* pBuffer);
+
+			// Makes sure this string owns its memory and can hold capacity characters, keeps the content.
+			void MakeUniqueAndReserve(uint32 capacity);
+			void Release();
+
+			union StringMemory
+			{
+				char m_shortString[ShortStringCapacity + 1];
+				SharedBuffer* m_pShared;
+			} m_memory;
+			uint32 m_length;
+			bool m_bIsShort;
+		};
+
+		// Table of unique immutable strings, used for script string constants and identifiers so equal strings share one buffer.
+		// Access is guarded by the AngelScript exclusive lock as the string factory can be called from multiple threads.
+		class ScriptStringInternTable
+		{
+		public:
+			~ScriptStringInternTable();
+
+			// Returns a string that stays valid until it has been released as many times as it was acquired.
+			const ScriptString* AcquireConstant(const char* pString, uint32 length);
+			bool ReleaseConstant(const ScriptString* pString);
+			// Returns a copy sharing the memory of the interned string, interned identifiers stay alive until the table is destroyed.
+			ScriptString Intern(const ScriptString& string);
+
+			uint32 GetNumberOfEntries() const { return m_numberOfEntries; }
+
+		private:
+			struct Entry
+			{
+				ScriptString m_string;
+				uint64 m_hash;
+				uint32 m_numberOfReferences;
+				bool m_bPinned;
+				Entry* m_pNext;
+			};
+
+			Entry* FindOrCreate(const char* pString, uint32 length);
+			void Remove(Entry* pEntry);
+			void Rehash(uint32 numberOfBuckets);
+
+			Entry** m_ppBuckets = nullptr;
+			uint32 m_numberOfBuckets = 0;
+			uint32 m_numberOfEntries = 0;
+		};
+	}
+}
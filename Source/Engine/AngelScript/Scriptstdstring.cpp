@@ -2,66 +2,46 @@
 #include "Scriptstdstring.h"
 
 #include "TypeRegistry.h"
+#include "ScriptString.h"
 
 #include "String.hpp"
 
 #include <assert.h> // assert()
-#include <sstream>  // std::stringstream
 #include <string.h> // strstr()
 #include <stdio.h>	// snprintf()
 #include <stdlib.h> // strtod()
+#include <new>		// placement new
 #ifndef __psp2__
 	#include <locale.h> // setlocale()
 #endif
 
-using namespace std;
+using namespace Hail::AngelScript;
 
 // This macro is used to avoid warnings about unused variables.
 // Usually where the variables are only used in debug mode.
 #define UNUSED_VAR(x) (void)(x)
 
-#ifdef AS_CAN_USE_CPP11
-// The string factory doesn't need to keep a specific order in the
-// cache, so the unordered_map is faster than the ordinary map
-#include <unordered_map>  // std::unordered_map
 BEGIN_AS_NAMESPACE
-typedef unordered_map<string, int> map_t;
-END_AS_NAMESPACE
-#else
-#include <map>      // std::map
-BEGIN_AS_NAMESPACE
-typedef map<string, int> map_t;
-END_AS_NAMESPACE
-#endif
-
-BEGIN_AS_NAMESPACE
-class CStdStringFactory : public asIStringFactory
+class CScriptStringFactory : public asIStringFactory
 {
 public:
-	CStdStringFactory() {}
-	~CStdStringFactory() 
+	CScriptStringFactory() {}
+	~CScriptStringFactory()
 	{
-		// The script engine must release each string 
+		// The script engine must release each string
 		// constant that it has requested
-		assert(stringCache.size() == 0);
+		assert(stringCache.GetNumberOfEntries() == 0);
 	}
 
 	const void *GetStringConstant(const char *data, asUINT length)
 	{
-		// The string factory might be modified from multiple 
+		// The string factory might be modified from multiple
 		// threads, so it is necessary to use a mutex.
 		asAcquireExclusiveLock();
-		
-		string str(data, length);
-		map_t::iterator it = stringCache.find(str);
-		if (it != stringCache.end())
-			it->second++;
-		else
-			it = stringCache.insert(map_t::value_type(str, 1)).first;
-
+		const ScriptString* pConstant = stringCache.AcquireConstant(data, length);
 		asReleaseExclusiveLock();
-		
-		return reinterpret_cast<const void*>(&it->first);
+
+		return reinterpret_cast<const void*>(pConstant);
 	}
 
 	int  ReleaseStringConstant(const void *str)
@@ -69,25 +49,13 @@ public:
 		if (str == 0)
 			return asERROR;
 
-		int ret = asSUCCESS;
-		
-		// The string factory might be modified from multiple 
+		// The string factory might be modified from multiple
 		// threads, so it is necessary to use a mutex.
 		asAcquireExclusiveLock();
-		
-		map_t::iterator it = stringCache.find(*reinterpret_cast<const string*>(str));
-		if (it == stringCache.end())
-			ret = asERROR;
-		else
-		{
-			it->second--;
-			if (it->second == 0)
-				stringCache.erase(it);
-		}
-		
+		const bool bReleased = stringCache.ReleaseConstant(reinterpret_cast<const ScriptString*>(str));
 		asReleaseExclusiveLock();
-		
-		return ret;
+
+		return bReleased ? asSUCCESS : asERROR;
 	}
 
 	int  GetRawStringData(const void *str, char *data, asUINT *length) const
@@ -95,39 +63,46 @@ public:
 		if (str == 0)
 			return asERROR;
 
+		const ScriptString* pString = reinterpret_cast<const ScriptString*>(str);
 		if (length)
-			*length = (asUINT)reinterpret_cast<const string*>(str)->length();
+			*length = pString->Length();
 
 		if (data)
-			memcpy(data, reinterpret_cast<const string*>(str)->c_str(), reinterpret_cast<const string*>(str)->length());
+			memcpy(data, pString->Data(), pString->Length());
 
 		return asSUCCESS;
 	}
 
-	// THe access to the string cache is protected with the common mutex provided by AngelScript
-	map_t stringCache;
+	ScriptString Intern(const ScriptString& str)
+	{
+		asAcquireExclusiveLock();
+		ScriptString internedString = stringCache.Intern(str);
+		asReleaseExclusiveLock();
+		return internedString;
+	}
+
+	// The access to the string cache is protected with the common mutex provided by AngelScript
+	// Constants and interned identifiers share the same table so equal strings share one buffer.
+	ScriptStringInternTable stringCache;
 };
 
-static CStdStringFactory *stringFactory = 0;
+static CScriptStringFactory *stringFactory = 0;
 
-// TODO: Make this public so the application can also use the string 
-//       factory and share the string constants if so desired, or to
-//       monitor the size of the string factory cache.
-CStdStringFactory *GetStdStringFactorySingleton()
+CScriptStringFactory *GetScriptStringFactorySingleton()
 {
 	if( stringFactory == 0 )
 	{
-		// The following instance will be destroyed by the global 
-		// CStdStringFactoryCleaner instance upon application shutdown
-		stringFactory = new CStdStringFactory();
+		// The following instance will be destroyed by the global
+		// CScriptStringFactoryCleaner instance upon application shutdown
+		stringFactory = new CScriptStringFactory();
 	}
 	return stringFactory;
 }
 
-class CStdStringFactoryCleaner
+class CScriptStringFactoryCleaner
 {
 public:
-	~CStdStringFactoryCleaner()
+	~CScriptStringFactoryCleaner()
 	{
 		if (stringFactory)
 		{
@@ -137,7 +112,7 @@ public:
 			// the application might crash. Not deleting the cache would
 			// lead to a memory leak, but since this is only happens when the
 			// application is shutting down anyway, it is not important.
-			if (stringFactory->stringCache.empty())
+			if (stringFactory->stringCache.GetNumberOfEntries() == 0)
 			{
 				delete stringFactory;
 				stringFactory = 0;
@@ -146,200 +121,151 @@ public:
 	}
 };
 
-static CStdStringFactoryCleaner cleaner;
-
-
-static void ConstructString(string *thisPointer)
-{
-	new(thisPointer) string();
-}
-
-static void CopyConstructString(const string &other, string *thisPointer)
-{
-	new(thisPointer) string(other);
-}
-
-static void DestructString(string *thisPointer)
-{
-	thisPointer->~string();
-}
+static CScriptStringFactoryCleaner cleaner;
 
-static string &AddAssignStringToString(const string &str, string &dest)
+// Formats a primitive in to a stack buffer, all numeric conversions go through here instead of a string stream.
+struct PrimitiveString
 {
-	// We don't register the method directly because some compilers
-	// and standard libraries inline the definition, resulting in the
-	// linker being unable to find the declaration.
-	// Example: CLang/LLVM with XCode 4.3 on OSX 10.7
-	dest += str;
-	return dest;
-}
+	char m_data[64];
+	asUINT m_length;
+};
 
-// bool string::isEmpty()
-// bool string::empty() // if AS_USE_STLNAMES == 1
-static bool StringIsEmpty(const string &str)
+static PrimitiveString ToPrimitiveString(asINT64 value)
 {
-	// We don't register the method directly because some compilers
-	// and standard libraries inline the definition, resulting in the
-	// linker being unable to find the declaration
-	// Example: CLang/LLVM with XCode 4.3 on OSX 10.7
-	return str.empty();
+	PrimitiveString str;
+	str.m_length = (asUINT)snprintf(str.m_data, sizeof(str.m_data), "%lld", (long long)value);
+	return str;
 }
 
-#if AS_NO_IMPL_OPS_WITH_STRING_AND_PRIMITIVE == 0
-static string &AssignUInt64ToString(asQWORD i, string &dest)
+static PrimitiveString ToPrimitiveString(asQWORD value)
 {
-	ostringstream stream;
-	stream << i;
-	dest = stream.str();
-	return dest;
+	PrimitiveString str;
+	str.m_length = (asUINT)snprintf(str.m_data, sizeof(str.m_data), "%llu", (unsigned long long)value);
+	return str;
 }
 
-static string &AddAssignUInt64ToString(asQWORD i, string &dest)
+static PrimitiveString ToPrimitiveString(double value)
 {
-	ostringstream stream;
-	stream << i;
-	dest += stream.str();
-	return dest;
+	// %g matches the default formatting of the std::stringstream used by the original add-on.
+	PrimitiveString str;
+	str.m_length = (asUINT)snprintf(str.m_data, sizeof(str.m_data), "%g", value);
+	return str;
 }
 
-static string AddStringUInt64(const string &str, asQWORD i)
+// Script floats are passed as 32 bit to native calls, so they need their own instantiation that widens to double here.
+static PrimitiveString ToPrimitiveString(float value)
 {
-	ostringstream stream;
-	stream << i;
-	return str + stream.str();
+	return ToPrimitiveString((double)value);
 }
 
-static string AddInt64String(asINT64 i, const string &str)
+static PrimitiveString ToPrimitiveString(bool value)
 {
-	ostringstream stream;
-	stream << i;
-	return stream.str() + str;
+	PrimitiveString str;
+	str.m_length = (asUINT)snprintf(str.m_data, sizeof(str.m_data), "%s", value ? "true" : "false");
+	return str;
 }
 
-static string &AssignInt64ToString(asINT64 i, string &dest)
+template<typename T>
+static ScriptString &AssignPrimitiveToString(T value, ScriptString &dest)
 {
-	ostringstream stream;
-	stream << i;
-	dest = stream.str();
+	const PrimitiveString str = ToPrimitiveString(value);
+	dest.Assign(str.m_data, str.m_length);
 	return dest;
 }
 
-static string &AddAssignInt64ToString(asINT64 i, string &dest)
+template<typename T>
+static ScriptString &AddAssignPrimitiveToString(T value, ScriptString &dest)
 {
-	ostringstream stream;
-	stream << i;
-	dest += stream.str();
+	const PrimitiveString str = ToPrimitiveString(value);
+	dest.Append(str.m_data, str.m_length);
 	return dest;
 }
 
-static string AddStringInt64(const string &str, asINT64 i)
-{
-	ostringstream stream;
-	stream << i;
-	return str + stream.str();
-}
-
-static string AddUInt64String(asQWORD i, const string &str)
+template<typename T>
+static ScriptString AddStringPrimitive(const ScriptString &str, T value)
 {
-	ostringstream stream;
-	stream << i;
-	return stream.str() + str;
+	const PrimitiveString primitive = ToPrimitiveString(value);
+	ScriptString ret;
+	ret.Reserve(str.Length() + primitive.m_length);
+	ret.Append(str.Data(), str.Length());
+	ret.Append(primitive.m_data, primitive.m_length);
+	return ret;
 }
 
-static string &AssignDoubleToString(double f, string &dest)
+template<typename T>
+static ScriptString AddPrimitiveString(T value, const ScriptString &str)
 {
-	ostringstream stream;
-	stream << f;
-	dest = stream.str();
-	return dest;
+	const PrimitiveString primitive = ToPrimitiveString(value);
+	ScriptString ret;
+	ret.Reserve(str.Length() + primitive.m_length);
+	ret.Append(primitive.m_data, primitive.m_length);
+	ret.Append(str.Data(), str.Length());
+	return ret;
 }
 
-static string &AddAssignDoubleToString(double f, string &dest)
+static void ConstructString(ScriptString *thisPointer)
 {
-	ostringstream stream;
-	stream << f;
-	dest += stream.str();
-	return dest;
+	new(thisPointer) ScriptString();
 }
 
-static string &AssignFloatToString(float f, string &dest)
+static void CopyConstructString(const ScriptString &other, ScriptString *thisPointer)
 {
-	ostringstream stream;
-	stream << f;
-	dest = stream.str();
-	return dest;
+	new(thisPointer) ScriptString(other);
 }
 
-static string &AddAssignFloatToString(float f, string &dest)
+static void DestructString(ScriptString *thisPointer)
 {
-	ostringstream stream;
-	stream << f;
-	dest += stream.str();
-	return dest;
+	thisPointer->~ScriptString();
 }
 
-static string &AssignBoolToString(bool b, string &dest)
+static ScriptString &AssignStringToString(const ScriptString &str, ScriptString &dest)
 {
-	ostringstream stream;
-	stream << (b ? "true" : "false");
-	dest = stream.str();
+	dest = str;
 	return dest;
 }
 
-static string &AddAssignBoolToString(bool b, string &dest)
+static ScriptString &AddAssignStringToString(const ScriptString &str, ScriptString &dest)
 {
-	ostringstream stream;
-	stream << (b ? "true" : "false");
-	dest += stream.str();
+	dest += str;
 	return dest;
 }
 
-static string AddStringDouble(const string &str, double f)
-{
-	ostringstream stream;
-	stream << f;
-	return str + stream.str();
-}
-
-static string AddDoubleString(double f, const string &str)
+static ScriptString AddStrings(const ScriptString &a, const ScriptString &b)
 {
-	ostringstream stream;
-	stream << f;
-	return stream.str() + str;
+	// Reserve once up front so a concatenation is a single allocation.
+	ScriptString ret;
+	ret.Reserve(a.Length() + b.Length());
+	ret.Append(a.Data(), a.Length());
+	ret.Append(b.Data(), b.Length());
+	return ret;
 }
 
-static string AddStringFloat(const string &str, float f)
+// bool string::isEmpty()
+// bool string::empty() // if AS_USE_STLNAMES == 1
+static bool StringIsEmpty(const ScriptString &str)
 {
-	ostringstream stream;
-	stream << f;
-	return str + stream.str();
+	return str.Empty();
 }
 
-static string AddFloatString(float f, const string &str)
+static char *StringCharAt(unsigned int i, ScriptString &str)
 {
-	ostringstream stream;
-	stream << f;
-	return stream.str() + str;
-}
+	if( i >= str.Length() )
+	{
+		// Set a script exception
+		asIScriptContext *ctx = asGetActiveContext();
+		ctx->SetException("Out of range");
 
-static string AddStringBool(const string &str, bool b)
-{
-	ostringstream stream;
-	stream << (b ? "true" : "false");
-	return str + stream.str();
-}
+		// Return a null pointer
+		return 0;
+	}
 
-static string AddBoolString(bool b, const string &str)
-{
-	ostringstream stream;
-	stream << (b ? "true" : "false");
-	return stream.str() + str;
+	// Writing through the returned reference must not change other strings sharing the memory.
+	return &str.MutableData()[i];
 }
-#endif
 
-static char *StringCharAt(unsigned int i, string &str)
+static const char *StringCharAtConst(unsigned int i, const ScriptString &str)
 {
-	if( i >= str.size() )
+	if( i >= str.Length() )
 	{
 		// Set a script exception
 		asIScriptContext *ctx = asGetActiveContext();
@@ -349,17 +275,22 @@ static char *StringCharAt(unsigned int i, string &str)
 		return 0;
 	}
 
-	return &str[i];
+	return &str.Data()[i];
 }
 
 // AngelScript signature:
 // int string::opCmp(const string &in) const
-static int StringCmp(const string &a, const string &b)
+static int StringCmp(const ScriptString &a, const ScriptString &b)
 {
-	int cmp = 0;
-	if( a < b ) cmp = -1;
-	else if( a > b ) cmp = 1;
-	return cmp;
+	const int result = a.Compare(b);
+	return result < 0 ? -1 : (result > 0 ? 1 : 0);
+}
+
+// String equality comparison.
+// Returns true iff lhs is equal to rhs.
+static bool StringEquals(const ScriptString& lhs, const ScriptString& rhs)
+{
+	return lhs == rhs;
 }
 
 // This function returns the index of the first position where the substring
@@ -368,231 +299,158 @@ static int StringCmp(const string &a, const string &b)
 //
 // AngelScript signature:
 // int string::findFirst(const string &in sub, uint start = 0) const
-static int StringFindFirst(const string &sub, asUINT start, const string &str)
+static int StringFindFirst(const ScriptString &sub, asUINT start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.find(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.Find(sub, start);
 }
 
-// This function returns the index of the first position where the one of the bytes in substring
-// exists in the input string. If the characters in the substring doesn't exist in the input
-// string -1 is returned.
-//
 // AngelScript signature:
 // int string::findFirstOf(const string &in sub, uint start = 0) const
-static int StringFindFirstOf(const string &sub, asUINT start, const string &str)
+static int StringFindFirstOf(const ScriptString &sub, asUINT start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.find_first_of(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.FindFirstOf(sub, start);
 }
 
-// This function returns the index of the last position where the one of the bytes in substring
-// exists in the input string. If the characters in the substring doesn't exist in the input
-// string -1 is returned.
-//
 // AngelScript signature:
-// int string::findLastOf(const string &in sub, uint start = -1) const
-static int StringFindLastOf(const string &sub, asUINT start, const string &str)
+// int string::findLastOf(const string &in sub, int start = -1) const
+static int StringFindLastOf(const ScriptString &sub, int start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.find_last_of(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.FindLastOf(sub, start < 0 ? Hail::MAX_UINT : (asUINT)start);
 }
 
-// This function returns the index of the first position where a byte other than those in substring
-// exists in the input string. If none is found -1 is returned.
-//
 // AngelScript signature:
 // int string::findFirstNotOf(const string &in sub, uint start = 0) const
-static int StringFindFirstNotOf(const string &sub, asUINT start, const string &str)
+static int StringFindFirstNotOf(const ScriptString &sub, asUINT start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.find_first_not_of(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.FindFirstNotOf(sub, start);
 }
 
-// This function returns the index of the last position where a byte other than those in substring
-// exists in the input string. If none is found -1 is returned.
-//
 // AngelScript signature:
-// int string::findLastNotOf(const string &in sub, uint start = -1) const
-static int StringFindLastNotOf(const string &sub, asUINT start, const string &str)
+// int string::findLastNotOf(const string &in sub, int start = -1) const
+static int StringFindLastNotOf(const ScriptString &sub, int start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.find_last_not_of(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.FindLastNotOf(sub, start < 0 ? Hail::MAX_UINT : (asUINT)start);
 }
 
-// This function returns the index of the last position where the substring
-// exists in the input string. If the substring doesn't exist in the input
-// string -1 is returned.
-//
 // AngelScript signature:
 // int string::findLast(const string &in sub, int start = -1) const
-static int StringFindLast(const string &sub, int start, const string &str)
+static int StringFindLast(const ScriptString &sub, int start, const ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	return (int)str.rfind(sub, (size_t)(start < 0 ? string::npos : start));
+	return str.FindLast(sub, start < 0 ? Hail::MAX_UINT : (asUINT)start);
 }
 
 // AngelScript signature:
 // void string::insert(uint pos, const string &in other)
-static void StringInsert(unsigned int pos, const string &other, string &str)
+static void StringInsert(unsigned int pos, const ScriptString &other, ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	str.insert(pos, other);
+	str.Insert(pos, other);
 }
 
 // AngelScript signature:
 // void string::erase(uint pos, int count = -1)
-static void StringErase(unsigned int pos, int count, string &str)
+static void StringErase(unsigned int pos, int count, ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	str.erase(pos, (size_t)(count < 0 ? string::npos : count));
+	str.Erase(pos, count < 0 ? Hail::MAX_UINT : (asUINT)count);
 }
 
-
 // AngelScript signature:
 // uint string::length() const
-static asUINT StringLength(const string &str)
+static asUINT StringLength(const ScriptString &str)
 {
-	// We don't register the method directly because the return type changes between 32bit and 64bit platforms
-	return (asUINT)str.length();
+	return str.Length();
 }
 
-
 // AngelScript signature:
 // void string::resize(uint l)
-static void StringResize(asUINT l, string &str)
+static void StringResize(asUINT l, ScriptString &str)
 {
-	// We don't register the method directly because the argument types change between 32bit and 64bit platforms
-	str.resize(l);
+	str.Resize(l);
 }
 
 // AngelScript signature:
-// string formatInt(int64 val, const string &in options, uint width)
-static string formatInt(asINT64 value, const string &options, asUINT width)
-{
-	bool leftJustify = options.find("l") != string::npos;
-	bool padWithZero = options.find("0") != string::npos;
-	bool alwaysSign  = options.find("+") != string::npos;
-	bool spaceOnSign = options.find(" ") != string::npos;
-	bool hexSmall    = options.find("h") != string::npos;
-	bool hexLarge    = options.find("H") != string::npos;
-
-	string fmt = "%";
-	if( leftJustify ) fmt += "-";
-	if( alwaysSign ) fmt += "+";
-	if( spaceOnSign ) fmt += " ";
-	if( padWithZero ) fmt += "0";
-
-#ifdef _WIN32
-	fmt += "*I64";
-#else
-#ifdef _LP64
-	fmt += "*l";
-#else
-	fmt += "*ll";
-#endif
-#endif
+// string string::intern() const
+static ScriptString StringIntern(const ScriptString &str)
+{
+	return GetScriptStringFactorySingleton()->Intern(str);
+}
 
-	if( hexSmall ) fmt += "x";
-	else if( hexLarge ) fmt += "X";
-	else fmt += "d";
-
-	string buf;
-	buf.resize(width+30);
-#if _MSC_VER >= 1400 && !defined(__S3E__)
-	// MSVC 8.0 / 2005 or newer
-	sprintf_s(&buf[0], buf.size(), fmt.c_str(), width, value);
-#else
-	snprintf(&buf[0], buf.size(), fmt.c_str(), width, value);
-#endif
-	buf.resize(strlen(&buf[0]));
+static bool StringContainsOption(const ScriptString &options, char option)
+{
+	return memchr(options.Data(), option, options.Length()) != nullptr;
+}
 
+// Builds the printf format string in a stack buffer from the script options.
+static void BuildFormatPrefix(const ScriptString &options, char* fmt, asUINT& length)
+{
+	length = 0;
+	fmt[length++] = '%';
+	if( StringContainsOption(options, 'l') ) fmt[length++] = '-';
+	if( StringContainsOption(options, '+') ) fmt[length++] = '+';
+	if( StringContainsOption(options, ' ') ) fmt[length++] = ' ';
+	if( StringContainsOption(options, '0') ) fmt[length++] = '0';
+}
+
+static ScriptString FormatIntegerString(const ScriptString &options, asUINT width, bool bIsSigned, asQWORD bits)
+{
+	char fmt[16];
+	asUINT fmtLength = 0;
+	BuildFormatPrefix(options, fmt, fmtLength);
+	fmt[fmtLength++] = '*';
+	fmt[fmtLength++] = 'l';
+	fmt[fmtLength++] = 'l';
+	if( StringContainsOption(options, 'h') ) fmt[fmtLength++] = 'x';
+	else if( StringContainsOption(options, 'H') ) fmt[fmtLength++] = 'X';
+	else fmt[fmtLength++] = bIsSigned ? 'd' : 'u';
+	fmt[fmtLength] = 0;
+
+	ScriptString buf;
+	buf.Resize(width + 30);
+	int written = bIsSigned ?
+		snprintf(buf.MutableData(), buf.Length() + 1, fmt, width, (long long)bits) :
+		snprintf(buf.MutableData(), buf.Length() + 1, fmt, width, (unsigned long long)bits);
+	buf.Resize(written > 0 ? (asUINT)written : 0u);
 	return buf;
 }
 
 // AngelScript signature:
-// string formatUInt(uint64 val, const string &in options, uint width)
-static string formatUInt(asQWORD value, const string &options, asUINT width)
-{
-	bool leftJustify = options.find("l") != string::npos;
-	bool padWithZero = options.find("0") != string::npos;
-	bool alwaysSign  = options.find("+") != string::npos;
-	bool spaceOnSign = options.find(" ") != string::npos;
-	bool hexSmall    = options.find("h") != string::npos;
-	bool hexLarge    = options.find("H") != string::npos;
-
-	string fmt = "%";
-	if( leftJustify ) fmt += "-";
-	if( alwaysSign ) fmt += "+";
-	if( spaceOnSign ) fmt += " ";
-	if( padWithZero ) fmt += "0";
-
-#ifdef _WIN32
-	fmt += "*I64";
-#else
-#ifdef _LP64
-	fmt += "*l";
-#else
-	fmt += "*ll";
-#endif
-#endif
-
-	if( hexSmall ) fmt += "x";
-	else if( hexLarge ) fmt += "X";
-	else fmt += "u";
-
-	string buf;
-	buf.resize(width+30);
-#if _MSC_VER >= 1400 && !defined(__S3E__)
-	// MSVC 8.0 / 2005 or newer
-	sprintf_s(&buf[0], buf.size(), fmt.c_str(), width, value);
-#else
-	snprintf(&buf[0], buf.size(), fmt.c_str(), width, value);
-#endif
-	buf.resize(strlen(&buf[0]));
+// string formatInt(int64 val, const string &in options, uint width)
+static ScriptString formatInt(asINT64 value, const ScriptString &options, asUINT width)
+{
+	return FormatIntegerString(options, width, true, (asQWORD)value);
+}
 
-	return buf;
+// AngelScript signature:
+// string formatUInt(uint64 val, const string &in options, uint width)
+static ScriptString formatUInt(asQWORD value, const ScriptString &options, asUINT width)
+{
+	return FormatIntegerString(options, width, false, value);
 }
 
 // AngelScript signature:
 // string formatFloat(double val, const string &in options, uint width, uint precision)
-static string formatFloat(double value, const string &options, asUINT width, asUINT precision)
-{
-	bool leftJustify = options.find("l") != string::npos;
-	bool padWithZero = options.find("0") != string::npos;
-	bool alwaysSign  = options.find("+") != string::npos;
-	bool spaceOnSign = options.find(" ") != string::npos;
-	bool expSmall    = options.find("e") != string::npos;
-	bool expLarge    = options.find("E") != string::npos;
-
-	string fmt = "%";
-	if( leftJustify ) fmt += "-";
-	if( alwaysSign ) fmt += "+";
-	if( spaceOnSign ) fmt += " ";
-	if( padWithZero ) fmt += "0";
-
-	fmt += "*.*";
-
-	if( expSmall ) fmt += "e";
-	else if( expLarge ) fmt += "E";
-	else fmt += "f";
-
-	string buf;
-	buf.resize(width+precision+50);
-#if _MSC_VER >= 1400 && !defined(__S3E__)
-	// MSVC 8.0 / 2005 or newer
-	sprintf_s(&buf[0], buf.size(), fmt.c_str(), width, precision, value);
-#else
-	snprintf(&buf[0], buf.size(), fmt.c_str(), width, precision, value);
-#endif
-	buf.resize(strlen(&buf[0]));
-
+static ScriptString formatFloat(double value, const ScriptString &options, asUINT width, asUINT precision)
+{
+	char fmt[16];
+	asUINT fmtLength = 0;
+	BuildFormatPrefix(options, fmt, fmtLength);
+	fmt[fmtLength++] = '*';
+	fmt[fmtLength++] = '.';
+	fmt[fmtLength++] = '*';
+	if( StringContainsOption(options, 'e') ) fmt[fmtLength++] = 'e';
+	else if( StringContainsOption(options, 'E') ) fmt[fmtLength++] = 'E';
+	else fmt[fmtLength++] = 'f';
+	fmt[fmtLength] = 0;
+
+	ScriptString buf;
+	buf.Resize(width + precision + 50);
+	const int written = snprintf(buf.MutableData(), buf.Length() + 1, fmt, width, precision, value);
+	buf.Resize(written > 0 ? (asUINT)written : 0u);
 	return buf;
 }
 
 // AngelScript signature:
 // int64 parseInt(const string &in val, uint base = 10, uint &out byteCount = 0)
-static asINT64 parseInt(const string &val, asUINT base, asUINT *byteCount)
+static asINT64 parseInt(const ScriptString &val, asUINT base, asUINT *byteCount)
 {
 	// Only accept base 10 and 16
 	if( base != 10 && base != 16 )
@@ -601,7 +459,7 @@ static asINT64 parseInt(const string &val, asUINT base, asUINT *byteCount)
 		return 0;
 	}
 
-	const char *end = &val[0];
+	const char *end = val.Data();
 
 	// Determine the sign
 	bool sign = false;
@@ -639,7 +497,7 @@ static asINT64 parseInt(const string &val, asUINT base, asUINT *byteCount)
 	}
 
 	if( byteCount )
-		*byteCount = asUINT(size_t(end - val.c_str()));
+		*byteCount = asUINT(size_t(end - val.Data()));
 
 	if( sign )
 		res = -res;
@@ -649,7 +507,7 @@ static asINT64 parseInt(const string &val, asUINT base, asUINT *byteCount)
 
 // AngelScript signature:
 // uint64 parseUInt(const string &in val, uint base = 10, uint &out byteCount = 0)
-static asQWORD parseUInt(const string &val, asUINT base, asUINT *byteCount)
+static asQWORD parseUInt(const ScriptString &val, asUINT base, asUINT *byteCount)
 {
 	// Only accept base 10 and 16
 	if (base != 10 && base != 16)
@@ -658,7 +516,7 @@ static asQWORD parseUInt(const string &val, asUINT base, asUINT *byteCount)
 		return 0;
 	}
 
-	const char *end = &val[0];
+	const char *end = val.Data();
 
 	asQWORD res = 0;
 	if (base == 10)
@@ -686,14 +544,14 @@ static asQWORD parseUInt(const string &val, asUINT base, asUINT *byteCount)
 	}
 
 	if (byteCount)
-		*byteCount = asUINT(size_t(end - val.c_str()));
+		*byteCount = asUINT(size_t(end - val.Data()));
 
 	return res;
 }
 
 // AngelScript signature:
 // double parseFloat(const string &in val, uint &out byteCount = 0)
-double parseFloat(const string &val, asUINT *byteCount)
+static double parseFloat(const ScriptString &val, asUINT *byteCount)
 {
 	char *end;
 
@@ -703,19 +561,19 @@ double parseFloat(const string &val, asUINT *byteCount)
 #if !defined(_WIN32_WCE) && !defined(ANDROID) && !defined(__psp2__)
 	// Set the locale to C so that we are guaranteed to parse the float value correctly
 	char *tmp = setlocale(LC_NUMERIC, 0);
-	string orig = tmp ? tmp : "C";
+	String64 orig = tmp ? tmp : "C";
 	setlocale(LC_NUMERIC, "C");
 #endif
 
-	double res = strtod(val.c_str(), &end);
+	double res = strtod(val.Data(), &end);
 
 #if !defined(_WIN32_WCE) && !defined(ANDROID) && !defined(__psp2__)
 	// Restore the locale
-	setlocale(LC_NUMERIC, orig.c_str());
+	setlocale(LC_NUMERIC, orig.Data());
 #endif
 
 	if( byteCount )
-		*byteCount = asUINT(size_t(end - val.c_str()));
+		*byteCount = asUINT(size_t(end - val.Data()));
 
 	return res;
 }
@@ -725,116 +583,85 @@ double parseFloat(const string &val, asUINT *byteCount)
 //
 // AngelScript signature:
 // string string::substr(uint start = 0, int count = -1) const
-static string StringSubString(asUINT start, int count, const string &str)
+static ScriptString StringSubString(asUINT start, int count, const ScriptString &str)
 {
-	// Check for out-of-bounds
-	string ret;
-	if( start < str.length() && count != 0 )
-		ret = str.substr(start, (size_t)(count < 0 ? string::npos : count));
-
-	return ret;
-}
-
-// String equality comparison.
-// Returns true iff lhs is equal to rhs.
-//
-// For some reason gcc 4.7 has difficulties resolving the
-// asFUNCTIONPR(operator==, (const string &, const string &)
-// makro, so this wrapper was introduced as work around.
-static bool StringEquals(const std::string& lhs, const std::string& rhs)
-{
-	return lhs == rhs;
+	return str.SubString(start, count < 0 ? Hail::MAX_UINT : (asUINT)count);
 }
 
 static Hail::AngelScript::Variable GetStringData(void* pObj)
 {
-	const string& stringObject = *(string*)pObj;
+	const ScriptString& stringObject = *(ScriptString*)pObj;
 	Hail::AngelScript::Variable variableToReturn;
 	variableToReturn.m_type = "string";
-	variableToReturn.m_value = stringObject.c_str();
+	variableToReturn.m_value = stringObject.Data();
 
 	return variableToReturn;
 }
 
-void RegisterStdString_Native(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
+void RegisterScriptString_Native(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
 {
 	int r = 0;
 	UNUSED_VAR(r);
 
 	// Register the string type
-#if AS_CAN_USE_CPP11
-	// With C++11 it is possible to use asGetTypeTraits to automatically determine the correct flags to use
-	//r = engine->RegisterObjectType("string", sizeof(string), asOBJ_VALUE | asGetTypeTraits<string>()); assert( r >= 0 );
-	r = pTypeRegistry->RegisterType("string", sizeof(string), asOBJ_VALUE | asGetTypeTraits<string>(), H_FILE_LINE); assert(r >= 0);
-#else
-	//r = engine->RegisterObjectType("string", sizeof(string), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK); assert( r >= 0 );
-	r = pTypeRegistry->RegisterType("string", sizeof(string), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK); assert(r >= 0);
-#endif
-
-	r = pTypeRegistry->RegisterVariableFunction("string", &GetStringData); assert(r >= 0);
+	r = pTypeRegistry->RegisterType("string", sizeof(ScriptString), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK, H_FILE_LINE); assert(r);
+	r = pTypeRegistry->RegisterVariableFunction("string", &GetStringData); assert(r);
 
-	r = engine->RegisterStringFactory("string", GetStdStringFactorySingleton());
+	r = engine->RegisterStringFactory("string", GetScriptStringFactorySingleton());
 
 	// Register the object operator overloads
 	r = engine->RegisterObjectBehaviour("string", asBEHAVE_CONSTRUCT,  "void f()",                    asFUNCTION(ConstructString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 	r = engine->RegisterObjectBehaviour("string", asBEHAVE_CONSTRUCT,  "void f(const string &in)",    asFUNCTION(CopyConstructString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 	r = engine->RegisterObjectBehaviour("string", asBEHAVE_DESTRUCT,   "void f()",                    asFUNCTION(DestructString),  asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAssign(const string &in)", asMETHODPR(string, operator =, (const string&), string&), asCALL_THISCALL); assert( r >= 0 );
-	// Need to use a wrapper on Mac OS X 10.7/XCode 4.3 and CLang/LLVM, otherwise the linker fails
+	r = engine->RegisterObjectMethod("string", "string &opAssign(const string &in)", asFUNCTION(AssignStringToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 	r = engine->RegisterObjectMethod("string", "string &opAddAssign(const string &in)", asFUNCTION(AddAssignStringToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-//	r = engine->RegisterObjectMethod("string", "string &opAddAssign(const string &in)", asMETHODPR(string, operator+=, (const string&), string&), asCALL_THISCALL); assert( r >= 0 );
-
-	// Need to use a wrapper for operator== otherwise gcc 4.7 fails to compile
-	r = engine->RegisterObjectMethod("string", "bool opEquals(const string &in) const", asFUNCTIONPR(StringEquals, (const string &, const string &), bool), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "bool opEquals(const string &in) const", asFUNCTION(StringEquals), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
 	r = engine->RegisterObjectMethod("string", "int opCmp(const string &in) const", asFUNCTION(StringCmp), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(const string &in) const", asFUNCTIONPR(operator +, (const string &, const string &), string), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(const string &in) const", asFUNCTION(AddStrings), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
 
 	// The string length can be accessed through methods or through virtual property
-	// TODO: Register as size() for consistency with other types
 #if AS_USE_ACCESSORS != 1
 	r = engine->RegisterObjectMethod("string", "uint length() const", asFUNCTION(StringLength), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 #endif
 	r = engine->RegisterObjectMethod("string", "void resize(uint)", asFUNCTION(StringResize), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 #if AS_USE_STLNAMES != 1 && AS_USE_ACCESSORS == 1
-	// Don't register these if STL names is used, as they conflict with the method size()
 	r = engine->RegisterObjectMethod("string", "uint get_length() const property", asFUNCTION(StringLength), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 	r = engine->RegisterObjectMethod("string", "void set_length(uint) property", asFUNCTION(StringResize), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 #endif
-	// Need to use a wrapper on Mac OS X 10.7/XCode 4.3 and CLang/LLVM, otherwise the linker fails
-//	r = engine->RegisterObjectMethod("string", "bool isEmpty() const", asMETHOD(string, empty), asCALL_THISCALL); assert( r >= 0 );
 	r = engine->RegisterObjectMethod("string", "bool isEmpty() const", asFUNCTION(StringIsEmpty), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 
 	// Register the index operator, both as a mutator and as an inspector
 	// Note that we don't register the operator[] directly, as it doesn't do bounds checking
 	r = engine->RegisterObjectMethod("string", "uint8 &opIndex(uint)", asFUNCTION(StringCharAt), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "const uint8 &opIndex(uint) const", asFUNCTION(StringCharAt), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "const uint8 &opIndex(uint) const", asFUNCTION(StringCharAtConst), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 
 #if AS_NO_IMPL_OPS_WITH_STRING_AND_PRIMITIVE == 0
 	// Automatic conversion from values
-	r = engine->RegisterObjectMethod("string", "string &opAssign(double)", asFUNCTION(AssignDoubleToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(double)", asFUNCTION(AddAssignDoubleToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(double) const", asFUNCTION(AddStringDouble), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(double) const", asFUNCTION(AddDoubleString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(float)", asFUNCTION(AssignFloatToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(float)", asFUNCTION(AddAssignFloatToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(float) const", asFUNCTION(AddStringFloat), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(float) const", asFUNCTION(AddFloatString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(int64)", asFUNCTION(AssignInt64ToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(int64)", asFUNCTION(AddAssignInt64ToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(int64) const", asFUNCTION(AddStringInt64), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(int64) const", asFUNCTION(AddInt64String), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(uint64)", asFUNCTION(AssignUInt64ToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(uint64)", asFUNCTION(AddAssignUInt64ToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(uint64) const", asFUNCTION(AddStringUInt64), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(uint64) const", asFUNCTION(AddUInt64String), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(bool)", asFUNCTION(AssignBoolToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(bool)", asFUNCTION(AddAssignBoolToString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(bool) const", asFUNCTION(AddStringBool), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(bool) const", asFUNCTION(AddBoolString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAssign(double)", asFUNCTIONPR(AssignPrimitiveToString, (double, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(double)", asFUNCTIONPR(AddAssignPrimitiveToString, (double, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(double) const", asFUNCTIONPR(AddStringPrimitive, (const ScriptString&, double), ScriptString), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(double) const", asFUNCTIONPR(AddPrimitiveString, (double, const ScriptString&), ScriptString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+
+	// Floats are widened to double in ToPrimitiveString, the %g formatting gives the same output as for the float itself.
+	r = engine->RegisterObjectMethod("string", "string &opAssign(float)", asFUNCTIONPR(AssignPrimitiveToString, (float, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(float)", asFUNCTIONPR(AddAssignPrimitiveToString, (float, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(float) const", asFUNCTIONPR(AddStringPrimitive, (const ScriptString&, float), ScriptString), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(float) const", asFUNCTIONPR(AddPrimitiveString, (float, const ScriptString&), ScriptString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(int64)", asFUNCTIONPR(AssignPrimitiveToString, (asINT64, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(int64)", asFUNCTIONPR(AddAssignPrimitiveToString, (asINT64, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(int64) const", asFUNCTIONPR(AddStringPrimitive, (const ScriptString&, asINT64), ScriptString), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(int64) const", asFUNCTIONPR(AddPrimitiveString, (asINT64, const ScriptString&), ScriptString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(uint64)", asFUNCTIONPR(AssignPrimitiveToString, (asQWORD, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(uint64)", asFUNCTIONPR(AddAssignPrimitiveToString, (asQWORD, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(uint64) const", asFUNCTIONPR(AddStringPrimitive, (const ScriptString&, asQWORD), ScriptString), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(uint64) const", asFUNCTIONPR(AddPrimitiveString, (asQWORD, const ScriptString&), ScriptString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(bool)", asFUNCTIONPR(AssignPrimitiveToString, (bool, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(bool)", asFUNCTIONPR(AddAssignPrimitiveToString, (bool, ScriptString&), ScriptString&), asCALL_CDECL_OBJLAST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(bool) const", asFUNCTIONPR(AddStringPrimitive, (const ScriptString&, bool), ScriptString), asCALL_CDECL_OBJFIRST); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(bool) const", asFUNCTIONPR(AddPrimitiveString, (bool, const ScriptString&), ScriptString), asCALL_CDECL_OBJLAST); assert( r >= 0 );
 #endif
 
 	// Utilities
@@ -847,6 +674,8 @@ void RegisterStdString_Native(asIScriptEngine *engine, Hail::AngelScript::TypeRe
 	r = engine->RegisterObjectMethod("string", "int findLastNotOf(const string &in, int start = -1) const", asFUNCTION(StringFindLastNotOf), asCALL_CDECL_OBJLAST); assert(r >= 0);
 	r = engine->RegisterObjectMethod("string", "void insert(uint pos, const string &in other)", asFUNCTION(StringInsert), asCALL_CDECL_OBJLAST); assert(r >= 0);
 	r = engine->RegisterObjectMethod("string", "void erase(uint pos, int count = -1)", asFUNCTION(StringErase), asCALL_CDECL_OBJLAST); assert(r >= 0);
+	// Returns a copy that shares its memory with every other interned copy of the same text, intended for identifiers.
+	r = engine->RegisterObjectMethod("string", "string intern() const", asFUNCTION(StringIntern), asCALL_CDECL_OBJLAST); assert(r >= 0);
 
 
 	r = engine->RegisterGlobalFunction("string formatInt(int64 val, const string &in options = \"\", uint width = 0)", asFUNCTION(formatInt), asCALL_CDECL); assert(r >= 0);
@@ -873,440 +702,223 @@ void RegisterStdString_Native(asIScriptEngine *engine, Hail::AngelScript::TypeRe
 	// multiply/times/opMul/opMul_r - takes the string and multiplies it n times, e.g. "-".multiply(5) returns "-----"
 }
 
+// Generic calling convention wrappers, they forward to the native functions above.
+static ScriptString* GenericSelf(asIScriptGeneric* gen)
+{
+	return static_cast<ScriptString*>(gen->GetObject());
+}
+
+static const ScriptString& GenericStringArg(asIScriptGeneric* gen, asUINT arg)
+{
+	return *static_cast<const ScriptString*>(gen->GetArgAddress(arg));
+}
+
 static void ConstructStringGeneric(asIScriptGeneric * gen)
 {
-	new (gen->GetObject()) string();
+	new (gen->GetObject()) ScriptString();
 }
 
 static void CopyConstructStringGeneric(asIScriptGeneric * gen)
 {
-	string * a = static_cast<string *>(gen->GetArgObject(0));
-	new (gen->GetObject()) string(*a);
+	new (gen->GetObject()) ScriptString(*static_cast<ScriptString*>(gen->GetArgObject(0)));
 }
 
 static void DestructStringGeneric(asIScriptGeneric * gen)
 {
-	string * ptr = static_cast<string *>(gen->GetObject());
-	ptr->~string();
+	GenericSelf(gen)->~ScriptString();
 }
 
 static void AssignStringGeneric(asIScriptGeneric *gen)
 {
-	string * a = static_cast<string *>(gen->GetArgObject(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	*self = *a;
+	ScriptString* self = GenericSelf(gen);
+	*self = *static_cast<ScriptString*>(gen->GetArgObject(0));
 	gen->SetReturnAddress(self);
 }
 
 static void AddAssignStringGeneric(asIScriptGeneric *gen)
 {
-	string * a = static_cast<string *>(gen->GetArgObject(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	*self += *a;
+	ScriptString* self = GenericSelf(gen);
+	*self += *static_cast<ScriptString*>(gen->GetArgObject(0));
 	gen->SetReturnAddress(self);
 }
 
 static void StringEqualsGeneric(asIScriptGeneric * gen)
 {
-	string * a = static_cast<string *>(gen->GetObject());
-	string * b = static_cast<string *>(gen->GetArgAddress(0));
-	*(bool*)gen->GetAddressOfReturnLocation() = (*a == *b);
+	*(bool*)gen->GetAddressOfReturnLocation() = StringEquals(*GenericSelf(gen), GenericStringArg(gen, 0));
 }
 
 static void StringCmpGeneric(asIScriptGeneric * gen)
 {
-	string * a = static_cast<string *>(gen->GetObject());
-	string * b = static_cast<string *>(gen->GetArgAddress(0));
-
-	int cmp = 0;
-	if( *a < *b ) cmp = -1;
-	else if( *a > *b ) cmp = 1;
-
-	*(int*)gen->GetAddressOfReturnLocation() = cmp;
+	gen->SetReturnDWord(StringCmp(*GenericSelf(gen), GenericStringArg(gen, 0)));
 }
 
 static void StringAddGeneric(asIScriptGeneric * gen)
 {
-	string * a = static_cast<string *>(gen->GetObject());
-	string * b = static_cast<string *>(gen->GetArgAddress(0));
-	string ret_val = *a + *b;
-	gen->SetReturnObject(&ret_val);
+	ScriptString ret = AddStrings(*GenericSelf(gen), GenericStringArg(gen, 0));
+	gen->SetReturnObject(&ret);
 }
 
 static void StringLengthGeneric(asIScriptGeneric * gen)
 {
-	string * self = static_cast<string *>(gen->GetObject());
-	*static_cast<asUINT *>(gen->GetAddressOfReturnLocation()) = (asUINT)self->length();
+	gen->SetReturnDWord(GenericSelf(gen)->Length());
 }
 
 static void StringIsEmptyGeneric(asIScriptGeneric * gen)
 {
-	string * self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<bool *>(gen->GetAddressOfReturnLocation()) = StringIsEmpty(*self);
+	*reinterpret_cast<bool*>(gen->GetAddressOfReturnLocation()) = GenericSelf(gen)->Empty();
 }
 
 static void StringResizeGeneric(asIScriptGeneric * gen)
 {
-	string * self = static_cast<string *>(gen->GetObject());
-	self->resize(*static_cast<asUINT *>(gen->GetAddressOfArg(0)));
+	GenericSelf(gen)->Resize(*static_cast<asUINT*>(gen->GetAddressOfArg(0)));
 }
 
 static void StringInsert_Generic(asIScriptGeneric *gen)
 {
-	string * self = static_cast<string *>(gen->GetObject());
-	asUINT pos = gen->GetArgDWord(0);
-	string *other = reinterpret_cast<string*>(gen->GetArgAddress(1));
-	StringInsert(pos, *other, *self);
+	StringInsert(gen->GetArgDWord(0), GenericStringArg(gen, 1), *GenericSelf(gen));
 }
 
 static void StringErase_Generic(asIScriptGeneric *gen)
 {
-	string * self = static_cast<string *>(gen->GetObject());
-	asUINT pos = gen->GetArgDWord(0);
-	int count = int(gen->GetArgDWord(1));
-	StringErase(pos, count, *self);
+	StringErase(gen->GetArgDWord(0), gen->GetArgDWord(1), *GenericSelf(gen));
 }
 
 static void StringFindFirst_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindFirst(*find, start, *self);
+	gen->SetReturnDWord(StringFindFirst(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
 }
 
 static void StringFindLast_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindLast(*find, start, *self);
+	gen->SetReturnDWord(StringFindLast(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
 }
 
 static void StringFindFirstOf_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindFirstOf(*find, start, *self);
+	gen->SetReturnDWord(StringFindFirstOf(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
 }
 
 static void StringFindLastOf_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindLastOf(*find, start, *self);
+	gen->SetReturnDWord(StringFindLastOf(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
 }
 
 static void StringFindFirstNotOf_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindFirstNotOf(*find, start, *self);
+	gen->SetReturnDWord(StringFindFirstNotOf(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
 }
 
 static void StringFindLastNotOf_Generic(asIScriptGeneric * gen)
 {
-	string *find = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT start = gen->GetArgDWord(1);
-	string *self = reinterpret_cast<string *>(gen->GetObject());
-	*reinterpret_cast<int *>(gen->GetAddressOfReturnLocation()) = StringFindLastNotOf(*find, start, *self);
+	gen->SetReturnDWord(StringFindLastNotOf(GenericStringArg(gen, 0), gen->GetArgDWord(1), *GenericSelf(gen)));
+}
+
+static void StringIntern_Generic(asIScriptGeneric * gen)
+{
+	ScriptString interned = StringIntern(*GenericSelf(gen));
+	gen->SetReturnObject(&interned);
 }
 
 static void formatInt_Generic(asIScriptGeneric * gen)
 {
-	asINT64 val = gen->GetArgQWord(0);
-	string *options = reinterpret_cast<string*>(gen->GetArgAddress(1));
-	asUINT width = gen->GetArgDWord(2);
-	new(gen->GetAddressOfReturnLocation()) string(formatInt(val, *options, width));
+	ScriptString str = formatInt(gen->GetArgQWord(0), GenericStringArg(gen, 1), gen->GetArgDWord(2));
+	gen->SetReturnObject(&str);
 }
 
 static void formatUInt_Generic(asIScriptGeneric * gen)
 {
-	asQWORD val = gen->GetArgQWord(0);
-	string *options = reinterpret_cast<string*>(gen->GetArgAddress(1));
-	asUINT width = gen->GetArgDWord(2);
-	new(gen->GetAddressOfReturnLocation()) string(formatUInt(val, *options, width));
+	ScriptString str = formatUInt(gen->GetArgQWord(0), GenericStringArg(gen, 1), gen->GetArgDWord(2));
+	gen->SetReturnObject(&str);
 }
 
 static void formatFloat_Generic(asIScriptGeneric *gen)
 {
-	double val = gen->GetArgDouble(0);
-	string *options = reinterpret_cast<string*>(gen->GetArgAddress(1));
-	asUINT width = gen->GetArgDWord(2);
-	asUINT precision = gen->GetArgDWord(3);
-	new(gen->GetAddressOfReturnLocation()) string(formatFloat(val, *options, width, precision));
+	ScriptString str = formatFloat(gen->GetArgDouble(0), GenericStringArg(gen, 1), gen->GetArgDWord(2), gen->GetArgDWord(3));
+	gen->SetReturnObject(&str);
 }
 
 static void parseInt_Generic(asIScriptGeneric *gen)
 {
-	string *str = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT base = gen->GetArgDWord(1);
 	asUINT *byteCount = reinterpret_cast<asUINT*>(gen->GetArgAddress(2));
-	gen->SetReturnQWord(parseInt(*str,base,byteCount));
+	gen->SetReturnQWord(parseInt(GenericStringArg(gen, 0), gen->GetArgDWord(1), byteCount));
 }
 
 static void parseUInt_Generic(asIScriptGeneric *gen)
 {
-	string *str = reinterpret_cast<string*>(gen->GetArgAddress(0));
-	asUINT base = gen->GetArgDWord(1);
 	asUINT *byteCount = reinterpret_cast<asUINT*>(gen->GetArgAddress(2));
-	gen->SetReturnQWord(parseUInt(*str, base, byteCount));
+	gen->SetReturnQWord(parseUInt(GenericStringArg(gen, 0), gen->GetArgDWord(1), byteCount));
 }
 
 static void parseFloat_Generic(asIScriptGeneric *gen)
 {
-	string *str = reinterpret_cast<string*>(gen->GetArgAddress(0));
 	asUINT *byteCount = reinterpret_cast<asUINT*>(gen->GetArgAddress(1));
-	gen->SetReturnDouble(parseFloat(*str,byteCount));
+	gen->SetReturnDouble(parseFloat(GenericStringArg(gen, 0), byteCount));
 }
 
 static void StringCharAtGeneric(asIScriptGeneric * gen)
 {
-	unsigned int index = gen->GetArgDWord(0);
-	string * self = static_cast<string *>(gen->GetObject());
-
-	if (index >= self->size())
-	{
-		// Set a script exception
-		asIScriptContext *ctx = asGetActiveContext();
-		ctx->SetException("Out of range");
-
-		gen->SetReturnAddress(0);
-	}
-	else
-	{
-		gen->SetReturnAddress(&(self->operator [](index)));
-	}
-}
-
-#if AS_NO_IMPL_OPS_WITH_STRING_AND_PRIMITIVE == 0
-static void AssignInt2StringGeneric(asIScriptGeneric *gen)
-{
-	asINT64 *a = static_cast<asINT64*>(gen->GetAddressOfArg(0));
-	string *self = static_cast<string*>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self = sstr.str();
-	gen->SetReturnAddress(self);
-}
-
-static void AssignUInt2StringGeneric(asIScriptGeneric *gen)
-{
-	asQWORD *a = static_cast<asQWORD*>(gen->GetAddressOfArg(0));
-	string *self = static_cast<string*>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self = sstr.str();
-	gen->SetReturnAddress(self);
+	gen->SetReturnAddress(StringCharAt(gen->GetArgDWord(0), *GenericSelf(gen)));
 }
 
-static void AssignDouble2StringGeneric(asIScriptGeneric *gen)
+static void StringCharAtConstGeneric(asIScriptGeneric * gen)
 {
-	double *a = static_cast<double*>(gen->GetAddressOfArg(0));
-	string *self = static_cast<string*>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self = sstr.str();
-	gen->SetReturnAddress(self);
+	gen->SetReturnAddress((void*)StringCharAtConst(gen->GetArgDWord(0), *GenericSelf(gen)));
 }
 
-static void AssignFloat2StringGeneric(asIScriptGeneric *gen)
-{
-	float *a = static_cast<float*>(gen->GetAddressOfArg(0));
-	string *self = static_cast<string*>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self = sstr.str();
-	gen->SetReturnAddress(self);
-}
-
-static void AssignBool2StringGeneric(asIScriptGeneric *gen)
-{
-	bool *a = static_cast<bool*>(gen->GetAddressOfArg(0));
-	string *self = static_cast<string*>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << (*a ? "true" : "false");
-	*self = sstr.str();
-	gen->SetReturnAddress(self);
-}
-
-static void AddAssignDouble2StringGeneric(asIScriptGeneric * gen)
-{
-	double * a = static_cast<double *>(gen->GetAddressOfArg(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self += sstr.str();
-	gen->SetReturnAddress(self);
-}
-
-static void AddAssignFloat2StringGeneric(asIScriptGeneric * gen)
-{
-	float * a = static_cast<float *>(gen->GetAddressOfArg(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self += sstr.str();
-	gen->SetReturnAddress(self);
-}
-
-static void AddAssignInt2StringGeneric(asIScriptGeneric * gen)
+#if AS_NO_IMPL_OPS_WITH_STRING_AND_PRIMITIVE == 0
+template<typename T>
+static T GenericPrimitiveArg(asIScriptGeneric* gen, asUINT arg)
 {
-	asINT64 * a = static_cast<asINT64 *>(gen->GetAddressOfArg(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self += sstr.str();
-	gen->SetReturnAddress(self);
+	return *static_cast<T*>(gen->GetAddressOfArg(arg));
 }
 
-static void AddAssignUInt2StringGeneric(asIScriptGeneric * gen)
+template<typename T, typename ArgType = T>
+static void AssignPrimitive2StringGeneric(asIScriptGeneric *gen)
 {
-	asQWORD * a = static_cast<asQWORD *>(gen->GetAddressOfArg(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a;
-	*self += sstr.str();
+	ScriptString* self = GenericSelf(gen);
+	AssignPrimitiveToString((T)GenericPrimitiveArg<ArgType>(gen, 0), *self);
 	gen->SetReturnAddress(self);
 }
 
-static void AddAssignBool2StringGeneric(asIScriptGeneric * gen)
+template<typename T, typename ArgType = T>
+static void AddAssignPrimitive2StringGeneric(asIScriptGeneric *gen)
 {
-	bool * a = static_cast<bool *>(gen->GetAddressOfArg(0));
-	string * self = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << (*a ? "true" : "false");
-	*self += sstr.str();
+	ScriptString* self = GenericSelf(gen);
+	AddAssignPrimitiveToString((T)GenericPrimitiveArg<ArgType>(gen, 0), *self);
 	gen->SetReturnAddress(self);
 }
 
-static void AddString2DoubleGeneric(asIScriptGeneric * gen)
-{
-	string * a = static_cast<string *>(gen->GetObject());
-	double * b = static_cast<double *>(gen->GetAddressOfArg(0));
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddString2FloatGeneric(asIScriptGeneric * gen)
-{
-	string * a = static_cast<string *>(gen->GetObject());
-	float * b = static_cast<float *>(gen->GetAddressOfArg(0));
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddString2IntGeneric(asIScriptGeneric * gen)
+template<typename T, typename ArgType = T>
+static void AddString2PrimitiveGeneric(asIScriptGeneric *gen)
 {
-	string * a = static_cast<string *>(gen->GetObject());
-	asINT64 * b = static_cast<asINT64 *>(gen->GetAddressOfArg(0));
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
+	ScriptString ret = AddStringPrimitive(*GenericSelf(gen), (T)GenericPrimitiveArg<ArgType>(gen, 0));
+	gen->SetReturnObject(&ret);
 }
 
-static void AddString2UIntGeneric(asIScriptGeneric * gen)
+template<typename T, typename ArgType = T>
+static void AddPrimitive2StringGeneric(asIScriptGeneric *gen)
 {
-	string * a = static_cast<string *>(gen->GetObject());
-	asQWORD * b = static_cast<asQWORD *>(gen->GetAddressOfArg(0));
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddString2BoolGeneric(asIScriptGeneric * gen)
-{
-	string * a = static_cast<string *>(gen->GetObject());
-	bool * b = static_cast<bool *>(gen->GetAddressOfArg(0));
-	std::stringstream sstr;
-	sstr << *a << (*b ? "true" : "false");
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddDouble2StringGeneric(asIScriptGeneric * gen)
-{
-	double* a = static_cast<double *>(gen->GetAddressOfArg(0));
-	string * b = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddFloat2StringGeneric(asIScriptGeneric * gen)
-{
-	float* a = static_cast<float *>(gen->GetAddressOfArg(0));
-	string * b = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddInt2StringGeneric(asIScriptGeneric * gen)
-{
-	asINT64* a = static_cast<asINT64 *>(gen->GetAddressOfArg(0));
-	string * b = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddUInt2StringGeneric(asIScriptGeneric * gen)
-{
-	asQWORD* a = static_cast<asQWORD *>(gen->GetAddressOfArg(0));
-	string * b = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << *a << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
-}
-
-static void AddBool2StringGeneric(asIScriptGeneric * gen)
-{
-	bool* a = static_cast<bool *>(gen->GetAddressOfArg(0));
-	string * b = static_cast<string *>(gen->GetObject());
-	std::stringstream sstr;
-	sstr << (*a ? "true" : "false") << *b;
-	std::string ret_val = sstr.str();
-	gen->SetReturnObject(&ret_val);
+	ScriptString ret = AddPrimitiveString((T)GenericPrimitiveArg<ArgType>(gen, 0), *GenericSelf(gen));
+	gen->SetReturnObject(&ret);
 }
 #endif
 
 static void StringSubString_Generic(asIScriptGeneric *gen)
 {
-	// Get the arguments
-	string *str   = (string*)gen->GetObject();
-	asUINT  start = *(int*)gen->GetAddressOfArg(0);
-	int     count = *(int*)gen->GetAddressOfArg(1);
-
-	// Return the substring
-	new(gen->GetAddressOfReturnLocation()) string(StringSubString(start, count, *str));
+	ScriptString str = StringSubString(gen->GetArgDWord(0), gen->GetArgDWord(1), *GenericSelf(gen));
+	gen->SetReturnObject(&str);
 }
 
-void RegisterStdString_Generic(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
+void RegisterScriptString_Generic(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
 {
 	int r = 0;
 	UNUSED_VAR(r);
 
 	// Register the string type
-	//r = engine->RegisterObjectType("string", sizeof(string), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK); assert( r >= 0 );
+	r = pTypeRegistry->RegisterType("string", sizeof(ScriptString), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK, H_FILE_LINE); assert(r);
+	r = pTypeRegistry->RegisterVariableFunction("string", &GetStringData); assert(r);
 
-	r = pTypeRegistry->RegisterType("string", sizeof(string), asOBJ_VALUE | asOBJ_APP_CLASS_CDAK, H_FILE_LINE); assert(r >= 0);
-	r = pTypeRegistry->RegisterVariableFunction("string", &GetStringData); assert(r >= 0);
-
-	r = engine->RegisterStringFactory("string", GetStdStringFactorySingleton());
+	r = engine->RegisterStringFactory("string", GetScriptStringFactorySingleton());
 
 	// Register the object operator overloads
 	r = engine->RegisterObjectBehaviour("string", asBEHAVE_CONSTRUCT,  "void f()",                    asFUNCTION(ConstructStringGeneric), asCALL_GENERIC); assert( r >= 0 );
@@ -1332,34 +944,34 @@ void RegisterStdString_Generic(asIScriptEngine *engine, Hail::AngelScript::TypeR
 
 	// Register the index operator, both as a mutator and as an inspector
 	r = engine->RegisterObjectMethod("string", "uint8 &opIndex(uint)", asFUNCTION(StringCharAtGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "const uint8 &opIndex(uint) const", asFUNCTION(StringCharAtGeneric), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "const uint8 &opIndex(uint) const", asFUNCTION(StringCharAtConstGeneric), asCALL_GENERIC); assert( r >= 0 );
 
 #if AS_NO_IMPL_OPS_WITH_STRING_AND_PRIMITIVE == 0
 	// Automatic conversion from values
-	r = engine->RegisterObjectMethod("string", "string &opAssign(double)", asFUNCTION(AssignDouble2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(double)", asFUNCTION(AddAssignDouble2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(double) const", asFUNCTION(AddString2DoubleGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(double) const", asFUNCTION(AddDouble2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(float)", asFUNCTION(AssignFloat2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(float)", asFUNCTION(AddAssignFloat2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(float) const", asFUNCTION(AddString2FloatGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(float) const", asFUNCTION(AddFloat2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(int64)", asFUNCTION(AssignInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(int64)", asFUNCTION(AddAssignInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(int64) const", asFUNCTION(AddString2IntGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(int64) const", asFUNCTION(AddInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(uint64)", asFUNCTION(AssignUInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(uint64)", asFUNCTION(AddAssignUInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(uint64) const", asFUNCTION(AddString2UIntGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(uint64) const", asFUNCTION(AddUInt2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-
-	r = engine->RegisterObjectMethod("string", "string &opAssign(bool)", asFUNCTION(AssignBool2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string &opAddAssign(bool)", asFUNCTION(AddAssignBool2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd(bool) const", asFUNCTION(AddString2BoolGeneric), asCALL_GENERIC); assert( r >= 0 );
-	r = engine->RegisterObjectMethod("string", "string opAdd_r(bool) const", asFUNCTION(AddBool2StringGeneric), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAssign(double)", asFUNCTION((AssignPrimitive2StringGeneric<double>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(double)", asFUNCTION((AddAssignPrimitive2StringGeneric<double>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(double) const", asFUNCTION((AddString2PrimitiveGeneric<double>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(double) const", asFUNCTION((AddPrimitive2StringGeneric<double>)), asCALL_GENERIC); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(float)", asFUNCTION((AssignPrimitive2StringGeneric<double, float>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(float)", asFUNCTION((AddAssignPrimitive2StringGeneric<double, float>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(float) const", asFUNCTION((AddString2PrimitiveGeneric<double, float>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(float) const", asFUNCTION((AddPrimitive2StringGeneric<double, float>)), asCALL_GENERIC); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(int64)", asFUNCTION((AssignPrimitive2StringGeneric<asINT64>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(int64)", asFUNCTION((AddAssignPrimitive2StringGeneric<asINT64>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(int64) const", asFUNCTION((AddString2PrimitiveGeneric<asINT64>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(int64) const", asFUNCTION((AddPrimitive2StringGeneric<asINT64>)), asCALL_GENERIC); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(uint64)", asFUNCTION((AssignPrimitive2StringGeneric<asQWORD>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(uint64)", asFUNCTION((AddAssignPrimitive2StringGeneric<asQWORD>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(uint64) const", asFUNCTION((AddString2PrimitiveGeneric<asQWORD>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(uint64) const", asFUNCTION((AddPrimitive2StringGeneric<asQWORD>)), asCALL_GENERIC); assert( r >= 0 );
+
+	r = engine->RegisterObjectMethod("string", "string &opAssign(bool)", asFUNCTION((AssignPrimitive2StringGeneric<bool>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string &opAddAssign(bool)", asFUNCTION((AddAssignPrimitive2StringGeneric<bool>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd(bool) const", asFUNCTION((AddString2PrimitiveGeneric<bool>)), asCALL_GENERIC); assert( r >= 0 );
+	r = engine->RegisterObjectMethod("string", "string opAdd_r(bool) const", asFUNCTION((AddPrimitive2StringGeneric<bool>)), asCALL_GENERIC); assert( r >= 0 );
 #endif
 
 	r = engine->RegisterObjectMethod("string", "string substr(uint start = 0, int count = -1) const", asFUNCTION(StringSubString_Generic), asCALL_GENERIC); assert(r >= 0);
@@ -1371,7 +983,7 @@ void RegisterStdString_Generic(asIScriptEngine *engine, Hail::AngelScript::TypeR
 	r = engine->RegisterObjectMethod("string", "int findLastNotOf(const string &in, int start = -1) const", asFUNCTION(StringFindLastNotOf_Generic), asCALL_GENERIC); assert(r >= 0);
 	r = engine->RegisterObjectMethod("string", "void insert(uint pos, const string &in other)", asFUNCTION(StringInsert_Generic), asCALL_GENERIC); assert(r >= 0);
 	r = engine->RegisterObjectMethod("string", "void erase(uint pos, int count = -1)", asFUNCTION(StringErase_Generic), asCALL_GENERIC); assert(r >= 0);
-
+	r = engine->RegisterObjectMethod("string", "string intern() const", asFUNCTION(StringIntern_Generic), asCALL_GENERIC); assert(r >= 0);
 
 	r = engine->RegisterGlobalFunction("string formatInt(int64 val, const string &in options = \"\", uint width = 0)", asFUNCTION(formatInt_Generic), asCALL_GENERIC); assert(r >= 0);
 	r = engine->RegisterGlobalFunction("string formatUInt(uint64 val, const string &in options = \"\", uint width = 0)", asFUNCTION(formatUInt_Generic), asCALL_GENERIC); assert(r >= 0);
@@ -1381,16 +993,12 @@ void RegisterStdString_Generic(asIScriptEngine *engine, Hail::AngelScript::TypeR
 	r = engine->RegisterGlobalFunction("double parseFloat(const string &in, uint &out byteCount = 0)", asFUNCTION(parseFloat_Generic), asCALL_GENERIC); assert(r >= 0);
 }
 
-void RegisterStdString(asIScriptEngine * engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
+void RegisterScriptString(asIScriptEngine * engine, Hail::AngelScript::TypeRegistry* pTypeRegistry)
 {
 	if (strstr(asGetLibraryOptions(), "AS_MAX_PORTABILITY"))
-		RegisterStdString_Generic(engine, pTypeRegistry);
+		RegisterScriptString_Generic(engine, pTypeRegistry);
 	else
-		RegisterStdString_Native(engine, pTypeRegistry);
+		RegisterScriptString_Native(engine, pTypeRegistry);
 }
 
 END_AS_NAMESPACE
-
-
-
-
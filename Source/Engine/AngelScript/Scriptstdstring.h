@@ -1,11 +1,11 @@
 //
-// Script std::string
+// Script string
 //
-// This function registers the std::string type with AngelScript to be used as the default string type.
+// This function registers the Hail::AngelScript::ScriptString type with AngelScript to be used as the default string type.
 //
-// The string type is registered as a value type, thus may have performance issues if a lot of 
-// string operations are performed in the script. However, for relatively few operations, this should
-// not cause any problem for most applications.
+// The string type is registered as a value type. Short strings are stored inline and longer strings
+// share their memory between copies, so passing strings by value in the script is cheap.
+// String constants are interned by the string factory.
 //
 
 namespace Hail
@@ -24,8 +24,6 @@ namespace Hail
 #include <angelscript.h>
 #endif
 
-#include <string>
-
 //---------------------------
 // Compilation settings
 //
@@ -53,7 +51,7 @@ namespace Hail
 
 BEGIN_AS_NAMESPACE
 
-void RegisterStdString(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry);
+void RegisterScriptString(asIScriptEngine *engine, Hail::AngelScript::TypeRegistry* pTypeRegistry);
 
 END_AS_NAMESPACE
 
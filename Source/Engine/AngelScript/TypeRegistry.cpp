@@ -1,6 +1,7 @@
 #include "Engine_PCH.h"
 #include "TypeRegistry.h"
 #include "angelscript.h"
+#include "Hashing\xxh64_en.hpp"
 
 using namespace Hail;
 
@@ -46,6 +47,25 @@ namespace
 		}
 		return arguments;
 	}
+
+	uint64 HashRegistrationString(const char* pString, uint64 hash)
+	{
+		if (!pString)
+			return hash;
+		return xxh64::hash(pString, StringLength(pString), hash);
+	}
+
+	uint64 HashRegistrationValue(uint64 value, uint64 hash)
+	{
+		return xxh64::hash(reinterpret_cast<const char*>(&value), sizeof(value), hash);
+	}
+
+	uint64 HashRegisteredFunction(const asIScriptFunction* pFunction, uint64 hash)
+	{
+		if (!pFunction)
+			return hash;
+		return HashRegistrationString(pFunction->GetDeclaration(true, true, true), hash);
+	}
 }
 
 Hail::AngelScript::TypeRegistry::TypeRegistry(asIScriptEngine* pAsEngine, bool bEnableDebugger)
@@ -282,9 +302,7 @@ Hail::AngelScript::Variable Hail::AngelScript::TypeRegistry::GetVariableFromCall
 			return m_registeredTypes[i].toVariableCallback(pObject);
 		}
 	}
-	const char* declaration = m_pScriptEngine->GetTypeDeclaration(typeID);
-	const uint32 declarationLength = StringLength(declaration);
-	if (declaration[declarationLength - 2] == '[' && declaration[declarationLength - 1] == ']')
+	if (IsArrayType(typeID))
 	{
 		// 0 is for arrays
 		return m_registeredTypes[0].toVariableCallback(pObject);
@@ -293,6 +311,92 @@ Hail::AngelScript::Variable Hail::AngelScript::TypeRegistry::GetVariableFromCall
 	return Variable();
 }
 
+bool Hail::AngelScript::TypeRegistry::IsArrayType(uint32 typeID) const
+{
+	const char* declaration = m_pScriptEngine->GetTypeDeclaration(typeID);
+	const uint32 declarationLength = declaration ? StringLength(declaration) : 0u;
+	return declarationLength > 2u && declaration[declarationLength - 2] == '[' && declaration[declarationLength - 1] == ']';
+}
+
+uint64 Hail::AngelScript::TypeRegistry::CalculateRegistrationSignature() const
+{
+	uint64 hash = HashRegistrationString(asGetLibraryVersion(), 0);
+	hash = HashRegistrationString(asGetLibraryOptions(), hash);
+
+	for (asUINT typeIndex = 0; typeIndex < m_pScriptEngine->GetObjectTypeCount(); typeIndex++)
+	{
+		const asITypeInfo* pType = m_pScriptEngine->GetObjectTypeByIndex(typeIndex);
+		hash = HashRegistrationString(pType->GetNamespace(), hash);
+		hash = HashRegistrationString(pType->GetName(), hash);
+		hash = HashRegistrationValue(pType->GetSize(), hash);
+		hash = HashRegistrationValue(pType->GetFlags(), hash);
+
+		for (asUINT i = 0; i < pType->GetBehaviourCount(); i++)
+		{
+			asEBehaviours behaviour;
+			const asIScriptFunction* pBehaviour = pType->GetBehaviourByIndex(i, &behaviour);
+			hash = HashRegistrationValue(behaviour, HashRegisteredFunction(pBehaviour, hash));
+		}
+		for (asUINT i = 0; i < pType->GetFactoryCount(); i++)
+		{
+			hash = HashRegisteredFunction(pType->GetFactoryByIndex(i), hash);
+		}
+		for (asUINT i = 0; i < pType->GetMethodCount(); i++)
+		{
+			hash = HashRegisteredFunction(pType->GetMethodByIndex(i, false), hash);
+		}
+		for (asUINT i = 0; i < pType->GetPropertyCount(); i++)
+		{
+			hash = HashRegistrationString(pType->GetPropertyDeclaration(i, true), hash);
+		}
+	}
+
+	for (asUINT i = 0; i < m_pScriptEngine->GetGlobalFunctionCount(); i++)
+	{
+		hash = HashRegisteredFunction(m_pScriptEngine->GetGlobalFunctionByIndex(i), hash);
+	}
+
+	for (asUINT i = 0; i < m_pScriptEngine->GetGlobalPropertyCount(); i++)
+	{
+		const char* pName = nullptr;
+		const char* pNamespace = nullptr;
+		int typeID = 0;
+		bool bIsConst = false;
+		m_pScriptEngine->GetGlobalPropertyByIndex(i, &pName, &pNamespace, &typeID, &bIsConst);
+		hash = HashRegistrationString(pNamespace, hash);
+		hash = HashRegistrationString(pName, hash);
+		hash = HashRegistrationString(m_pScriptEngine->GetTypeDeclaration(typeID, true), hash);
+		hash = HashRegistrationValue(bIsConst, hash);
+	}
+
+	for (asUINT enumIndex = 0; enumIndex < m_pScriptEngine->GetEnumCount(); enumIndex++)
+	{
+		const asITypeInfo* pEnum = m_pScriptEngine->GetEnumByIndex(enumIndex);
+		hash = HashRegistrationString(pEnum->GetNamespace(), hash);
+		hash = HashRegistrationString(pEnum->GetName(), hash);
+		for (asUINT i = 0; i < pEnum->GetEnumValueCount(); i++)
+		{
+			int value = 0;
+			hash = HashRegistrationString(pEnum->GetEnumValueByIndex(i, &value), hash);
+			hash = HashRegistrationValue((uint64)value, hash);
+		}
+	}
+
+	for (asUINT i = 0; i < m_pScriptEngine->GetFuncdefCount(); i++)
+	{
+		hash = HashRegisteredFunction(m_pScriptEngine->GetFuncdefByIndex(i)->GetFuncdefSignature(), hash);
+	}
+
+	for (asUINT i = 0; i < m_pScriptEngine->GetTypedefCount(); i++)
+	{
+		const asITypeInfo* pTypedef = m_pScriptEngine->GetTypedefByIndex(i);
+		hash = HashRegistrationString(pTypedef->GetName(), hash);
+		hash = HashRegistrationValue(pTypedef->GetTypedefTypeId(), hash);
+	}
+
+	return hash;
+}
+
 void Hail::AngelScript::TypeDebuggerRegistry::RegisterClass(const char* className, const char* sourceFileName, int line)
 {
 	for (uint32 i = 0; i < m_registeredClasses.Size(); i++)
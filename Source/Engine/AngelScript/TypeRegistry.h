@@ -102,6 +102,9 @@ namespace Hail
 			bool RegisterGlobalEnumValue(const char* name, const char* valueName, uint32 value, const char* sourceFileName, int line);
 
 			Variable GetVariableFromCallback(uint32 typeID, void* pObject);
+			bool IsArrayType(uint32 typeID) const;
+			// Hash of every type, function and property registered to the engine, compiled bytecode is only valid for the same signature.
+			uint64 CalculateRegistrationSignature() const;
 			asIScriptEngine* GetEngine() { return m_pScriptEngine; }
 			TypeDebuggerRegistry* GetDebuggerRegistry() { return m_pDebuggerRegistry; }
 		private:
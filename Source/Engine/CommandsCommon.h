@@ -14,6 +14,8 @@
 #include "Transforms.h"
 #include "Camera.h"
 #include "EngineConstants.h"
+#include "TextArena.h"
+#include "Culling2D.h"
 
 namespace Hail
 {
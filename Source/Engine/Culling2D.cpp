@@ -0,0 +1,24 @@
+#include "Engine_PCH.h"
+#include "Culling2D.h"
+
+using namespace Hail;
+
+namespace
+{
+	// Text size is in pixels at 1080p, a glyph is never wider than a few times the text size.
+	constexpr float locTextReferenceHeight = 1080.f;
+	constexpr float locMaxGlyphWidthInTextSizes = 4.f;
+}
+
+bool Hail::IsBoundingCircleOnScreen(glm::vec2 normalizedPosition, float radius, float renderAspectRatio)
+{
+	const glm::vec2 center = normalizedPosition * 2.f - 1.f;
+	const float horizontalRadius = radius * renderAspectRatio;
+	return center.x + horizontalRadius >= -1.f && center.x - horizontalRadius <= 1.f && center.y + radius >= -1.f && center.y - radius <= 1.f;
+}
+
+float Hail::GetTextBoundingRadius(uint32 textLength, uint16 textSize)
+{
+	// The normalized device coordinates span 2 units over the screen height.
+	return (float)(textLength + 1u) * (float)textSize * locMaxGlyphWidthInTextSizes * 2.f / locTextReferenceHeight;
+}
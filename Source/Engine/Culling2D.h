@@ -0,0 +1,25 @@
+#pragma once
+#include "Types.h"
+#include "glm\vec2.hpp"
+
+namespace Hail
+{
+	// Number of 2D commands that were sent by the application and how many of them were not rendered.
+	struct CullingStats2D
+	{
+		uint32 m_numberOfSprites = 0u;
+		uint32 m_numberOfCulledSprites = 0u;
+		uint32 m_numberOfTexts = 0u;
+		uint32 m_numberOfCulledTexts = 0u;
+		// Sprites in a spatial index that were never added to the command pool as they were outside the view.
+		uint32 m_numberOfSpritesCulledBySpatialIndex = 0u;
+	};
+
+	// Tests a bounding circle against the screen. The position is in the 0-1 space of the camera and the radius is
+	// in normalized device coordinates of the screen height, renderAspectRatio is the height divided by the width.
+	bool IsBoundingCircleOnScreen(glm::vec2 normalizedPosition, float radius, float renderAspectRatio);
+
+	// Conservative radius of a text in normalized device coordinates of the screen height, as the text is not laid out
+	// until it is rendered. Covers any alignment and rotation of the text.
+	float GetTextBoundingRadius(uint32 textLength, uint16 textSize);
+}
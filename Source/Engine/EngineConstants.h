@@ -6,6 +6,8 @@ namespace Hail
 {
 	constexpr uint32 MAX_NUMBER_OF_SPRITES = 1024u;
 	constexpr uint32 MAX_NUMBER_OF_TEXT_COMMANDS = 128u;
+	// Total number of characters of all text commands in a command pool.
+	constexpr uint32 MAX_NUMBER_OF_TEXT_CHARACTERS = 8192u;
 	constexpr uint32 MAX_NUMBER_OF_DEBUG_LINES = 16392u;
 	constexpr uint32 MAX_NUMBER_OF_DEBUG_CIRCLES = 16392u;
 	constexpr uint32 MAX_NUMBER_OF_2D_RENDER_COMMANDS = MAX_NUMBER_OF_SPRITES + MAX_NUMBER_OF_TEXT_COMMANDS;
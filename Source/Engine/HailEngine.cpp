@@ -3,6 +3,7 @@
 
 #include "Input\InputHandler.h"
 #include "Input\InputActionMap.h"
+#include "Input\InputRecorder.h"
 
 #include "ApplicationWindow.h"
 #include "Timer.h"
@@ -14,6 +15,11 @@
 
 #include "InternalMessageHandling\InternalMessageLogger.h"
 #include "StringMemoryAllocator.h"
+#include "FrameArena.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
+#include "MemoryTracker.h"
+#include "ResourceCommon.h"
 
 #include <iostream>
 #include "imgui.h"
@@ -24,6 +30,10 @@
 #include "AngelScript\Runner.h"
 #include "AngelScript\Debugger.h"
 
+#include "Null\Null_ApplicationWindow.h"
+#include "Null\Null_InputHandler.h"
+#include "Null\Null_Renderer.h"
+
 #ifdef PLATFORM_WINDOWS
 
 #include "Windows/Windows_ApplicationWindow.h"
@@ -43,6 +53,7 @@ namespace Hail
 		Timer timer;
 		InputHandler* inputHandler = nullptr;
 		InputActionMap inputActionMap;
+		InputRecorder inputRecorder;
 		ApplicationWindow* appWindow = nullptr;
 		Renderer* renderer = nullptr;
 		ResourceManager* resourceManager = nullptr;
@@ -66,11 +77,22 @@ namespace Hail
 
 		std::thread applicationThread;
 		float applicationTickRate = 0;
+		// Set when replaying recorded input, the application then ticks with a fixed time step as fast as possible.
+		bool bFixedTimeStep = false;
+		bool bShutDownAfterReplay = false;
+		// Ticks left before a headless run shuts down, 0 when the run is not limited.
+		uint32 numberOfHeadlessTicksLeft = 0;
+		ePerformanceReportFormat performanceReportFormat = ePerformanceReportFormat::None;
+		FilePath performanceReportPath;
+		// Frames and application ticks to warm up before allocations in the game loop assert, 0 when the check is off.
+		uint32 steadyStateAllocationCheckFrame = 0;
 
 		AngelScript::Handler* pAsHandler;
 	};
 
 	EngineData* g_engineData = nullptr;
+	// Size of one frame block for every thread that uses the frame arena.
+	constexpr size_t g_frameArenaBlockSize = 2u * 1024u * 1024u;
 
 	void MainLoop();
 	void ProcessRendering(const bool applicationThreadLocked);
@@ -84,17 +106,34 @@ namespace Hail
 bool Hail::InitEngine(StartupAttributes& startupData)
 {
 	SetMainThread();
+	MemoryTracker::Initialize();
 	InternalMessageLogger::Initialize();
 	StringMemoryAllocator::Initialize();
+	FrameArena::Initialize(g_frameArenaBlockSize, MAX_FRAMESINFLIGHT);
+	Profiler::Initialize();
+	PerformanceCounters::Initialize();
 
 	g_engineData = new EngineData();
 	SetGlobalTimer(&g_engineData->timer);
 
+	if (startupData.bHeadless)
+	{
+		g_engineData->appWindow = new Null_ApplicationWindow();
+		g_engineData->inputHandler = new Null_InputHandler();
+		g_engineData->renderer = new NullRenderer();
+		// No ImGui context exists without a window, and headless runs tick as fast as possible.
+		g_engineData->m_renderSettings.m_bEnableImgui = false;
+		g_engineData->bFixedTimeStep = true;
+		g_engineData->numberOfHeadlessTicksLeft = startupData.numberOfHeadlessTicks;
+	}
+	else
+	{
 #ifdef PLATFORM_WINDOWS
-	g_engineData->appWindow = new Windows_ApplicationWindow();
-	g_engineData->inputHandler = new Windows_InputHandler();
-	g_engineData->renderer = new VlkRenderer();
+		g_engineData->appWindow = new Windows_ApplicationWindow();
+		g_engineData->inputHandler = new Windows_InputHandler();
+		g_engineData->renderer = new VlkRenderer();
 #endif
+	}
 
 	g_engineData->inputHandler->InitInputMapping();
 	if(!g_engineData->appWindow->Init(startupData, g_engineData->inputHandler))
@@ -110,7 +149,7 @@ bool Hail::InitEngine(StartupAttributes& startupData)
 	}
 	g_engineData->resourceRegistry.Init();
 
-	g_engineData->resourceManager = new ResourceManager();
+	g_engineData->resourceManager = new ResourceManager(startupData.bHeadless);
 	g_engineData->renderer->InitGraphicsEngineAndContext(g_engineData->resourceManager, startupData.m_pErrorManager);
 	if (!g_engineData->resourceManager->InitResources(g_engineData->renderer->GetRenderingDevice(), 
 		g_engineData->renderer->GetCurrentContext(), startupData.renderTargetResolution, startupData.startupWindowResolution, startupData.m_pErrorManager))
@@ -136,6 +175,20 @@ bool Hail::InitEngine(StartupAttributes& startupData)
 	g_engineData->applicationTickRate = (float32)startupData.applicationTickRate;
 	const float tickTime = 1.0f / g_engineData->applicationTickRate;
 	g_engineData->threadSynchronizer.Init(tickTime);
+	if (startupData.inputRecordingMode != eInputRecordingMode::None)
+	{
+		const FilePath recordingPath = FilePath::GetUserProjectDirectory() + startupData.inputRecordingFileName;
+		g_engineData->inputRecorder.Init(startupData.inputRecordingMode, recordingPath, g_engineData->applicationTickRate);
+		g_engineData->bFixedTimeStep |= g_engineData->inputRecorder.IsReplaying();
+		g_engineData->bShutDownAfterReplay = startupData.bShutDownAfterReplay;
+	}
+	if (startupData.performanceReportFormat != ePerformanceReportFormat::None)
+	{
+		const wchar_t* pExtension = startupData.performanceReportFormat == ePerformanceReportFormat::Csv ? L".csv" : L".json";
+		g_engineData->performanceReportFormat = startupData.performanceReportFormat;
+		g_engineData->performanceReportPath = FilePath::GetUserProjectDirectory() + startupData.performanceReportFileName + pExtension;
+	}
+	g_engineData->steadyStateAllocationCheckFrame = startupData.steadyStateAllocationCheckFrame;
 	g_engineData->imguiCommandRecorder.Init(g_engineData->resourceManager);
 	startupData.initFunctionToCall(&g_engineData->inputHandler->GetInputMapping()); // Init the calling application
 	g_engineData->updateFunctionToCall = startupData.updateFunctionToCall;
@@ -150,6 +203,11 @@ bool Hail::InitEngine(StartupAttributes& startupData)
 void Hail::CleanupEngineSystems()
 {
 	StringMemoryAllocator::Deinitialize();
+	FrameArena::Deinitialize();
+	Profiler::Deinitialize();
+	PerformanceCounters::Deinitialize();
+	// Last so everything the other systems free is no longer reported as a leak.
+	MemoryTracker::Deinitialize();
 }
 
 void Hail::StartEngine()
@@ -218,9 +276,19 @@ void Hail::MainLoop()
 {
 	bool lockApplicationThread = false;
 	EngineData& engineData = *g_engineData;
+	uint32 framesUntilSteadyState = engineData.steadyStateAllocationCheckFrame;
 	while (engineData.runMainThread)
 	{
 		engineData.timer.FrameStart();
+		FrameArena::GetInstance().BeginFrame();
+		H_PROFILE_FRAME();
+		MemoryTracker::EndFrame();
+		H_GAUGE_SET("Heap allocations", MemoryTracker::GetAllocationsLastFrame());
+		H_GAUGE_SET("Tracked heap bytes", MemoryTracker::GetTotalLiveBytes());
+		// The delta time is the duration of the last frame, so its counters are flushed together with it.
+		PerformanceCounters::GetInstance().EndFrame(engineData.timer.GetDeltaTimeMs());
+		if (framesUntilSteadyState != 0 && --framesUntilSteadyState == 0)
+			MemoryTracker::SetSteadyStateCheck(true);
 
 		// Updates window state and checks for input messages from OS
 		engineData.appWindow->ApplicationUpdateLoop();
@@ -242,9 +310,17 @@ void Hail::MainLoop()
 		if (engineData.applicationLoopDone)
 		{
 			// This area of the code is synchronized and locks the game thread, so keep code running here to a minimal
-			engineData.inputHandler->UpdateGamepads();
+			H_PROFILE_SCOPE("Synchronize threads");
+			if (!engineData.inputRecorder.IsReplaying())
+				engineData.inputHandler->UpdateGamepads();
+			engineData.inputRecorder.Update(*engineData.inputHandler);
+			if (engineData.bShutDownAfterReplay && engineData.inputRecorder.IsReplayFinished())
+				engineData.terminateApplication = true;
+			if (engineData.numberOfHeadlessTicksLeft != 0 && --engineData.numberOfHeadlessTicksLeft == 0)
+				engineData.terminateApplication = true;
 			g_engineData->inputActionMap.UpdateInputActions();
 			InternalMessageLogger::GetInstance().Update();
+			H_GAUGE_SET("String allocator bytes", StringMemoryAllocator::GetInstance().GetNumberOfAllocatedBytes());
 			engineData.imguiCommandRecorder.SwitchCommandBuffers(lockApplicationThread);
 			engineData.threadSynchronizer.SynchronizeAppData(engineData.inputActionMap, engineData.imguiCommandRecorder.FetchImguiResults(), *engineData.resourceManager);
 
@@ -266,6 +342,7 @@ void Hail::MainLoop()
 			lockApplicationThread = false;
 		}
 	}
+	MemoryTracker::SetSteadyStateCheck(false);
 	engineData.applicationThread.join();
 	engineData.renderer->WaitForGPU();
 	Cleanup();
@@ -273,6 +350,7 @@ void Hail::MainLoop()
 
 void Hail::ProcessRendering(const bool applicationThreadLocked)
 {
+	H_PROFILE_FUNCTION();
 	EngineData& engineData = *g_engineData;
 	Hail::InputMapping& inputMapping = g_engineData->inputHandler->GetInputMapping();
 
@@ -286,6 +364,7 @@ void Hail::ProcessRendering(const bool applicationThreadLocked)
 	ImGuiCommandManager::RenderParams imGuiRenderParams;
 	imGuiRenderParams.m_pFrameRenderSettings = &g_engineData->m_renderSettings;
 	imGuiRenderParams.m_pRenderContext = g_engineData->renderer->GetCurrentContext();
+	imGuiRenderParams.m_pRenderPool = startFrameParams.m_pRenderPool;
 	if (applicationThreadLocked)
 	{
 		bool unlockApplicationThread = false;
@@ -313,7 +392,10 @@ void Hail::ProcessApplicationThread()
 	Timer applicationTimer;
 	const float tickTime = 1.0f / engineData.applicationTickRate;
 	float applicationTime = 0.0;
+	uint32 fixedTickIndex = 0;
+	uint32 ticksUntilSteadyState = engineData.steadyStateAllocationCheckFrame;
 
+	Profiler::GetInstance().SetThreadName("Application thread");
 	AngelScript::Runner asScriptRunner;
 	g_engineData->pAsHandler->SetActiveScriptRunner(&asScriptRunner);
 	asScriptRunner.Initialize(g_engineData->pAsHandler->GetScriptEngine(), g_engineData->pAsHandler->GetTypeRegistry());
@@ -326,21 +408,29 @@ void Hail::ProcessApplicationThread()
 	{
 		applicationTimer.FrameStart();
 		applicationTime += applicationTimer.GetDeltaTime();
-		if (applicationTime >= tickTime && !engineData.applicationLoopDone)
+		if ((applicationTime >= tickTime || engineData.bFixedTimeStep) && !engineData.applicationLoopDone)
 		{
-			engineData.updateFunctionToCall(applicationTimer.GetTotalTime(), tickTime, engineData.threadSynchronizer.GetAppFrameData());
+			H_PROFILE_SCOPE("Application tick");
+			FrameArena::GetInstance().BeginFrame();
+			const double totalTime = engineData.bFixedTimeStep ? (double)fixedTickIndex++ * tickTime : applicationTimer.GetTotalTime();
+			engineData.updateFunctionToCall(totalTime, tickTime, engineData.threadSynchronizer.GetAppFrameData());
 			asScriptRunner.RunScript("FirstScript");
 			asScriptRunner.Update();
 			engineData.threadSynchronizer.PrepareApplicationData();
 			applicationTime = 0.0;
 			engineData.applicationLoopDone = true;
+			if (ticksUntilSteadyState != 0 && --ticksUntilSteadyState == 0)
+				MemoryTracker::SetSteadyStateCheck(true);
 		}
 		if(engineData.terminateApplication)
 		{
+			// The shutdown of the application is allowed to allocate.
+			MemoryTracker::SetSteadyStateCheck(false);
 			engineData.runApplication = false;
 			engineData.shutdownFunctionToCall();
 		}
 	}
+	MemoryTracker::SetSteadyStateCheck(false);
 	if (engineData.pauseApplication == false)
 	{
 		g_engineData->runMainThread = false;
@@ -351,6 +441,9 @@ void Hail::ProcessApplicationThread()
 
 void Hail::Cleanup()
 {
+	if (g_engineData->performanceReportFormat != ePerformanceReportFormat::None)
+		PerformanceCounters::GetInstance().WriteReport(g_engineData->performanceReportPath, g_engineData->performanceReportFormat);
+	g_engineData->inputRecorder.Deinit();
 	g_engineData->imguiCommandRecorder.DeInit();
 	g_engineData->renderer->Cleanup();
 	if (asIScriptEngine* pScriptEngine = g_engineData->pAsHandler->GetScriptEngine())
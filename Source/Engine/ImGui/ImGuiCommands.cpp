@@ -1,5 +1,6 @@
 #include "Engine_PCH.h"
 #include "ImGuiCommands.h"
+#include "Profiler.h"
 #include "imgui.h"
 #include "DebugMacros.h"
 #include "ImGuiMaterialEditor.h"
@@ -205,6 +206,7 @@ void Hail::ImGuiCommandManager::DeInit()
 
 void Hail::ImGuiCommandManager::RenderImguiCommands(RenderParams renderParams)
 {
+	H_PROFILE_FUNCTION();
 	if (!renderParams.m_pFrameRenderSettings->m_bEnableImgui)
 		return;
 
@@ -361,7 +363,7 @@ void Hail::ImGuiCommandManager::RenderImguiCommands(RenderParams renderParams)
 			SendImGuiPopCommand(m_pushedTypeStack.RemoveLast());
 		}
 	}
-	RenderEngineImgui(renderParams.m_pRenderContext);
+	RenderEngineImgui(renderParams.m_pRenderContext, renderParams.m_pRenderPool);
 }
 void Hail::ImGuiCommandManager::RenderSingleImguiCommand(bool& unlockApplicationThread, RenderParams renderParams)
 {
@@ -386,7 +388,7 @@ void Hail::ImGuiCommandManager::RenderSingleImguiCommand(bool& unlockApplication
 		RenderErrorModal(unlockApplicationThread);
 	}
 
-	RenderEngineImgui(renderParams.m_pRenderContext);
+	RenderEngineImgui(renderParams.m_pRenderContext, renderParams.m_pRenderPool);
 
 	if (unlockApplicationThread)
 	{
@@ -485,7 +487,7 @@ void Hail::ImGuiCommandManager::SendImGuiPopCommand(ImGuiCommandRecorder::IMGUI_
 	}
 }
 
-void Hail::ImGuiCommandManager::RenderEngineImgui(RenderContext* pRenderContext)
+void Hail::ImGuiCommandManager::RenderEngineImgui(RenderContext* pRenderContext, const RenderCommandPool* pRenderPool)
 {
 	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 5.0f);
 	if (ImGui::Begin("Engine Window", nullptr, ImGuiWindowFlags_MenuBar))
@@ -562,7 +564,7 @@ void Hail::ImGuiCommandManager::RenderEngineImgui(RenderContext* pRenderContext)
 		}
 		else if (m_bOpenProfilerlWindow)
 		{
-			g_profilerWindow.RenderImGuiCommands(&g_contextObject);
+			g_profilerWindow.RenderImGuiCommands(&g_contextObject, pRenderPool);
 		}
 	}
 	ImGui::End();
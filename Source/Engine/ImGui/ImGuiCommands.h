@@ -12,6 +12,7 @@ namespace Hail
 	class ResourceManager;
 	class RenderContext;
 	class RenderSettings;
+	struct RenderCommandPool;
 
 	constexpr uint32_t MAX_NUMBER_OF_IMGUI_RESPONSES = 1024;
 
@@ -111,6 +112,7 @@ namespace Hail
 		{
 			RenderSettings* m_pFrameRenderSettings;
 			RenderContext* m_pRenderContext;
+			const RenderCommandPool* m_pRenderPool;
 		};
 		void RenderImguiCommands(RenderParams renderParams);
 		void RenderSingleImguiCommand(bool& unlockApplicationThread, RenderParams renderParams);
@@ -124,7 +126,7 @@ namespace Hail
 		void PopStackType(ImGuiCommandRecorder::IMGUI_TYPES referenceTypeToPop);
 		void SendImGuiPopCommand(ImGuiCommandRecorder::IMGUI_TYPES typeToPop);
 
-		void RenderEngineImgui(RenderContext* pRenderContext);
+		void RenderEngineImgui(RenderContext* pRenderContext, const RenderCommandPool* pRenderPool);
 
 		uint32 m_numberOfOpenWindows = 0;
 		uint32 m_numberOfOpenTabItems = 0;
@@ -85,6 +85,10 @@ void Hail::ImGuiMessageLogger::RenderImGuiCommands()
         {
             InternalMessageLogger::GetInstance().ClearMessages();
         }
+        if (const uint32 numberOfDroppedMessages = InternalMessageLogger::GetInstance().GetNumberOfDroppedMessages())
+        {
+            ImGui::Text("Dropped messages: %u", numberOfDroppedMessages);
+        }
 
         if (ImGui::BeginCombo("Display type", localGetMessageLogType(m_logType)))
         {
@@ -3,8 +3,15 @@
 #include "HailEngine.h"
 #include "imgui.h"
 #include "Timer.h"
+#include "FrameArena.h"
+#include "RenderCommands.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
+#include "MemoryTracker.h"
+#include "StringMemoryAllocator.h"
+#include "Utility\FilePath.hpp"
 
-void Hail::ImGuiProfilerWindow::RenderImGuiCommands(ImGuiContext* context)
+void Hail::ImGuiProfilerWindow::RenderImGuiCommands(ImGuiContext* context, const RenderCommandPool* pRenderPool)
 {
 	const Timer& renderLoopTimer = GetRenderLoopTimer();
 
@@ -36,5 +43,225 @@ void Hail::ImGuiProfilerWindow::RenderImGuiCommands(ImGuiContext* context)
 	ImGui::Text("Render loop delta time : %fs, %fms ", currentDeltaTime, currentDeltaTimeMs);
 	ImGui::Text("Render loop average delta time /s : %fs, %fms ", m_deltaTimeLastSecond, m_deltaTimeMsLastSecond);
 
+	if (ImGui::CollapsingHeader("Frame memory", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		FrameArena::GetInstance().GetStats(m_frameArenaStats);
+		for (uint32 i = 0; i < m_frameArenaStats.Size(); i++)
+		{
+			const FrameArena::Stats& stats = m_frameArenaStats[i];
+			const float kiloBytesPerByte = 1.f / 1024.f;
+			if (stats.m_threadID == g_mainThreadID)
+				ImGui::Text("Main thread");
+			else
+				ImGui::Text("Thread %llu", stats.m_threadID);
+			ImGui::ProgressBar((float)stats.m_usedLastFrame / (float)stats.m_blockSize, ImVec2(-1.f, 0.f));
+			ImGui::Text("Last frame: %.1fKB / %.1fKB, high water mark: %.1fKB, %u frames in flight", 
+				stats.m_usedLastFrame * kiloBytesPerByte, stats.m_blockSize * kiloBytesPerByte, stats.m_highWaterMark * kiloBytesPerByte, stats.m_numberOfFramesInFlight);
+			if (stats.m_overflowLastFrame)
+				ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "Overflowed to the heap last frame: %.1fKB", stats.m_overflowLastFrame * kiloBytesPerByte);
+		}
+	}
+
+	if (PerformanceCounters::IsInitialized() && ImGui::CollapsingHeader("Counters", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		RenderPerformanceCounters();
+	}
+
+	if (ImGui::CollapsingHeader("Memory"))
+	{
+		RenderMemoryTracker();
+	}
+
+	if (Profiler::IsInitialized() && ImGui::CollapsingHeader("CPU zones", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		RenderZoneTimeline();
+	}
+
+	if (pRenderPool && ImGui::CollapsingHeader("2D culling", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const CullingStats2D& cullingStats = pRenderPool->m_cullingStats2D;
+		ImGui::Text("Sprites: %u, culled: %u", cullingStats.m_numberOfSprites, cullingStats.m_numberOfCulledSprites);
+		ImGui::Text("Texts: %u, culled: %u", cullingStats.m_numberOfTexts, cullingStats.m_numberOfCulledTexts);
+		ImGui::Text("Sprites culled by spatial index: %u", cullingStats.m_numberOfSpritesCulledBySpatialIndex);
+	}
+
 	ImGui::EndChild();
 }
+
+void Hail::ImGuiProfilerWindow::RenderZoneTimeline()
+{
+	Profiler& profiler = Profiler::GetInstance();
+	bool bPaused = profiler.IsPaused();
+	if (ImGui::Checkbox("Pause capture", &bPaused))
+		profiler.SetPaused(bPaused);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace"))
+		profiler.ExportChromeTrace(FilePath::GetUserProjectDirectory() + L"ProfilerTrace.json");
+
+	const uint32 numberOfFrames = profiler.GetNumberOfCapturedFrames();
+	if (numberOfFrames == 0u)
+		return;
+
+	// Older frames can only be browsed while paused, otherwise the view follows the last finished frame.
+	if (bPaused)
+		ImGui::SliderInt("Frames ago", &m_framesAgo, 0, (int)numberOfFrames - 1);
+	else
+		m_framesAgo = 0;
+
+	uint64 frameStartNs = 0u;
+	uint64 frameEndNs = 0u;
+	if (!profiler.GetFrameZones((uint32)m_framesAgo, m_zones, frameStartNs, frameEndNs))
+		return;
+	profiler.GetThreads(m_profilerThreads);
+
+	const double frameDurationNs = (double)(frameEndNs - frameStartNs);
+	ImGui::Text("Frame: %.3fms, %u zones", frameDurationNs * 0.000001, m_zones.Size());
+
+	const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	const float laneWidth = ImGui::GetContentRegionAvail().x;
+	const ImVec2 mousePosition = ImGui::GetIO().MousePos;
+	ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+	for (uint32 iThread = 0; iThread < m_profilerThreads.Size(); iThread++)
+	{
+		const Profiler::ThreadInfo& threadInfo = m_profilerThreads[iThread];
+		uint32 maxDepth = 0u;
+		bool bHasZones = false;
+		for (uint32 iZone = 0; iZone < m_zones.Size(); iZone++)
+		{
+			if (m_zones[iZone].m_threadIndex != threadInfo.m_threadIndex)
+				continue;
+			maxDepth = Math::Max(maxDepth, m_zones[iZone].m_depth);
+			bHasZones = true;
+		}
+		if (!bHasZones)
+			continue;
+
+		if (threadInfo.m_pName)
+			ImGui::Text("%s", threadInfo.m_pName);
+		else
+			ImGui::Text("Thread %llu", threadInfo.m_threadID);
+
+		const ImVec2 laneOrigin = ImGui::GetCursorScreenPos();
+		ImGui::PushID((int)threadInfo.m_threadIndex);
+		ImGui::InvisibleButton("Lane", ImVec2(laneWidth, (maxDepth + 1u) * rowHeight));
+		const bool bLaneHovered = ImGui::IsItemHovered();
+		ImGui::PopID();
+
+		for (uint32 iZone = 0; iZone < m_zones.Size(); iZone++)
+		{
+			const Profiler::Zone& zone = m_zones[iZone];
+			if (zone.m_threadIndex != threadInfo.m_threadIndex)
+				continue;
+
+			// Zones crossing the frame boundaries are clamped to the lane.
+			const float startFraction = Math::Clamp(0.f, 1.f, (float)(((double)zone.m_startNs - (double)frameStartNs) / frameDurationNs));
+			const float endFraction = Math::Clamp(0.f, 1.f, (float)(((double)zone.m_endNs - (double)frameStartNs) / frameDurationNs));
+			const ImVec2 zoneMin(laneOrigin.x + startFraction * laneWidth, laneOrigin.y + zone.m_depth * rowHeight);
+			const ImVec2 zoneMax(Math::Max(laneOrigin.x + endFraction * laneWidth, zoneMin.x + 1.f), zoneMin.y + rowHeight - 1.f);
+
+			// Same hue for a zone name every frame, the name is a string literal so its address is stable.
+			const float hue = (float)(((uint64)zone.m_pName * 2654435761ull) & 0xffffu) / 65535.f;
+			pDrawList->AddRectFilled(zoneMin, zoneMax, ImColor::HSV(hue, 0.5f, 0.7f));
+			pDrawList->PushClipRect(zoneMin, zoneMax, true);
+			pDrawList->AddText(ImVec2(zoneMin.x + 2.f, zoneMin.y), IM_COL32_WHITE, zone.m_pName);
+			pDrawList->PopClipRect();
+
+			if (bLaneHovered && mousePosition.x >= zoneMin.x && mousePosition.x < zoneMax.x && mousePosition.y >= zoneMin.y && mousePosition.y < zoneMax.y)
+				ImGui::SetTooltip("%s: %.3fms", zone.m_pName, (zone.m_endNs - zone.m_startNs) * 0.000001);
+		}
+	}
+}
+
+void Hail::ImGuiProfilerWindow::RenderPerformanceCounters()
+{
+	const PerformanceCounters& counters = PerformanceCounters::GetInstance();
+	const PerformanceCounters::FrameTimeStats frameTimeStats = counters.GetFrameTimeStats();
+	ImGui::Text("Frame time over %u frames, average: %.2fms, p50: %.2fms, p90: %.2fms, p99: %.2fms, max: %.2fms",
+		frameTimeStats.m_numberOfFrames, frameTimeStats.m_averageMs, frameTimeStats.m_p50Ms, frameTimeStats.m_p90Ms, frameTimeStats.m_p99Ms, frameTimeStats.m_maxMs);
+	counters.GetFrameTimeHistory(m_counterHistory);
+	ImGui::PlotLines("##FrameTime", m_counterHistory.Data(), m_counterHistory.Size(), 0, nullptr, 0.f, FLT_MAX, ImVec2(-1.f, 40.f));
+
+	const ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+	if (!ImGui::BeginTable("Counters", 6, tableFlags))
+		return;
+
+	ImGui::TableSetupColumn("Name");
+	ImGui::TableSetupColumn("Last");
+	ImGui::TableSetupColumn("Average");
+	ImGui::TableSetupColumn("Min");
+	ImGui::TableSetupColumn("Max");
+	ImGui::TableSetupColumn("History");
+	ImGui::TableHeadersRow();
+	for (uint32 iCounter = 0; iCounter < counters.GetNumberOfCounters(); iCounter++)
+	{
+		const PerformanceCounters::CounterStats stats = counters.GetCounterStats(iCounter);
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::Text("%s", stats.m_pName);
+		ImGui::TableNextColumn();
+		ImGui::Text("%lld", stats.m_lastValue);
+		ImGui::TableNextColumn();
+		ImGui::Text("%.1f", stats.m_averageValue);
+		ImGui::TableNextColumn();
+		ImGui::Text("%lld", stats.m_minValue);
+		ImGui::TableNextColumn();
+		ImGui::Text("%lld", stats.m_maxValue);
+		ImGui::TableNextColumn();
+		counters.GetCounterHistory(iCounter, m_counterHistory);
+		ImGui::PushID((int)iCounter);
+		ImGui::PlotLines("##History", m_counterHistory.Data(), m_counterHistory.Size(), 0, nullptr, FLT_MAX, FLT_MAX, ImVec2(-1.f, 0.f));
+		ImGui::PopID();
+	}
+	ImGui::EndTable();
+}
+
+void Hail::ImGuiProfilerWindow::RenderMemoryTracker()
+{
+	const float kiloBytesPerByte = 1.f / 1024.f;
+	ImGui::Text("Live: %.1fKB, allocations last frame: %llu", MemoryTracker::GetTotalLiveBytes() * kiloBytesPerByte, MemoryTracker::GetAllocationsLastFrame());
+	if (const uint64 numberOfViolations = MemoryTracker::GetNumberOfSteadyStateViolations())
+		ImGui::TextColored(ImVec4(1.f, 0.4f, 0.4f, 1.f), "Allocations in steady state: %llu", numberOfViolations);
+
+	float allocationHistory[MemoryTracker::HistorySize];
+	const uint32 numberOfFrames = MemoryTracker::GetAllocationHistory(allocationHistory, MemoryTracker::HistorySize);
+	ImGui::PlotLines("##Allocations", allocationHistory, (int)numberOfFrames, 0, nullptr, 0.f, FLT_MAX, ImVec2(-1.f, 40.f));
+
+	const ImGuiTableFlags tableFlags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+	if (ImGui::BeginTable("Memory tags", 6, tableFlags))
+	{
+		ImGui::TableSetupColumn("Tag");
+		ImGui::TableSetupColumn("Live KB");
+		ImGui::TableSetupColumn("Peak KB");
+		ImGui::TableSetupColumn("Live allocations");
+		ImGui::TableSetupColumn("Last frame");
+		ImGui::TableSetupColumn("Max in a frame");
+		ImGui::TableHeadersRow();
+		for (uint32 iTag = 0; iTag < (uint32)eMemoryTag::Count; iTag++)
+		{
+			const MemoryTracker::TagStats stats = MemoryTracker::GetTagStats((eMemoryTag)iTag);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::Text("%s", stats.m_pName);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.m_liveBytes * kiloBytesPerByte);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", stats.m_peakBytes * kiloBytesPerByte);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", stats.m_liveAllocations);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", stats.m_allocationsLastFrame);
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", stats.m_maxAllocationsInAFrame);
+		}
+		ImGui::EndTable();
+	}
+
+	// Free bytes spread over many small holes while the largest hole is small means the allocator is fragmented.
+	StringMemoryAllocator& stringAllocator = StringMemoryAllocator::GetInstance();
+	const StringMemoryAllocator::FragmentationStats charStats = stringAllocator.GetCharFragmentationStats();
+	const StringMemoryAllocator::FragmentationStats wCharStats = stringAllocator.GetWCharFragmentationStats();
+	ImGui::Text("Strings: %.1fKB in %u holes, largest hole: %.1fKB, untouched: %.1fKB",
+		charStats.m_freeBytes * kiloBytesPerByte, charStats.m_numberOfFreeBlocks, charStats.m_largestFreeBytes * kiloBytesPerByte, charStats.m_untouchedBytes * kiloBytesPerByte);
+	ImGui::Text("Wide strings: %.1fKB in %u holes, largest hole: %.1fKB, untouched: %.1fKB",
+		wCharStats.m_freeBytes * kiloBytesPerByte, wCharStats.m_numberOfFreeBlocks, wCharStats.m_largestFreeBytes * kiloBytesPerByte, wCharStats.m_untouchedBytes * kiloBytesPerByte);
+}
@@ -1,19 +1,29 @@
 #pragma once
+#include "FrameArena.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
 
 namespace Hail
 {
 	class ImGuiFileBrowser;
 	class ImGuiContext;
 	class ResourceManager;
+	struct RenderCommandPool;
 
 	class ImGuiProfilerWindow
 	{
 	public:
 
-		void RenderImGuiCommands(ImGuiContext* context);
+		void RenderImGuiCommands(ImGuiContext* context, const RenderCommandPool* pRenderPool);
 
 	private:
 
+		// Draws the zones of a captured frame as one lane per thread with nested zones stacked below their parent.
+		void RenderZoneTimeline();
+		void RenderPerformanceCounters();
+		// Live bytes and allocations per memory tag and the fragmentation of the string allocator.
+		void RenderMemoryTracker();
+
 		uint32 m_numberOfFramesInCurrentSecond = 0;
 		uint32 m_timeCounterInMs = 0u;
 
@@ -22,6 +32,12 @@ namespace Hail
 		float m_accumulatedDeltaTimeMsCurrentSecond = 0.f;
 		float m_deltaTimeMsLastSecond = 0.f;
 
+		GrowingArray<FrameArena::Stats> m_frameArenaStats;
+		GrowingArray<Profiler::Zone> m_zones;
+		GrowingArray<Profiler::ThreadInfo> m_profilerThreads;
+		int m_framesAgo = 0;
+		GrowingArray<float> m_counterHistory;
+
 		// TODO, save averages and start plotting a graph of data over time
 	};
 }
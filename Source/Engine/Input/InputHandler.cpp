@@ -62,6 +62,19 @@ Gamepad* Hail::InputHandler::GetGamePad(int gamepadIndex) const
 	return nullptr;
 }
 
+GamepadState Hail::InputHandler::GetGamepadState(int gamepadIndex) const
+{
+	if (Gamepad* pGamepad = m_pGamepads[gamepadIndex])
+		return pGamepad->GetState();
+	return GamepadState{};
+}
+
+void Hail::InputHandler::SetGamepadState(int gamepadIndex, const GamepadState& state)
+{
+	if (Gamepad* pGamepad = m_pGamepads[gamepadIndex])
+		pGamepad->SetState(state);
+}
+
 bool Hail::InputHandler::IsGamepadActive(int gamepadIndex) const
 {
 	//TODO: Add assert on index
@@ -125,3 +138,29 @@ void Hail::Gamepad::ResetStates()
 	}
 
 }
+
+GamepadState Hail::Gamepad::GetState() const
+{
+	GamepadState state{};
+	for (size_t i = 0; i < 2; i++)
+	{
+		state.directions[i] = m_currentGamepadDirections[i];
+		state.triggers[i] = m_triggerStates[i];
+	}
+	for (size_t i = 0; i < (uint8)eGamepadInputMapping::Count; i++)
+		state.buttonStates[i] = (uint8)m_currentButtonStates[i];
+	state.bIsActive = m_bIsActive;
+	return state;
+}
+
+void Hail::Gamepad::SetState(const GamepadState& state)
+{
+	for (size_t i = 0; i < 2; i++)
+	{
+		m_currentGamepadDirections[i] = state.directions[i];
+		m_triggerStates[i] = state.triggers[i];
+	}
+	for (size_t i = 0; i < (uint8)eGamepadInputMapping::Count; i++)
+		m_currentButtonStates[i] = (eInputState)state.buttonStates[i];
+	m_bIsActive = state.bIsActive;
+}
@@ -6,6 +6,15 @@ class ApplicationWindow;
 
 namespace Hail
 {
+	// Everything an action reads from a gamepad, used to record and replay the gamepad input.
+	struct GamepadState
+	{
+		glm::vec2 directions[2];
+		float triggers[2];
+		uint8 buttonStates[(uint8)eGamepadInputMapping::Count];
+		bool bIsActive;
+	};
+
 	class Gamepad
 	{
 	public:
@@ -32,6 +41,9 @@ namespace Hail
 
 		void ResetStates();
 
+		GamepadState GetState() const;
+		void SetState(const GamepadState& state);
+
 	protected:
 
 		StaticArray<glm::vec2, 2> m_currentGamepadDirections; // L 0 | R 1
@@ -64,6 +76,9 @@ namespace Hail
 		InputMap& GetInputMap() { return m_inputMap; }
 
 		Gamepad* GetGamePad(int gamepadIndex) const;
+		// Access to the gamepad regardless of if it is active, used by the input recorder.
+		GamepadState GetGamepadState(int gamepadIndex) const;
+		void SetGamepadState(int gamepadIndex, const GamepadState& state);
 
 		bool IsGamepadActive(int gamepadIndex) const;
 
@@ -0,0 +1,214 @@
+#include "Engine_PCH.h"
+#include "InputRecorder.h"
+#include "Utility\InOutStream.h"
+
+using namespace Hail;
+
+namespace
+{
+	constexpr uint32 g_recordingMagic = 0x52494C48; // "HLIR"
+	constexpr uint32 g_recordingVersion = 1;
+	// Unchanged bytes between two changed runs shorter than this are stored in the run, as a run header is 4 bytes.
+	constexpr uint32 g_maxUnchangedBytesInRun = 4;
+
+	struct RecordingHeader
+	{
+		uint32 magic;
+		uint32 version;
+		uint32 frameSize;
+		uint32 numberOfTicks;
+		float tickRate;
+	};
+
+	void AppendBytes(GrowingArray<uint8>& stream, const void* pData, uint32 numberOfBytes)
+	{
+		const uint8* pBytes = (const uint8*)pData;
+		for (uint32 i = 0; i < numberOfBytes; i++)
+			stream.Add(pBytes[i]);
+	}
+
+	bool ReadBytes(const GrowingArray<uint8>& stream, uint32& readOffset, void* pData, uint32 numberOfBytes)
+	{
+		if (readOffset + numberOfBytes > stream.Size())
+			return false;
+		memcpy(pData, stream.Data() + readOffset, numberOfBytes);
+		readOffset += numberOfBytes;
+		return true;
+	}
+}
+
+bool Hail::InputRecorder::Init(eInputRecordingMode mode, const FilePath& recordingPath, float tickRate)
+{
+	m_mode = mode;
+	m_recordingPath = recordingPath;
+	m_tickRate = tickRate;
+	m_tickIndex = 0;
+	m_numberOfRecordedTicks = 0;
+	m_readOffset = 0;
+	m_bReplayFinished = false;
+	memset(&m_previousFrame, 0, sizeof(InputFrame));
+	m_stream.RemoveAll();
+
+	if (m_mode == eInputRecordingMode::Replay && !LoadRecording())
+	{
+		m_mode = eInputRecordingMode::None;
+		return false;
+	}
+	return true;
+}
+
+void Hail::InputRecorder::Deinit()
+{
+	if (m_mode != eInputRecordingMode::Record || m_numberOfRecordedTicks == 0)
+		return;
+
+	RecordingHeader header;
+	header.magic = g_recordingMagic;
+	header.version = g_recordingVersion;
+	header.frameSize = sizeof(InputFrame);
+	header.numberOfTicks = m_numberOfRecordedTicks;
+	header.tickRate = m_tickRate;
+
+	InOutStream outStream;
+	if (!outStream.OpenFile(m_recordingPath, FILE_OPEN_TYPE::WRITE, true))
+	{
+		H_WARNING("Failed to open the input recording file for writing.");
+		return;
+	}
+	outStream.Write(&header, sizeof(RecordingHeader));
+	outStream.Write(m_stream.Data(), sizeof(uint8), m_stream.Size());
+	outStream.CloseFile();
+	m_stream.RemoveAll();
+	m_mode = eInputRecordingMode::None;
+}
+
+void Hail::InputRecorder::Update(InputHandler& inputHandler)
+{
+	if (m_mode == eInputRecordingMode::Record)
+	{
+		InputFrame frame;
+		memset(&frame, 0, sizeof(InputFrame));
+		memcpy(&frame.inputMap, &inputHandler.GetInputMap(), sizeof(InputMap));
+		for (int i = 0; i < 4; i++)
+		{
+			const GamepadState gamepadState = inputHandler.GetGamepadState(i);
+			memcpy(&frame.gamepads[i], &gamepadState, sizeof(GamepadState));
+		}
+		RecordFrame(frame);
+		m_tickIndex++;
+	}
+	else if (m_mode == eInputRecordingMode::Replay)
+	{
+		// The last tick is held when the replay has finished so no live input leaks in.
+		if (!m_bReplayFinished && !ReplayFrame(m_previousFrame))
+			m_bReplayFinished = true;
+
+		memcpy(&inputHandler.GetInputMap(), &m_previousFrame.inputMap, sizeof(InputMap));
+		for (int i = 0; i < 4; i++)
+			inputHandler.SetGamepadState(i, m_previousFrame.gamepads[i]);
+		if (!m_bReplayFinished)
+			m_tickIndex++;
+	}
+}
+
+void Hail::InputRecorder::RecordFrame(const InputFrame& frame)
+{
+	const uint8* pCurrent = (const uint8*)&frame;
+	const uint8* pPrevious = (const uint8*)&m_previousFrame;
+	constexpr uint32 frameSize = sizeof(InputFrame);
+	static_assert(frameSize <= 0xffff, "Run offsets are stored as 16 bit.");
+
+	const uint32 runCountOffset = m_stream.Size();
+	uint16 numberOfRuns = 0;
+	AppendBytes(m_stream, &numberOfRuns, sizeof(uint16));
+
+	uint32 byteIndex = 0;
+	while (byteIndex < frameSize)
+	{
+		if (pCurrent[byteIndex] == pPrevious[byteIndex])
+		{
+			byteIndex++;
+			continue;
+		}
+
+		const uint32 runStart = byteIndex;
+		uint32 runEnd = byteIndex + 1;
+		uint32 unchangedBytes = 0;
+		for (uint32 i = runEnd; i < frameSize && unchangedBytes <= g_maxUnchangedBytesInRun; i++)
+		{
+			if (pCurrent[i] != pPrevious[i])
+			{
+				runEnd = i + 1;
+				unchangedBytes = 0;
+			}
+			else
+			{
+				unchangedBytes++;
+			}
+		}
+
+		const uint16 offset = (uint16)runStart;
+		const uint16 length = (uint16)(runEnd - runStart);
+		AppendBytes(m_stream, &offset, sizeof(uint16));
+		AppendBytes(m_stream, &length, sizeof(uint16));
+		AppendBytes(m_stream, pCurrent + runStart, length);
+		numberOfRuns++;
+		byteIndex = runEnd;
+	}
+
+	memcpy(m_stream.Data() + runCountOffset, &numberOfRuns, sizeof(uint16));
+	memcpy(&m_previousFrame, &frame, sizeof(InputFrame));
+	m_numberOfRecordedTicks++;
+}
+
+bool Hail::InputRecorder::ReplayFrame(InputFrame& frame)
+{
+	if (m_tickIndex >= m_numberOfRecordedTicks)
+		return false;
+
+	uint16 numberOfRuns = 0;
+	if (!ReadBytes(m_stream, m_readOffset, &numberOfRuns, sizeof(uint16)))
+		return false;
+
+	uint8* pFrame = (uint8*)&frame;
+	for (uint16 iRun = 0; iRun < numberOfRuns; iRun++)
+	{
+		uint16 offset = 0;
+		uint16 length = 0;
+		if (!ReadBytes(m_stream, m_readOffset, &offset, sizeof(uint16)) || !ReadBytes(m_stream, m_readOffset, &length, sizeof(uint16)) ||
+			offset + length > sizeof(InputFrame) || !ReadBytes(m_stream, m_readOffset, pFrame + offset, length))
+		{
+			H_WARNING("The input recording is corrupt, stopping the replay.");
+			return false;
+		}
+	}
+	return true;
+}
+
+bool Hail::InputRecorder::LoadRecording()
+{
+	InOutStream inStream;
+	if (!m_recordingPath.IsValid() || !inStream.OpenFile(m_recordingPath, FILE_OPEN_TYPE::READ, true))
+	{
+		H_WARNING("Failed to open the input recording, replay is disabled.");
+		return false;
+	}
+
+	RecordingHeader header{};
+	const bool bReadHeader = inStream.GetFileSize() >= sizeof(RecordingHeader) && inStream.Read(&header, sizeof(RecordingHeader));
+	if (!bReadHeader || header.magic != g_recordingMagic || header.version != g_recordingVersion || header.frameSize != sizeof(InputFrame))
+	{
+		H_WARNING("The input recording is from another version of the engine, replay is disabled.");
+		inStream.CloseFile();
+		return false;
+	}
+	if (header.tickRate != m_tickRate)
+		H_WARNING("The input recording was made with another application tick rate, the replay will not match the recording.");
+
+	m_stream = GrowingArray<uint8>((uint32)(inStream.GetFileSize() - sizeof(RecordingHeader)));
+	m_stream.Fill();
+	inStream.Read(m_stream.Data(), sizeof(uint8), m_stream.Size());
+	inStream.CloseFile();
+	m_numberOfRecordedTicks = header.numberOfTicks;
+	return true;
+}
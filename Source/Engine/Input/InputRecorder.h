@@ -0,0 +1,50 @@
+#pragma once
+#include "Types.h"
+#include "StartupAttributes.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+#include "Utility\FilePath.hpp"
+#include "InputMappings.h"
+#include "InputHandler.h"
+
+namespace Hail
+{
+	// Records the raw input of every application tick to a compact binary stream, or feeds it back from a recording so a
+	// session can be replayed with identical input. Each tick is stored as the byte runs that changed since the previous tick.
+	class InputRecorder
+	{
+	public:
+		bool Init(eInputRecordingMode mode, const FilePath& recordingPath, float tickRate);
+		// Writes the recording to disk if recording.
+		void Deinit();
+
+		// Call once per application tick after the OS input is gathered and before the input actions are updated.
+		// Records the current input, or overwrites it with the next tick of the recording.
+		void Update(InputHandler& inputHandler);
+
+		eInputRecordingMode GetMode() const { return m_mode; }
+		bool IsReplaying() const { return m_mode == eInputRecordingMode::Replay; }
+		bool IsReplayFinished() const { return m_bReplayFinished; }
+		uint32 GetTickIndex() const { return m_tickIndex; }
+
+	private:
+		struct InputFrame
+		{
+			InputMap inputMap;
+			GamepadState gamepads[4];
+		};
+
+		void RecordFrame(const InputFrame& frame);
+		bool ReplayFrame(InputFrame& frame);
+		bool LoadRecording();
+
+		eInputRecordingMode m_mode = eInputRecordingMode::None;
+		FilePath m_recordingPath;
+		float m_tickRate = 0.0f;
+		uint32 m_tickIndex = 0;
+		uint32 m_numberOfRecordedTicks = 0;
+		uint32 m_readOffset = 0;
+		bool m_bReplayFinished = false;
+		InputFrame m_previousFrame;
+		GrowingArray<uint8> m_stream;
+	};
+}
@@ -23,9 +23,21 @@ void Hail::ApplicationCommandPool::AddSpriteCommand(const GameCommand_Sprite& sp
 	depthTypeCounter.m_textCounter = 0;
 }
 
-void Hail::ApplicationCommandPool::AddTextCommand(const GameCommand_Text& textToAdd)
+void Hail::ApplicationCommandPool::AddTextCommand(const GameCommand_Text& textToAdd, const StringLW& text)
 {
-	m_textCommands.Add(textToAdd);
+	AddTextCommand(textToAdd, text.Data(), text.Length());
+}
+
+void Hail::ApplicationCommandPool::AddTextCommand(const GameCommand_Text& textToAdd, const wchar_t* pText, uint32 textLength)
+{
+	// The arena warns when it is full, the renderer expects every text command to have characters so an empty span is dropped.
+	const TextSpan textSpan = m_textArena.Add(pText, textLength);
+	if (textSpan.m_length == 0u)
+		return;
+
+	GameCommand_Text& textCommand = m_textCommands.Add();
+	textCommand = textToAdd;
+	textCommand.text = textSpan;
 	for (uint32 i = 0; i < m_depthTypeCounters.Size(); i++)
 	{
 		if (textToAdd.m_layer == m_depthTypeCounters[i].m_layer)
@@ -52,5 +64,7 @@ void Hail::ApplicationCommandPool::NewFrame()
 	m_debugCircleCommands.Clear();
 	m_spriteCommands.Clear();
 	m_textCommands.Clear();
+	m_textArena.Clear();
 	m_meshCommands.Clear();
+	m_numberOfSpritesCulledBySpatialIndex = 0u;
 }
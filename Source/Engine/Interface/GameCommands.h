@@ -26,7 +26,7 @@ namespace Hail
 		Transform2D transform; // 20 Bytes
 		Color color; // 12 Bytes
 		uint32 index;
-		StringLW text; // TODO: kolla hur jag sparar strngen, kanske ha en stor strng pool bara fr text commands, som r en circular buffer
+		TextSpan text; // Set by the command pool when the command is added
 		uint16 textSize;
 		int m_layer{ 0 };
 		bool bLerpCommand{ true };
@@ -54,9 +54,13 @@ namespace Hail
 
 		void AddDebugLine(const DebugLineCommand& debugLineToAdd);
 		void AddSpriteCommand(const GameCommand_Sprite& spriteToAdd);
-		void AddTextCommand(const GameCommand_Text& textToAdd);
+		// The text is copied in to the text arena of the pool.
+		void AddTextCommand(const GameCommand_Text& textToAdd, const StringLW& text);
+		void AddTextCommand(const GameCommand_Text& textToAdd, const wchar_t* pText, uint32 textLength);
 		// Debug circles should be normalized, or add conversion to camera space and the like
 		void AddDebugCircle(DebugCircle circleToAdd);
+		// Reported in the culling stats, for sprites that a spatial index skipped adding to the pool.
+		void AddSpritesCulledBySpatialIndex(uint32 numberOfSprites) { m_numberOfSpritesCulledBySpatialIndex += numberOfSprites; }
 		void NewFrame();
 
 		VectorOnStack<GameCommand_Mesh, 1024, false> m_meshCommands;
@@ -68,7 +72,9 @@ namespace Hail
 		VectorOnStack<DepthTypeCounter2D, MAX_NUMBER_OF_2D_RENDER_COMMANDS> m_depthTypeCounters; 
 		VectorOnStack<GameCommand_Sprite, MAX_NUMBER_OF_SPRITES, false> m_spriteCommands;
 		VectorOnStack<GameCommand_Text, MAX_NUMBER_OF_TEXT_COMMANDS, false> m_textCommands;
+		TextArena m_textArena;
 		VectorOnStack<DebugLineCommand, MAX_NUMBER_OF_DEBUG_LINES / 2, false> m_debugLineCommands;
 		VectorOnStack<DebugCircle, MAX_NUMBER_OF_DEBUG_CIRCLES, false> m_debugCircleCommands;
+		uint32 m_numberOfSpritesCulledBySpatialIndex = 0u;
 	};
 }
\ No newline at end of file
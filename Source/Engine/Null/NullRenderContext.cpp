@@ -0,0 +1,338 @@
+#include "Engine_PCH.h"
+
+#include "NullRenderContext.h"
+#include "NullResources.h"
+
+#include "Resources\ResourceManager.h"
+#include "Rendering\SwapChain.h"
+#include "MathUtils.h"
+
+using namespace Hail;
+
+namespace
+{
+	void AddStatistics(NullRenderStatistics& total, const NullRenderStatistics& frame)
+	{
+		total.drawCalls += frame.drawCalls;
+		total.renderedInstances += frame.renderedInstances;
+		total.fullscreenPasses += frame.fullscreenPasses;
+		total.renderedLines += frame.renderedLines;
+		total.dispatches += frame.dispatches;
+		total.meshletDispatches += frame.meshletDispatches;
+		total.pipelineBinds += frame.pipelineBinds;
+		total.uploadedBytes += frame.uploadedBytes;
+	}
+}
+
+NullRenderContext::NullRenderContext(RenderContextStartupParams renderContextStartParams) :
+	RenderContext(renderContextStartParams)
+{
+	for (uint32 i = 0; i < MAX_FRAMESINFLIGHT; i++)
+	{
+		m_pFrameCommandData[i] = new NullFrameData();
+		m_pFrameCommandData[i]->Init(m_pDevice, i);
+	}
+}
+
+void NullRenderContext::Cleanup()
+{
+	for (uint32 i = 0; i < m_pFrameBufferMaterialPipelines.Size(); i++)
+	{
+		m_pFrameBufferMaterialPipelines[i]->Cleanup(m_pDevice);
+		SAFEDELETE(m_pFrameBufferMaterialPipelines[i]);
+	}
+	m_pFrameBufferMaterialPipelines.RemoveAll();
+
+	for (uint32 i = 0; i < m_pComputePipelines.Size(); i++)
+	{
+		m_pComputePipelines[i]->Cleanup(m_pDevice);
+		SAFEDELETE(m_pComputePipelines[i]);
+	}
+	m_pComputePipelines.RemoveAll();
+
+	for (uint32 i = 0; i < MAX_FRAMESINFLIGHT; i++)
+	{
+		m_pFrameCommandData[i]->Cleanup(m_pDevice, i);
+		SAFEDELETE(m_pFrameCommandData[i]);
+	}
+}
+
+void NullRenderContext::BindMaterialInstance(uint32 materialInstanceIndex)
+{
+	H_ASSERT(m_pBoundMaterial, "No bound material, is this called in a material pipeline pass?");
+	H_ASSERT(((NullMaterial*)m_pBoundMaterial)->m_numberOfInstances > materialInstanceIndex, "Material instance is not initialized");
+}
+
+void NullRenderContext::UploadDataToBufferInternal(BufferObject* pBuffer, void* pDataToUpload, uint32 sizeOfUploadedData)
+{
+	H_ASSERT(m_pCurrentCommandBuffer);
+	H_ASSERT(m_currentState == eContextState::Transfer);
+	H_ASSERT(pBuffer->GetBufferSize() >= sizeOfUploadedData, "Invalid size of mapped data");
+
+	const uint32 frameInFlight = m_pResourceManager->GetSwapChain()->GetFrameInFlight();
+	memcpy(((NullBufferObject*)pBuffer)->GetData(frameInFlight), pDataToUpload, sizeOfUploadedData);
+	m_frameStatistics.uploadedBytes += sizeOfUploadedData;
+}
+
+void NullRenderContext::CopyDataToBufferInternal(BufferObject* pDstBuffer, BufferObject* pSrcBuffer)
+{
+	H_ASSERT(m_pCurrentCommandBuffer);
+
+	const uint32 frameInFlight = m_pResourceManager->GetSwapChain()->GetFrameInFlight();
+	const uint32 bytesToCopy = Math::Min(pDstBuffer->GetBufferSize(), pSrcBuffer->GetBufferSize());
+	memcpy(((NullBufferObject*)pDstBuffer)->GetData(frameInFlight), ((NullBufferObject*)pSrcBuffer)->GetData(frameInFlight), bytesToCopy);
+}
+
+void NullRenderContext::UploadDataToTextureInternal(TextureResource* pTexture, void* pDataToUpload, uint32 mipLevel)
+{
+	H_ASSERT(m_pCurrentCommandBuffer);
+	m_frameStatistics.uploadedBytes += ((NullTextureResource*)pTexture)->GetByteSize();
+}
+
+void NullRenderContext::TransferFramebufferLayoutInternal(TextureResource* pTextureToTransfer, eFrameBufferLayoutState sourceState, eFrameBufferLayoutState destinationState)
+{
+	H_ASSERT(m_pCurrentCommandBuffer);
+}
+
+void NullRenderContext::TransferImageStateInternal(TextureResource* pTexture, eShaderAccessQualifier newState, uint32 newStageCombination)
+{
+	NullTextureResource* pNullTexture = (NullTextureResource*)pTexture;
+	pNullTexture->m_accessQualifier = newState;
+	pNullTexture->m_currentStageUsage = newStageCombination;
+}
+
+void NullRenderContext::Dispatch(glm::uvec3 dispatchSize)
+{
+	RenderContext::Dispatch(dispatchSize);
+	H_ASSERT(m_pBoundMaterialPipeline->m_bIsCompute);
+	m_frameStatistics.dispatches++;
+}
+
+void NullRenderContext::RenderMeshlets(glm::uvec3 dispatchSize)
+{
+	RenderContext::RenderMeshlets(dispatchSize);
+	m_frameStatistics.meshletDispatches++;
+}
+
+void NullRenderContext::RenderFullscreenPass()
+{
+	H_ASSERT(m_pBoundVertexBuffer == nullptr, "No vertex buffer should be bound for fullscreen rendering.");
+	m_frameStatistics.fullscreenPasses++;
+	m_frameStatistics.drawCalls++;
+}
+
+void NullRenderContext::RenderInstances(uint32 numberOfInstances, uint32 offset)
+{
+	H_ASSERT(m_pCurrentCommandBuffer && m_currentState == eContextState::Graphics, "Can not render outside of a graphics pass");
+	H_ASSERT(m_pBoundMaterial || m_pBoundMaterialPipeline, "Must have bound a material to render instances.");
+
+	bool bDoesNotNeedVertexBuffer = m_boundMaterialType == eMaterialType::CUSTOM;
+	bool bHaveABoundVertexBuffer = m_pBoundVertexBuffer;
+	H_ASSERT(bDoesNotNeedVertexBuffer != bHaveABoundVertexBuffer, "Must have bound a material to render sprites.");
+
+	m_frameStatistics.renderedInstances += numberOfInstances;
+	m_frameStatistics.drawCalls++;
+}
+
+void NullRenderContext::RenderDebugLines(uint32 numberOfLinesToRender)
+{
+	H_ASSERT(m_pCurrentCommandBuffer && m_currentState == eContextState::Graphics, "Can not render outside of a graphics pass");
+	H_ASSERT(m_pBoundMaterialPipeline, "Must have bound a material to render lines.");
+	H_ASSERT(m_boundMaterialType == eMaterialType::CUSTOM, "Must have a custom material for lines.");
+
+	m_frameStatistics.renderedLines += numberOfLinesToRender;
+	m_frameStatistics.drawCalls++;
+}
+
+void NullRenderContext::RecordIndexedDraw(uint32 numberOfIndices)
+{
+	H_ASSERT(m_pCurrentCommandBuffer && m_currentState == eContextState::Graphics, "Can not render outside of a graphics pass");
+	H_ASSERT(numberOfIndices != 0u, "Empty draw call");
+
+	m_frameStatistics.renderedInstances++;
+	m_frameStatistics.drawCalls++;
+}
+
+bool NullRenderContext::BindMaterialInternal(Pipeline* pPipeline)
+{
+	for (uint32 i = 0; i < m_pFrameBufferMaterialPipelines.Size(); i++)
+	{
+		MaterialFrameBufferConnection& connection = *m_pFrameBufferMaterialPipelines[i];
+
+		if (connection.m_pBoundFrameBuffer == m_pBoundFrameBuffers[0] && connection.m_pMaterialPipeline == pPipeline)
+		{
+			BindMaterialFrameBufferConnection(m_pFrameBufferMaterialPipelines[i]);
+			return true;
+		}
+	}
+
+	NullMaterialFrameBufferConnection* pConnection = new NullMaterialFrameBufferConnection();
+	pConnection->m_pBoundFrameBuffer = m_pBoundFrameBuffers[0];
+	pConnection->m_pMaterialPipeline = pPipeline;
+	m_pFrameBufferMaterialPipelines.Add(pConnection);
+	BindMaterialFrameBufferConnection(pConnection);
+	return true;
+}
+
+bool NullRenderContext::BindComputePipelineInternal(Pipeline* pPipeline)
+{
+	for (uint32 i = 0; i < m_pComputePipelines.Size(); i++)
+	{
+		if (m_pComputePipelines[i]->m_pMaterialPipeline == pPipeline)
+		{
+			BindComputePipeline(m_pComputePipelines[i]);
+			return true;
+		}
+	}
+
+	NullComputePipeline* pComputePipeline = new NullComputePipeline();
+	pComputePipeline->m_pMaterialPipeline = pPipeline;
+	m_pComputePipelines.Add(pComputePipeline);
+	BindComputePipeline(pComputePipeline);
+	return true;
+}
+
+void NullRenderContext::ClearFrameBufferInternal(FrameBufferTexture* pFrameBuffer)
+{
+	H_ASSERT(m_pCurrentCommandBuffer);
+}
+
+void NullRenderContext::SetPushConstantInternal(void* pPushConstant)
+{
+	H_ASSERT(m_pBoundMaterialPipeline, "No bound pipeline to set push constants on");
+}
+
+void NullRenderContext::StartFrame()
+{
+	NullSwapChain* pNullSwapChain = (NullSwapChain*)m_pResourceManager->GetSwapChain();
+	FrameCommandData& currentFrameData = *m_pFrameCommandData[pNullSwapChain->GetFrameInFlight()];
+
+	pNullSwapChain->FrameStart();
+	if (m_currentRenderFrame != 0)
+	{
+		H_ASSERT(m_currentState == eContextState::TransitionBetweenStates && m_pCurrentCommandBuffer == nullptr);
+		currentFrameData.Reset(m_pDevice);
+	}
+	m_currentRenderFrame++;
+	m_pBoundTextures.Fill(nullptr);
+	m_pBoundStructuredBuffers.Fill(nullptr);
+	m_pBoundUniformBuffers.Fill(nullptr);
+	m_pBoundFrameBuffers.Fill(nullptr);
+}
+
+void NullRenderContext::EndCurrentPass(uint32 nextShaderStage)
+{
+	if (m_currentlyBoundPipeline != MAX_UINT && m_lastBoundShaderStages != ComputeShaderStage)
+		CleanupAndEndPass();
+}
+
+void NullRenderContext::SubmitFinalFrameCommandBuffer()
+{
+	const uint32 currentFrame = m_pResourceManager->GetSwapChain()->GetFrameInFlight();
+	FrameCommandData& currentFrameData = *m_pFrameCommandData[currentFrame];
+
+	currentFrameData.GetCurrentCommandBuffer()->EndBuffer();
+	currentFrameData.CommitCommandBuffer(m_pDevice);
+
+	m_pCurrentCommandBuffer = nullptr;
+
+	AddStatistics(m_totalStatistics, m_frameStatistics);
+	m_lastFrameStatistics = m_frameStatistics;
+	m_frameStatistics = NullRenderStatistics();
+
+	((NullSwapChain*)m_pResourceManager->GetSwapChain())->FrameEnd();
+}
+
+void NullRenderContext::TransferBufferStateInternal(BufferObject* pBuffer, eShaderAccessQualifier newState)
+{
+}
+
+void NullRenderContext::BindMaterialFrameBufferConnection(MaterialFrameBufferConnection* pConnectionToBind)
+{
+	H_ASSERT(m_pCurrentCommandBuffer, "No command buffer started.");
+	if (m_currentlyBoundPipeline == pConnectionToBind->m_pMaterialPipeline->m_sortKey)
+		return;
+
+	const bool bRebindTypeDescriptors = m_boundMaterialType != pConnectionToBind->m_pMaterialPipeline->m_type || pConnectionToBind->m_pMaterialPipeline->m_type == eMaterialType::CUSTOM;
+	if (bRebindTypeDescriptors)
+		m_boundMaterialType = pConnectionToBind->m_pMaterialPipeline->m_type;
+
+	m_currentlyBoundPipeline = pConnectionToBind->m_pMaterialPipeline->m_sortKey;
+	m_frameStatistics.pipelineBinds++;
+}
+
+void NullRenderContext::BindComputePipeline(ComputePipeline* pPipelineToBind)
+{
+	H_ASSERT(m_pCurrentCommandBuffer, "No command buffer started.");
+	if (m_currentlyBoundPipeline == pPipelineToBind->m_pMaterialPipeline->m_sortKey)
+		return;
+
+	EndCurrentPass(ComputeShaderStage);
+	m_currentlyBoundPipeline = pPipelineToBind->m_pMaterialPipeline->m_sortKey;
+	m_frameStatistics.pipelineBinds++;
+}
+
+void NullRenderContext::BindVertexBufferInternal()
+{
+}
+
+NullCommandBuffer::NullCommandBuffer(RenderingDevice* pDevice) :
+	CommandBuffer(pDevice)
+{
+}
+
+void NullCommandBuffer::Cleanup(RenderingDevice* pDevice, uint32 frame)
+{
+}
+
+void NullCommandBuffer::BeginBufferInternal()
+{
+}
+
+void NullCommandBuffer::EndBufferInternal()
+{
+	H_ASSERT(m_bIsRecording, "If not recording something has gone wrong.");
+}
+
+void NullRenderContext::NullMaterialFrameBufferConnection::Cleanup(RenderingDevice* pDevice)
+{
+	m_validator = ResourceValidator();
+}
+
+void NullRenderContext::NullComputePipeline::Cleanup(RenderingDevice* pDevice)
+{
+}
+
+void NullRenderContext::NullFrameData::Init(RenderingDevice* pDevice, uint32 frame)
+{
+	for (uint32 iCommandBuffer = 0; iCommandBuffer < (uint32)FrameCommandData::eCommandBuffers::Count; ++iCommandBuffer)
+		m_pCommandBuffers[iCommandBuffer] = new NullCommandBuffer(pDevice);
+}
+
+void NullRenderContext::NullFrameData::CommitCommandBuffer(RenderingDevice* pDevice)
+{
+	H_ASSERT(IsTransfer() || IsGraphics(), "Committing a command buffer that was never started");
+}
+
+void NullRenderContext::NullFrameData::Reset(RenderingDevice* pDevice)
+{
+	m_currentCommandBuffer = FrameCommandData::eCommandBuffers::Count;
+
+	for (uint32 i = 0; i < m_stagingBuffers.Size(); i++)
+	{
+		m_stagingBuffers[i]->CleanupResource(pDevice);
+		SAFEDELETE(m_stagingBuffers[i]);
+	}
+	m_stagingBuffers.RemoveAll();
+}
+
+void NullRenderContext::NullFrameData::Cleanup(RenderingDevice* pDevice, uint32 frame)
+{
+	Reset(pDevice);
+
+	for (uint32 iCommandBuffer = 0; iCommandBuffer < (uint32)FrameCommandData::eCommandBuffers::Count; ++iCommandBuffer)
+	{
+		m_pCommandBuffers[iCommandBuffer]->Cleanup(pDevice, frame);
+		SAFEDELETE(m_pCommandBuffers[iCommandBuffer]);
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Rendering\RenderContext.h"
+
+namespace Hail
+{
+	// What the CPU side of the engine asked the GPU to do, the cost a real backend would have is not simulated.
+	struct NullRenderStatistics
+	{
+		uint64 drawCalls = 0u;
+		uint64 renderedInstances = 0u;
+		uint64 fullscreenPasses = 0u;
+		uint64 renderedLines = 0u;
+		uint64 dispatches = 0u;
+		uint64 meshletDispatches = 0u;
+		uint64 pipelineBinds = 0u;
+		uint64 uploadedBytes = 0u;
+	};
+
+	class NullCommandBuffer : public CommandBuffer
+	{
+	public:
+		explicit NullCommandBuffer(RenderingDevice* pDevice);
+
+		void Cleanup(RenderingDevice* pDevice, uint32 frame) override;
+
+	private:
+		void BeginBufferInternal() override;
+		void EndBufferInternal() override;
+	};
+
+	class NullRenderContext : public RenderContext
+	{
+	public:
+		explicit NullRenderContext(RenderContextStartupParams renderContextStartParams);
+
+		void Cleanup() override;
+
+		void BindMaterialInstance(uint32 materialInstanceIndex) override;
+
+		void UploadDataToBufferInternal(BufferObject* pBuffer, void* pDataToUpload, uint32 sizeOfUploadedData) override;
+		void CopyDataToBufferInternal(BufferObject* pDstBuffer, BufferObject* pSrcBuffer) override;
+		void UploadDataToTextureInternal(TextureResource* pTexture, void* pDataToUpload, uint32 mipLevel) override;
+		void TransferFramebufferLayoutInternal(TextureResource* pTextureToTransfer, eFrameBufferLayoutState sourceState, eFrameBufferLayoutState destinationState) override;
+		void TransferImageStateInternal(TextureResource* pTexture, eShaderAccessQualifier newState, uint32 newStageCombination) override;
+
+		void Dispatch(glm::uvec3 dispatchSize) override;
+		void RenderMeshlets(glm::uvec3 dispatchSize) override;
+		void RenderFullscreenPass() override;
+		void RenderInstances(uint32 numberOfInstances, uint32 offset) override;
+		void RenderDebugLines(uint32 numberOfLinesToRender) override;
+
+		bool BindMaterialInternal(Pipeline* pPipeline) override;
+		bool BindComputePipelineInternal(Pipeline* pPipeline) override;
+		void ClearFrameBufferInternal(FrameBufferTexture* pFrameBuffer) override;
+
+		void SetPushConstantInternal(void* pPushConstant) override;
+
+		void StartFrame() override;
+		void EndCurrentPass(uint32 nextShaderStage) override;
+		void SubmitFinalFrameCommandBuffer() override;
+
+		void TransferBufferStateInternal(BufferObject* pBuffer, eShaderAccessQualifier newState) override;
+
+		// Counts an indexed draw, the null renderer has no vertex input so meshes are only counted.
+		void RecordIndexedDraw(uint32 numberOfIndices);
+
+		const NullRenderStatistics& GetLastFrameStatistics() const { return m_lastFrameStatistics; }
+		const NullRenderStatistics& GetTotalStatistics() const { return m_totalStatistics; }
+
+	private:
+		void BindMaterialFrameBufferConnection(MaterialFrameBufferConnection* connectionToBind) override;
+		void BindComputePipeline(ComputePipeline* pPipelineToBind) override;
+		void BindVertexBufferInternal() override;
+
+		class NullMaterialFrameBufferConnection : public MaterialFrameBufferConnection
+		{
+		public:
+			void Cleanup(RenderingDevice* pDevice) override;
+		};
+
+		class NullComputePipeline : public ComputePipeline
+		{
+		public:
+			void Cleanup(RenderingDevice* pDevice) override;
+		};
+
+		class NullFrameData : public FrameCommandData
+		{
+		public:
+			void Init(RenderingDevice* pDevice, uint32 frame) override;
+			void CommitCommandBuffer(RenderingDevice* pDevice) override;
+			void Cleanup(RenderingDevice* pDevice, uint32 frame) override;
+			void Reset(RenderingDevice* pDevice) override;
+		};
+
+		NullRenderStatistics m_frameStatistics;
+		NullRenderStatistics m_lastFrameStatistics;
+		NullRenderStatistics m_totalStatistics;
+	};
+}
@@ -0,0 +1,223 @@
+#include "Engine_PCH.h"
+#include "NullResourceManagers.h"
+#include "NullResources.h"
+
+#include "Rendering\SwapChain.h"
+
+using namespace Hail;
+
+bool NullRenderingResourceManager::Init(RenderingDevice* renderingDevice, SwapChain* swapChain)
+{
+	m_renderDevice = renderingDevice;
+	m_swapChain = swapChain;
+	return InternalInit();
+}
+
+void NullRenderingResourceManager::ClearAllResources()
+{
+	H_ASSERT(m_renderDevice);
+
+	for (uint32 i = 0; i < (uint32)GlobalSamplers::Count; i++)
+	{
+		m_samplers[i]->CleanupResource(m_renderDevice);
+		SAFEDELETE(m_samplers[i]);
+	}
+
+	for (uint32 iSet = 0; iSet < 2; iSet++)
+	{
+		for (uint32 iBuffer = 0; iBuffer < m_uniformBuffers[iSet].Size(); iBuffer++)
+		{
+			m_uniformBuffers[iSet][iBuffer]->CleanupResource(m_renderDevice);
+			SAFEDELETE(m_uniformBuffers[iSet][iBuffer]);
+		}
+		m_uniformBuffers[iSet].RemoveAll();
+		for (uint32 iBuffer = 0; iBuffer < m_structuredBuffers[iSet].Size(); iBuffer++)
+		{
+			m_structuredBuffers[iSet][iBuffer]->CleanupResource(m_renderDevice);
+			SAFEDELETE(m_structuredBuffers[iSet][iBuffer]);
+		}
+		m_structuredBuffers[iSet].RemoveAll();
+	}
+}
+
+BufferObject* NullRenderingResourceManager::CreateBuffer(BufferProperties properties, const char* name)
+{
+	NullBufferObject* pBuffer = new NullBufferObject();
+	if (pBuffer->Init(m_renderDevice, properties, name))
+		return pBuffer;
+
+	pBuffer->CleanupResource(m_renderDevice);
+	SAFEDELETE(pBuffer);
+	return nullptr;
+}
+
+SamplerObject* NullRenderingResourceManager::CreateSamplerObject(SamplerProperties properties)
+{
+	SamplerObject* pSampler = new NullSamplerObject();
+	pSampler->Init(m_renderDevice, properties);
+	return pSampler;
+}
+
+NullTextureManager::NullTextureManager(RenderingDevice* pDevice) : TextureManager(pDevice)
+{
+}
+
+FrameBufferTexture* NullTextureManager::FrameBufferTexture_Create(String64 name, glm::uvec2 resolution, eTextureFormat format, TEXTURE_DEPTH_FORMAT depthFormat)
+{
+	NullFrameBufferTexture* pFrameBuffer = new NullFrameBufferTexture(resolution, format, depthFormat);
+	pFrameBuffer->SetName(name);
+	pFrameBuffer->CreateFrameBufferTextureObjects(m_device);
+	return pFrameBuffer;
+}
+
+TextureView* NullTextureManager::CreateTextureView()
+{
+	return new NullTextureView();
+}
+
+void NullTextureManager::DeleteImGuiTextureResource(ImGuiTextureResource* textureToDelete)
+{
+	SAFEDELETE(textureToDelete);
+}
+
+TextureResource* NullTextureManager::CreateTextureInternal(const char* name, CompiledTexture& compiledTextureData)
+{
+	NullTextureResource* pTexture = new NullTextureResource();
+	pTexture->textureName = name;
+	pTexture->m_compiledTextureData = compiledTextureData;
+	return pTexture;
+}
+
+TextureResource* NullTextureManager::CreateTextureInternalNoLoad()
+{
+	return new NullTextureResource();
+}
+
+bool NullTextureManager::CreateTextureGPUData(RenderContext* pRenderContext, CompiledTexture& compiledTextureData, TextureResource* pTextureResource)
+{
+	if (compiledTextureData.loadState != TEXTURE_LOADSTATE::LOADED_TO_RAM)
+		return false;
+
+	return pTextureResource->Init(m_device);
+}
+
+void NullTextureManager::ClearTextureInternalForReload(int textureIndex, uint32 frameInFlight)
+{
+	TextureManager::ClearTextureInternalForReload(textureIndex, frameInFlight);
+	m_loadedTextures[textureIndex].m_pTexture->CleanupResourceForReload(m_device, frameInFlight);
+	m_loadedTextures[textureIndex].m_pView->CleanupResource(m_device);
+}
+
+void NullMaterialManager::UpdateCustomPipelineDescriptors(Pipeline* pPipeline, RenderContext* pRenderContext)
+{
+	H_ASSERT(pPipeline, "Must have a valid pipeline");
+	const uint32 frameInFlight = m_swapChain->GetFrameInFlight();
+	if (pPipeline->m_pTypeObject->m_bBoundTypeData[frameInFlight])
+		return;
+
+	H_ASSERT(pPipeline->m_type == eMaterialType::CUSTOM, "Only custom pipelines should use this function");
+}
+
+void NullMaterialManager::BindFrameBuffer(eMaterialType materialType, FrameBufferTexture* frameBufferToBindToMaterial)
+{
+}
+
+bool NullMaterialManager::InitMaterialInternal(Material* pMaterial, uint32 frameInFlight)
+{
+	ResourceValidator& materialDataValidator = pMaterial->m_validator;
+	if (materialDataValidator.GetIsResourceDirty() && !materialDataValidator.GetIsFrameDataDirty(frameInFlight))
+		return false;
+
+	if (materialDataValidator.GetFrameThatMarkedFrameDirty() == frameInFlight)
+	{
+		if (!CreateMaterialTypeObject(pMaterial->m_pPipeline))
+			return false;
+	}
+
+	Pipeline* pPipeline = pMaterial->m_pPipeline;
+	MaterialTypeObject* pTypeObject = pPipeline->m_bUseTypePasses ? m_MaterialTypeObjects[(uint32)pPipeline->m_type] : pPipeline->m_pTypeObject;
+	pTypeObject->m_bBoundTypeData[frameInFlight] = true;
+
+	materialDataValidator.ClearFrameData(frameInFlight);
+	return true;
+}
+
+bool NullMaterialManager::InitMaterialPipelineInternal(MaterialPipeline* pMaterialPipeline, uint32 frameInFlight)
+{
+	ResourceValidator& materialDataValidator = pMaterialPipeline->m_validator;
+	if (materialDataValidator.GetIsResourceDirty() && !materialDataValidator.GetIsFrameDataDirty(frameInFlight))
+	{
+		H_ASSERT(false, "validator is in a broken state");
+		return false;
+	}
+
+	if (materialDataValidator.GetFrameThatMarkedFrameDirty() == frameInFlight)
+	{
+		if (!CreateMaterialTypeObject(pMaterialPipeline->m_pPipeline))
+		{
+			H_ASSERT(false, "Failed to create pipeline");
+			return false;
+		}
+	}
+
+	materialDataValidator.ClearFrameData(frameInFlight);
+	return true;
+}
+
+bool NullMaterialManager::InitMaterialInstanceInternal(MaterialInstance& instance, uint32 frameInFlight, bool isDefaultMaterialInstance)
+{
+	NullMaterial* pMaterial = (NullMaterial*)m_materials[(uint8)instance.m_materialType][instance.m_materialIndex];
+
+	ResourceValidator& validator = isDefaultMaterialInstance ? GetDefaultMaterialValidator(instance.m_materialType) : m_materialsInstanceValidationData[instance.m_instanceIdentifier];
+	if (validator.GetFrameThatMarkedFrameDirty() == frameInFlight)
+		instance.m_gpuResourceInstance = pMaterial->m_numberOfInstances++;
+
+	return true;
+}
+
+void NullMaterialManager::ClearMaterialInternal(Material* pMaterial, uint32 frameInFlight)
+{
+	pMaterial->m_validator.MarkResourceAsDirty(frameInFlight);
+	if (pMaterial->m_validator.GetFrameThatMarkedFrameDirty() == frameInFlight)
+		pMaterial->CleanupResource(*m_renderDevice);
+}
+
+Material* NullMaterialManager::CreateUnderlyingMaterial()
+{
+	Material* pMaterial = new NullMaterial();
+	pMaterial->m_pPipeline = CreateUnderlyingPipeline();
+	return pMaterial;
+}
+
+MaterialPipeline* NullMaterialManager::CreateUnderlyingMaterialPipeline()
+{
+	MaterialPipeline* pMaterialPipeline = new NullMaterialPipeline();
+	pMaterialPipeline->m_pPipeline = CreateUnderlyingPipeline();
+	return pMaterialPipeline;
+}
+
+Pipeline* NullMaterialManager::CreateUnderlyingPipeline()
+{
+	return new NullPipeline();
+}
+
+bool NullMaterialManager::CreateMaterialTypeObject(Pipeline* pPipeline)
+{
+	if (pPipeline->m_bUseTypePasses && m_MaterialTypeObjects[(uint32)pPipeline->m_type])
+	{
+		pPipeline->m_pTypeObject = m_MaterialTypeObjects[(uint32)pPipeline->m_type];
+		return true;
+	}
+
+	if (pPipeline->m_pShaders[0]->loadState != eShaderLoadState::LoadedToRAM)
+		return false;
+
+	MaterialTypeObject** pTypeObjectToCreate = pPipeline->m_bUseTypePasses ? &m_MaterialTypeObjects[(uint32)pPipeline->m_type] : &pPipeline->m_pTypeObject;
+	(*pTypeObjectToCreate) = new NullMaterialTypeObject();
+	(*pTypeObjectToCreate)->m_type = pPipeline->m_type;
+	// One binding list per shader, the context validates bound resources against them.
+	for (uint32 i = 0; i < pPipeline->m_pShaders.Size(); i++)
+		(*pTypeObjectToCreate)->m_boundResources.Add();
+
+	return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Resources\RenderingResourceManager.h"
+#include "Resources\TextureManager.h"
+#include "Resources\MaterialManager.h"
+
+namespace Hail
+{
+	class NullRenderingResourceManager : public RenderingResourceManager
+	{
+	public:
+		bool Init(RenderingDevice* renderingDevice, SwapChain* swapChain) override;
+		void ClearAllResources() override;
+
+		void* GetRenderingResources() override { return nullptr; }
+
+		BufferObject* CreateBuffer(BufferProperties properties, const char* name) override;
+		SamplerObject* CreateSamplerObject(SamplerProperties properties) override;
+	};
+
+	class NullTextureManager : public TextureManager
+	{
+	public:
+		explicit NullTextureManager(RenderingDevice* pDevice);
+
+		FrameBufferTexture* FrameBufferTexture_Create(String64 name, glm::uvec2 resolution, eTextureFormat format, TEXTURE_DEPTH_FORMAT depthFormat) override;
+		TextureView* CreateTextureView() override;
+
+		// ImGui is never initialized in headless mode.
+		ImGuiTextureResource* CreateImGuiTextureResource(RenderContext* pRenderContext, const FilePath& filepath, RenderingResourceManager* renderingResourceManager, TextureProperties* headerToFill) override { return nullptr; }
+		void DeleteImGuiTextureResource(ImGuiTextureResource* textureToDelete) override;
+
+	private:
+		TextureResource* CreateTextureInternal(const char* name, CompiledTexture& compiledTextureData) override;
+		TextureResource* CreateTextureInternalNoLoad() override;
+		bool CreateTextureGPUData(RenderContext* pRenderContext, CompiledTexture& compiledTextureData, TextureResource* pTextureResource) override;
+
+		void ClearTextureInternalForReload(int textureIndex, uint32 frameInFlight) override;
+	};
+
+	class NullMaterialManager : public MaterialManager
+	{
+	private:
+		void UpdateCustomPipelineDescriptors(Pipeline* pPipeline, RenderContext* pRenderContext) override;
+
+		void BindFrameBuffer(eMaterialType materialType, FrameBufferTexture* frameBufferToBindToMaterial) override;
+		bool InitMaterialInternal(Material* pMaterial, uint32 frameInFlight) override;
+		bool InitMaterialPipelineInternal(MaterialPipeline* pMaterialPipeline, uint32 frameInFlight) override;
+		bool InitMaterialInstanceInternal(MaterialInstance& instance, uint32 frameInFlight, bool isDefaultMaterialInstance) override;
+		void ClearMaterialInternal(Material* pMaterial, uint32 frameInFlight) override;
+		Material* CreateUnderlyingMaterial() override;
+		MaterialPipeline* CreateUnderlyingMaterialPipeline() override;
+		Pipeline* CreateUnderlyingPipeline() override;
+		bool CreateMaterialTypeObject(Pipeline* pPipeline) override;
+	};
+}
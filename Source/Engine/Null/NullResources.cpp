@@ -0,0 +1,188 @@
+#include "Engine_PCH.h"
+#include "NullResources.h"
+
+using namespace Hail;
+
+void NullDevice::CreateInstance(ErrorManager* pErrorManager)
+{
+	// Common desktop limits, so compute shaders are validated the same way as on a GPU.
+	m_deviceLimits.m_maxComputeWorkGroupInvocations = 1024u;
+	m_deviceLimits.m_maxComputeSharedMemorySize = 32768u;
+}
+
+void NullDevice::DestroyDevice()
+{
+}
+
+NullSwapChain::NullSwapChain(TextureManager* pTextureManager) : SwapChain(pTextureManager)
+{
+	m_pFrameBufferTexture = new NullFrameBufferTexture(glm::uvec2(0u, 0u));
+}
+
+void NullSwapChain::Init(RenderingDevice* renderDevice)
+{
+	CalculateRenderResolution();
+	m_pFrameBufferTexture->SetName("SwapchainFrameBuffer");
+	m_pFrameBufferTexture->SetTextureFormat(eTextureFormat::B8G8R8A8_SRGB);
+	m_pFrameBufferTexture->SetResolution(m_windowResolution);
+	m_pFrameBufferTexture->CreateFrameBufferTextureObjects(renderDevice);
+	m_bResizeSwapChain = false;
+}
+
+void NullSwapChain::DestroySwapChain(RenderingDevice* renderDevice)
+{
+	if (m_pFrameBufferTexture)
+		m_pFrameBufferTexture->ClearResources(renderDevice, true);
+	SAFEDELETE(m_pFrameBufferTexture);
+	SwapChain::DestroySwapChain(renderDevice);
+}
+
+void NullSwapChain::FrameStart()
+{
+	if (m_bResizeSwapChain)
+	{
+		CalculateRenderResolution();
+		m_pFrameBufferTexture->ClearResources(nullptr, true);
+		m_pFrameBufferTexture->SetResolution(m_windowResolution);
+		m_pFrameBufferTexture->CreateFrameBufferTextureObjects(nullptr);
+		m_bResizeSwapChain = false;
+	}
+}
+
+void NullSwapChain::FrameEnd()
+{
+	m_currentFrame = (m_currentFrame + 1) % MAX_FRAMESINFLIGHT;
+}
+
+void NullBufferObject::CleanupResource(RenderingDevice* device)
+{
+	for (uint32 i = 0; i < MAX_FRAMESINFLIGHT; i++)
+		SAFEDELETE_ARRAY(m_pData[i]);
+}
+
+bool NullBufferObject::UsesPersistentMapping(RenderingDevice* device, uint32 frameInFlight)
+{
+	return m_properties.domain == eShaderBufferDomain::CpuToGpu || m_properties.domain == eShaderBufferDomain::GpuToCpu;
+}
+
+bool NullBufferObject::InternalInit(RenderingDevice* pDevice)
+{
+	const uint32 numberOfCopies = m_bUsesFramesInFlight ? MAX_FRAMESINFLIGHT : 1u;
+	for (uint32 i = 0; i < numberOfCopies; i++)
+	{
+		m_pData[i] = new uint8[GetBufferSize()];
+		memset(m_pData[i], 0, GetBufferSize());
+	}
+	return true;
+}
+
+void NullSamplerObject::Init(RenderingDevice* pDevice, SamplerProperties props)
+{
+	m_props = props;
+}
+
+void NullSamplerObject::CleanupResource(RenderingDevice* pDevice)
+{
+}
+
+void NullTextureResource::CleanupResource(RenderingDevice* device)
+{
+	m_byteSize = 0u;
+}
+
+void NullTextureResource::CleanupResourceForReload(RenderingDevice* device, uint32 frameInFligth)
+{
+	m_validator.MarkResourceAsDirty(frameInFligth);
+	if (m_validator.GetFrameThatMarkedFrameDirty() == frameInFligth)
+		CleanupResource(device);
+}
+
+bool NullTextureResource::InternalInit(RenderingDevice* pDevice)
+{
+	m_byteSize = GetTextureByteSize(m_properties);
+	return true;
+}
+
+void NullTextureView::CleanupResource(RenderingDevice* pDevice)
+{
+	m_textureIndex = MAX_UINT;
+}
+
+bool NullTextureView::InitView(RenderingDevice* pDevice, TextureViewProperties properties)
+{
+	H_ASSERT(properties.pTextureToView, "A view needs a texture to view");
+	m_props = properties;
+	m_textureIndex = properties.pTextureToView->m_index;
+	return true;
+}
+
+NullFrameBufferTexture::NullFrameBufferTexture(glm::uvec2 resolution, eTextureFormat format, TEXTURE_DEPTH_FORMAT depthFormat) :
+	FrameBufferTexture(resolution, format, depthFormat)
+{
+}
+
+void NullFrameBufferTexture::CreateFrameBufferTextureObjects(RenderingDevice* device)
+{
+	if (m_textureFormat != eTextureFormat::UNDEFINED)
+		CreateTextureResources(true, device);
+	if (m_depthFormat != TEXTURE_DEPTH_FORMAT::UNDEFINED)
+		CreateTextureResources(false, device);
+}
+
+void NullFrameBufferTexture::CreateTextureResources(bool bIsColorTexture, RenderingDevice* device)
+{
+	TextureProperties props{};
+	props.width = m_resolution.x;
+	props.height = m_resolution.y;
+	props.format = m_textureFormat;
+	props.depthFormat = bIsColorTexture ? TEXTURE_DEPTH_FORMAT::UNDEFINED : m_depthFormat;
+	props.textureUsage = bIsColorTexture ? eTextureUsage::FramebufferColor : eTextureUsage::FramebufferDepthOnly;
+
+	for (uint32 i = 0; i < MAX_FRAMESINFLIGHT; i++)
+	{
+		NullTextureResource* pTexture = new NullTextureResource();
+		pTexture->textureName = m_bufferName;
+		pTexture->m_properties = props;
+		pTexture->m_index = MAX_UINT - 2;
+		H_ASSERT(pTexture->Init(device), "Failed creating frame buffer texture");
+
+		NullTextureView* pView = new NullTextureView();
+		TextureViewProperties viewProps{};
+		viewProps.viewUsage = props.textureUsage;
+		viewProps.pTextureToView = pTexture;
+		viewProps.accessQualifier = eShaderAccessQualifier::ReadOnly;
+		pView->InitView(device, viewProps);
+
+		if (bIsColorTexture)
+		{
+			m_pTextureResource[i] = pTexture;
+			m_pTextureViews[i] = pView;
+		}
+		else
+		{
+			m_pDepthTextureResource[i] = pTexture;
+			m_pDepthTextureViews[i] = pView;
+		}
+	}
+}
+
+void NullMaterialTypeObject::CleanupResource(RenderingDevice& device)
+{
+}
+
+void NullPipeline::CleanupResource(RenderingDevice& device)
+{
+	if (m_pTypeObject && !m_bUseTypePasses)
+		m_pTypeObject->CleanupResource(device);
+}
+
+void NullMaterial::CleanupResource(RenderingDevice& device)
+{
+	m_numberOfInstances = 0u;
+	m_pPipeline->CleanupResource(device);
+}
+
+void NullMaterialPipeline::CleanupResource(RenderingDevice& device)
+{
+	m_pPipeline->CleanupResource(device);
+}
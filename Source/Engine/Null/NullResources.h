@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Rendering\RenderDevice.h"
+#include "Rendering\SwapChain.h"
+#include "Rendering\FrameBufferTexture.h"
+#include "Resources\BufferResource.h"
+#include "Resources\TextureResource.h"
+#include "Resources\MaterialResources.h"
+
+// GPU resources of the headless backend, everything is tracked on the CPU and nothing is sent to a GPU.
+namespace Hail
+{
+	class NullDevice : public RenderingDevice
+	{
+	public:
+		void CreateInstance(ErrorManager* pErrorManager) override;
+		void DestroyDevice() override;
+	};
+
+	class NullSwapChain : public SwapChain
+	{
+	public:
+		explicit NullSwapChain(TextureManager* pTextureManager);
+		void Init(RenderingDevice* renderDevice) override;
+		void DestroySwapChain(RenderingDevice* renderDevice) override;
+		TextureView* GetSwapchainView() override { return nullptr; }
+		uint32 GetFrameInFlight() override { return m_currentFrame; }
+
+		void FrameStart();
+		void FrameEnd();
+
+	private:
+		uint32 m_currentFrame = 0;
+	};
+
+	// Keeps a CPU copy of the buffer data for each frame in flight so uploads cost what a memcpy to mapped memory would.
+	class NullBufferObject : public BufferObject
+	{
+	public:
+		void CleanupResource(RenderingDevice* device) override;
+		bool UsesPersistentMapping(RenderingDevice* device, uint32 frameInFlight) override;
+
+		uint8* GetData(uint32 frameInFlight) { return m_pData[m_bUsesFramesInFlight ? frameInFlight : 0]; }
+
+	private:
+		bool InternalInit(RenderingDevice* pDevice) override;
+
+		uint8* m_pData[MAX_FRAMESINFLIGHT] = { nullptr, nullptr };
+	};
+
+	class NullSamplerObject : public SamplerObject
+	{
+	public:
+		void Init(RenderingDevice* pDevice, SamplerProperties props) override;
+		void CleanupResource(RenderingDevice* pDevice) override;
+	};
+
+	class NullTextureResource : public TextureResource
+	{
+	public:
+		void CleanupResource(RenderingDevice* device) override;
+		void CleanupResourceForReload(RenderingDevice* device, uint32 frameInFligth) override;
+		uint32 GetCurrentStageUsage() override { return m_currentStageUsage; }
+
+		uint32 GetByteSize() const { return m_byteSize; }
+
+	private:
+		friend class NullRenderContext;
+		bool InternalInit(RenderingDevice* pDevice) override;
+
+		uint32 m_currentStageUsage = 0u;
+		// The size the texture would occupy on the GPU, no memory is allocated for it.
+		uint32 m_byteSize = 0u;
+	};
+
+	class NullTextureView : public TextureView
+	{
+	public:
+		void CleanupResource(RenderingDevice* pDevice) override;
+		bool InitView(RenderingDevice* pDevice, TextureViewProperties properties) override;
+	};
+
+	class NullImGuiTextureResource : public ImGuiTextureResource
+	{
+	public:
+		void* GetImguiTextureResource() final { return nullptr; }
+	};
+
+	class NullFrameBufferTexture : public FrameBufferTexture
+	{
+	public:
+		explicit NullFrameBufferTexture(glm::uvec2 resolution, eTextureFormat format = eTextureFormat::UNDEFINED, TEXTURE_DEPTH_FORMAT depthFormat = TEXTURE_DEPTH_FORMAT::UNDEFINED);
+
+		void CreateFrameBufferTextureObjects(RenderingDevice* device) override;
+
+	protected:
+		void CreateTextureResources(bool bIsColorTexture, RenderingDevice* device) override;
+	};
+
+	class NullMaterialTypeObject : public MaterialTypeObject
+	{
+	public:
+		void CleanupResource(RenderingDevice& device) override;
+	};
+
+	class NullPipeline : public Pipeline
+	{
+	public:
+		void CleanupResource(RenderingDevice& device) override;
+	};
+
+	class NullMaterial : public Material
+	{
+	public:
+		void CleanupResource(RenderingDevice& device) override;
+
+		// Stand in for the instance descriptor sets, the index of an instance is its m_gpuResourceInstance.
+		uint32 m_numberOfInstances = 0u;
+	};
+
+	class NullMaterialPipeline : public MaterialPipeline
+	{
+	public:
+		void CleanupResource(RenderingDevice& device) override;
+	};
+}
@@ -0,0 +1,34 @@
+#include "Engine_PCH.h"
+#include "Null_ApplicationWindow.h"
+
+bool Hail::Null_ApplicationWindow::Init(StartupAttributes startupData, Hail::InputHandler* inputHandler)
+{
+	const glm::uvec2 resolution = ResolutionFromEnum(startupData.startupWindowResolution);
+	m_windowSize = resolution;
+	m_frameBufferSize = resolution;
+	m_previousSize = resolution;
+	return true;
+}
+
+void Hail::Null_ApplicationWindow::SetApplicationSettings(Hail::ApplicationMessage message)
+{
+}
+
+void Hail::Null_ApplicationWindow::ApplicationUpdateLoop()
+{
+}
+
+glm::uvec2 Hail::Null_ApplicationWindow::GetWindowResolution()
+{
+	return m_windowSize;
+}
+
+glm::uvec2 Hail::Null_ApplicationWindow::GetWindowPosition()
+{
+	return glm::uvec2();
+}
+
+glm::uvec2 Hail::Null_ApplicationWindow::GetMonitorResolution()
+{
+	return m_windowSize;
+}
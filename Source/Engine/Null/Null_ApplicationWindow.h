@@ -0,0 +1,20 @@
+#pragma once
+#include "ApplicationWindow.h"
+
+namespace Hail
+{
+	// Window without an OS window behind it, only keeps the requested resolution.
+	class Null_ApplicationWindow : public ApplicationWindow
+	{
+	public:
+		bool Init(StartupAttributes startupData, Hail::InputHandler* inputHandler) final;
+
+		void SetApplicationSettings(Hail::ApplicationMessage message) final;
+
+		void ApplicationUpdateLoop() final;
+
+		glm::uvec2 GetWindowResolution() final;
+		glm::uvec2 GetWindowPosition() final;
+		glm::uvec2 GetMonitorResolution() final;
+	};
+}
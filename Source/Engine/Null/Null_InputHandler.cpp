@@ -0,0 +1,128 @@
+#include "Engine_PCH.h"
+#include "Null_InputHandler.h"
+
+using namespace Hail;
+
+Null_Gamepad::Null_Gamepad(int index) : Gamepad(index)
+{
+}
+
+void Null_Gamepad::Update()
+{
+}
+
+bool Null_Gamepad::GetControllerState()
+{
+	return false;
+}
+
+bool Null_Gamepad::Connected()
+{
+	return false;
+}
+
+void Null_InputHandler::InitInputMapping()
+{
+	// Same key codes as the Windows input handler, so recordings made on Windows replay identically.
+	m_inputMapping.Q = 0x51;
+	m_inputMapping.W = 0x57;
+	m_inputMapping.E = 0x45;
+	m_inputMapping.R = 0x52;
+	m_inputMapping.T = 0x54;
+	m_inputMapping.Y = 0x59;
+	m_inputMapping.U = 0x55;
+	m_inputMapping.I = 0x49;
+	m_inputMapping.O = 0x4F;
+	m_inputMapping.P = 0x50;
+	m_inputMapping.A = 0x41;
+	m_inputMapping.S = 0x53;
+	m_inputMapping.D = 0x44;
+	m_inputMapping.F = 0x46;
+	m_inputMapping.G = 0x47;
+	m_inputMapping.H = 0x48;
+	m_inputMapping.J = 0x4A;
+	m_inputMapping.K = 0x4B;
+	m_inputMapping.L = 0x4C;
+	m_inputMapping.Z = 0x5A;
+	m_inputMapping.X = 0x58;
+	m_inputMapping.C = 0x43;
+	m_inputMapping.V = 0x56;
+	m_inputMapping.B = 0x42;
+	m_inputMapping.N = 0x4E;
+	m_inputMapping.M = 0x4D;
+
+	m_inputMapping.CTRL = 0x11;
+	m_inputMapping.SHFT = 0x10;
+	m_inputMapping.TAB = 0x09;
+	m_inputMapping.ESC = 0x1B;
+	m_inputMapping.ALT = 0x12;
+	m_inputMapping.SPACE = 0x20;
+	m_inputMapping.ENTER = 0x0D;
+	m_inputMapping.BKSPC = 0x08;
+	m_inputMapping.DEL = 0x2E;
+	m_inputMapping.INS = 0x2D;
+	m_inputMapping.END = 0x23;
+	m_inputMapping.HME = 0x24;
+	m_inputMapping.PGUP = 0x21;
+	m_inputMapping.PGDN = 0x22;
+	m_inputMapping.PRTSC = 0x2A;
+
+	m_inputMapping.F1 = 0x70;
+	m_inputMapping.F2 = 0x71;
+	m_inputMapping.F3 = 0x72;
+	m_inputMapping.F4 = 0x73;
+	m_inputMapping.F5 = 0x74;
+	m_inputMapping.F6 = 0x75;
+	m_inputMapping.F7 = 0x76;
+	m_inputMapping.F8 = 0x77;
+	m_inputMapping.F9 = 0x78;
+	m_inputMapping.F10 = 0x79;
+	m_inputMapping.F11 = 0x7A;
+	m_inputMapping.F12 = 0x7B;
+	m_inputMapping.F13 = 0x7C;
+	m_inputMapping.F14 = 0x7D;
+	m_inputMapping.F15 = 0x7E;
+	m_inputMapping.F16 = 0x7F;
+	m_inputMapping.F17 = 0x80;
+	m_inputMapping.F18 = 0x81;
+	m_inputMapping.F19 = 0x82;
+	m_inputMapping.F20 = 0x83;
+	m_inputMapping.F21 = 0x84;
+	m_inputMapping.F22 = 0x85;
+	m_inputMapping.F23 = 0x86;
+	m_inputMapping.F24 = 0x87;
+
+	m_inputMapping.NMB_1 = 0x61;
+	m_inputMapping.NMB_2 = 0x62;
+	m_inputMapping.NMB_3 = 0x63;
+	m_inputMapping.NMB_4 = 0x64;
+	m_inputMapping.NMB_5 = 0x65;
+	m_inputMapping.NMB_6 = 0x66;
+	m_inputMapping.NMB_7 = 0x67;
+	m_inputMapping.NMB_8 = 0x68;
+	m_inputMapping.NMB_9 = 0x69;
+	m_inputMapping.NMB_0 = 0x60;
+
+	m_inputMapping.COMMA = 0x6C;
+	m_inputMapping.ADD = 0x6B;
+	m_inputMapping.SUBTRACT = 0x6D;
+	m_inputMapping.DIVIDE = 0x6F;
+	m_inputMapping.DOT = 0x6E;
+
+	for (int i = 0; i < 4; i++)
+		m_pGamepads[i] = new Null_Gamepad(i);
+}
+
+void Null_InputHandler::ShowCursor(bool visibilityState) const
+{
+}
+
+void Null_InputHandler::SetMousePos(glm::uvec2 windowPosition)
+{
+	if (m_cursorLock) return;
+	m_inputMap.mouse.mousePos = windowPosition;
+}
+
+void Null_InputHandler::LockMouseToWindow(bool lockMouse)
+{
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Input/InputHandler.h"
+
+namespace Hail
+{
+	// Never connected, its state only changes when an input recording is replayed.
+	class Null_Gamepad final : public Gamepad
+	{
+	public:
+		explicit Null_Gamepad(int index);
+		void Update() final;
+
+		bool GetControllerState() final;
+		bool Connected() final;
+	};
+
+	// Input handler without an OS behind it, input only comes from replaying an input recording.
+	class Null_InputHandler : public InputHandler
+	{
+	public:
+		Null_InputHandler() = default;
+		void InitInputMapping() final;
+
+		void ShowCursor(bool visibilityState) const override;
+		void SetMousePos(glm::uvec2 windowPosition) override;
+		void LockMouseToWindow(bool lockMouse) override;
+	};
+}
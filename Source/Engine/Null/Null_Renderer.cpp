@@ -0,0 +1,76 @@
+#include "Engine_PCH.h"
+#include "Null_Renderer.h"
+
+#include "NullResources.h"
+#include "Resources\ResourceManager.h"
+#include "Resources\BufferResource.h"
+#include "Timer.h"
+
+#include <stdio.h>
+
+using namespace Hail;
+
+void NullRenderer::InitDevice(Timer* pTimer, ErrorManager* pErrorManager)
+{
+	m_timer = pTimer;
+	m_renderDevice = new NullDevice();
+	m_renderDevice->CreateInstance(pErrorManager);
+}
+
+void NullRenderer::InitGraphicsEngineAndContext(ResourceManager* resourceManager, ErrorManager* pErrorManager)
+{
+	m_pResourceManager = resourceManager;
+	RenderContextStartupParams contextStartUpParams{};
+	contextStartUpParams.pDevice = m_renderDevice;
+	contextStartUpParams.pResourceManager = m_pResourceManager;
+	contextStartUpParams.pErrorManager = pErrorManager;
+
+	m_pContext = new NullRenderContext(contextStartUpParams);
+}
+
+void NullRenderer::RenderMesh(const RenderData_Mesh& meshCommandToRender, uint32_t meshInstance)
+{
+	// The model material is bound by Render before any mesh is drawn.
+	NullRenderContext* pNullContext = (NullRenderContext*)m_pContext;
+	pNullContext->BindMaterialInstance(0);
+	pNullContext->RecordIndexedDraw(m_pResourceManager->m_unitCube.indices.Size());
+}
+
+const NullRenderStatistics& NullRenderer::GetStatistics() const
+{
+	return ((NullRenderContext*)m_pContext)->GetTotalStatistics();
+}
+
+void NullRenderer::Cleanup()
+{
+	Renderer::Cleanup();
+
+	if (!m_renderDevice)
+		return;
+
+	// Printed in every configuration so benchmark runs can be read from the console output.
+	const NullRenderStatistics& statistics = GetStatistics();
+	const uint64 numberOfFrames = m_pContext->GetCurrentRenderFrame();
+	printf("Headless run: %llu frames in %.3f s\n", numberOfFrames, m_timer->GetTotalTime());
+	printf("  draw calls: %llu, instances: %llu, fullscreen passes: %llu, lines: %llu\n",
+		statistics.drawCalls, statistics.renderedInstances, statistics.fullscreenPasses, statistics.renderedLines);
+	printf("  dispatches: %llu, meshlet dispatches: %llu, pipeline binds: %llu, uploaded bytes: %llu\n",
+		statistics.dispatches, statistics.meshletDispatches, statistics.pipelineBinds, statistics.uploadedBytes);
+
+	m_pContext->Cleanup();
+	m_pResourceManager->ClearAllResources(m_renderDevice);
+
+	if (m_pSpriteVertexBuffer)
+		m_pSpriteVertexBuffer->CleanupResource(m_renderDevice);
+	if (m_pVertexBuffer)
+		m_pVertexBuffer->CleanupResource(m_renderDevice);
+	if (m_pIndexBuffer)
+		m_pIndexBuffer->CleanupResource(m_renderDevice);
+	SAFEDELETE(m_pSpriteVertexBuffer);
+	SAFEDELETE(m_pVertexBuffer);
+	SAFEDELETE(m_pIndexBuffer);
+	SAFEDELETE(m_pContext);
+
+	m_renderDevice->DestroyDevice();
+	SAFEDELETE(m_renderDevice);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "Renderer.h"
+#include "NullRenderContext.h"
+
+namespace Hail
+{
+	// Runs the full CPU side of the renderer without a GPU or a window, used for headless runs and benchmarks.
+	class NullRenderer : public Renderer
+	{
+	public:
+		void InitDevice(Timer* pTimer, ErrorManager* pErrorManager) override;
+		void InitGraphicsEngineAndContext(ResourceManager* resourceManager, ErrorManager* pErrorManager) override;
+		void Cleanup() override;
+		void InitImGui() override {}
+		void WaitForGPU() override {}
+
+		void RenderMesh(const RenderData_Mesh& meshCommandToRender, uint32_t meshInstance) override;
+		void RenderImGui() override {}
+
+		const NullRenderStatistics& GetStatistics() const;
+	};
+}
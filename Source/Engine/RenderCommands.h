@@ -54,7 +54,7 @@ namespace Hail
 	
 	struct RenderData_Text
 	{
-		StringLW text; // TODO: kolla hur jag sparar strngen, kanske ha en stor strng pool bara fr text commands, som r en circular buffer
+		TextSpan text; // Span in to the text arena of the pool
 		uint16 textSize;
 	};
 
@@ -90,10 +90,12 @@ namespace Hail
 		VectorOnStack<RenderCommand2DBase, MAX_NUMBER_OF_2D_RENDER_COMMANDS, false> m_2DRenderCommands;
 		VectorOnStack<RenderData_Sprite, MAX_NUMBER_OF_SPRITES, false> m_spriteData;
 		VectorOnStack<RenderData_Text, MAX_NUMBER_OF_TEXT_COMMANDS, false> m_textData;
+		TextArena m_textArena;
 		VectorOnStack<RenderData_Mesh, 128, false> m_meshData;
 		// TODO: define out for debug
 		VectorOnStack<DebugLineCommand, MAX_NUMBER_OF_DEBUG_LINES / 2, false> m_debugLineCommands;
 		VectorOnStack<DebugCircle, MAX_NUMBER_OF_DEBUG_CIRCLES, false> m_debugCircles;
+		CullingStats2D m_cullingStats2D;
 
 	};
 
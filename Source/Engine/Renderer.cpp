@@ -1,5 +1,7 @@
 #include "Engine_PCH.h"
 #include "Renderer.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 #include "DebugMacros.h"
 #include "RenderCommands.h"
 #include "Resources\ResourceManager.h"
@@ -54,6 +56,8 @@ void Hail::Renderer::StartFrame(RenderStartFrameParams startParams)
 
 void Hail::Renderer::Prepare()
 {
+	H_PROFILE_FUNCTION();
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Rendering);
 	H_ASSERT(m_commandPoolToRender);
 	m_pResourceManager->ReloadResources();
 	m_pResourceManager->UpdateRenderBuffers(*m_commandPoolToRender, m_pContext, m_timer);
@@ -74,6 +78,8 @@ void Hail::Renderer::EndFrame()
 
 void Hail::Renderer::Render()
 {
+	H_PROFILE_FUNCTION();
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Rendering);
 	m_pContext->StartGraphicsPass();
 	m_pContext->TransferFramebufferLayout(m_pResourceManager->GetMainPassFBTexture(), eFrameBufferLayoutState::ColorAttachment, eFrameBufferLayoutState::DepthAttachment);
 	m_pContext->BindFrameBufferAtSlot(m_pResourceManager->GetMainPassFBTexture(), 0);
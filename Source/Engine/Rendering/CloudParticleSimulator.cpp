@@ -5,13 +5,10 @@
 #include "Timer.h"
 #include "Utility\DebugLineHelpers.h"
 #include "RenderCommands.h"
+#include "Profiler.h"
 
-#include "Utility\Sorting.h"
 #include "Input\InputHandler.h"
 
-
-#include "Containers\StaticArray\StaticArray.h"
-
 #include "imgui.h"
 
 namespace Hail
@@ -105,34 +102,6 @@ namespace Hail
 		return r * glm::vec2(cos(theta), sin(theta));
 	}
 
-	const int32 HASH_SIZE = 0xffff;
-	const float L = 0.2f;
-
-	inline uint32 hasha(glm::ivec2& p) {
-		int ix = (unsigned int)((p[0] + 2.f) / L);
-		int iy = (unsigned int)((p[1] + 2.f) / L);
-		return (unsigned int)((ix * 73856093) ^ (iy * 19349663)) % HASH_SIZE;
-	}
-
-	glm::ivec2 PositionToCellCoord(glm::vec2 positionToCheck, float hRadius)
-	{
-		glm::vec2 worldCenter = glm::vec2(0.5f) * spaceModifier;
-		glm::vec2 adjustedCenter = positionToCheck - worldCenter;
-
-		return adjustedCenter / hRadius;
-	}
-
-	uint32 GenerateKeyFromCellPos(glm::ivec2 cellCoord, uint32 listMaxLength)
-	{
-		return hasha(cellCoord) % listMaxLength;
-	}
-
-	uint32 ComputeParticleKeyLookup(const CloudParticle& cloudParticle, uint32 listMaxLength, float hRadius)
-	{
-		glm::ivec2 cellCoord = PositionToCellCoord(cloudParticle.pos, hRadius);
-		return GenerateKeyFromCellPos(cellCoord, listMaxLength);
-	}
-
 	glm::ivec2 ParticlePosToSdfCoords(glm::vec2 particlePosition)
 	{
 		glm::vec2 normalizedParticlePos = particlePosition / spaceModifier;
@@ -274,7 +243,7 @@ namespace Hail
 		ImGui::SliderFloat("Particle Radius", &m_particleKernelRadius, 0.1f, 5.f);
 		h = m_particleKernelRadius;
 		float mass = m_mass;
-		UpdatePartialLookupList(particlesToSimulate, h);
+		UpdateParticleTree(particlesToSimulate);
 		UpdateParticlesBasedOnPaper(particlesToSimulate, h, resolution, dt, distanceField);
 
 		ImGui::Text("Particle density: %f", particlesToSimulate[m_particleToDebug].densityNearDensity.x);
@@ -324,49 +293,24 @@ namespace Hail
 		}
 	}
 
-	StaticArray<glm::ivec2, 9> cellOffsets = {
-		{-1, -1},
-		{0, -1},
-		{1, -1},
-		{-1, 0},
-		{0, 0},
-		{1, 0},
-		{-1, 1},
-		{0, 1},
-		{1, 1}
-	};
-
-	void CloudParticleSimulator::UpdatePartialLookupList(GrowingArray<CloudParticle>& cloudParticles, float hRadius)
+	void CloudParticleSimulator::UpdateParticleTree(GrowingArray<CloudParticle>& cloudParticles)
 	{
+		H_PROFILE_FUNCTION();
 		const uint32 numberOfParticles = m_numberOfParticles;
-		m_particleSpatialLookup.RemoveAll();
-		m_particleSpatialLookup.PrepareAndFill(m_particleGridSize);
-		m_particleSpatialLookupStartIndices.PrepareAndFill(m_particleGridSize);
+		m_particlePositions.PrepareAndFill(numberOfParticles);
 		for (uint32 i = 0; i < numberOfParticles; i++)
-		{
-			uint32 key = ComputeParticleKeyLookup(cloudParticles[i], m_particleGridSize, hRadius);
-			m_particleSpatialLookup[i] = (SpatialIndexLookup{ key, i });
-		}
-		for (uint32 i = 0; i < m_particleGridSize; i++)
-		{
-			m_particleSpatialLookupStartIndices[i] = MAX_UINT;
-		}
+			m_particlePositions[i] = cloudParticles[i].pos;
+		m_particleTree.Build(m_particlePositions.Data(), numberOfParticles);
+	}
 
-		SpatialIndexLookup* lookupStart = m_particleSpatialLookup.Data();
-		Sorting::LinearBubbleParticleLookup(&lookupStart, numberOfParticles);
-		
-		if (numberOfParticles)
-		{
-			for (uint32 i = 0u; i < numberOfParticles; i++)
-			{
-				uint32 key = m_particleSpatialLookup[i].cellKey;
-				uint32 keyPrevious = i == 0u ? MAX_UINT : m_particleSpatialLookup[i - 1].cellKey;
-				if (key != keyPrevious)
-				{
-					m_particleSpatialLookupStartIndices[key] = (i);
-				}
-			}
-		}
+	void CloudParticleSimulator::UpdatePredictedParticleTree(GrowingArray<CloudParticle>& cloudParticles)
+	{
+		H_PROFILE_FUNCTION();
+		const uint32 numberOfParticles = m_numberOfParticles;
+		m_predictedParticlePositions.PrepareAndFill(numberOfParticles);
+		for (uint32 i = 0; i < numberOfParticles; i++)
+			m_predictedParticlePositions[i] = cloudParticles[i].pos + cloudParticles[i].intermediateVelocity;
+		m_predictedParticleTree.Build(m_predictedParticlePositions.Data(), numberOfParticles);
 	}
 
 	glm::vec2 CloudParticleSimulator::CalculateForceToSdf(const CloudParticle& cloudParticle,  const GrowingArray<float>& distanceField)
@@ -405,6 +349,7 @@ namespace Hail
 
 	void CloudParticleSimulator::UpdateParticlesBasedOnPaper(GrowingArray<CloudParticle>& cloudParticleList, float h, glm::uvec2 resolution, float actualDT, const GrowingArray<float>& distanceField)
 	{
+		H_PROFILE_FUNCTION();
 		ImGui::SliderFloat("Mass", &m_mass, 0.01f, 5.f);
 		float mass = m_mass;
 		ImGui::SliderFloat("Rest density", &m_restDensity, -10.f, 10.f);
@@ -445,6 +390,8 @@ namespace Hail
 			cloudParticleList[i].intermediateVelocity = cloudParticleList[i].velocity + deltaTimeByMass * acceleration;
 		}
 
+		// The pressure is solved at the predicted positions.
+		UpdatePredictedParticleTree(cloudParticleList);
 		for (uint32 i = 0; i < m_numberOfParticles; i++)
 		{
 			cloudParticleList[i].pressureForce = CalculatePressureForceForEachPointWithinRadius(cloudParticleList, i, h, mass, deltaTimeByMass);
@@ -473,25 +420,12 @@ namespace Hail
 		CloudParticle& particle = cloudParticleList[indexToCheck];
 		particle.densityNearDensity.x = 0.f;
 		particle.densityNearDensity.y = 0.f;
-		glm::ivec2 cellCoord = PositionToCellCoord(particle.pos, h);
-
-		for (uint32 iCellID = 0; iCellID < 9; iCellID++)
-		{
-			const glm::ivec2 cellCoordToTest = cellCoord + cellOffsets[iCellID];
-			const uint32 key = GenerateKeyFromCellPos(cellCoordToTest, m_particleGridSize);
-			const uint32 cellStartIndex = m_particleSpatialLookupStartIndices[key];
-			for (uint32 i = cellStartIndex; i < m_numberOfParticles; i++)
+		m_particleTree.ForEachInRadius(m_particlePositions.Data(), particle.pos, h, [&](uint32 particleIndex, float distanceSquared)
 			{
-				if (m_particleSpatialLookup[i].cellKey != key)
-					break;
-
-				const uint32 particleIndex = m_particleSpatialLookup[i].particleIndex;
-				glm::vec2 rij = particle.pos - cloudParticleList[particleIndex].pos;
-				float r = glm::length(rij);
+				float r = sqrt(distanceSquared);
 				particle.densityNearDensity.x += mass * CubicSplineKernel(r, h);
 				particle.densityNearDensity.y += mass * NearSmoothingKernel(h, r);
-			}
-		}
+			});
 	}
 
 	glm::vec2 CloudParticleSimulator::CalculateViscosityForceForEachPointWithinRadius(GrowingArray<CloudParticle>& cloudParticleList, uint32 indexToCheck, float h, float mass)
@@ -499,28 +433,16 @@ namespace Hail
 		glm::vec2 viscosityForce = glm::vec2(0.f);
 
 		CloudParticle& pi = cloudParticleList[indexToCheck];
-		glm::ivec2 cellCoord = PositionToCellCoord(pi.pos, h);
-
-		for (uint32 iCellID = 0; iCellID < 9; iCellID++)
-		{
-			const glm::ivec2 cellCoordToTest = cellCoord + cellOffsets[iCellID];
-			const uint32 key = GenerateKeyFromCellPos(cellCoordToTest, m_particleGridSize);
-			const uint32 cellStartIndex = m_particleSpatialLookupStartIndices[key];
-			for (uint32 i = cellStartIndex; i < m_numberOfParticles; i++)
+		m_particleTree.ForEachInRadius(m_particlePositions.Data(), pi.pos, h, [&](uint32 particleIndex, float distanceSquared)
 			{
-				if (m_particleSpatialLookup[i].cellKey != key)
-					break;
-
-				const uint32 particleIndex = m_particleSpatialLookup[i].particleIndex;
-
 				if (particleIndex == indexToCheck)
-					continue;
+					return;
 
 				const CloudParticle& pj = cloudParticleList[particleIndex];
 
 				glm::vec2 rij = pi.pos - pj.pos;
-				float r = glm::length(rij);
-				if (r == 0.0f) continue; // avoid division by zero
+				float r = sqrt(distanceSquared);
+				if (r == 0.0f) return; // avoid division by zero
 
 				glm::vec2 velocityDiff = pj.velocity - pi.velocity;
 
@@ -531,8 +453,7 @@ namespace Hail
 				float kernelGradientNormalized = (glm::length(gradientOfKernel) * 2.f) / r;
 
 				viscosityForce += ((mass / pj.densityNearDensity.x) * velocityDiff * kernelGradientNormalized);
-			}
-		}
+			});
 
 		return viscosityForce;
 	}
@@ -547,31 +468,15 @@ namespace Hail
 
 		glm::vec2 piA = (pi.pos + pi.intermediateVelocity);
 
-		glm::ivec2 cellCoord = PositionToCellCoord(piA, h);
 		glm::vec2 randomFallbackDirection = VogelDirection(indexToCheck, 512u, (indexToCheck + 1u) * 0.01f);
-		const float hSquared = h * h;
-
-		for (uint32 iCellID = 0; iCellID < 9; iCellID++)
-		{
-			const glm::ivec2 cellCoordToTest = cellCoord + cellOffsets[iCellID];
-			const uint32 key = GenerateKeyFromCellPos(cellCoordToTest, m_particleGridSize);
-			const uint32 cellStartIndex = m_particleSpatialLookupStartIndices[key];
-			for (uint32 i = cellStartIndex; i < m_numberOfParticles; i++)
+		m_predictedParticleTree.ForEachInRadius(m_predictedParticlePositions.Data(), piA, h, [&](uint32 particleIndex, float rijLengthSquard)
 			{
-				if (m_particleSpatialLookup[i].cellKey != key)
-					break;
-
-				const uint32 particleIndex = m_particleSpatialLookup[i].particleIndex;
-
 				if (particleIndex == indexToCheck)
-					continue;
+					return;
 
 				const CloudParticle& pj = cloudParticleList[particleIndex];
 
-				glm::vec2 rij = piA - (pj.pos + pj.intermediateVelocity);
-				const float rijLengthSquard = rij.x * rij.x + rij.y * rij.y;
-				if (rijLengthSquard >= hSquared)
-					continue;
+				glm::vec2 rij = piA - m_predictedParticlePositions[particleIndex];
 
 				float nearPressureTerm = piNearPressureTerm + (pj.nearPressure / (pj.densityNearDensity.y * pj.densityNearDensity.y));
 				float pressureTerm = piPressureTerm + (pj.pressure / (pj.densityNearDensity.x * pj.densityNearDensity.x));
@@ -580,7 +485,6 @@ namespace Hail
 				const float pressureModifier = 1.f - r / h;
 				pressureTerm = pressureTerm * pressureModifier + nearPressureTerm * (pressureModifier * pressureModifier);
 
-				bool useRandomDirection = false;
 				float gradient = CubicSplineGradient(r, h);
 				if (r < FLT_EPSILON)
 					gradient *= 2.f;
@@ -588,8 +492,7 @@ namespace Hail
 				glm::vec2 pressureGradient = normalizedDirection * gradient;
 				
 				pressureForce += mass * -pressureTerm * pressureGradient;
-			}
-		}
+			});
 		return pressureForce;
 	}
 }
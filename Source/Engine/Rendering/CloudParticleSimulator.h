@@ -1,6 +1,7 @@
 #pragma once
 #include "Types.h"
 #include "Containers\GrowingArray\GrowingArray.h"
+#include "Containers\KDTree\KDTree2D.h"
 
 
 namespace Hail
@@ -20,19 +21,15 @@ namespace Hail
 
 	struct RenderCommandPool;
 
-	struct SpatialIndexLookup
-	{
-		uint32 cellKey;
-		uint32 particleIndex;
-	};
-
 	class CloudParticleSimulator
 	{
 	public:
 
 		void UpdateParticles(GrowingArray<CloudParticle>& cloudParticles, RenderCommandPool& poolOfCommands, glm::uvec2 resolution, const GrowingArray<float>& distanceField);
 
-		void UpdatePartialLookupList(GrowingArray<CloudParticle>& cloudParticles, float hRadius);
+		// Neighbours are found with radius queries in trees over the particle positions and the predicted positions.
+		void UpdateParticleTree(GrowingArray<CloudParticle>& cloudParticles);
+		void UpdatePredictedParticleTree(GrowingArray<CloudParticle>& cloudParticles);
 
 		glm::vec2 CalculateForceToSdf(const CloudParticle& cloudParticle, const GrowingArray<float>& distanceField);
 		
@@ -65,8 +62,10 @@ namespace Hail
 		uint32 m_particleGridSize = 128u;
 		uint32 m_numberOfParticles;
 
-		GrowingArray<SpatialIndexLookup> m_particleSpatialLookup;
-		GrowingArray<uint32> m_particleSpatialLookupStartIndices;
+		GrowingArray<glm::vec2> m_particlePositions;
+		KDTree2D<glm::vec2> m_particleTree;
+		GrowingArray<glm::vec2> m_predictedParticlePositions;
+		KDTree2D<glm::vec2> m_predictedParticleTree;
 
 		bool m_bSimulateGrid = true;
 		bool m_bShowCircles = true;
@@ -1,5 +1,7 @@
 #include "Engine_PCH.h"
 #include "CloudRenderer.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
 
 #include "HailEngine.h"
 #include "FrameBufferTexture.h"
@@ -647,6 +649,7 @@ namespace Hail
 
 	void CloudRenderer::Prepare(PrepareParams prepareParams)
 	{
+		H_PROFILE_FUNCTION();
 		RenderCommandPool& poolOfCommands = *prepareParams.m_pPoolOfCommands;
 
 		m_frameRenderSettings = prepareParams.m_frameRenderSettings;
@@ -784,6 +787,7 @@ namespace Hail
 		}
 
 		m_bRespawnParticles = bRespawnParticles;
+		H_COUNTER_ADD("Particles simulated", m_ParticleUniforms.numberOfParticles);
 
 		pContext->UploadDataToBuffer(m_pCloudListBuffer, m_cloudList.Data(), sizeof(CloudData)* m_cloudList.Size());
 		pContext->UploadDataToBuffer(m_pParticleUniformBuffer, &m_ParticleUniforms, sizeof(ParticleUniformBuffer));
@@ -1,5 +1,6 @@
 #include "Engine_PCH.h"
 #include "DebugRenderingManager.h"
+#include "Profiler.h"
 
 #include "HailEngine.h"
 #include "RenderCommands.h"
@@ -158,6 +159,7 @@ void Hail::DebugRenderingManager::Cleanup()
 
 void Hail::DebugRenderingManager::Prepare(RenderCommandPool& poolOfCommands)
 {
+	H_PROFILE_FUNCTION();
 	RenderContext* pContext = m_pRenderer->GetCurrentContext();
 	m_numberOfCirclesToRender = poolOfCommands.m_debugCircles.Size();
 
@@ -1,5 +1,7 @@
 #include "Engine_PCH.h"
 #include "FontRenderer.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
 
 #include "HailEngine.h"
 #include "Renderer.h"
@@ -10,10 +12,15 @@
 #include "RenderContext.h"
 #include "MathUtils.h"
 #include "RenderCommands.h"
+#include "Hashing\xxh64_en.hpp"
+#include "FrameArena.h"
 
 namespace Hail
 {
 	constexpr uint32 locMaxNumberOfGlyphlets = 1028u;
+	// Layouts that have not been rendered for this many frames are removed from the cache.
+	constexpr uint32 locTextLayoutEvictionFrames = 120u;
+	constexpr uint32 locMinTextLayoutLookupSize = 64u;
 
 	FontRenderer::~FontRenderer()
 	{
@@ -37,7 +44,7 @@ namespace Hail
 		StringL fontFileDir;
 		fontFileDir.Reserve(fontFilePath.Length());
 		FromWCharToConstChar(fontFilePath.Data(), fontFileDir.Data(), fontFilePath.Length());
-		m_fontData = TTF_ParseFontFile(fontFileDir);
+		m_fontData = TTF_LoadFont(fontFileDir);
 
 		if (m_fontData.m_renderVerts.Empty())
 		{
@@ -142,9 +149,11 @@ namespace Hail
 		pContext->UploadDataToBuffer(m_pVertexBuffer, m_fontData.m_renderVerts.Data(), m_fontData.m_renderVerts.Size() * sizeof(glm::vec2));
 		pContext->UploadDataToBuffer(m_pIndexBuffer, m_fontData.m_glyphData.m_triangles.Data(), m_fontData.m_glyphData.m_triangles.Size() * sizeof(GlyphTri));
 
-		m_glyphletsToRender.Prepare(locMaxNumberOfGlyphlets);
-		m_textCommandsToRender.Prepare(MAX_NUMBER_OF_TEXT_COMMANDS);
 		m_batchOffsetToInstanceStart.Prepare(MAX_NUMBER_OF_TEXT_COMMANDS);
+		m_textLayouts.Prepare(MAX_NUMBER_OF_TEXT_COMMANDS);
+		m_cachedGlyphlets.Prepare(locMaxNumberOfGlyphlets);
+		m_cachedLayoutText.Prepare(locMaxNumberOfGlyphlets);
+		RebuildTextLayoutLookup(locMinTextLayoutLookupSize);
 	}
 
 	void FontRenderer::Cleanup()
@@ -190,10 +199,7 @@ namespace Hail
 				glyphletToAdd.indexOffset = compoundGlyph.m_indexOffset;
 				glyphletToAdd.numberOfTrianglesNumberOfVertices = compoundGlyph.m_numberOfTrianglesNumberOfVertices;
 				glyphletToAdd.vertexOffset = compoundGlyph.m_vertexOffset;
-				if (listToFill.Size() < locMaxNumberOfGlyphlets)
-					listToFill.Add(glyphletToAdd);
-				else
-					H_ERROR("To many glyphlets spawned! Either increase buffer size or make better culling");
+				listToFill.Add(glyphletToAdd);
 			}
 			else
 			{
@@ -202,21 +208,40 @@ namespace Hail
 		}
 	}
 
+	static uint64 localGetTextLayoutKey(const wchar_t* pText, uint32 textLength, uint16 fontSize)
+	{
+		return xxh64::hash(reinterpret_cast<const char*>(pText), textLength * sizeof(wchar_t), fontSize);
+	}
+
 	void FontRenderer::Prepare(const RenderCommandPool& poolOfCommands)
 	{
+		H_PROFILE_FUNCTION();
 		RenderContext* pContext = m_pRenderer->GetCurrentContext();
 
 		glm::uvec2 resolution = m_pResourceManager->GetSwapChain()->GetTargetResolution();
 
-		glm::vec2 resolutionToFontRatio = glm::vec2((float)resolution.x / 1920.f, (float)resolution.y / 1080.f);
+		TextLayoutParameters layoutParameters;
+		layoutParameters.resolutionToFontRatio = glm::vec2((float)resolution.x / 1920.f, (float)resolution.y / 1080.f);
 
 		float aspectRatioY = (float)resolution.y / (float)resolution.x;
-		float aspectRatioX = (float)resolution.x / (float)resolution.y;
-		glm::vec2 pixelSize = glm::vec2(1.f / resolution.x, 1.f / resolution.y);
-		pixelSize.x = pixelSize.x * aspectRatioY;
+		layoutParameters.aspectRatioX = (float)resolution.x / (float)resolution.y;
+		layoutParameters.pixelSize = glm::vec2(1.f / resolution.x, 1.f / resolution.y);
+		layoutParameters.pixelSize.x = layoutParameters.pixelSize.x * aspectRatioY;
+
+		// All cached layouts are relative to the resolution
+		if (m_textLayoutResolution != resolution)
+		{
+			ClearTextLayoutCache();
+			m_textLayoutResolution = resolution;
+		}
+		m_textLayoutFrame++;
+
+		// The per frame glyphlets and commands are only needed until they are uploaded.
+		FrameArena::ScopedMarker frameMarker;
+		FrameArray<RenderGlypghlet> glyphletsToRender(locMaxNumberOfGlyphlets);
+		// vec2 for command position (aka pivot), float for rotation
+		FrameArray<glm::vec4> textCommandsToRender(MAX_NUMBER_OF_TEXT_COMMANDS);
 
-		m_glyphletsToRender.RemoveAll();
-		m_textCommandsToRender.RemoveAll();
 		m_batchOffsetToInstanceStart.RemoveAll();
 		m_batchNumberOfGlypsToRender.RemoveAll();
 		for (uint32 iLayer = 0; iLayer < poolOfCommands.m_layersBatchOffset.Size(); iLayer++)
@@ -228,83 +253,217 @@ namespace Hail
 				const Batch2DInfo& batchToRender = poolOfCommands.m_batches[poolOfCommands.m_layersBatchOffset[iLayer] + iBatch];
 				if (batchToRender.m_type == eCommandType::Text)
 				{
-					const uint32 batchGlyphOffset = m_batchOffsetToInstanceStart.Add(m_glyphletsToRender.Size());
+					const uint32 batchGlyphOffset = m_batchOffsetToInstanceStart.Add(glyphletsToRender.Size());
 					for (uint32 iTextCommand = 0; iTextCommand < batchToRender.m_numberOfInstances; iTextCommand++)
 					{
 						const RenderCommand2DBase& textCommandBase = poolOfCommands.m_2DRenderCommands[batchToRender.m_instanceOffset + iTextCommand];
 						H_ASSERT((textCommandBase.m_index_materialIndex_flags.u & IsSpriteFlagMask) == false, "Invalid RenderCommand");
 						const RenderData_Text& textData = poolOfCommands.m_textData[textCommandBase.m_dataIndex];
-						H_ASSERT(textData.text.Length(), "Invalid text command");
-						const StringLW& stringToRender = textData.text;
-						uint32 stringL = textData.text.Length();
+						H_ASSERT(textData.text.m_length, "Invalid text command");
 						glm::vec2 glyphPosition = textCommandBase.m_transform.GetPosition();
-						uint32 fontSize = textData.textSize; // the font size is relative to the height of 1080p
-
-						//correct for aspectRatio
-						float adjustedFontSize = (float)fontSize * resolutionToFontRatio.y;
-						glm::vec2 pixelSizeOfGlyph = pixelSize * adjustedFontSize;
-						const uint32 packedColor = textCommandBase.m_color.GetColorPacked();
 
-						H_ASSERT(m_textCommandsToRender.Size() + 1 < MAX_NUMBER_OF_TEXT_COMMANDS, "To many text render commands.");
+						H_ASSERT(textCommandsToRender.Size() + 1 < MAX_NUMBER_OF_TEXT_COMMANDS, "To many text render commands.");
 
 						glm::vec4 packedPositionRotation = { glyphPosition.x, glyphPosition.y, textCommandBase.m_transform.GetRotationRad(), 0.f };
-						m_textCommandsToRender.Add(packedPositionRotation);
-						glm::vec2 glyphRelativePosition = { 0.0, 0.0 };
-						for (size_t i = 0; i < stringL; i++)
+						textCommandsToRender.Add(packedPositionRotation);
+
+						const CachedTextLayout& layout = m_textLayouts[GetOrCreateTextLayout(poolOfCommands.m_textArena.GetText(textData.text), textData.text.m_length, textData.textSize, layoutParameters)];
+						uint32 numberOfGlyphletsToAdd = layout.m_numberOfGlyphlets;
+						if (glyphletsToRender.Size() + numberOfGlyphletsToAdd > locMaxNumberOfGlyphlets)
+						{
+							H_ERROR("To many glyphlets spawned! Either increase buffer size or make better culling");
+							numberOfGlyphletsToAdd = locMaxNumberOfGlyphlets - glyphletsToRender.Size();
+						}
+
+						const uint32 packedColor = textCommandBase.m_color.GetColorPacked();
+						for (uint32 iGlyphlet = 0; iGlyphlet < numberOfGlyphletsToAdd; iGlyphlet++)
 						{
-							const wchar_t& charToRender = stringToRender[i];
-							if (charToRender == L' ')
-							{
-								glyphRelativePosition.x += pixelSizeOfGlyph.x;
-							}
-							else
-							{
-								uint16 glyphID = m_fontData.m_uniCodeToGlyphID[charToRender];
-								const Glyph& glyph = m_fontData.m_glyphData.m_glyphs[glyphID];
-
-								const glm::ivec2 glyphExtents = { glyph.m_maxExtent.x - glyph.m_minExtent.x, glyph.m_maxExtent.y - glyph.m_minExtent.y };
-
-								float xRatioOfAdvanceWidth = ((float)glyph.m_advanceWidth / (float)m_fontData.m_glyphExtents.x);
-
-								float advanceWidth = (pixelSize.x * adjustedFontSize * xRatioOfAdvanceWidth) * aspectRatioX;
-								float glyphSize = pixelSizeOfGlyph.x * ((float)glyphExtents.x / (float)m_fontData.m_glyphExtents.x) * aspectRatioX;
-								float leftSideBearing = ((float)glyph.m_leftSideBearing / (float)m_fontData.m_glyphExtents.x) * pixelSize.x;
-
-								RenderGlypghlet glyphletToCreate;
-								glyphletToCreate.relativePos = glm::vec2(glyphRelativePosition.x + leftSideBearing, glyphRelativePosition.y);
-								glyphletToCreate.glyphletColor = packedColor;
-								glyphletToCreate.glyphPixelSize = adjustedFontSize;
-								glyphletToCreate.commandBufferIndex = iTextCommand;
-								if (glyph.m_bIsSimpleGlyph)
-								{
-									glyphletToCreate.indexOffset = glyph.m_indexOffset;
-									glyphletToCreate.numberOfTrianglesNumberOfVertices = glyph.m_numberOfTrianglesNumberOfVertices;
-									glyphletToCreate.vertexOffset = glyph.m_vertexOffset;
-									if (m_glyphletsToRender.Size() < locMaxNumberOfGlyphlets)
-										m_glyphletsToRender.Add(glyphletToCreate);
-									else
-										H_ERROR("To many glyphlets spawned! Either increase buffer size or make better culling");
-								}
-								else
-								{
-									localGetCompoundRenderGlyphlet(m_fontData, m_glyphletsToRender, glyphletToCreate, glyph);
-								}
-								glyphRelativePosition.x += advanceWidth + glyphSize;
-							}
+							RenderGlypghlet& glyphlet = glyphletsToRender.Add(m_cachedGlyphlets[layout.m_glyphletOffset + iGlyphlet]);
+							glyphlet.glyphletColor = packedColor;
+							glyphlet.commandBufferIndex = iTextCommand;
 						}
 					}
-					m_batchNumberOfGlypsToRender.Add(m_glyphletsToRender.Size() - batchGlyphOffset);
+					m_batchNumberOfGlypsToRender.Add(glyphletsToRender.Size() - batchGlyphOffset);
 				}
 			}
 		}
 
+		if (m_textLayoutFrame % locTextLayoutEvictionFrames == 0)
+		{
+			EvictUnusedTextLayouts();
+		}
+
+		H_COUNTER_ADD("Glyphlets emitted", glyphletsToRender.Size());
+
 		pContext->StartTransferPass();
-		pContext->UploadDataToBuffer(m_pGlyphletBuffer, m_glyphletsToRender.Data(), m_glyphletsToRender.Size() * sizeof(RenderGlypghlet));
-		pContext->UploadDataToBuffer(m_pTextCommandBuffer, m_textCommandsToRender.Data(), m_textCommandsToRender.Size() * sizeof(glm::vec4));
+		pContext->UploadDataToBuffer(m_pGlyphletBuffer, glyphletsToRender.Data(), glyphletsToRender.Size() * sizeof(RenderGlypghlet));
+		pContext->UploadDataToBuffer(m_pTextCommandBuffer, textCommandsToRender.Data(), textCommandsToRender.Size() * sizeof(glm::vec4));
 		pContext->UploadDataToBuffer(m_pBatchOffsetBuffer, m_batchOffsetToInstanceStart.Data(), MAX_NUMBER_OF_TEXT_COMMANDS * sizeof(uint32));
 		pContext->EndTransferPass();
 	}
 
+	uint32 FontRenderer::GetOrCreateTextLayout(const wchar_t* pText, uint32 textLength, uint16 fontSize, const TextLayoutParameters& parameters)
+	{
+		const uint64 key = localGetTextLayoutKey(pText, textLength, fontSize);
+		const uint32 lookupMask = m_textLayoutLookup.Size() - 1u;
+		uint32 slot = (uint32)key & lookupMask;
+		while (m_textLayoutLookup[slot] != 0u)
+		{
+			CachedTextLayout& layout = m_textLayouts[m_textLayoutLookup[slot] - 1u];
+			if (layout.m_key == key && layout.m_stringLength == textLength && layout.m_fontSize == fontSize &&
+				memcmp(m_cachedLayoutText.Data() + layout.m_textOffset, pText, textLength * sizeof(wchar_t)) == 0)
+			{
+				layout.m_lastUsedFrame = m_textLayoutFrame;
+				return m_textLayoutLookup[slot] - 1u;
+			}
+			slot = (slot + 1u) & lookupMask;
+		}
+
+		const uint32 layoutIndex = m_textLayouts.Size();
+		CachedTextLayout& newLayout = m_textLayouts.Add();
+		newLayout.m_key = key;
+		newLayout.m_stringLength = textLength;
+		newLayout.m_textOffset = m_cachedLayoutText.Size();
+		newLayout.m_glyphletOffset = m_cachedGlyphlets.Size();
+		newLayout.m_lastUsedFrame = m_textLayoutFrame;
+		newLayout.m_fontSize = fontSize;
+		m_cachedLayoutText.AddN(textLength);
+		memcpy(m_cachedLayoutText.Data() + newLayout.m_textOffset, pText, textLength * sizeof(wchar_t));
+		LayoutText(pText, textLength, fontSize, parameters);
+		m_textLayouts[layoutIndex].m_numberOfGlyphlets = m_cachedGlyphlets.Size() - m_textLayouts[layoutIndex].m_glyphletOffset;
+
+		m_textLayoutLookup[slot] = layoutIndex + 1u;
+		// Keep the lookup at most half full so the probing stays short.
+		if (m_textLayouts.Size() * 2u > m_textLayoutLookup.Size())
+		{
+			RebuildTextLayoutLookup(m_textLayoutLookup.Size() * 2u);
+		}
+		return layoutIndex;
+	}
+
+	void FontRenderer::LayoutText(const wchar_t* pText, uint32 textLength, uint16 fontSize, const TextLayoutParameters& parameters)
+	{
+		const glm::vec2 pixelSize = parameters.pixelSize;
+		const float aspectRatioX = parameters.aspectRatioX;
+		// the font size is relative to the height of 1080p, correct for aspectRatio
+		const float adjustedFontSize = (float)fontSize * parameters.resolutionToFontRatio.y;
+		const glm::vec2 pixelSizeOfGlyph = pixelSize * adjustedFontSize;
+		const float fontUnitToAdvance = (pixelSize.x * adjustedFontSize * aspectRatioX) / (float)m_fontData.m_glyphExtents.x;
+
+		glm::vec2 glyphRelativePosition = { 0.0, 0.0 };
+		uint16 previousGlyphID = 0u;
+		for (uint32 i = 0; i < textLength; i++)
+		{
+			const wchar_t& charToRender = pText[i];
+			if (charToRender == L' ')
+			{
+				glyphRelativePosition.x += pixelSizeOfGlyph.x;
+				previousGlyphID = 0u;
+				continue;
+			}
+
+			uint16 glyphID = m_fontData.m_uniCodeToGlyphID[charToRender];
+			const Glyph& glyph = m_fontData.m_glyphData.m_glyphs[glyphID];
+
+			if (previousGlyphID != 0u)
+			{
+				glyphRelativePosition.x += (float)TTF_GetKerning(m_fontData, previousGlyphID, glyphID) * fontUnitToAdvance;
+			}
+			previousGlyphID = glyphID;
+
+			const glm::ivec2 glyphExtents = { glyph.m_maxExtent.x - glyph.m_minExtent.x, glyph.m_maxExtent.y - glyph.m_minExtent.y };
+
+			float advanceWidth = (float)glyph.m_advanceWidth * fontUnitToAdvance;
+			float glyphSize = pixelSizeOfGlyph.x * ((float)glyphExtents.x / (float)m_fontData.m_glyphExtents.x) * aspectRatioX;
+			float leftSideBearing = ((float)glyph.m_leftSideBearing / (float)m_fontData.m_glyphExtents.x) * pixelSize.x;
+
+			// Color and command index are set when the layout is used.
+			RenderGlypghlet glyphletToCreate;
+			glyphletToCreate.relativePos = glm::vec2(glyphRelativePosition.x + leftSideBearing, glyphRelativePosition.y);
+			glyphletToCreate.glyphletColor = 0u;
+			glyphletToCreate.glyphPixelSize = adjustedFontSize;
+			glyphletToCreate.commandBufferIndex = 0u;
+			if (glyph.m_bIsSimpleGlyph)
+			{
+				glyphletToCreate.indexOffset = glyph.m_indexOffset;
+				glyphletToCreate.numberOfTrianglesNumberOfVertices = glyph.m_numberOfTrianglesNumberOfVertices;
+				glyphletToCreate.vertexOffset = glyph.m_vertexOffset;
+				m_cachedGlyphlets.Add(glyphletToCreate);
+			}
+			else
+			{
+				localGetCompoundRenderGlyphlet(m_fontData, m_cachedGlyphlets, glyphletToCreate, glyph);
+			}
+			glyphRelativePosition.x += advanceWidth + glyphSize;
+		}
+	}
+
+	void FontRenderer::EvictUnusedTextLayouts()
+	{
+		uint32 numberOfKeptLayouts = 0u;
+		uint32 numberOfKeptGlyphlets = 0u;
+		uint32 numberOfKeptCharacters = 0u;
+		for (uint32 i = 0; i < m_textLayouts.Size(); i++)
+		{
+			CachedTextLayout layout = m_textLayouts[i];
+			if (m_textLayoutFrame - layout.m_lastUsedFrame >= locTextLayoutEvictionFrames)
+				continue;
+
+			// Layouts are stored in creation order, so moving the kept runs to the front never overwrites a run that is kept.
+			memmove(m_cachedLayoutText.Data() + numberOfKeptCharacters, m_cachedLayoutText.Data() + layout.m_textOffset, layout.m_stringLength * sizeof(wchar_t));
+			layout.m_textOffset = numberOfKeptCharacters;
+			numberOfKeptCharacters += layout.m_stringLength;
+			for (uint32 iGlyphlet = 0; iGlyphlet < layout.m_numberOfGlyphlets; iGlyphlet++)
+			{
+				m_cachedGlyphlets[numberOfKeptGlyphlets + iGlyphlet] = m_cachedGlyphlets[layout.m_glyphletOffset + iGlyphlet];
+			}
+			layout.m_glyphletOffset = numberOfKeptGlyphlets;
+			numberOfKeptGlyphlets += layout.m_numberOfGlyphlets;
+			m_textLayouts[numberOfKeptLayouts++] = layout;
+		}
+
+		if (numberOfKeptLayouts == m_textLayouts.Size())
+			return;
+
+		while (m_textLayouts.Size() > numberOfKeptLayouts)
+			m_textLayouts.RemoveLast();
+		while (m_cachedGlyphlets.Size() > numberOfKeptGlyphlets)
+			m_cachedGlyphlets.RemoveLast();
+		while (m_cachedLayoutText.Size() > numberOfKeptCharacters)
+			m_cachedLayoutText.RemoveLast();
+
+		uint32 lookupSize = locMinTextLayoutLookupSize;
+		while (lookupSize < numberOfKeptLayouts * 2u)
+			lookupSize *= 2u;
+		RebuildTextLayoutLookup(lookupSize);
+	}
+
+	void FontRenderer::RebuildTextLayoutLookup(uint32 lookupSize)
+	{
+		H_ASSERT((lookupSize & (lookupSize - 1u)) == 0u, "Lookup size must be a power of two");
+		m_textLayoutLookup.RemoveAll();
+		m_textLayoutLookup.PrepareAndFill(lookupSize);
+		for (uint32 i = 0; i < lookupSize; i++)
+			m_textLayoutLookup[i] = 0u;
+
+		const uint32 lookupMask = lookupSize - 1u;
+		for (uint32 i = 0; i < m_textLayouts.Size(); i++)
+		{
+			uint32 slot = (uint32)m_textLayouts[i].m_key & lookupMask;
+			while (m_textLayoutLookup[slot] != 0u)
+				slot = (slot + 1u) & lookupMask;
+			m_textLayoutLookup[slot] = i + 1u;
+		}
+	}
+
+	void FontRenderer::ClearTextLayoutCache()
+	{
+		m_textLayouts.RemoveAll();
+		m_cachedGlyphlets.RemoveAll();
+		m_cachedLayoutText.RemoveAll();
+		RebuildTextLayoutLookup(locMinTextLayoutLookupSize);
+	}
+
 	void FontRenderer::RenderBatch(uint32 numberOfInstances, uint32 batchOffset)
 	{
 		RenderContext* pContext = m_pRenderer->GetCurrentContext();
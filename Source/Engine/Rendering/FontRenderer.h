@@ -27,6 +27,18 @@ namespace Hail
 
 	struct TTF_FontStruct;
 
+	// A laid out string, the glyphlets are stored relative to the text command position.
+	struct CachedTextLayout
+	{
+		uint64 m_key; // string hash seeded with the font size
+		uint32 m_stringLength;
+		uint32 m_textOffset;
+		uint32 m_glyphletOffset;
+		uint32 m_numberOfGlyphlets;
+		uint32 m_lastUsedFrame;
+		uint16 m_fontSize;
+	};
+
 	class FontRenderer
 	{
 	public:
@@ -39,7 +51,20 @@ namespace Hail
 		void RenderBatch(uint32 numberOfInstances, uint32 batchOffset);
 
 	private:
-
+		struct TextLayoutParameters
+		{
+			glm::vec2 pixelSize;
+			glm::vec2 resolutionToFontRatio;
+			float aspectRatioX;
+		};
+
+		// Returns the index of the cached layout of the string, lays out the string if it is not in the cache.
+		uint32 GetOrCreateTextLayout(const wchar_t* pText, uint32 textLength, uint16 fontSize, const TextLayoutParameters& parameters);
+		void LayoutText(const wchar_t* pText, uint32 textLength, uint16 fontSize, const TextLayoutParameters& parameters);
+		// Removes layouts not used in a while, compacts the text and glyphlet storage and rebuilds the lookup.
+		void EvictUnusedTextLayouts();
+		void RebuildTextLayoutLookup(uint32 lookupSize);
+		void ClearTextLayoutCache();
 
 		MaterialPipeline* m_pFontPipeline;
 
@@ -54,11 +79,18 @@ namespace Hail
 
 		TTF_FontStruct m_fontData;
 
-		GrowingArray<RenderGlypghlet> m_glyphletsToRender;
-		// vec2 for command position (aka pivot), float for rotation 
-		GrowingArray<glm::vec4> m_textCommandsToRender;
 		GrowingArray<uint32> m_batchOffsetToInstanceStart;
 		GrowingArray<uint32> m_batchNumberOfGlypsToRender;
+
+		// Layout cache, strings rarely change between frames so only new strings are laid out.
+		GrowingArray<CachedTextLayout> m_textLayouts;
+		GrowingArray<RenderGlypghlet> m_cachedGlyphlets;
+		// The text of every cached layout, compared on a lookup hit so a hash collision never returns another string's layout.
+		GrowingArray<wchar_t> m_cachedLayoutText;
+		// Open addressed table of layout index + 1, 0 is an empty slot. Size is a power of two.
+		GrowingArray<uint32> m_textLayoutLookup;
+		glm::uvec2 m_textLayoutResolution = { 0u, 0u };
+		uint32 m_textLayoutFrame = 0u;
 	};
 
 }
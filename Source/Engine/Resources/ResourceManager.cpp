@@ -1,6 +1,9 @@
 #include "Engine_PCH.h"
 #include "ResourceManager.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 #include "glm\geometric.hpp"
+#include "glm\common.hpp"
 #include "MathUtils.h"
 #include "Renderer.h"
 #include "RenderCommands.h"
@@ -13,6 +16,9 @@
 #include "Resources_Materials\ShaderBufferList.h"
 #include "Rendering\RenderContext.h"
 
+#include "Null\NullResources.h"
+#include "Null\NullResourceManagers.h"
+
 #ifdef PLATFORM_WINDOWS
 #include "windows\VulkanInternal\VlkResourceManager.h"
 #include "windows\VulkanInternal\VlkSwapChain.h"
@@ -30,7 +36,7 @@ namespace Hail
 }
 
 
-Hail::ResourceManager::ResourceManager()
+Hail::ResourceManager::ResourceManager(bool bHeadless) : m_bHeadless(bHeadless)
 {
 	m_unitCube = CreateUnitCube();
 	m_unitSphere = CreateUnitSphere();
@@ -39,14 +45,25 @@ Hail::ResourceManager::ResourceManager()
 
 bool Hail::ResourceManager::InitResources(RenderingDevice* renderingDevice, RenderContext* pRenderContext, eResolutions targetRes, eResolutions startupWindowRes, ErrorManager* pErrorManager)
 {
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Resources);
 	m_renderDevice = renderingDevice;
 
+	if (m_bHeadless)
+	{
+		m_textureManager = new NullTextureManager(m_renderDevice);
+		m_materialManager = new NullMaterialManager();
+		m_renderingResourceManager = new NullRenderingResourceManager();
+		m_swapChain = new NullSwapChain(m_textureManager);
+	}
+	else
+	{
 #ifdef PLATFORM_WINDOWS
-	m_textureManager = new VlkTextureResourceManager(m_renderDevice);
-	m_materialManager = new VlkMaterialManager();
-	m_renderingResourceManager = new VlkRenderingResourceManager();
-	m_swapChain = new VlkSwapChain(m_textureManager);
+		m_textureManager = new VlkTextureResourceManager(m_renderDevice);
+		m_materialManager = new VlkMaterialManager();
+		m_renderingResourceManager = new VlkRenderingResourceManager();
+		m_swapChain = new VlkSwapChain(m_textureManager);
 #endif
+	}
 	SetTargetResolution(targetRes);
 	SetWindowResolution(startupWindowRes);
 
@@ -196,6 +213,7 @@ Hail::uint32 Hail::ResourceManager::GetMaterialInstanceHandle(GUID guid) const
 
 void Hail::ResourceManager::UpdateRenderBuffers(RenderCommandPool& renderPool, RenderContext* pRenderContext, Timer* timer)
 {
+	H_PROFILE_FUNCTION();
 	// Upload texture data to the GPU
 	pRenderContext->StartTransferPass();
 	m_textureManager->Update(pRenderContext);
@@ -261,39 +279,102 @@ void Hail::ResourceManager::SetSwapchainTargetResolution(glm::uvec2 targetResolu
 	m_swapChain->SetTargetResolution(targetResolution);
 }
 
-void Hail::ResourceManager::SpriteRenderDataFromGameCommand(const GameCommand_Sprite& commandToCreateFrom, RenderCommand2DBase& baseCommandToFill, RenderData_Sprite& dataToFill)
+namespace
+{
+	// The properties of a material instance that the sprite render data needs.
+	struct SpriteMaterialCacheEntry
+	{
+		uint32 m_materialInstanceID;
+		float m_cutoutThreshold;
+		glm::vec2 m_textureScaleMultiplier;
+	};
+	constexpr uint32 locSpriteMaterialCacheSize = 16u;
+}
+
+uint32 Hail::ResourceManager::SpriteRenderDataFromGameCommands(const GameCommand_Sprite* pCommandsToCreateFrom, uint32 numberOfCommands, RenderCommand2DBase* pBaseCommandsToFill, RenderData_Sprite* pDataToFill)
 {
 	const TextureResource* defaultTexture = m_textureManager->GetDefaultTexture().m_pTexture;
 	const glm::vec2 renderResolution = m_swapChain->GetTargetResolution();
-	const MaterialInstance& materialInstance = m_materialManager->GetMaterialInstance(commandToCreateFrom.materialInstanceID, eMaterialType::SPRITE);
-	const TextureResource& texture = materialInstance.m_textureHandles[0] != INVALID_TEXTURE_HANDLE ? *m_textureManager->GetTexture(materialInstance.m_textureHandles[0]) : *defaultTexture;
-	const float textureAspectRatio = (float)texture.m_properties.width / (float)texture.m_properties.height;
-
-	glm::vec2 spriteScale = commandToCreateFrom.transform.GetScale();
-	const glm::vec2 spriteSizeMultiplier = commandToCreateFrom.bSizeRelativeToRenderTarget ? glm::vec2(1.0, 1.0) : commandToCreateFrom.transform.GetScale();
-	if (commandToCreateFrom.bSizeRelativeToRenderTarget)
-	{
-		spriteScale.x *= m_swapChain->GetHorizontalAspectRatio();
-	}
-	else
+	const float horizontalAspectRatio = m_swapChain->GetHorizontalAspectRatio();
+	const float renderAspectRatio = renderResolution.y / renderResolution.x;
+
+	// Sprites are sorted on material so the last used entry is checked first, the cache is only searched on a material change.
+	// If the cache is full the oldest entry is replaced.
+	SpriteMaterialCacheEntry materialCache[locSpriteMaterialCacheSize];
+	uint32 numberOfCachedMaterials = 0u;
+	uint32 currentCacheIndex = 0u;
+	uint32 nextCacheIndexToReplace = 0u;
+
+	uint32 numberOfVisibleSprites = 0u;
+	for (uint32 i = 0; i < numberOfCommands; i++)
 	{
-		const glm::vec2 scaleMultiplier = glm::vec2(texture.m_properties.width, texture.m_properties.height) / renderResolution.y;
-		spriteScale = (spriteScale * 2.0f) * scaleMultiplier;
-	}
-	const float cutoutThreshhold = materialInstance.m_blendMode == eBlendMode::None ? 0.0f : (float)materialInstance.m_cutoutThreshold / 256.f;
+		const GameCommand_Sprite& commandToCreateFrom = pCommandsToCreateFrom[i];
 
-	// The last bit is set to 1 or 0 for if the data should be lerped or not
-	baseCommandToFill.m_color = commandToCreateFrom.color;
-	baseCommandToFill.m_transform = commandToCreateFrom.transform;
-	baseCommandToFill.m_transform.SetScale(spriteScale);
-	baseCommandToFill.m_index_materialIndex_flags.u = commandToCreateFrom.index;
-	uint32 maskedValue = commandToCreateFrom.materialInstanceID << 16;
-	baseCommandToFill.m_index_materialIndex_flags.u |= (maskedValue | LerpCommandFlagMask | IsSpriteFlagMask);
+		if (numberOfCachedMaterials == 0u || materialCache[currentCacheIndex].m_materialInstanceID != commandToCreateFrom.materialInstanceID)
+		{
+			uint32 iCache = 0;
+			for (; iCache < numberOfCachedMaterials; iCache++)
+			{
+				if (materialCache[iCache].m_materialInstanceID == commandToCreateFrom.materialInstanceID)
+					break;
+			}
 
-	dataToFill.uvTR_BL = commandToCreateFrom.uvTR_BL;
-	dataToFill.pivot_sizeMultiplier = { commandToCreateFrom.pivot.x, commandToCreateFrom.pivot.y, spriteSizeMultiplier.x, spriteSizeMultiplier.y };
-	dataToFill.cutoutThreshold_padding = { cutoutThreshhold, 0.f, 0.f, 0.f };
+			if (iCache == numberOfCachedMaterials)
+			{
+				if (numberOfCachedMaterials < locSpriteMaterialCacheSize)
+				{
+					numberOfCachedMaterials++;
+				}
+				else
+				{
+					iCache = nextCacheIndexToReplace;
+					nextCacheIndexToReplace = (nextCacheIndexToReplace + 1u) % locSpriteMaterialCacheSize;
+				}
+				const MaterialInstance& materialInstance = m_materialManager->GetMaterialInstance(commandToCreateFrom.materialInstanceID, eMaterialType::SPRITE);
+				const TextureResource& texture = materialInstance.m_textureHandles[0] != INVALID_TEXTURE_HANDLE ? *m_textureManager->GetTexture(materialInstance.m_textureHandles[0]) : *defaultTexture;
+				SpriteMaterialCacheEntry& entry = materialCache[iCache];
+				entry.m_materialInstanceID = commandToCreateFrom.materialInstanceID;
+				entry.m_cutoutThreshold = materialInstance.m_blendMode == eBlendMode::None ? 0.0f : (float)materialInstance.m_cutoutThreshold / 256.f;
+				entry.m_textureScaleMultiplier = glm::vec2(texture.m_properties.width, texture.m_properties.height) / renderResolution.y;
+			}
+			currentCacheIndex = iCache;
+		}
+		const SpriteMaterialCacheEntry& material = materialCache[currentCacheIndex];
 
+		glm::vec2 spriteScale = commandToCreateFrom.transform.GetScale();
+		const glm::vec2 spriteSizeMultiplier = commandToCreateFrom.bSizeRelativeToRenderTarget ? glm::vec2(1.0, 1.0) : commandToCreateFrom.transform.GetScale();
+		if (commandToCreateFrom.bSizeRelativeToRenderTarget)
+		{
+			spriteScale.x *= horizontalAspectRatio;
+		}
+		else
+		{
+			spriteScale = (spriteScale * 2.0f) * material.m_textureScaleMultiplier;
+		}
+
+		// Same extents as in VS_Sprite.vert, the quad is offset by the pivot and the radius covers any rotation.
+		const glm::vec2 pivotOffset = glm::abs(commandToCreateFrom.pivot * 2.0f - 1.0f);
+		const glm::vec2 halfExtents = (1.0f + pivotOffset) * glm::abs(spriteScale * spriteSizeMultiplier);
+		if (!IsBoundingCircleOnScreen(commandToCreateFrom.transform.GetPosition(), glm::length(halfExtents), renderAspectRatio))
+			continue;
+
+		RenderCommand2DBase& baseCommandToFill = pBaseCommandsToFill[numberOfVisibleSprites];
+		RenderData_Sprite& dataToFill = pDataToFill[numberOfVisibleSprites];
+		numberOfVisibleSprites++;
+
+		// The last bit is set to 1 or 0 for if the data should be lerped or not
+		baseCommandToFill.m_color = commandToCreateFrom.color;
+		baseCommandToFill.m_transform = commandToCreateFrom.transform;
+		baseCommandToFill.m_transform.SetScale(spriteScale);
+		baseCommandToFill.m_index_materialIndex_flags.u = commandToCreateFrom.index;
+		uint32 maskedValue = commandToCreateFrom.materialInstanceID << 16;
+		baseCommandToFill.m_index_materialIndex_flags.u |= (maskedValue | LerpCommandFlagMask | IsSpriteFlagMask);
+
+		dataToFill.uvTR_BL = commandToCreateFrom.uvTR_BL;
+		dataToFill.pivot_sizeMultiplier = { commandToCreateFrom.pivot.x, commandToCreateFrom.pivot.y, spriteSizeMultiplier.x, spriteSizeMultiplier.y };
+		dataToFill.cutoutThreshold_padding = { material.m_cutoutThreshold, 0.f, 0.f, 0.f };
+	}
+	return numberOfVisibleSprites;
 }
 
 Hail::Mesh Hail::CreateUnitCube()
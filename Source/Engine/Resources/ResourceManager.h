@@ -25,7 +25,8 @@ namespace Hail
 	class ResourceManager
 	{
 	public:
-		ResourceManager();
+		// Headless creates the null rendering resources instead of the platform ones.
+		explicit ResourceManager(bool bHeadless = false);
 		bool InitResources(RenderingDevice* renderingDevice, RenderContext* pRenderContext, eResolutions targetRes, eResolutions startupWindowRes, ErrorManager* pErrorManager);
 		void ClearAllResources(RenderingDevice* pRenderDevice);
 		MaterialManager* GetMaterialManager() { return m_materialManager; }
@@ -49,7 +50,9 @@ namespace Hail
 		void ClearFrameData();
 		void SetSwapchainTargetResolution(glm::uvec2 targetResolution);
 
-		void SpriteRenderDataFromGameCommand(const GameCommand_Sprite& commandToCreateFrom, RenderCommand2DBase& baseCommandToFill, RenderData_Sprite& dataToFill);
+		// Fills the render data of consecutive sprites, the material instance and texture of each distinct material is only resolved once.
+		// Sprites outside of the screen are culled and not written, returns the number of sprites written. The m_dataIndex of the base commands is not set.
+		uint32 SpriteRenderDataFromGameCommands(const GameCommand_Sprite* pCommandsToCreateFrom, uint32 numberOfCommands, RenderCommand2DBase* pBaseCommandsToFill, RenderData_Sprite* pDataToFill);
 		
 		SwapChain* GetSwapChain() { return m_swapChain; }
 
@@ -60,6 +63,7 @@ namespace Hail
 	private:
 
 		eResolutions m_targetResolution;
+		bool m_bHeadless = false;
 
 		//Dependency
 		RenderingDevice* m_renderDevice = nullptr;
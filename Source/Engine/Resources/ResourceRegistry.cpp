@@ -29,6 +29,7 @@ void ResourceRegistry::Init()
 				continue;
 
 			resource.m_resource = resourceToFill;
+			resource.m_projectPath = PathTable::GetInstance().Intern(resourceToFill.GetProjectFilePath().GetFilePath());
 			m_textureResources.Add(resource);
 		}
 		if (StringCompare(currentFileObject.Extension(), L"mat"))
@@ -39,6 +40,7 @@ void ResourceRegistry::Init()
 				continue;
 
 			resource.m_resource = resourceToFill;
+			resource.m_projectPath = PathTable::GetInstance().Intern(resourceToFill.GetProjectFilePath().GetFilePath());
 			m_materialResources.Add(resource);
 		}
 		if (StringCompare(currentFileObject.Extension(), L"shr"))
@@ -47,6 +49,7 @@ void ResourceRegistry::Init()
 			if (resourceToFill.GetGUID() == GUID())
 				continue;
 			resource.m_resource = resourceToFill;
+			resource.m_projectPath = PathTable::GetInstance().Intern(resourceToFill.GetProjectFilePath().GetFilePath());
 			m_shaderResources.Add(resource);
 		}
 	}
@@ -113,6 +116,7 @@ void Hail::ResourceRegistry::AddToRegistry(const FilePath& resourcePath, Resourc
 	}
 
 	resource.m_resource = resourceToFill;
+	resource.m_projectPath = PathTable::GetInstance().Intern(resourceToFill.GetProjectFilePath().GetFilePath());
 
 	if (type == ResourceType::Texture)
 		m_textureResources.Add(resource);
@@ -258,7 +262,7 @@ FilePath Hail::ResourceRegistry::GetProjectFilePathInternal(const GrowingArray<M
 {
 	for (size_t i = 0; i < list.Size(); i++)
 		if (list[i].m_resource.GetGUID() == resourceGuid)
-			return list[i].m_resource.GetProjectFilePath().GetFilePath();
+			return PathTable::GetInstance().ToFilePath(list[i].m_projectPath);
 	return FilePath();
 }
 
@@ -351,10 +355,15 @@ String64 Hail::ResourceRegistry::GetResourceNameInternal(const GrowingArray<Meta
 
 const Hail::MetaResource* Hail::ResourceRegistry::GetMetaResourceInternal(const GrowingArray<MetaData>& list, const FilePath& pathToCheck) const
 {
+	// A path that was never interned can not belong to a registered resource.
+	const PathHandle pathHandle = PathTable::GetInstance().Find(pathToCheck);
+	if (pathHandle == InvalidPathHandle)
+		return nullptr;
+
 	for (size_t i = 0; i < list.Size(); i++)
 	{
 		const MetaData& meta = list[i];
-		if (meta.m_resource.GetProjectFilePath().GetFilePath() == pathToCheck)
+		if (meta.m_projectPath == pathHandle)
 			return &meta.m_resource;
 	}
 
@@ -2,6 +2,7 @@
 
 #include "Types.h"
 #include "MetaResource.h"
+#include "Utility\PathTable.h"
 #include "Containers\GrowingArray\GrowingArray.h"
 
 namespace Hail
@@ -43,6 +44,8 @@ namespace Hail
 		{
 			MetaResource m_resource;
 			eResourceState m_state;
+			// Interned project path, so path lookups compare handles instead of rebuilding file paths.
+			PathHandle m_projectPath;
 		};
 		FilePath GetProjectFilePathInternal(const GrowingArray<MetaData>& list, const GUID& resourceGuid) const;
 		FilePath GetSourceFilePathInternal(const GrowingArray<MetaData>& list, const GUID& resourceGuid) const;
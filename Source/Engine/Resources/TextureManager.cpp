@@ -10,6 +10,8 @@
 
 #include "MetaResource.h"
 #include "HailEngine.h"
+#include "PerformanceCounters.h"
+#include "MemoryTracker.h"
 #include "ResourceRegistry.h"
 #include "Rendering\RenderContext.h"
 #include "Rendering\RenderDevice.h"
@@ -21,35 +23,23 @@ namespace
 	//TODO: Move the memory that is used here to a temporary memory buffer
 	void Read8BitStream(Hail::InOutStream& stream, void** outData, const uint32_t numberOfBytesToRead)
 	{
-		*outData = new uint8_t[numberOfBytesToRead];
-		unsigned char* pixels = (unsigned char*)malloc(numberOfBytesToRead);
-		stream.Read((char*)&pixels[0], numberOfBytesToRead);
-		memcpy(*outData, pixels, numberOfBytesToRead);
-		free(pixels);
+		*outData = H_TRACKED_ALLOCATE(numberOfBytesToRead, alignof(uint8_t), Hail::eMemoryTag::Textures);
+		stream.Read((char*)*outData, numberOfBytesToRead);
 	}
 	void Read16BitStream(Hail::InOutStream& stream, void** outData, const uint32_t numberOfBytesToRead)
 	{
-		*outData = new uint16_t[numberOfBytesToRead];
-		uint16_t* pixels = (uint16_t*)malloc(numberOfBytesToRead);
-		stream.Read((char*)&pixels[0], numberOfBytesToRead);
-		memcpy(*outData, pixels, numberOfBytesToRead);
-		free(pixels);
+		*outData = H_TRACKED_ALLOCATE(numberOfBytesToRead, alignof(uint16_t), Hail::eMemoryTag::Textures);
+		stream.Read((char*)*outData, numberOfBytesToRead);
 	}
 	void Read32UintBitStream(Hail::InOutStream& stream, void** outData, const uint32_t numberOfBytesToRead)
 	{
-		*outData = new uint32_t[numberOfBytesToRead];
-		uint32_t* pixels = (uint32_t*)malloc(numberOfBytesToRead);
-		stream.Read((char*)&pixels[0], numberOfBytesToRead);
-		memcpy(*outData, pixels, numberOfBytesToRead);
-		free(pixels);
+		*outData = H_TRACKED_ALLOCATE(numberOfBytesToRead, alignof(uint32_t), Hail::eMemoryTag::Textures);
+		stream.Read((char*)*outData, numberOfBytesToRead);
 	}
 	void Read32FltBitStream(Hail::InOutStream& stream, void** outData, const uint32_t numberOfBytesToRead)
 	{
-		*outData = new float[numberOfBytesToRead];
-		float* pixels = (float*)malloc(numberOfBytesToRead);
-		stream.Read((char*)&pixels[0], numberOfBytesToRead);
-		memcpy(*outData, pixels, numberOfBytesToRead);
-		free(pixels);
+		*outData = H_TRACKED_ALLOCATE(numberOfBytesToRead, alignof(float), Hail::eMemoryTag::Textures);
+		stream.Read((char*)*outData, numberOfBytesToRead);
 	}
 }
 
@@ -245,6 +235,7 @@ CompiledTexture TextureManager::LoadTextureInternal(const char* textureName, Met
 	inStream.CloseFile();
 
 	returnTexture.loadState = TEXTURE_LOADSTATE::LOADED_TO_RAM;
+	H_COUNTER_ADD("Textures loaded", 1);
 	return returnTexture;
 }
 
@@ -265,6 +256,7 @@ TextureResource* Hail::TextureManager::LoadTextureRequestInternal(const FilePath
 		return nullptr;
 
 	compiledTextureData.loadState = TEXTURE_LOADSTATE::LOADED_TO_RAM;
+	H_COUNTER_ADD("Textures loaded", 1);
 
 	TextureWithView textureAndView{};
 	if (compiledTextureData.loadState == TEXTURE_LOADSTATE::LOADED_TO_RAM)
@@ -296,7 +288,7 @@ bool Hail::TextureManager::ReadStreamInternal(CompiledTexture& textureToFill, In
 		void* tempData = nullptr;
 		Read8BitStream(inStream, &tempData, GetTextureByteSize(textureToFill.properties));
 		textureToFill.properties.textureType = static_cast<uint32_t>(eTextureSerializeableType::R8G8B8A8_SRGB);
-		textureToFill.compiledColorValues = new uint8_t[1 * 4 * textureToFill.properties.width * textureToFill.properties.height];
+		textureToFill.compiledColorValues = H_TRACKED_ALLOCATE(4u * textureToFill.properties.width * textureToFill.properties.height, alignof(uint8_t), eMemoryTag::Textures);
 		uint32_t rgbIterator = 0;
 		for (size_t i = 0; i < 4 * textureToFill.properties.width * textureToFill.properties.height; i++)
 		{
@@ -316,7 +308,7 @@ bool Hail::TextureManager::ReadStreamInternal(CompiledTexture& textureToFill, In
 				break;
 			}
 		}
-		delete[] tempData;
+		MemoryTracker::Deallocate(tempData);
 	}
 	break;
 	case eTextureSerializeableType::R8G8B8A8:
@@ -327,7 +319,7 @@ bool Hail::TextureManager::ReadStreamInternal(CompiledTexture& textureToFill, In
 		void* tempData = nullptr;
 		Read8BitStream(inStream, &tempData, GetTextureByteSize(textureToFill.properties));
 		textureToFill.properties.textureType = static_cast<uint32_t>(eTextureSerializeableType::R8G8B8A8);
-		textureToFill.compiledColorValues = new uint8_t[1 * 4 * textureToFill.properties.width * textureToFill.properties.height];
+		textureToFill.compiledColorValues = H_TRACKED_ALLOCATE(4u * textureToFill.properties.width * textureToFill.properties.height, alignof(uint8_t), eMemoryTag::Textures);
 		uint32_t rgbIterator = 0;
 		for (size_t i = 0; i < 4 * textureToFill.properties.width * textureToFill.properties.height; i++)
 		{
@@ -347,7 +339,7 @@ bool Hail::TextureManager::ReadStreamInternal(CompiledTexture& textureToFill, In
 				break;
 			}
 		}
-		delete[] tempData;
+		MemoryTracker::Deallocate(tempData);
 	}
 	break;
 	case eTextureSerializeableType::R16G16B16A16:
@@ -625,7 +617,7 @@ void Hail::TextureManager::CreateDefaultTexture(RenderContext* pRenderContext)
 	compiledTextureData.properties.height = widthHeight;
 	compiledTextureData.properties.width = widthHeight;
 	compiledTextureData.properties.textureType = (uint32)eTextureSerializeableType::R8G8B8A8_SRGB;
-	compiledTextureData.compiledColorValues = new uint8[GetTextureByteSize(compiledTextureData.properties)];
+	compiledTextureData.compiledColorValues = H_TRACKED_ALLOCATE(GetTextureByteSize(compiledTextureData.properties), alignof(uint8), eMemoryTag::Textures);
 	compiledTextureData.loadState = TEXTURE_LOADSTATE::LOADED_TO_RAM;
 	struct Color
 	{
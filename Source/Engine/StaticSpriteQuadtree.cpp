@@ -0,0 +1,132 @@
+#include "Engine_PCH.h"
+#include "StaticSpriteQuadtree.h"
+#include "MathUtils.h"
+
+using namespace Hail;
+
+void Hail::StaticSpriteQuadtree::Initialize(glm::vec2 worldMin, glm::vec2 worldMax, uint32 depth)
+{
+	H_ASSERT(depth > 0u && depth <= MaxDepth, "Invalid depth of the quadtree.");
+	H_ASSERT(worldMax.x > worldMin.x && worldMax.y > worldMin.y, "Invalid world bounds of the quadtree.");
+	m_worldMin = worldMin;
+	m_worldSize = worldMax - worldMin;
+	m_depth = Math::Clamp(1u, MaxDepth, depth);
+	RemoveAll();
+}
+
+uint32 Hail::StaticSpriteQuadtree::AddSprite(const GameCommand_Sprite& sprite, glm::vec2 boundsMin, glm::vec2 boundsMax)
+{
+	SpriteEntry& entry = m_sprites.Add();
+	entry.m_sprite = sprite;
+	entry.m_boundsMin = boundsMin;
+	entry.m_boundsMax = boundsMax;
+	entry.m_cellIndex = GetCellIndex(boundsMin, boundsMax);
+	m_bIsBuilt = false;
+	return m_sprites.Size() - 1u;
+}
+
+void Hail::StaticSpriteQuadtree::RemoveAll()
+{
+	m_sprites.RemoveAll();
+	m_sortedSpriteIndices.RemoveAll();
+	m_cellOffsets.RemoveAll();
+	m_bIsBuilt = false;
+}
+
+void Hail::StaticSpriteQuadtree::Build()
+{
+	// Counting sort of the sprites on their cell.
+	const uint32 numberOfCells = GetDepthCellOffset(m_depth);
+	m_cellOffsets.RemoveAll();
+	m_cellOffsets.PrepareAndFill(numberOfCells + 1u);
+	memset(m_cellOffsets.Data(), 0, m_cellOffsets.Size() * sizeof(uint32));
+	for (uint32 i = 0; i < m_sprites.Size(); i++)
+		m_cellOffsets[m_sprites[i].m_cellIndex + 1u]++;
+	for (uint32 iCell = 0; iCell < numberOfCells; iCell++)
+		m_cellOffsets[iCell + 1u] += m_cellOffsets[iCell];
+
+	m_sortedSpriteIndices.RemoveAll();
+	m_sortedSpriteIndices.PrepareAndFill(m_sprites.Size());
+	GrowingArray<uint32> cellWritePositions(numberOfCells);
+	cellWritePositions.PrepareAndFill(numberOfCells);
+	memcpy(cellWritePositions.Data(), m_cellOffsets.Data(), numberOfCells * sizeof(uint32));
+	for (uint32 i = 0; i < m_sprites.Size(); i++)
+		m_sortedSpriteIndices[cellWritePositions[m_sprites[i].m_cellIndex]++] = i;
+	m_bIsBuilt = true;
+}
+
+void Hail::StaticSpriteQuadtree::Query(glm::vec2 areaMin, glm::vec2 areaMax, GrowingArray<uint32>& spriteIndicesToFill) const
+{
+	H_ASSERT(m_bIsBuilt || m_sprites.Empty(), "Build the quadtree before querying it.");
+	if (!m_bIsBuilt)
+		return;
+
+	for (uint32 iDepth = 0; iDepth < m_depth; iDepth++)
+	{
+		const int32 cellsPerAxis = 1 << iDepth;
+		const glm::vec2 cellSize = m_worldSize / (float)cellsPerAxis;
+		// A cell can only hold a sprite that overlaps the area if its loose bounds overlap the area.
+		const glm::vec2 looseMin = (areaMin - cellSize * 0.5f - m_worldMin) / cellSize;
+		const glm::vec2 looseMax = (areaMax + cellSize * 0.5f - m_worldMin) / cellSize;
+		const int32 minX = Math::Clamp(0, cellsPerAxis - 1, (int32)floorf(looseMin.x));
+		const int32 minY = Math::Clamp(0, cellsPerAxis - 1, (int32)floorf(looseMin.y));
+		const int32 maxX = Math::Clamp(0, cellsPerAxis - 1, (int32)floorf(looseMax.x));
+		const int32 maxY = Math::Clamp(0, cellsPerAxis - 1, (int32)floorf(looseMax.y));
+
+		const uint32 depthCellOffset = GetDepthCellOffset(iDepth);
+		for (int32 y = minY; y <= maxY; y++)
+		{
+			// The cells of a row are consecutive, so the sprites of the row are one range.
+			const uint32 firstCell = depthCellOffset + (uint32)(y * cellsPerAxis + minX);
+			const uint32 lastCell = depthCellOffset + (uint32)(y * cellsPerAxis + maxX);
+			for (uint32 iSorted = m_cellOffsets[firstCell]; iSorted < m_cellOffsets[lastCell + 1u]; iSorted++)
+			{
+				const uint32 spriteIndex = m_sortedSpriteIndices[iSorted];
+				const SpriteEntry& entry = m_sprites[spriteIndex];
+				if (entry.m_boundsMax.x >= areaMin.x && entry.m_boundsMin.x <= areaMax.x && entry.m_boundsMax.y >= areaMin.y && entry.m_boundsMin.y <= areaMax.y)
+					spriteIndicesToFill.Add(spriteIndex);
+			}
+		}
+	}
+}
+
+uint32 Hail::StaticSpriteQuadtree::AddVisibleSprites(const Camera2D& camera, ApplicationCommandPool& poolToFill)
+{
+	glm::vec2 viewMin;
+	glm::vec2 viewMax;
+	camera.GetViewBoundsInPixelSpace(viewMin, viewMax);
+
+	m_visibleSpriteIndices.RemoveAll();
+	Query(viewMin, viewMax, m_visibleSpriteIndices);
+	for (uint32 i = 0; i < m_visibleSpriteIndices.Size(); i++)
+	{
+		const GameCommand_Sprite& sprite = m_sprites[m_visibleSpriteIndices[i]].m_sprite;
+		H_ASSERT(sprite.bIsAffectedBy2DCamera, "Sprites in the quadtree are culled against the camera.");
+		poolToFill.AddSpriteCommand(sprite);
+	}
+	poolToFill.AddSpritesCulledBySpatialIndex(m_sprites.Size() - m_visibleSpriteIndices.Size());
+	return m_visibleSpriteIndices.Size();
+}
+
+uint32 Hail::StaticSpriteQuadtree::GetCellIndex(glm::vec2 boundsMin, glm::vec2 boundsMax) const
+{
+	const glm::vec2 size = boundsMax - boundsMin;
+	const glm::vec2 center = (boundsMin + boundsMax) * 0.5f - m_worldMin;
+	if (center.x < 0.f || center.y < 0.f || center.x >= m_worldSize.x || center.y >= m_worldSize.y)
+		return 0u;
+
+	uint32 depth = 0u;
+	while (depth + 1u < m_depth)
+	{
+		const glm::vec2 childCellSize = m_worldSize / (float)(1u << (depth + 1u));
+		if (size.x > childCellSize.x || size.y > childCellSize.y)
+			break;
+		depth++;
+	}
+
+	const int32 cellsPerAxis = 1 << depth;
+	const glm::vec2 cellSize = m_worldSize / (float)cellsPerAxis;
+	const int32 x = Math::Clamp(0, cellsPerAxis - 1, (int32)(center.x / cellSize.x));
+	const int32 y = Math::Clamp(0, cellsPerAxis - 1, (int32)(center.y / cellSize.y));
+	return GetDepthCellOffset(depth) + (uint32)(y * cellsPerAxis + x);
+}
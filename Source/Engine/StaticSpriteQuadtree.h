@@ -0,0 +1,55 @@
+#pragma once
+#include "Interface\GameCommands.h"
+
+namespace Hail
+{
+	class Camera2D;
+
+	// Loose quadtree for sprites that do not move, so large worlds only add the sprites the camera sees to the command pool.
+	// Every depth is a grid of cells, a sprite is stored in the deepest depth where it is no larger than a cell, in the cell
+	// that contains its center. The bounds of a cell are loose, expanded by half a cell on each side, so a sprite is always
+	// inside the loose bounds of its cell. Sprites that are outside of the world or too large for a cell are stored in the root.
+	class StaticSpriteQuadtree
+	{
+	public:
+		static constexpr uint32 MaxDepth = 8u;
+
+		// The world bounds are in pixel space, the same space as the positions of sprites affected by the 2D camera.
+		void Initialize(glm::vec2 worldMin, glm::vec2 worldMax, uint32 depth);
+		// The bounds of the sprite in pixel space, returns the index of the sprite. Build must be called before the sprite can be found.
+		uint32 AddSprite(const GameCommand_Sprite& sprite, glm::vec2 boundsMin, glm::vec2 boundsMax);
+		GameCommand_Sprite& GetSprite(uint32 spriteIndex) { return m_sprites[spriteIndex].m_sprite; }
+		void RemoveAll();
+		// Sorts the sprites in to their cells.
+		void Build();
+
+		// Fills the list with the index of every sprite with bounds that overlap the area.
+		void Query(glm::vec2 areaMin, glm::vec2 areaMax, GrowingArray<uint32>& spriteIndicesToFill) const;
+		// Adds the sprites that the camera sees to the pool, the sprites that were not added are reported as culled. Returns the number of sprites added.
+		uint32 AddVisibleSprites(const Camera2D& camera, ApplicationCommandPool& poolToFill);
+		uint32 GetNumberOfSprites() const { return m_sprites.Size(); }
+
+	private:
+		struct SpriteEntry
+		{
+			GameCommand_Sprite m_sprite;
+			glm::vec2 m_boundsMin;
+			glm::vec2 m_boundsMax;
+			uint32 m_cellIndex;
+		};
+
+		uint32 GetCellIndex(glm::vec2 boundsMin, glm::vec2 boundsMax) const;
+		// Offset of the first cell of the depth, the number of cells in all depths before it.
+		static uint32 GetDepthCellOffset(uint32 depth) { return ((1u << (2u * depth)) - 1u) / 3u; }
+
+		glm::vec2 m_worldMin = glm::vec2(0.f);
+		glm::vec2 m_worldSize = glm::vec2(1.f);
+		uint32 m_depth = 1u;
+		bool m_bIsBuilt = false;
+		GrowingArray<SpriteEntry> m_sprites;
+		// Sprite indices sorted on cell, with the offset in to the list of the first sprite of each cell and one offset past the last cell.
+		GrowingArray<uint32> m_sortedSpriteIndices;
+		GrowingArray<uint32> m_cellOffsets;
+		GrowingArray<uint32> m_visibleSpriteIndices;
+	};
+}
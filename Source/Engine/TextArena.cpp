@@ -0,0 +1,25 @@
+#include "Engine_PCH.h"
+#include "TextArena.h"
+
+using namespace Hail;
+
+TextSpan Hail::TextArena::Add(const wchar_t* pText, uint32 length)
+{
+	TextSpan span;
+	span.m_offset = m_size;
+	if (m_size + length > MAX_NUMBER_OF_TEXT_CHARACTERS)
+	{
+		H_WARNING("Text arena is full, text is cut. Increase MAX_NUMBER_OF_TEXT_CHARACTERS.");
+		length = MAX_NUMBER_OF_TEXT_CHARACTERS - m_size;
+	}
+	memcpy(m_buffer + m_size, pText, length * sizeof(wchar_t));
+	m_size += length;
+	span.m_length = length;
+	return span;
+}
+
+void Hail::TextArena::CopyFrom(const TextArena& otherArena)
+{
+	memcpy(m_buffer, otherArena.m_buffer, otherArena.m_size * sizeof(wchar_t));
+	m_size = otherArena.m_size;
+}
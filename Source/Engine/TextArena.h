@@ -0,0 +1,31 @@
+#pragma once
+#include "Types.h"
+#include "EngineConstants.h"
+
+namespace Hail
+{
+	// Range of characters in a TextArena.
+	struct TextSpan
+	{
+		uint32 m_offset{};
+		uint32 m_length{};
+	};
+
+	// Contiguous character buffer owned by a command pool, the text of every text command in the pool is stored back to back
+	// so adding text never allocates and moving the text to another pool is a single copy.
+	class TextArena
+	{
+	public:
+		// Copies the text in to the arena, the text is cut if the arena is full.
+		TextSpan Add(const wchar_t* pText, uint32 length);
+		const wchar_t* GetText(const TextSpan& span) const { return m_buffer + span.m_offset; }
+		// Copies the used part of the other arena, spans from the other arena are valid in this arena afterwards.
+		void CopyFrom(const TextArena& otherArena);
+		void Clear() { m_size = 0u; }
+		uint32 Size() const { return m_size; }
+
+	private:
+		wchar_t m_buffer[MAX_NUMBER_OF_TEXT_CHARACTERS];
+		uint32 m_size = 0u;
+	};
+}
@@ -1,5 +1,7 @@
 #include "Engine_PCH.h"
 #include "ThreadSynchronizer.h"
+#include "Profiler.h"
+#include "PerformanceCounters.h"
 #include "Input\InputHandler.h"
 #include "glm\common.hpp"
 #include "Resources\ResourceManager.h"
@@ -22,6 +24,7 @@ void Hail::ThreadSyncronizer::Init(float tickTimer)
 
 void Hail::ThreadSyncronizer::SynchronizeAppData(InputActionMap& inputActionMap, ImGuiCommandRecorder& imguiCommandRecorder, ResourceManager& resourceManager)
 {
+	H_PROFILE_FUNCTION();
 	m_currentResolution = ResolutionFromEnum(resourceManager.GetTargetResolution());
 	SwapBuffersInternal();
 	m_appData.rawInputData = inputActionMap.GetRawInputMap();
@@ -36,6 +39,7 @@ void Hail::ThreadSyncronizer::SynchronizeAppData(InputActionMap& inputActionMap,
 
 void Hail::ThreadSyncronizer::TransferGameCommandsToRenderCommands(ResourceManager& resourceManager)
 {
+	H_PROFILE_FUNCTION();
 	ApplicationCommandPool& poolToTransferFrom = m_appCommandPools[m_currentActiveAppCommandPoolRead];
 	// Filling data from the read pool
 	RenderCommandPool& renderPoolReadToFill = m_renderCommandPools[m_currentActiveRenderPoolRead];
@@ -51,9 +55,18 @@ void Hail::ThreadSyncronizer::TransferGameCommandsToRenderCommands(ResourceManag
 	renderPoolReadToFill.m_2DRenderCommands.Clear();
 	renderPoolReadToFill.m_spriteData.Clear();
 	renderPoolReadToFill.m_textData.Clear();
+	// The spans of the text commands are offsets in to the arena, so the whole arena is moved with one copy.
+	renderPoolReadToFill.m_textArena.CopyFrom(poolToTransferFrom.m_textArena);
 	renderPoolReadToFill.m_debugLineCommands.Clear();
 	renderPoolReadToFill.m_debugCircles.Clear();
 
+	CullingStats2D& cullingStats = renderPoolReadToFill.m_cullingStats2D;
+	cullingStats = CullingStats2D();
+	cullingStats.m_numberOfSpritesCulledBySpatialIndex = poolToTransferFrom.m_numberOfSpritesCulledBySpatialIndex;
+	const glm::vec2 renderResolution = resourceManager.GetSwapChain()->GetTargetResolution();
+	const float renderAspectRatio = renderResolution.y / renderResolution.x;
+
+	// Game command counters, culled commands are not added to the render pool so these do not match the render command indices.
 	uint16 textCounter = 0u;
 	uint16 spriteCounter = 0u;
 	uint32 batchCounter = 0u;
@@ -64,64 +77,56 @@ void Hail::ThreadSyncronizer::TransferGameCommandsToRenderCommands(ResourceManag
 		H_ASSERT(depthTypeCounter.m_spriteCounter || depthTypeCounter.m_textCounter);
 		renderPoolReadToFill.m_layersBatchOffset.Add(batchCounter);
 
-		uint32 currentMaterialID{MAX_UINT - 1};
-		uint16 numberOfInstancesInBatch = 0;
-		const int32 spriteCounterBeforeBatching = spriteCounter;
+		// The sprites of a layer are consecutive in both the game commands and the render commands, so the whole layer is filled in one call.
+		const uint32 renderCommandOffset = renderPoolReadToFill.m_2DRenderCommands.Size();
+		const uint32 spriteDataOffset = renderPoolReadToFill.m_spriteData.Size();
+		uint32 numberOfVisibleSprites = 0u;
+		if (depthTypeCounter.m_spriteCounter)
+		{
+			H_ASSERT(renderCommandOffset + depthTypeCounter.m_spriteCounter <= MAX_NUMBER_OF_2D_RENDER_COMMANDS, "To many 2D render commands.");
+			H_ASSERT(spriteDataOffset + depthTypeCounter.m_spriteCounter <= MAX_NUMBER_OF_SPRITES, "To many sprites.");
+			numberOfVisibleSprites = resourceManager.SpriteRenderDataFromGameCommands(&poolToTransferFrom.m_spriteCommands[spriteCounter], depthTypeCounter.m_spriteCounter,
+				renderPoolReadToFill.m_2DRenderCommands.Data() + renderCommandOffset, renderPoolReadToFill.m_spriteData.Data() + spriteDataOffset);
+			renderPoolReadToFill.m_2DRenderCommands.AddN_NoConstruction(numberOfVisibleSprites);
+			renderPoolReadToFill.m_spriteData.AddN_NoConstruction(numberOfVisibleSprites);
+			cullingStats.m_numberOfSprites += depthTypeCounter.m_spriteCounter;
+			cullingStats.m_numberOfCulledSprites += depthTypeCounter.m_spriteCounter - numberOfVisibleSprites;
+			spriteCounter += depthTypeCounter.m_spriteCounter;
+		}
 
-		for (uint16 iSpriteC = 0; iSpriteC < depthTypeCounter.m_spriteCounter; iSpriteC++)
+		uint16 numberOfInstancesInBatch = 0;
+		for (uint32 iSprite = 0; iSprite < numberOfVisibleSprites; iSprite++)
 		{
 			numberOfInstancesInBatch++;
-			// Prepare all sprite data we need from application data
-			const uint16 iSpriteCIndex = spriteCounterBeforeBatching + iSpriteC;
-			GameCommand_Sprite& spriteCToTransfer = poolToTransferFrom.m_spriteCommands[iSpriteCIndex];
+			RenderCommand2DBase& spriteCommand = renderPoolReadToFill.m_2DRenderCommands[renderCommandOffset + iSprite];
+			spriteCommand.m_dataIndex = spriteDataOffset + iSprite;
 
-			RenderCommand2DBase& commandToAdd = renderPoolReadToFill.m_2DRenderCommands.Add();
-			commandToAdd.m_dataIndex = renderPoolReadToFill.m_spriteData.Size();
-			RenderData_Sprite& dataToAdd = renderPoolReadToFill.m_spriteData.Add();
-			resourceManager.SpriteRenderDataFromGameCommand(spriteCToTransfer, commandToAdd, dataToAdd);
-
-			const uint32 nextSpriteIndex = Math::Min(iSpriteCIndex + 1, (depthTypeCounter.m_spriteCounter + spriteCounterBeforeBatching) - 1);
-			const uint32 nextMaterialID = poolToTransferFrom.m_spriteCommands[nextSpriteIndex].materialInstanceID;
-			if (spriteCToTransfer.materialInstanceID != nextMaterialID)
+			const bool bIsLastSprite = iSprite + 1u == numberOfVisibleSprites;
+			if (bIsLastSprite || spriteCommand.m_index_materialIndex_flags.bits.materialIndex != renderPoolReadToFill.m_2DRenderCommands[renderCommandOffset + iSprite + 1u].m_index_materialIndex_flags.bits.materialIndex)
 			{
-				currentMaterialID = poolToTransferFrom.m_spriteCommands[iSpriteCIndex].materialInstanceID;
-
 				Batch2DInfo& spriteBatch = renderPoolReadToFill.m_batches.Add();
 				spriteBatch.m_type = eCommandType::Sprite;
-				spriteBatch.m_instanceOffset = spriteCounter + textCounter;
+				spriteBatch.m_instanceOffset = renderCommandOffset + iSprite + 1u - numberOfInstancesInBatch;
 				spriteBatch.m_numberOfInstances = numberOfInstancesInBatch;
 				batchCounter++;
-				spriteCounter += numberOfInstancesInBatch;
 				numberOfInstancesInBatch = 0;
 			}
 		}
 
-		if (numberOfInstancesInBatch)
-		{
-
-			Batch2DInfo& spriteBatch = renderPoolReadToFill.m_batches.Add();
-			spriteBatch.m_type = eCommandType::Sprite;
-			spriteBatch.m_instanceOffset = spriteCounter + textCounter;
-			spriteBatch.m_numberOfInstances = numberOfInstancesInBatch;
-			batchCounter++;
-
-			spriteCounter += numberOfInstancesInBatch;
-			numberOfInstancesInBatch = 0;
-		}
-
 		if (depthTypeCounter.m_textCounter == 0u)
 			continue;
 
-		Batch2DInfo& textBatch = renderPoolReadToFill.m_batches.Add();
-		textBatch.m_type = eCommandType::Text;
-		textBatch.m_instanceOffset = spriteCounter + textCounter;
-		textBatch.m_numberOfInstances = depthTypeCounter.m_textCounter;
-		batchCounter++;
+		const uint32 textCommandOffset = renderPoolReadToFill.m_2DRenderCommands.Size();
 		for (uint16 iTextC = 0; iTextC < depthTypeCounter.m_textCounter; iTextC++)
 		{
 			const uint16 iTextCAdjusted = textCounter + iTextC;
 
 			GameCommand_Text& textCToTransfer = poolToTransferFrom.m_textCommands[iTextCAdjusted];
+			if (!IsBoundingCircleOnScreen(textCToTransfer.transform.GetPosition(), GetTextBoundingRadius(textCToTransfer.text.m_length, textCToTransfer.textSize), renderAspectRatio))
+			{
+				cullingStats.m_numberOfCulledTexts++;
+				continue;
+			}
 
 			RenderCommand2DBase& commandToAdd = renderPoolReadToFill.m_2DRenderCommands.Add();
 			commandToAdd.m_dataIndex = renderPoolReadToFill.m_textData.Size();
@@ -136,8 +141,23 @@ void Hail::ThreadSyncronizer::TransferGameCommandsToRenderCommands(ResourceManag
 			dataToAdd.textSize = textCToTransfer.textSize;
 		}
 		textCounter += depthTypeCounter.m_textCounter;
+		cullingStats.m_numberOfTexts += depthTypeCounter.m_textCounter;
+
+		const uint32 numberOfVisibleTexts = renderPoolReadToFill.m_2DRenderCommands.Size() - textCommandOffset;
+		if (numberOfVisibleTexts)
+		{
+			Batch2DInfo& textBatch = renderPoolReadToFill.m_batches.Add();
+			textBatch.m_type = eCommandType::Text;
+			textBatch.m_instanceOffset = textCommandOffset;
+			textBatch.m_numberOfInstances = numberOfVisibleTexts;
+			batchCounter++;
+		}
 	}
 
+	H_COUNTER_ADD("Sprite commands", poolToTransferFrom.m_spriteCommands.Size());
+	H_COUNTER_ADD("Text commands", poolToTransferFrom.m_textCommands.Size());
+	H_COUNTER_ADD("2D batches built", batchCounter);
+
 	for (uint16 i = 0; i < poolToTransferFrom.m_debugLineCommands.Size(); i++)
 		renderPoolReadToFill.m_debugLineCommands.Add(poolToTransferFrom.m_debugLineCommands[i]);
 
@@ -161,17 +181,20 @@ void Hail::ThreadSyncronizer::TransferGameCommandsToRenderCommands(ResourceManag
 
 	for (uint32 i = 0; i < renderPoolReadToFill.m_textData.Size(); i++)
 		writeRenderPool.m_textData[i] = renderPoolReadToFill.m_textData[i];
+	writeRenderPool.m_textArena.CopyFrom(renderPoolReadToFill.m_textArena);
 
 	for (uint32 i = 0; i < renderPoolReadToFill.m_batches.Size(); i++)
 		writeRenderPool.m_batches[i] = renderPoolReadToFill.m_batches[i];
 
 	for (uint32 i = 0; i < renderPoolReadToFill.m_layersBatchOffset.Size(); i++)
 		writeRenderPool.m_layersBatchOffset[i] = renderPoolReadToFill.m_layersBatchOffset[i];
+	writeRenderPool.m_cullingStats2D = renderPoolReadToFill.m_cullingStats2D;
 
 }
 
 void Hail::ThreadSyncronizer::SynchronizeRenderData(float frameDeltaTime)
 {
+	H_PROFILE_FUNCTION();
 	m_currentRenderTimer += frameDeltaTime;
 
 	LerpRenderBuffers();
@@ -191,6 +214,7 @@ void Transform2DLineFromPixelSpaceToNormalizedSpace(glm::vec3& start, glm::vec3&
 
 void Hail::ThreadSyncronizer::PrepareApplicationData()
 {
+	H_PROFILE_FUNCTION();
 	ApplicationCommandPool* pPool = m_appData.commandPoolToFill;
 	Camera2D& camera = pPool->camera2D;
 	camera.SetResolution(m_currentResolution);
@@ -1,5 +1,6 @@
 #include "ResourceCompiler_PCH.h"
 #include "TextureCommons.h"
+#include "MemoryTracker.h"
 
 namespace Hail
 {
@@ -9,7 +10,9 @@ namespace Hail
 		{
 			return;
 		}
-		SAFEDELETE_ARRAY(texture.compiledColorValues);
+		// Texture payloads are allocated through the memory tracker by the texture loaders.
+		MemoryTracker::Deallocate(texture.compiledColorValues);
+		texture.compiledColorValues = nullptr;
 		texture.loadState = TEXTURE_LOADSTATE::UNLOADED;
 	}
 
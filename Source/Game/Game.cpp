@@ -35,6 +35,9 @@ namespace
 	Hail::GameCommand_Text g_textCommand1{};
 	Hail::GameCommand_Text g_textCounter{};
 	Hail::GameCommand_Text g_textCounterNumber{};
+	Hail::StringLW g_text1;
+	Hail::StringLW g_textCounterText;
+	Hail::StringLW g_textCounterNumberText;
 	Hail::uint32 g_debugCounter{0u};
 	Hail::uint32 g_frameCounter{ 0u };
 
@@ -146,10 +149,10 @@ namespace Hail
 		g_textCounter.m_layer = 1;
 		g_textCounterNumber.m_layer = 1;
 
-		g_textCommand1.text = L"Tjenare tjena bddy! <3 :}";
+		g_text1 = L"Tjenare tjena bddy! <3 :}";
 		g_textCommand1.transform.SetPosition({ 0.5f, 0.5f });
-		g_textCounter.text = L"Rknare :";
-		g_textCounterNumber.text = StringLW::Format(L"%u", g_debugCounter);
+		g_textCounterText = L"Rknare :";
+		g_textCounterNumberText = StringLW::Format(L"%u", g_debugCounter);
 
 		g_textCommand1.textSize = 48u;
 		g_textCounter.textSize = 48u;
@@ -245,7 +248,7 @@ namespace Hail
 		if (frameData.inputActionMap->GetButtonInput(eInputAction::PlayerAction1) == Hail::eInputState::Pressed)
 		{
 			g_camera.GetTransform().AddToPosition(glm::vec3{ 0.0, 0.0, 1.0 } *g_movementSpeed);
-			g_textCounterNumber.text = StringLW::Format(L"%u", ++g_debugCounter);
+			g_textCounterNumberText = StringLW::Format(L"%u", ++g_debugCounter);
 			g_textCounterNumber.color = glm::vec3(1.0, g_debugCounter * 0.01f, g_debugCounter * 0.01f);
 		}
 		if (frameData.inputActionMap->GetButtonInput(eInputAction::PlayerAction2) == Hail::eInputState::Pressed)
@@ -320,9 +323,9 @@ namespace Hail
 
 	void GameApplication::Shutdown()
 	{
-		g_textCommand1.text.Clear();
-		g_textCounter.text.Clear();
-		g_textCounterNumber.text.Clear();
+		g_text1.Clear();
+		g_textCounterText.Clear();
+		g_textCounterNumberText.Clear();
 	}
 
 
@@ -344,14 +347,14 @@ namespace Hail
 			g_textCounter.transform.SetPosition(player.transform.GetPosition() + glm::vec2(-140, -55));
 			g_textCounterNumber.transform.SetPosition(player.transform.GetPosition() + glm::vec2(30, -55));
 			//DrawCircle2DPixelSpace(commandPoolToFill, player.transform.GetPosition(), 10.0f, true);
-			commandPoolToFill.AddTextCommand(g_textCounter);
-			commandPoolToFill.AddTextCommand(g_textCounterNumber);
+			commandPoolToFill.AddTextCommand(g_textCounter, g_textCounterText);
+			commandPoolToFill.AddTextCommand(g_textCounterNumber, g_textCounterNumberText);
 		}
 		else
 		{
 			g_textCommand1.transform.SetRotationEuler(-90 + g_frameCounter);
 		}
-		commandPoolToFill.AddTextCommand(g_textCommand1);
+		commandPoolToFill.AddTextCommand(g_textCommand1, g_text1);
 		commandPoolToFill.camera2D = g_2DCamera;
 		commandPoolToFill.m_meshCommands.Add(Hail::GameCommand_Mesh());
 
@@ -1,7 +1,8 @@
 #pragma once
 #include "ComponentOwner.h"
+#include "CapabilityDependencies.h"
 
-class CapabilityTickLinkedElement;
+class CapabilityTypeBatch;
 
 enum class ECapabilityTickGroup : uint8_t
 {
@@ -29,6 +30,8 @@ public:
     ECapabilityTickSubGroup SubGroup = ECapabilityTickSubGroup::Normal;
 
     virtual ~Capability() {}
+    // Hide this in a capability type to declare the components it accesses, called once per type.
+    static void DeclareDependencies(CapabilityDependencies& Dependencies) {}
     virtual void Setup() {}
     virtual void LateSetup() {}
     
@@ -48,7 +51,29 @@ public:
         return bActive;
     }
 
+    // Set before the capability is registered, the capability gets its components from the owner entity.
+    void SetOwner(ComponentStorage& Storage, EntityId Entity)
+    {
+        Owner.Storage = &Storage;
+        Owner.Id = Entity;
+    }
+
 protected:
+    // Wrap component access during ticks in these so the tick world can validate the declared dependencies.
+    template<class T>
+    T* AccessForWrite(T* pComponent) const
+    {
+        ValidateComponentAccess(GetComponentTypeId<T>(), true);
+        return pComponent;
+    }
+
+    template<class T>
+    const T* AccessForRead(const T* pComponent) const
+    {
+        ValidateComponentAccess(GetComponentTypeId<T>(), false);
+        return pComponent;
+    }
+
     float ActiveDuration = 0.0;
     float InactiveDuration = 0.0;
     ComponentOwner Owner;
@@ -59,7 +84,11 @@ private:
         return 1.0;
     }
     
-    friend  CapabilityTickLinkedElement;
+    friend CapabilityTypeBatch;
+    friend class CapabilityTickWorld;
+    // The batch of the capability type that ticks the capability, and the index in that batch.
+    CapabilityTypeBatch* pTickBatch = nullptr;
+    uint32_t TickBatchIndex = 0;
     bool bActive = false;
     bool bDidLateSetup = false;
 };
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <cassert>
+
+uint32_t CreateComponentTypeId();
+
+// Unique id per component type, ids are handed out on first use.
+template<class T>
+uint32_t GetComponentTypeId()
+{
+    static const uint32_t TypeId = CreateComponentTypeId();
+    return TypeId;
+}
+
+constexpr uint32_t MaxNumberOfComponentTypes = 64;
+
+// The component types a capability type reads and writes while it ticks, the tick world ticks capability types
+// that do not conflict at the same time. A capability type that declares nothing conflicts with every other type.
+struct CapabilityDependencies
+{
+    template<class T>
+    void Reads()
+    {
+        bDeclared = true;
+        ReadMask |= GetComponentMask(GetComponentTypeId<T>());
+    }
+
+    template<class T>
+    void Writes()
+    {
+        bDeclared = true;
+        WriteMask |= GetComponentMask(GetComponentTypeId<T>());
+    }
+
+    // Declared with no component access, can tick together with anything that does not conflict.
+    void ReadsAndWritesNothing() { bDeclared = true; }
+
+    bool ConflictsWith(const CapabilityDependencies& Other) const
+    {
+        if (!bDeclared || !Other.bDeclared)
+            return true;
+        return (WriteMask & (Other.ReadMask | Other.WriteMask)) != 0 || (Other.WriteMask & ReadMask) != 0;
+    }
+
+    bool CanRead(uint32_t ComponentTypeId) const { return ((ReadMask | WriteMask) & GetComponentMask(ComponentTypeId)) != 0; }
+    bool CanWrite(uint32_t ComponentTypeId) const { return (WriteMask & GetComponentMask(ComponentTypeId)) != 0; }
+
+    static uint64_t GetComponentMask(uint32_t ComponentTypeId)
+    {
+        assert(ComponentTypeId < MaxNumberOfComponentTypes && "Too many component types for the dependency masks.");
+        return 1ull << ComponentTypeId;
+    }
+
+    uint64_t ReadMask = 0;
+    uint64_t WriteMask = 0;
+    bool bDeclared = false;
+};
+
+// Asserts if the capability type that is ticking on this thread did not declare the access, only checked when the tick world validates component access.
+void ValidateComponentAccess(uint32_t ComponentTypeId, bool bWrite);
@@ -1,12 +1,13 @@
 #pragma once
-
-struct ComponentOwner;
+#include "ComponentStorage.h"
 
 // "Component"
 struct Component
 {
     virtual ~Component() {}
-    ComponentOwner* Owner = nullptr;
+    // The entity the component belongs to, set by ComponentOwner::GetOrCreateData. The ComponentOwner is a member of one
+    // capability and does not live as long as the component.
+    EntityId Entity;
 };
 
 // have static array of Components?
@@ -1,17 +1,30 @@
 #pragma once
 #include "Component.h"
+#include "ComponentStorage.h"
 
 // "Entity / Actor"
 struct ComponentOwner
 {
-    int Id = -1; // hash?
+    EntityId Id;
+    ComponentStorage* Storage = nullptr;
 
-   template<class T>
+    // The pointer is valid until the next component or entity is added or removed in the storage.
+    template<class T>
     T* GetOrCreateData()
     {
-       // go to class lookup and see if we have this data
-       // otherwise create it
-       Component* Data = nullptr;
+        assert(Storage && Id.IsValid() && "Component owner is not an entity in a component storage.");
+        T* Data = Storage->GetComponent<T>(Id);
+        if (Data == nullptr)
+        {
+            Data = &Storage->AddComponent<T>(Id);
+            Data->Entity = Id;
+        }
         return Data;
     }
+
+    template<class T>
+    T* GetData() const
+    {
+        return Storage ? Storage->GetComponent<T>(Id) : nullptr;
+    }
 };
@@ -0,0 +1,233 @@
+#include "GameSystem_PCH.h"
+#include "ComponentStorage.h"
+
+using namespace Hail;
+
+namespace
+{
+	uint32_t AlignUp(uint32_t Value, uint32_t Alignment)
+	{
+		return (Value + Alignment - 1) & ~(Alignment - 1);
+	}
+}
+
+ComponentStorage::ComponentStorage()
+{
+	pEmptyArchetype = GetOrCreateArchetype(0);
+}
+
+ComponentStorage::~ComponentStorage()
+{
+	for (uint32_t iArchetype = 0; iArchetype < Archetypes.Size(); ++iArchetype)
+	{
+		ComponentArchetype* pArchetype = Archetypes[iArchetype];
+		for (uint32_t Row = 0; Row < pArchetype->NumberOfEntities; ++Row)
+		{
+			for (uint32_t iColumn = 1; iColumn < pArchetype->ColumnComponentTypeIds.Size(); ++iColumn)
+				TypeInfos[pArchetype->ColumnComponentTypeIds[iColumn]].Destruct(pArchetype->GetElement(Row, iColumn));
+		}
+		for (uint32_t iChunk = 0; iChunk < pArchetype->Chunks.Size(); ++iChunk)
+			MemoryTracker::Deallocate(pArchetype->Chunks[iChunk]);
+		delete pArchetype;
+	}
+}
+
+EntityId ComponentStorage::CreateEntity()
+{
+	EntityId NewEntity;
+	if (FreeIndices.Size())
+	{
+		NewEntity.Index = FreeIndices.GetLast();
+		FreeIndices.RemoveLast();
+	}
+	else
+	{
+		NewEntity.Index = Records.Size();
+		Records.Add(EntityRecord());
+	}
+
+	EntityRecord& Record = Records[NewEntity.Index];
+	NewEntity.Generation = Record.Generation;
+	Record.pArchetype = pEmptyArchetype;
+	Record.Row = AllocateRow(*pEmptyArchetype);
+	*static_cast<EntityId*>(pEmptyArchetype->GetElement(Record.Row, 0)) = NewEntity;
+	return NewEntity;
+}
+
+void ComponentStorage::DestroyEntity(EntityId Entity)
+{
+	if (!IsAlive(Entity))
+	{
+		assert(false && "Destroying an entity that is not alive.");
+		return;
+	}
+
+	EntityRecord& Record = Records[Entity.Index];
+	ComponentArchetype& Archetype = *Record.pArchetype;
+	for (uint32_t iColumn = 1; iColumn < Archetype.ColumnComponentTypeIds.Size(); ++iColumn)
+		TypeInfos[Archetype.ColumnComponentTypeIds[iColumn]].Destruct(Archetype.GetElement(Record.Row, iColumn));
+	RemoveRow(Archetype, Record.Row);
+
+	Record.pArchetype = nullptr;
+	Record.Generation++;
+	FreeIndices.Add(Entity.Index);
+}
+
+void* ComponentStorage::AddComponent(EntityId Entity, uint32_t ComponentTypeId)
+{
+	if (!IsAlive(Entity))
+	{
+		assert(false && "Adding a component to an entity that is not alive.");
+		return nullptr;
+	}
+
+	EntityRecord& Record = Records[Entity.Index];
+	ComponentArchetype& SourceArchetype = *Record.pArchetype;
+	if (SourceArchetype.ColumnOfComponentType[ComponentTypeId] >= 0)
+		return SourceArchetype.GetElement(Record.Row, SourceArchetype.ColumnOfComponentType[ComponentTypeId]);
+
+	ComponentArchetype* pTargetArchetype = SourceArchetype.AddEdges[ComponentTypeId];
+	if (pTargetArchetype == nullptr)
+	{
+		pTargetArchetype = GetOrCreateArchetype(SourceArchetype.ComponentMask | CapabilityDependencies::GetComponentMask(ComponentTypeId));
+		SourceArchetype.AddEdges[ComponentTypeId] = pTargetArchetype;
+		pTargetArchetype->RemoveEdges[ComponentTypeId] = &SourceArchetype;
+	}
+
+	MoveEntity(Record, *pTargetArchetype);
+	void* pComponent = pTargetArchetype->GetElement(Record.Row, pTargetArchetype->ColumnOfComponentType[ComponentTypeId]);
+	TypeInfos[ComponentTypeId].DefaultConstruct(pComponent);
+	return pComponent;
+}
+
+void ComponentStorage::RemoveComponent(EntityId Entity, uint32_t ComponentTypeId)
+{
+	if (!IsAlive(Entity))
+	{
+		assert(false && "Removing a component from an entity that is not alive.");
+		return;
+	}
+
+	EntityRecord& Record = Records[Entity.Index];
+	ComponentArchetype& SourceArchetype = *Record.pArchetype;
+	if (ComponentTypeId >= MaxNumberOfComponentTypes || SourceArchetype.ColumnOfComponentType[ComponentTypeId] < 0)
+		return;
+
+	ComponentArchetype* pTargetArchetype = SourceArchetype.RemoveEdges[ComponentTypeId];
+	if (pTargetArchetype == nullptr)
+	{
+		pTargetArchetype = GetOrCreateArchetype(SourceArchetype.ComponentMask & ~CapabilityDependencies::GetComponentMask(ComponentTypeId));
+		SourceArchetype.RemoveEdges[ComponentTypeId] = pTargetArchetype;
+		pTargetArchetype->AddEdges[ComponentTypeId] = &SourceArchetype;
+	}
+	MoveEntity(Record, *pTargetArchetype);
+}
+
+void* ComponentStorage::GetComponent(EntityId Entity, uint32_t ComponentTypeId) const
+{
+	if (!IsAlive(Entity) || ComponentTypeId >= MaxNumberOfComponentTypes)
+		return nullptr;
+
+	const EntityRecord& Record = Records[Entity.Index];
+	const int8_t Column = Record.pArchetype->ColumnOfComponentType[ComponentTypeId];
+	return Column < 0 ? nullptr : Record.pArchetype->GetElement(Record.Row, Column);
+}
+
+ComponentArchetype* ComponentStorage::GetOrCreateArchetype(uint64_t ComponentMask)
+{
+	for (uint32_t iArchetype = 0; iArchetype < Archetypes.Size(); ++iArchetype)
+	{
+		if (Archetypes[iArchetype]->ComponentMask == ComponentMask)
+			return Archetypes[iArchetype];
+	}
+
+	ComponentArchetype* pArchetype = new ComponentArchetype();
+	pArchetype->ComponentMask = ComponentMask;
+	for (uint32_t TypeId = 0; TypeId < MaxNumberOfComponentTypes; ++TypeId)
+	{
+		pArchetype->ColumnOfComponentType[TypeId] = -1;
+		pArchetype->AddEdges[TypeId] = nullptr;
+		pArchetype->RemoveEdges[TypeId] = nullptr;
+	}
+
+	// Column 0 is the entity ids, followed by the component types in type id order.
+	uint32_t BytesPerEntity = sizeof(EntityId);
+	uint32_t AlignmentPadding = 0;
+	pArchetype->ColumnComponentTypeIds.Add(EntityId::InvalidIndex);
+	pArchetype->ColumnSizes.Add(sizeof(EntityId));
+	for (uint32_t TypeId = 0; TypeId < MaxNumberOfComponentTypes; ++TypeId)
+	{
+		if ((ComponentMask & CapabilityDependencies::GetComponentMask(TypeId)) == 0)
+			continue;
+		assert(TypeInfos[TypeId].Size != 0 && "Component type is used in an archetype before it was registered.");
+		pArchetype->ColumnOfComponentType[TypeId] = (int8_t)pArchetype->ColumnComponentTypeIds.Size();
+		pArchetype->ColumnComponentTypeIds.Add(TypeId);
+		pArchetype->ColumnSizes.Add(TypeInfos[TypeId].Size);
+		BytesPerEntity += TypeInfos[TypeId].Size;
+		AlignmentPadding += TypeInfos[TypeId].Alignment;
+	}
+
+	// Components larger than a chunk get one entity per chunk.
+	pArchetype->ChunkCapacity = ComponentArchetype::ChunkSizeInBytes > AlignmentPadding + BytesPerEntity ? (ComponentArchetype::ChunkSizeInBytes - AlignmentPadding) / BytesPerEntity : 1;
+	uint32_t Offset = 0;
+	for (uint32_t iColumn = 0; iColumn < pArchetype->ColumnComponentTypeIds.Size(); ++iColumn)
+	{
+		const uint32_t Alignment = iColumn == 0 ? alignof(EntityId) : TypeInfos[pArchetype->ColumnComponentTypeIds[iColumn]].Alignment;
+		Offset = AlignUp(Offset, Alignment);
+		pArchetype->ColumnOffsets.Add(Offset);
+		Offset += pArchetype->ColumnSizes[iColumn] * pArchetype->ChunkCapacity;
+	}
+	pArchetype->AllocatedChunkSize = AlignUp(Offset, ComponentArchetype::ChunkAlignment);
+
+	Archetypes.Add(pArchetype);
+	return pArchetype;
+}
+
+uint32_t ComponentStorage::AllocateRow(ComponentArchetype& Archetype)
+{
+	// Chunks are kept when the archetype shrinks and reused when it grows again.
+	if (Archetype.NumberOfEntities == Archetype.Chunks.Size() * Archetype.ChunkCapacity)
+		Archetype.Chunks.Add(static_cast<uint8_t*>(H_TRACKED_ALLOCATE(Archetype.AllocatedChunkSize, ComponentArchetype::ChunkAlignment, eMemoryTag::Components)));
+	return Archetype.NumberOfEntities++;
+}
+
+void ComponentStorage::RemoveRow(ComponentArchetype& Archetype, uint32_t Row)
+{
+	const uint32_t LastRow = --Archetype.NumberOfEntities;
+	if (Row == LastRow)
+		return;
+
+	const EntityId MovedEntity = *static_cast<EntityId*>(Archetype.GetElement(LastRow, 0));
+	*static_cast<EntityId*>(Archetype.GetElement(Row, 0)) = MovedEntity;
+	for (uint32_t iColumn = 1; iColumn < Archetype.ColumnComponentTypeIds.Size(); ++iColumn)
+	{
+		const ComponentTypeInfo& TypeInfo = TypeInfos[Archetype.ColumnComponentTypeIds[iColumn]];
+		void* pLastComponent = Archetype.GetElement(LastRow, iColumn);
+		TypeInfo.MoveConstruct(Archetype.GetElement(Row, iColumn), pLastComponent);
+		TypeInfo.Destruct(pLastComponent);
+	}
+	Records[MovedEntity.Index].Row = Row;
+}
+
+void ComponentStorage::MoveEntity(EntityRecord& Record, ComponentArchetype& TargetArchetype)
+{
+	ComponentArchetype& SourceArchetype = *Record.pArchetype;
+	const uint32_t SourceRow = Record.Row;
+	const uint32_t TargetRow = AllocateRow(TargetArchetype);
+
+	*static_cast<EntityId*>(TargetArchetype.GetElement(TargetRow, 0)) = *static_cast<EntityId*>(SourceArchetype.GetElement(SourceRow, 0));
+	for (uint32_t iColumn = 1; iColumn < SourceArchetype.ColumnComponentTypeIds.Size(); ++iColumn)
+	{
+		const uint32_t TypeId = SourceArchetype.ColumnComponentTypeIds[iColumn];
+		const ComponentTypeInfo& TypeInfo = TypeInfos[TypeId];
+		void* pSourceComponent = SourceArchetype.GetElement(SourceRow, iColumn);
+		const int8_t TargetColumn = TargetArchetype.ColumnOfComponentType[TypeId];
+		if (TargetColumn >= 0)
+			TypeInfo.MoveConstruct(TargetArchetype.GetElement(TargetRow, TargetColumn), pSourceComponent);
+		TypeInfo.Destruct(pSourceComponent);
+	}
+
+	RemoveRow(SourceArchetype, SourceRow);
+	Record.pArchetype = &TargetArchetype;
+	Record.Row = TargetRow;
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "CapabilityDependencies.h"
+#include "Containers/GrowingArray/GrowingArray.h"
+#include "MemoryTracker.h"
+#include <new>
+#include <utility>
+
+// Generational handle to an entity in a ComponentStorage, the index of a destroyed entity is reused with the next generation.
+struct EntityId
+{
+    static constexpr uint32_t InvalidIndex = 0xFFFFFFFF;
+
+    uint32_t Index = InvalidIndex;
+    uint32_t Generation = 0;
+
+    bool IsValid() const { return Index != InvalidIndex; }
+    bool operator==(const EntityId& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+    bool operator!=(const EntityId& Other) const { return !(*this == Other); }
+};
+
+// How the storage creates, moves and destroys a component type without knowing the type.
+struct ComponentTypeInfo
+{
+    uint32_t Size = 0;
+    uint32_t Alignment = 0;
+    void (*DefaultConstruct)(void* pDestination) = nullptr;
+    void (*MoveConstruct)(void* pDestination, void* pSource) = nullptr;
+    void (*Destruct)(void* pComponent) = nullptr;
+};
+
+// All entities with exactly the same set of component types. Entities are stored in fixed size chunks where each component
+// type is one contiguous column, so iterating a component type walks linear memory. Rows are kept packed with swap-back removal.
+struct ComponentArchetype
+{
+    static constexpr uint32_t ChunkSizeInBytes = 16 * 1024;
+    static constexpr uint32_t ChunkAlignment = 64;
+
+    uint64_t ComponentMask = 0;
+    // Column of each component type, -1 if the archetype does not have the type. Column 0 is the entity ids.
+    int8_t ColumnOfComponentType[MaxNumberOfComponentTypes];
+    Hail::GrowingArray<uint32_t> ColumnComponentTypeIds;
+    Hail::GrowingArray<uint32_t> ColumnOffsets;
+    Hail::GrowingArray<uint32_t> ColumnSizes;
+    uint32_t ChunkCapacity = 0;
+    uint32_t AllocatedChunkSize = 0;
+    Hail::GrowingArray<uint8_t*> Chunks;
+    uint32_t NumberOfEntities = 0;
+    // The archetype with one component type added or removed, filled in on the first move between them.
+    ComponentArchetype* AddEdges[MaxNumberOfComponentTypes];
+    ComponentArchetype* RemoveEdges[MaxNumberOfComponentTypes];
+
+    uint32_t GetNumberOfEntitiesInChunk(uint32_t ChunkIndex) const
+    {
+        const uint32_t FirstRow = ChunkIndex * ChunkCapacity;
+        return NumberOfEntities - FirstRow < ChunkCapacity ? NumberOfEntities - FirstRow : ChunkCapacity;
+    }
+    uint32_t GetNumberOfUsedChunks() const { return (NumberOfEntities + ChunkCapacity - 1) / ChunkCapacity; }
+    void* GetElement(uint32_t Row, uint32_t Column) const
+    {
+        return Chunks[Row / ChunkCapacity] + ColumnOffsets[Column] + (Row % ChunkCapacity) * ColumnSizes[Column];
+    }
+    EntityId* GetEntities(uint32_t ChunkIndex) const { return reinterpret_cast<EntityId*>(Chunks[ChunkIndex]); }
+    template<class T>
+    T* GetColumn(uint32_t ChunkIndex) const
+    {
+        return reinterpret_cast<T*>(Chunks[ChunkIndex] + ColumnOffsets[ColumnOfComponentType[GetComponentTypeId<T>()]]);
+    }
+};
+
+// Archetype based storage of the component data of entities. Adding and removing entities and components is O(1) apart from the
+// first time an archetype is created. Components move when their entity changes archetype or another entity is removed from the
+// same archetype, so component pointers are only valid until the next add or remove in the storage.
+// Adding and removing is not thread safe, ticking capabilities may read and write component data in parallel as declared in their dependencies.
+class ComponentStorage
+{
+public:
+    ComponentStorage();
+    ~ComponentStorage();
+
+    EntityId CreateEntity();
+    void DestroyEntity(EntityId Entity);
+    bool IsAlive(EntityId Entity) const { return Entity.Index < Records.Size() && Records[Entity.Index].Generation == Entity.Generation && Records[Entity.Index].pArchetype; }
+    uint32_t GetNumberOfEntities() const { return Records.Size() - FreeIndices.Size(); }
+    uint32_t GetNumberOfArchetypes() const { return Archetypes.Size(); }
+
+    // Returns the existing component if the entity already has one of the type.
+    template<class T>
+    T& AddComponent(EntityId Entity)
+    {
+        const uint32_t TypeId = RegisterComponentType<T>();
+        return *static_cast<T*>(AddComponent(Entity, TypeId));
+    }
+
+    template<class T>
+    void RemoveComponent(EntityId Entity) { RemoveComponent(Entity, GetComponentTypeId<T>()); }
+
+    // Returns nullptr if the entity does not have the component.
+    template<class T>
+    T* GetComponent(EntityId Entity) const { return static_cast<T*>(GetComponent(Entity, GetComponentTypeId<T>())); }
+
+    template<class T>
+    bool HasComponent(EntityId Entity) const { return GetComponent(Entity, GetComponentTypeId<T>()) != nullptr; }
+
+    // Calls Function(EntityId, Ts&...) for every entity that has all the component types, one chunk column at a time.
+    template<class... Ts, class FunctionType>
+    void ForEach(FunctionType&& Function) const
+    {
+        const uint64_t RequiredMask = (0ull | ... | CapabilityDependencies::GetComponentMask(GetComponentTypeId<Ts>()));
+        for (uint32_t iArchetype = 0; iArchetype < Archetypes.Size(); ++iArchetype)
+        {
+            const ComponentArchetype& Archetype = *Archetypes[iArchetype];
+            if ((Archetype.ComponentMask & RequiredMask) != RequiredMask)
+                continue;
+            const uint32_t NumberOfUsedChunks = Archetype.GetNumberOfUsedChunks();
+            for (uint32_t iChunk = 0; iChunk < NumberOfUsedChunks; ++iChunk)
+                ForEachInChunk<Ts...>(Function, Archetype.GetNumberOfEntitiesInChunk(iChunk), Archetype.GetEntities(iChunk), Archetype.GetColumn<Ts>(iChunk)...);
+        }
+    }
+
+private:
+    struct EntityRecord
+    {
+        ComponentArchetype* pArchetype = nullptr;
+        uint32_t Row = 0;
+        uint32_t Generation = 0;
+    };
+
+    template<class T>
+    uint32_t RegisterComponentType()
+    {
+        const uint32_t TypeId = GetComponentTypeId<T>();
+        assert(TypeId < MaxNumberOfComponentTypes && "Too many component types for the archetype masks.");
+        ComponentTypeInfo& TypeInfo = TypeInfos[TypeId];
+        if (TypeInfo.Size == 0)
+        {
+            TypeInfo.Size = sizeof(T);
+            TypeInfo.Alignment = alignof(T);
+            TypeInfo.DefaultConstruct = [](void* pDestination) { new (pDestination) T(); };
+            TypeInfo.MoveConstruct = [](void* pDestination, void* pSource) { new (pDestination) T(std::move(*static_cast<T*>(pSource))); };
+            TypeInfo.Destruct = [](void* pComponent) { static_cast<T*>(pComponent)->~T(); };
+        }
+        return TypeId;
+    }
+
+    template<class... Ts, class FunctionType>
+    static void ForEachInChunk(FunctionType& Function, uint32_t NumberOfEntities, const EntityId* pEntities, Ts*... pColumns)
+    {
+        for (uint32_t i = 0; i < NumberOfEntities; ++i)
+            Function(pEntities[i], pColumns[i]...);
+    }
+
+    void* AddComponent(EntityId Entity, uint32_t ComponentTypeId);
+    void RemoveComponent(EntityId Entity, uint32_t ComponentTypeId);
+    void* GetComponent(EntityId Entity, uint32_t ComponentTypeId) const;
+
+    ComponentArchetype* GetOrCreateArchetype(uint64_t ComponentMask);
+    uint32_t AllocateRow(ComponentArchetype& Archetype);
+    // The components of the row have to be destroyed or moved from, the last row is moved in to its place.
+    void RemoveRow(ComponentArchetype& Archetype, uint32_t Row);
+    void MoveEntity(EntityRecord& Record, ComponentArchetype& TargetArchetype);
+
+    ComponentTypeInfo TypeInfos[MaxNumberOfComponentTypes];
+    Hail::GrowingArray<ComponentArchetype*> Archetypes;
+    ComponentArchetype* pEmptyArchetype = nullptr;
+    Hail::GrowingArray<EntityRecord> Records;
+    Hail::GrowingArray<uint32_t> FreeIndices;
+};
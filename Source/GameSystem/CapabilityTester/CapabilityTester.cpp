@@ -14,8 +14,8 @@ void SpriteCapabilityData::Init()
 
 void InputScreenMovementCapability::LateSetup()
 {
-    //MovementData = Owner.GetOrCreateData(); //GetOrCreateData<MovementCapabilityData>();
-    //MovementData->Speed = 0.005f;
+    MovementData = Owner.GetOrCreateData<MovementComponent>();
+    MovementData->Speed = 0.005f;
 }
 
 bool InputScreenMovementCapability::ShouldActivate() const
@@ -62,8 +62,8 @@ void InputScreenMovementCapability::TickActive(float DeltaTime)
 
 void ScreenMovementCapability::LateSetup()
 {
-    //MovementData = Owner.GetOrCreateData(); //GetOrCreateData<MovementCapabilityData>();
-    //SpriteData = Owner.GetOrCreateData(); //GetOrCreateData<SpriteData>();
+    MovementData = Owner.GetOrCreateData<MovementComponent>();
+    SpriteData = Owner.GetOrCreateData<SpriteComponent>();
 }
 
 bool ScreenMovementCapability::ShouldActivate() const
@@ -94,14 +94,16 @@ bool ScreenMovementCapability::ShouldDeactivate() const
 
 void ScreenMovementCapability::TickActive(float DeltaTime)
 {
+    const MovementComponent* Movement = AccessForRead(MovementData);
+    SpriteComponent* Sprite = AccessForWrite(SpriteData);
     glm::vec2 Position;
     glm::vec2 Velocity;
-    Velocity.x = MovementData->VelocityX * DeltaTime;
-    Velocity.y = MovementData->VelocityY * DeltaTime;
-    Position.x = MovementData->PositionX;  
-    Position.y = MovementData->PositionY;  
-    SpriteData->Sprite.transform.SetPosition(Position + Velocity);
-    SpriteData->Sprite.transform.LookAt(glm::normalize(Velocity));
+    Velocity.x = Movement->VelocityX * DeltaTime;
+    Velocity.y = Movement->VelocityY * DeltaTime;
+    Position.x = Movement->PositionX;  
+    Position.y = Movement->PositionY;  
+    Sprite->Sprite.transform.SetPosition(Position + Velocity);
+    Sprite->Sprite.transform.LookAt(glm::normalize(Velocity));
 }
 
 // ----------------------------------------
@@ -112,13 +114,25 @@ CapabilityTester::CapabilityTester()
 
 void CapabilityTester::Init()
 {
+    JobSystem.Init(0);
     TickWorld = new CapabilityTickWorld();
     TickWorld->Init();
+    TickWorld->SetJobSystem(&JobSystem);
+    Storage = new ComponentStorage();
+
+    // The components are created up front so the pointers the capabilities get in LateSetup stay valid.
+    const EntityId Player = Storage->CreateEntity();
+    Storage->AddComponent<MovementComponent>(Player);
+    Storage->AddComponent<SpriteComponent>(Player);
 
     InputScreenMovementCapability* InputMovementCapa = new InputScreenMovementCapability();
+    InputMovementCapa->SetOwner(*Storage, Player);
     TickWorld->RegisterCapability(*InputMovementCapa);
+    Capabilities.Add(InputMovementCapa);
     ScreenMovementCapability* MovementCapa = new ScreenMovementCapability();
+    MovementCapa->SetOwner(*Storage, Player);
     TickWorld->RegisterCapability(*MovementCapa);
+    Capabilities.Add(MovementCapa);
 }
 
 void CapabilityTester::Update(float DeltaTime)
@@ -132,3 +146,22 @@ void CapabilityTester::Update(float DeltaTime)
     TickWorld->Tick(DeltaTime);
 }
 
+void CapabilityTester::Shutdown()
+{
+    if (!bHasRunInit)
+        return;
+
+    for (uint32_t i = 0; i < Capabilities.Size(); ++i)
+    {
+        TickWorld->UnregisterCapability(*Capabilities[i]);
+        delete Capabilities[i];
+    }
+    Capabilities.RemoveAll();
+    delete TickWorld;
+    TickWorld = nullptr;
+    delete Storage;
+    Storage = nullptr;
+    JobSystem.Cleanup();
+    bHasRunInit = false;
+}
+
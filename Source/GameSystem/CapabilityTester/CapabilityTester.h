@@ -2,6 +2,7 @@
 #include "Capability/Component.h"
 #include "Capability/Capability.h"
 #include "CapabilityTickManager/CapabilityTickManager.h"
+#include "JobSystem.h"
 #include "../Engine/RenderCommands.h"
 
 struct SpriteComponent : Component
@@ -27,7 +28,9 @@ struct MovementComponent : Component
 
 class InputScreenMovementCapability : public Capability
 {
+public:
     ~InputScreenMovementCapability()  {};
+    static void DeclareDependencies(CapabilityDependencies& Dependencies) { Dependencies.Writes<MovementComponent>(); }
     void LateSetup() override;
     bool ShouldActivate() const override;
     bool ShouldDeactivate() const override;
@@ -39,7 +42,13 @@ class InputScreenMovementCapability : public Capability
 
 class ScreenMovementCapability : public Capability
 {
+public:
     ~ScreenMovementCapability() {}
+    static void DeclareDependencies(CapabilityDependencies& Dependencies)
+    {
+        Dependencies.Reads<MovementComponent>();
+        Dependencies.Writes<SpriteComponent>();
+    }
     void LateSetup() override;
     bool ShouldActivate() const override;
     bool ShouldDeactivate() const override;
@@ -58,10 +67,15 @@ public:
     CapabilityTester();
 
     void Update(float DeltaTime);
+    void Shutdown();
 
 private:
     void Init();
 
     bool bHasRunInit = false;
+    // Workers for the parallel tick waves of the tick world.
+    Hail::JobSystem JobSystem;
     CapabilityTickWorld* TickWorld = nullptr;
+    Hail::GrowingArray<Capability*> Capabilities;
+    ComponentStorage* Storage = nullptr;
 };
\ No newline at end of file
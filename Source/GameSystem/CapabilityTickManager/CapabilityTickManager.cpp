@@ -1,195 +1,340 @@
 #include "GameSystem_PCH.h"
 #include "CapabilityTickManager.h"
 #include "Capability.h"
+#include "JobSystem.h"
 
-void CapabilityTickLinkedElement::Tick(float DeltaTime)
+using namespace Hail;
+
+namespace
 {
-	if (!pCapability->bDidLateSetup)
+	// Dependencies of the type batch ticking on this thread, only set when the world validates component access.
+	thread_local const CapabilityDependencies* tl_pTickingDependencies = nullptr;
+
+	struct TickWaveJobData
 	{
-		pCapability->bDidLateSetup = true;
-		pCapability->LateSetup();
-	}
-	
-	if (!pCapability->bActive && pCapability->ShouldActivate())
+		CapabilityTickWorld* pWorld;
+		CapabilityTypeBatch** ppBatches;
+		float DeltaTime;
+	};
+}
+
+// The first use of a type can be on a job system worker, so the ids are handed out atomically.
+uint32_t CreateCapabilityTypeId()
+{
+	static std::atomic_uint32_t NextTypeId{ 0 };
+	return NextTypeId.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t CreateComponentTypeId()
+{
+	static std::atomic_uint32_t NextTypeId{ 0 };
+	return NextTypeId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ValidateComponentAccess(uint32_t ComponentTypeId, bool bWrite)
+{
+	if (tl_pTickingDependencies == nullptr)
+		return;
+	if (bWrite)
+		assert(tl_pTickingDependencies->CanWrite(ComponentTypeId) && "Capability wrote to a component type it did not declare.");
+	else
+		assert(tl_pTickingDependencies->CanRead(ComponentTypeId) && "Capability read a component type it did not declare.");
+}
+
+// ---
+
+void CapabilityTypeBatch::Add(Capability& NewCapability)
+{
+	const uint32_t Index = Capabilities.Size();
+	if (Index % 64 == 0)
 	{
-		pCapability->bActive = true;
-		pCapability->ActiveDuration = 0.0;
-		pCapability->InactiveDuration = 0.0;
-		pCapability->OnActivated();
+		ActiveBits.Add(0);
+		NeedsLateSetupBits.Add(0);
 	}
-	else if (pCapability->bActive && pCapability->ShouldDeactivate())
+	Capabilities.Add(&NewCapability);
+	NewCapability.pTickBatch = this;
+	NewCapability.TickBatchIndex = Index;
+
+	SetBit(ActiveBits, Index, NewCapability.bActive);
+	if (!NewCapability.bDidLateSetup)
 	{
-		pCapability->bActive = false;
-		pCapability->ActiveDuration = 0.0;
-		pCapability->InactiveDuration = 0.0;
-		pCapability->OnDeactivated();
+		SetBit(NeedsLateSetupBits, Index, true);
+		NumberOfCapabilitiesNeedingLateSetup++;
 	}
+}
+
+void CapabilityTypeBatch::Remove(Capability& CapabilityToRemove)
+{
+	assert(CapabilityToRemove.pTickBatch == this);
+	const uint32_t Index = CapabilityToRemove.TickBatchIndex;
+	const uint32_t LastIndex = Capabilities.Size() - 1;
+	if (IsBitSet(NeedsLateSetupBits, Index))
+		NumberOfCapabilitiesNeedingLateSetup--;
 
-	if (pCapability->bActive)
+	// The last capability is moved in to the removed slot, together with its bits.
+	if (Index != LastIndex)
 	{
-		pCapability->TickActive(DeltaTime * pCapability->GetTimeDilation());
-		pCapability->ActiveDuration += DeltaTime * pCapability->GetTimeDilation();
+		Capability* pMovedCapability = Capabilities[LastIndex];
+		Capabilities[Index] = pMovedCapability;
+		pMovedCapability->TickBatchIndex = Index;
+		SetBit(ActiveBits, Index, IsBitSet(ActiveBits, LastIndex));
+		SetBit(NeedsLateSetupBits, Index, IsBitSet(NeedsLateSetupBits, LastIndex));
 	}
-	else
+	SetBit(ActiveBits, LastIndex, false);
+	SetBit(NeedsLateSetupBits, LastIndex, false);
+	Capabilities.RemoveLast();
+	if (LastIndex % 64 == 0)
 	{
-		pCapability->TickInactive(DeltaTime * pCapability->GetTimeDilation());
-		pCapability->InactiveDuration += DeltaTime * pCapability->GetTimeDilation();
+		ActiveBits.RemoveLast();
+		NeedsLateSetupBits.RemoveLast();
 	}
+
+	CapabilityToRemove.pTickBatch = nullptr;
+	CapabilityToRemove.TickBatchIndex = 0;
 }
 
-/*void CapabilityTickLinkedElement::Register(CapabilityTickWorld* World)
+uint32_t CapabilityTypeBatch::GetNumberOfActiveCapabilities() const
 {
-    assert(pWorld == nullptr);
-    pWorld = World;
-    pWorld->RegisterTicker(*this);
-}*/
+	uint32_t NumberOfActiveCapabilities = 0;
+	for (uint32_t i = 0; i < Capabilities.Size(); ++i)
+	{
+		if (IsBitSet(ActiveBits, i))
+			NumberOfActiveCapabilities++;
+	}
+	return NumberOfActiveCapabilities;
+}
+
+void CapabilityTypeBatch::SetBit(GrowingArray<uint64_t>& Bits, uint32_t Index, bool bValue)
+{
+	const uint64_t Mask = 1ull << (Index % 64);
+	if (bValue)
+		Bits[Index / 64] |= Mask;
+	else
+		Bits[Index / 64] &= ~Mask;
+}
+
+void CapabilityTypeBatch::SetCapabilityActive(Capability& CapabilityToSet, bool bActive)
+{
+	CapabilityToSet.bActive = bActive;
+	CapabilityToSet.ActiveDuration = 0.0;
+	CapabilityToSet.InactiveDuration = 0.0;
+}
 
-void CapabilityTickLinkedElement::Unregister()
+void CapabilityTypeBatch::AddTickDuration(Capability& CapabilityTicked, bool bActive, float DeltaTime)
 {
-    assert(pWorld != nullptr);
-    
+	if (bActive)
+		CapabilityTicked.ActiveDuration += DeltaTime;
+	else
+		CapabilityTicked.InactiveDuration += DeltaTime;
 }
 
 // ---
 
-void SortWithQuick(GrowingArray<CapabilityTickLinkedElement*> * aArray, uint8_t left, uint8_t right)
+CapabilityTickWorld::CapabilityTickWorld()
 {
-	uint8_t i = left, j = right;
-	CapabilityTickLinkedElement* temp;
-	const CapabilityTickLinkedElement* pivot = (*aArray)[(left + right) / 2];
+}
 
-	/* partition */
-	while (i <= j) 
+CapabilityTickWorld::~CapabilityTickWorld()
+{
+	for (uint32_t iSubGroup = 0; iSubGroup < TickBatches.Getsize(); ++iSubGroup)
 	{
-		while ((*aArray)[i]->Sortable < pivot->Sortable)
-			i++;
-		while ((*aArray)[j]->Sortable > pivot->Sortable)
-			j--;
-		
-		if (i <= j) {
-			temp = (*aArray)[i];
-			(*aArray)[i] = (*aArray)[j];
-			(*aArray)[j] = temp;
-			i++;
-			j--;
-		}
+		GrowingArray<CapabilityTypeBatch*>& Batches = TickBatches[iSubGroup];
+		for (uint32_t iBatch = 0; iBatch < Batches.Size(); ++iBatch)
+			delete Batches[iBatch];
 	}
-	
-	/* recursion */
-	if (left < j)
-		SortWithQuick(aArray,  left, j);
-	if (i < right)
-		SortWithQuick(aArray, i, right);
 }
 
-CapabilityTickLinkedList::CapabilityTickLinkedList()
+void CapabilityTickWorld::Init()
 {
+	PendingRegistrations.Prepare(256);
+	PendingUnregistrations.Prepare(64);
+	for (uint32_t iSubGroup = 0; iSubGroup < TickBatches.Getsize(); ++iSubGroup)
+		TickBatches[iSubGroup].Prepare(16);
 }
 
-void CapabilityTickLinkedList::TickAll(float DeltaTime)
+void CapabilityTickWorld::Tick(float DeltaTime)
 {
-	if (ElementsToAdd.Size() > 0)
+	AddPendingRegistrations();
+
+	bIsTicking = true;
+	if (TickMode == ECapabilityTickMode::Serial || pJobSystem == nullptr)
 	{
-		// insert new elements while ticking
-		if (ElementsToAdd.Size() > 1)
-			SortWithQuick(&ElementsToAdd, 0, (uint8_t)ElementsToAdd.Size() -1);
-		size_t AddNextIndex = 0;
-		size_t NumThingsToAdd = ElementsToAdd.Size();
-
-		CapabilityTickLinkedElement* pCurrentElement = pFirstElement;
-		do
+		// Sub groups are stored in tick order, one virtual call per type batch.
+		for (uint32_t iSubGroup = 0; iSubGroup < TickBatches.Getsize(); ++iSubGroup)
 		{
-			// we're first
-			if (pCurrentElement == nullptr) 
+			GrowingArray<CapabilityTypeBatch*>& Batches = TickBatches[iSubGroup];
+			for (uint32_t iBatch = 0; iBatch < Batches.Size(); ++iBatch)
 			{
-				pFirstElement = ElementsToAdd[AddNextIndex++];
-				pCurrentElement = pFirstElement;
+				TickBatch(*Batches[iBatch], DeltaTime);
+				RemovePendingUnregistrations();
 			}
+		}
+		bIsTicking = false;
+		return;
+	}
 
-			// we're last
-			const bool bAnythingLeftToAdd = AddNextIndex < NumThingsToAdd;
-			if (bAnythingLeftToAdd && pCurrentElement->pNext == nullptr) 
-			{
-				CapabilityTickLinkedElement* ToInsert = ElementsToAdd[AddNextIndex++];
-				pCurrentElement->pNext = ToInsert;
-				ToInsert->pPrevious = pCurrentElement;
-				pLastElement = ToInsert;
-			}
-			else if (bAnythingLeftToAdd && ElementsToAdd[AddNextIndex]->Sortable < pCurrentElement->Sortable)
-			{
-				CapabilityTickLinkedElement* ToInsert = ElementsToAdd[AddNextIndex++];
-				CapabilityTickLinkedElement* pPrevious = pCurrentElement->pPrevious;
-				if (pPrevious != nullptr)
-				{
-					pPrevious->pNext = ToInsert;
-					ToInsert->pPrevious = pPrevious;
-				}
-				pCurrentElement->pPrevious = ToInsert;
-				ToInsert->pNext = pCurrentElement;
-				pCurrentElement = ToInsert;
-			}
-			
-			pCurrentElement->Tick(DeltaTime);
-			pCurrentElement = pCurrentElement->pNext;
-		} while (pCurrentElement != nullptr);
-		
-		ElementsToAdd.RemoveAll();
+	if (bScheduleIsDirty)
+		BuildSchedule();
+
+	for (uint32_t iWave = 0; iWave + 1 < WaveOffsets.Size(); ++iWave)
+	{
+		const uint32_t NumberOfBatchesInWave = WaveOffsets[iWave + 1] - WaveOffsets[iWave];
+		if (NumberOfBatchesInWave == 1)
+		{
+			TickBatch(*ScheduledBatches[WaveOffsets[iWave]], DeltaTime);
+		}
+		else
+		{
+			TickWaveJobData JobData;
+			JobData.pWorld = this;
+			JobData.ppBatches = ScheduledBatches.Data() + WaveOffsets[iWave];
+			JobData.DeltaTime = DeltaTime;
+			pJobSystem->ParallelFor(NumberOfBatchesInWave, &CapabilityTickWorld::TickBatchJob, &JobData);
+		}
+		RemovePendingUnregistrations();
 	}
-	else
+	bIsTicking = false;
+}
+
+void CapabilityTickWorld::AddPendingRegistrations()
+{
+	ScopedLock<Mutex> Lock(PendingChangesLock);
+	for (uint32_t i = 0; i < PendingRegistrations.Size(); ++i)
 	{
-		// tick normally
-		CapabilityTickLinkedElement* pCurrentElement = pFirstElement;
-		while (pCurrentElement != nullptr)
+		const PendingRegistration& Registration = PendingRegistrations[i];
+		Capability& NewCapability = *Registration.pCapability;
+		CapabilityTypeBatch* pBatch = FindBatch(NewCapability.Group, NewCapability.SubGroup, Registration.TypeId);
+		if (pBatch == nullptr)
 		{
-			pCurrentElement->Tick(DeltaTime);
-			pCurrentElement = pCurrentElement->pNext;
+			pBatch = Registration.pCreateBatch();
+			GetSubGroupBatches(NewCapability.Group, NewCapability.SubGroup).Add(pBatch);
+			bScheduleIsDirty = true;
 		}
+		pBatch->Add(NewCapability);
 	}
+	PendingRegistrations.RemoveAll();
 }
 
-void CapabilityTickLinkedList::Add(CapabilityTickLinkedElement& pTicker)
+void CapabilityTickWorld::RemovePendingUnregistrations()
 {
-	ElementsToAdd.Add(&pTicker);
+	ScopedLock<Mutex> Lock(PendingChangesLock);
+	for (uint32_t i = 0; i < PendingUnregistrations.Size(); ++i)
+	{
+		Capability& CapabilityToRemove = *PendingUnregistrations[i];
+		if (CapabilityToRemove.pTickBatch)
+			CapabilityToRemove.pTickBatch->Remove(CapabilityToRemove);
+		else
+			RemovePendingRegistration(CapabilityToRemove);
+	}
+	PendingUnregistrations.RemoveAll();
 }
 
-// ---
+bool CapabilityTickWorld::RemovePendingRegistration(Capability& CapabilityToRemove)
+{
+	for (uint32_t i = 0; i < PendingRegistrations.Size(); ++i)
+	{
+		if (PendingRegistrations[i].pCapability == &CapabilityToRemove)
+		{
+			PendingRegistrations.RemoveAtIndex(i);
+			return true;
+		}
+	}
+	return false;
+}
 
-CapabilityTickWorld::CapabilityTickWorld()
+void CapabilityTickWorld::BuildSchedule()
+{
+	ScheduledBatches.RemoveAll();
+	WaveOffsets.RemoveAll();
+	GrowingArray<uint32_t> BatchWaves;
+
+	// Sub groups are stored in tick order and are barriers, a sub group only starts when every wave of the sub group before it is done.
+	for (uint32_t iSubGroup = 0; iSubGroup < TickBatches.Getsize(); ++iSubGroup)
+	{
+		// Each batch goes in the wave after the last earlier batch of the sub group it conflicts with.
+		GrowingArray<CapabilityTypeBatch*>& Batches = TickBatches[iSubGroup];
+		BatchWaves.RemoveAll();
+		uint32_t NumberOfWaves = 0;
+		for (uint32_t iBatch = 0; iBatch < Batches.Size(); ++iBatch)
+		{
+			uint32_t Wave = 0;
+			for (uint32_t iEarlierBatch = 0; iEarlierBatch < iBatch; ++iEarlierBatch)
+			{
+				if (BatchWaves[iEarlierBatch] + 1 > Wave && Batches[iBatch]->GetDependencies().ConflictsWith(Batches[iEarlierBatch]->GetDependencies()))
+					Wave = BatchWaves[iEarlierBatch] + 1;
+			}
+			BatchWaves.Add(Wave);
+			if (Wave + 1 > NumberOfWaves)
+				NumberOfWaves = Wave + 1;
+		}
+
+		// Batches within a wave keep their tick order.
+		for (uint32_t iWave = 0; iWave < NumberOfWaves; ++iWave)
+		{
+			WaveOffsets.Add(ScheduledBatches.Size());
+			for (uint32_t iBatch = 0; iBatch < Batches.Size(); ++iBatch)
+			{
+				if (BatchWaves[iBatch] == iWave)
+					ScheduledBatches.Add(Batches[iBatch]);
+			}
+		}
+	}
+	WaveOffsets.Add(ScheduledBatches.Size());
+	bScheduleIsDirty = false;
+}
+
+void CapabilityTickWorld::TickBatch(CapabilityTypeBatch& Batch, float DeltaTime)
 {
+	if (bValidateComponentAccess)
+		tl_pTickingDependencies = &Batch.GetDependencies();
+	Batch.TickBatch(DeltaTime);
+	tl_pTickingDependencies = nullptr;
 }
 
-void CapabilityTickWorld::Init()
+void CapabilityTickWorld::TickBatchJob(void* pUserData, uint32_t JobIndex)
 {
-	CapabilityElements.Init(1024);
-    for (int i = 0; i < TickLists.Getsize(); ++i)
-    {
-        TickLists[i].ElementsToAdd.Init(256);
-    }
+	TickWaveJobData* pJobData = static_cast<TickWaveJobData*>(pUserData);
+	pJobData->pWorld->TickBatch(*pJobData->ppBatches[JobIndex], pJobData->DeltaTime);
 }
 
-void CapabilityTickWorld::RegisterCapability(Capability& pCapability)
+void CapabilityTickWorld::UnregisterCapability(Capability& CapabilityToRemove)
 {
-	CapabilityTickLinkedElement NewElement;
-	NewElement.pCapability = &pCapability;
-	NewElement.pWorld = this;
-	NewElement.Sortable.Group = pCapability.Group;
-	NewElement.Sortable.SubGroup = pCapability.SubGroup;
-	CapabilityElements.Add(NewElement);
-	RegisterTicker(CapabilityElements.GetLast());
-	pCapability.Setup();
+	ScopedLock<Mutex> Lock(PendingChangesLock);
+	// Removing from a batch while ticking would move capabilities under the tick loops of the batch.
+	if (bIsTicking)
+	{
+		PendingUnregistrations.Add(&CapabilityToRemove);
+		return;
+	}
+
+	if (CapabilityToRemove.pTickBatch)
+		CapabilityToRemove.pTickBatch->Remove(CapabilityToRemove);
+	else
+		RemovePendingRegistration(CapabilityToRemove);
 }
 
-void CapabilityTickWorld::RegisterTicker(CapabilityTickLinkedElement& Ticker)
+GrowingArray<CapabilityTypeBatch*>& CapabilityTickWorld::GetSubGroupBatches(ECapabilityTickGroup Group, ECapabilityTickSubGroup SubGroup)
 {
-    CapabilityTickSortable Sorting = Ticker.GetSorting();
-    TickLists[(uint8_t)Sorting.Group].Add(Ticker);
+	return TickBatches[(uint32_t)Group * NumberOfCapabilityTickSubGroups + (uint32_t)SubGroup];
 }
 
-void CapabilityTickWorld::Tick(float DeltaTime)
+CapabilityTypeBatch* CapabilityTickWorld::FindBatch(ECapabilityTickGroup Group, ECapabilityTickSubGroup SubGroup, uint32_t TypeId)
 {
-    for (int i = 0; i < TickLists.Getsize(); ++i)
-    {
-        TickLists[i].TickAll(DeltaTime);
-    }
+	GrowingArray<CapabilityTypeBatch*>& Batches = GetSubGroupBatches(Group, SubGroup);
+	for (uint32_t iBatch = 0; iBatch < Batches.Size(); ++iBatch)
+	{
+		if (Batches[iBatch]->GetTypeId() == TypeId)
+			return Batches[iBatch];
+	}
+	return nullptr;
 }
 
+void CapabilityTickWorld::RegisterCapability(Capability& NewCapability, uint32_t TypeId, CapabilityTypeBatch* (*pCreateBatch)())
+{
+	NewCapability.Setup();
+	ScopedLock<Mutex> Lock(PendingChangesLock);
+	PendingRegistration& Registration = PendingRegistrations.Add();
+	Registration.pCapability = &NewCapability;
+	Registration.TypeId = TypeId;
+	Registration.pCreateBatch = pCreateBatch;
+}
@@ -2,97 +2,200 @@
 #include "Capability/Capability.h"
 #include "Containers/GrowingArray/GrowingArray.h"
 #include "Containers/StaticArray/StaticArray.h"
+#include "Threading.h"
 
-struct CapabilityTickSortable
+namespace Hail
 {
-    ECapabilityTickGroup Group = ECapabilityTickGroup::Gameplay;
-    ECapabilityTickSubGroup SubGroup = ECapabilityTickSubGroup::Normal;
-    
-    bool operator <(const CapabilityTickSortable& Right) const
-    {
-        if ((int)Group < (int)Right.Group)
-            return true;
-        if ((int)Group > (int)Right.Group)
-            return false;
-        if ((int)SubGroup < (int)Right.SubGroup)
-            return true;
-        /*if ((int)SubGroup > (int)Right.SubGroup)
-            return false;*/
-        return false;
-    }
+    class JobSystem;
+}
 
-    bool operator >(const CapabilityTickSortable& Right) const
-    {
-        return !(*this < Right);
-    }
-};
+constexpr uint32_t NumberOfCapabilityTickSubGroups = (uint32_t)ECapabilityTickSubGroup::Post + 1;
+
+uint32_t CreateCapabilityTypeId();
 
-class CapabilityTickWorld;
+// Unique id per concrete capability type, ids are handed out on first use.
+template<class T>
+uint32_t GetCapabilityTypeId()
+{
+    static const uint32_t TypeId = CreateCapabilityTypeId();
+    return TypeId;
+}
 
 // ---
 
-class CapabilityTickLinkedElement
+// All capabilities of one concrete type in one tick group and sub group, ticked with one call per frame.
+// The activation and late setup state is kept in bitsets next to the capability pointers.
+class CapabilityTypeBatch
 {
 public:
-    CapabilityTickLinkedElement() {};
-    
-    void Tick(float DeltaTime);
+    CapabilityTypeBatch(uint32_t InTypeId) : TypeId(InTypeId) {}
+    virtual ~CapabilityTypeBatch() {}
 
-    //void Register(CapabilityTickWorld* World);
-    void Unregister();
+    virtual void TickBatch(float DeltaTime) = 0;
 
-    void SetSorting(CapabilityTickSortable NewSorting)
-    {
-        Sortable = NewSorting;
-    }
+    void Add(Capability& NewCapability);
+    void Remove(Capability& CapabilityToRemove);
+
+    uint32_t GetTypeId() const { return TypeId; }
+    const CapabilityDependencies& GetDependencies() const { return Dependencies; }
+    uint32_t GetNumberOfCapabilities() const { return Capabilities.Size(); }
+    uint32_t GetNumberOfActiveCapabilities() const;
+
+protected:
+    static bool IsBitSet(const Hail::GrowingArray<uint64_t>& Bits, uint32_t Index) { return (Bits[Index / 64] >> (Index % 64)) & 1; }
+    static void SetBit(Hail::GrowingArray<uint64_t>& Bits, uint32_t Index, bool bValue);
 
-    bool GetIsRegistered() const
+    // Capability state is private, the batches of each type reach it through these as friendship is not inherited.
+    static void SetCapabilityActive(Capability& CapabilityToSet, bool bActive);
+    static void SetCapabilityDidLateSetup(Capability& CapabilityToSet) { CapabilityToSet.bDidLateSetup = true; }
+    static float GetDilatedDeltaTime(Capability& CapabilityToTick, float DeltaTime) { return DeltaTime * CapabilityToTick.GetTimeDilation(); }
+    static void AddTickDuration(Capability& CapabilityTicked, bool bActive, float DeltaTime);
+
+    Hail::GrowingArray<Capability*> Capabilities;
+    Hail::GrowingArray<uint64_t> ActiveBits;
+    // Capabilities are late setup the first time they are ticked, as with the old linked list, so a set bit means it is still to do.
+    Hail::GrowingArray<uint64_t> NeedsLateSetupBits;
+    uint32_t NumberOfCapabilitiesNeedingLateSetup = 0;
+    CapabilityDependencies Dependencies;
+
+private:
+    uint32_t TypeId;
+};
+
+// Calls the capability functions of T without virtual dispatch, the compiler can inline them in to the loops.
+template<class T>
+class CapabilityTypeBatchOf : public CapabilityTypeBatch
+{
+public:
+    CapabilityTypeBatchOf() : CapabilityTypeBatch(GetCapabilityTypeId<T>())
     {
-        return pWorld != nullptr;        
+        T::DeclareDependencies(Dependencies);
     }
 
-    CapabilityTickSortable GetSorting() const
+    void TickBatch(float DeltaTime) override
     {
-        return Sortable;
+        const uint32_t NumberOfCapabilities = Capabilities.Size();
+
+        if (NumberOfCapabilitiesNeedingLateSetup)
+        {
+            for (uint32_t i = 0; i < NumberOfCapabilities; ++i)
+            {
+                if (!IsBitSet(NeedsLateSetupBits, i))
+                    continue;
+                T* pCapability = static_cast<T*>(Capabilities[i]);
+                SetCapabilityDidLateSetup(*pCapability);
+                pCapability->T::LateSetup();
+            }
+            for (uint32_t iWord = 0; iWord < NeedsLateSetupBits.Size(); ++iWord)
+                NeedsLateSetupBits[iWord] = 0;
+            NumberOfCapabilitiesNeedingLateSetup = 0;
+        }
+
+        // Activation is resolved for the whole batch before any capability is ticked.
+        for (uint32_t i = 0; i < NumberOfCapabilities; ++i)
+        {
+            T* pCapability = static_cast<T*>(Capabilities[i]);
+            const bool bActive = IsBitSet(ActiveBits, i);
+            if (!bActive && pCapability->T::ShouldActivate())
+            {
+                SetBit(ActiveBits, i, true);
+                SetCapabilityActive(*pCapability, true);
+                pCapability->T::OnActivated();
+            }
+            else if (bActive && pCapability->T::ShouldDeactivate())
+            {
+                SetBit(ActiveBits, i, false);
+                SetCapabilityActive(*pCapability, false);
+                pCapability->T::OnDeactivated();
+            }
+        }
+
+        for (uint32_t i = 0; i < NumberOfCapabilities; ++i)
+        {
+            T* pCapability = static_cast<T*>(Capabilities[i]);
+            const float DilatedDeltaTime = GetDilatedDeltaTime(*pCapability, DeltaTime);
+            const bool bActive = IsBitSet(ActiveBits, i);
+            if (bActive)
+                pCapability->T::TickActive(DilatedDeltaTime);
+            else
+                pCapability->T::TickInactive(DilatedDeltaTime);
+            AddTickDuration(*pCapability, bActive, DilatedDeltaTime);
+        }
     }
-
-    CapabilityTickSortable Sortable;
-    Capability* pCapability = nullptr;
-    CapabilityTickWorld* pWorld = nullptr;
-    CapabilityTickLinkedElement *pPrevious = nullptr; 
-    CapabilityTickLinkedElement *pNext = nullptr;
 };
 
 // ---
 
-class CapabilityTickLinkedList
+enum class ECapabilityTickMode : uint8_t
 {
-public:
-    CapabilityTickLinkedList();
-    
-    void TickAll(float DeltaTime);
-    void Add(CapabilityTickLinkedElement& pTicker);
-    
-    CapabilityTickLinkedElement* pFirstElement = nullptr;
-    CapabilityTickLinkedElement* pLastElement = nullptr;
-
-    GrowingArray<CapabilityTickLinkedElement*> ElementsToAdd;
+    // Type batches that do not conflict in their declared dependencies tick at the same time on the job system.
+    Parallel,
+    // Every type batch ticks on the calling thread in tick order, deterministic for debugging.
+    Serial,
 };
 
-// ---
-
+// Ticks the capabilities in order of tick group and sub group, within a sub group every concrete type is ticked as one batch
+// in the order the types were first registered. Tick groups and sub groups always tick in order, in parallel mode the batches of
+// a sub group are put in waves where a batch is in the wave after the last earlier batch it conflicts with, and each wave ticks in parallel.
 class CapabilityTickWorld
 {
 public:
     CapabilityTickWorld();
+    ~CapabilityTickWorld();
 
     void Init();
     void Tick(float DeltaTime);
-    void RegisterCapability(Capability& pCapability);
-    
+
+    // Without a job system the world ticks serially.
+    void SetJobSystem(Hail::JobSystem* pNewJobSystem) { pJobSystem = pNewJobSystem; }
+    void SetTickMode(ECapabilityTickMode NewTickMode) { TickMode = NewTickMode; }
+    // Asserts when a capability accesses a component through AccessForRead or AccessForWrite that its type did not declare.
+    void SetValidateComponentAccess(bool bValidate) { bValidateComponentAccess = bValidate; }
+
+    // The capability is set up directly and queued, it is added to the batch of its type at the start of the next tick.
+    // Registering and unregistering can be done from ticking capabilities, also on the job system workers. A capability that is
+    // unregistered while ticking is removed when the batch or wave it was unregistered in has finished, so it may tick for the
+    // rest of that batch and has to stay alive until Tick returns.
+    template<class T>
+    void RegisterCapability(T& NewCapability)
+    {
+        RegisterCapability(NewCapability, GetCapabilityTypeId<T>(), [](){ return static_cast<CapabilityTypeBatch*>(new CapabilityTypeBatchOf<T>()); });
+    }
+    void UnregisterCapability(Capability& CapabilityToRemove);
+
 private:
-    void RegisterTicker(CapabilityTickLinkedElement& Ticker);
-    
-    StaticArray<CapabilityTickLinkedList, (uint8_t)ECapabilityTickGroup::Max> TickLists;
-    GrowingArray<CapabilityTickLinkedElement> CapabilityElements;
-};
\ No newline at end of file
+    struct PendingRegistration
+    {
+        Capability* pCapability;
+        uint32_t TypeId;
+        // Creates the batch for the type the first time a capability of the type is added.
+        CapabilityTypeBatch* (*pCreateBatch)();
+    };
+
+    Hail::GrowingArray<CapabilityTypeBatch*>& GetSubGroupBatches(ECapabilityTickGroup Group, ECapabilityTickSubGroup SubGroup);
+    CapabilityTypeBatch* FindBatch(ECapabilityTickGroup Group, ECapabilityTickSubGroup SubGroup, uint32_t TypeId);
+    void RegisterCapability(Capability& NewCapability, uint32_t TypeId, CapabilityTypeBatch* (*pCreateBatch)());
+    void AddPendingRegistrations();
+    // Called when no batch is ticking, between the batches in serial mode and between the waves in parallel mode.
+    void RemovePendingUnregistrations();
+    bool RemovePendingRegistration(Capability& CapabilityToRemove);
+    void BuildSchedule();
+    void TickBatch(CapabilityTypeBatch& Batch, float DeltaTime);
+    static void TickBatchJob(void* pUserData, uint32_t JobIndex);
+
+    StaticArray<Hail::GrowingArray<CapabilityTypeBatch*>, (uint32_t)ECapabilityTickGroup::Max * NumberOfCapabilityTickSubGroups> TickBatches;
+    // Registrations and unregistrations can come from any thread while ticking, the batches are only changed by the ticking thread.
+    Hail::Mutex PendingChangesLock;
+    Hail::GrowingArray<PendingRegistration> PendingRegistrations;
+    Hail::GrowingArray<Capability*> PendingUnregistrations;
+
+    // The batches of all sub groups sorted on sub group and wave, with the offset of each wave and one offset past the last wave.
+    Hail::GrowingArray<CapabilityTypeBatch*> ScheduledBatches;
+    Hail::GrowingArray<uint32_t> WaveOffsets;
+    bool bScheduleIsDirty = true;
+    bool bIsTicking = false;
+
+    Hail::JobSystem* pJobSystem = nullptr;
+    ECapabilityTickMode TickMode = ECapabilityTickMode::Parallel;
+    bool bValidateComponentAccess = false;
+};
@@ -173,7 +173,7 @@ namespace Hail
 
 	void GameApplication::Shutdown()
 	{
-
+		g_capabilityTester.Shutdown();
 	}
 
 
@@ -202,10 +202,10 @@ LONG WINAPI HailWindowsUnhandledExceptionFilter(EXCEPTION_POINTERS* pExceptionIn
     return EXCEPTION_EXECUTE_HANDLER;
 }
 
-static Hail::BinarySemaphore unhandledExceptionSemaphore;
+static Hail::Mutex unhandledExceptionLock;
 static LONG WINAPI unhandledException(EXCEPTION_POINTERS* excpInfo = NULL)
 {
-    unhandledExceptionSemaphore.Signal();
+    unhandledExceptionLock.Lock();
     if (!excpInfo == NULL)
     {
         __try // Generate exception to get proper context in dump
@@ -220,7 +220,7 @@ static LONG WINAPI unhandledException(EXCEPTION_POINTERS* excpInfo = NULL)
     {
         HailWindowsUnhandledExceptionFilter(excpInfo);
     }
-    unhandledExceptionSemaphore.Wait();
+    unhandledExceptionLock.Unlock();
     return 0;
 }
 
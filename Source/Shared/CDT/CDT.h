@@ -41,7 +41,7 @@ typedef unsigned short LayerDepth;
 typedef LayerDepth BoundaryOverlapCount;
 
 /// Triangles by vertex index
-typedef std::vector<TriIndVec> VerticesTriangles;
+typedef vector<TriIndVec> VerticesTriangles;
 
 /** @defgroup helpers Helpers
  *  Helpers for working with CDT::Triangulation.
@@ -66,8 +66,8 @@ calculateTrianglesByVertex(const TriangleVec& triangles, VertInd verticesSize);
  */
 struct CDT_EXPORT DuplicatesInfo
 {
-    std::vector<std::size_t> mapping;    ///< vertex index mapping
-    std::vector<std::size_t> duplicates; ///< duplicates' indices
+    vector<std::size_t> mapping;    ///< vertex index mapping
+    vector<std::size_t> duplicates; ///< duplicates' indices
 };
 
 /**
@@ -105,7 +105,7 @@ DuplicatesInfo FindDuplicates(
 template <typename TVertex, typename TAllocator>
 void RemoveDuplicates(
     std::vector<TVertex, TAllocator>& vertices,
-    const std::vector<std::size_t>& duplicates);
+    const vector<std::size_t>& duplicates);
 
 /**
  * Remove duplicated points in-place
@@ -115,7 +115,7 @@ void RemoveDuplicates(
  * @returns information about duplicated vertices that were removed.
  */
 template <typename T>
-CDT_EXPORT DuplicatesInfo RemoveDuplicates(std::vector<V2d<T> >& vertices);
+CDT_EXPORT DuplicatesInfo RemoveDuplicates(vector<V2d<T> >& vertices);
 
 /**
  * Remap vertex indices in edges (in-place) using given vertex-index mapping.
@@ -142,7 +142,7 @@ template <
 CDT_EXPORT void RemapEdges(
     TEdgeIter first,
     TEdgeIter last,
-    const std::vector<std::size_t>& mapping,
+    const vector<std::size_t>& mapping,
     TGetEdgeVertexStart getStart,
     TGetEdgeVertexEnd getEnd,
     TMakeEdgeFromStartAndEnd makeEdge);
@@ -155,7 +155,7 @@ CDT_EXPORT void RemapEdges(
  * @param mapping vertex-index mapping
  */
 CDT_EXPORT void
-RemapEdges(std::vector<Edge>& edges, const std::vector<std::size_t>& mapping);
+RemapEdges(vector<Edge>& edges, const vector<std::size_t>& mapping);
 
 /**
  * Find point duplicates, remove them from vector (in-place) and remap edges
@@ -216,8 +216,8 @@ DuplicatesInfo RemoveDuplicatesAndRemapEdges(
  */
 template <typename T>
 CDT_EXPORT DuplicatesInfo RemoveDuplicatesAndRemapEdges(
-    std::vector<V2d<T> >& vertices,
-    std::vector<Edge>& edges);
+    vector<V2d<T> >& vertices,
+    vector<Edge>& edges);
 
 /**
  * Extract all edges of triangles
@@ -244,9 +244,9 @@ EdgeToPiecesMapping(const unordered_map<Edge, EdgeVec>& pieceToOriginals);
  * Split points are sorted from edge's start (v1) to end (v2)
  */
 template <typename T>
-CDT_EXPORT unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
+CDT_EXPORT unordered_map<Edge, vector<VertInd> > EdgeToSplitVertices(
     const unordered_map<Edge, EdgeVec>& edgeToPieces,
-    const std::vector<V2d<T> >& vertices);
+    const vector<V2d<T> >& vertices);
 
 /// @}
 
@@ -300,7 +300,7 @@ DuplicatesInfo FindDuplicates(
     PosToIndex uniqueVerts;
     const std::size_t verticesSize = std::distance(first, last);
     DuplicatesInfo di = {
-        std::vector<std::size_t>(verticesSize), std::vector<std::size_t>()};
+        vector<std::size_t>(verticesSize), vector<std::size_t>()};
     for(std::size_t iIn = 0, iOut = iIn; iIn < verticesSize; ++iIn, ++first)
     {
         typename PosToIndex::const_iterator it;
@@ -321,7 +321,7 @@ DuplicatesInfo FindDuplicates(
 template <typename TVertex, typename TAllocator>
 void RemoveDuplicates(
     std::vector<TVertex, TAllocator>& vertices,
-    const std::vector<std::size_t>& duplicates)
+    const vector<std::size_t>& duplicates)
 {
     vertices.erase(
         remove_at(
@@ -340,7 +340,7 @@ template <
 void RemapEdges(
     TEdgeIter first,
     const TEdgeIter last,
-    const std::vector<std::size_t>& mapping,
+    const vector<std::size_t>& mapping,
     TGetEdgeVertexStart getStart,
     TGetEdgeVertexEnd getEnd,
     TMakeEdgeFromStartAndEnd makeEdge)
@@ -381,9 +381,9 @@ DuplicatesInfo RemoveDuplicatesAndRemapEdges(
 }
 
 template <typename T>
-unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
+unordered_map<Edge, vector<VertInd> > EdgeToSplitVertices(
     const unordered_map<Edge, EdgeVec>& edgeToPieces,
-    const std::vector<V2d<T> >& vertices)
+    const vector<V2d<T> >& vertices)
 {
     typedef std::pair<VertInd, T> VertCoordPair;
     struct ComparePred
@@ -394,7 +394,7 @@ unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
         }
     } comparePred;
 
-    unordered_map<Edge, std::vector<VertInd> > edgeToSplitVerts;
+    unordered_map<Edge, vector<VertInd> > edgeToSplitVerts;
     typedef unordered_map<Edge, EdgeVec>::const_iterator It;
     for(It e2pIt = edgeToPieces.begin(); e2pIt != edgeToPieces.end(); ++e2pIt)
     {
@@ -405,7 +405,7 @@ unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
         const bool isAscending =
             isX ? dX >= 0 : dY >= 0; // Longer coordinate ascends
         const EdgeVec& pieces = e2pIt->second;
-        std::vector<VertCoordPair> splitVerts;
+        vector<VertCoordPair> splitVerts;
         // size is:  2[ends] + (pieces - 1)[split vertices] = pieces + 1
         splitVerts.reserve(pieces.size() + 1);
         typedef EdgeVec::const_iterator EIt;
@@ -426,10 +426,10 @@ unordered_map<Edge, std::vector<VertInd> > EdgeToSplitVertices(
             std::unique(splitVerts.begin(), splitVerts.end()),
             splitVerts.end());
         assert(splitVerts.size() > 2); // 2 end points with split vertices
-        std::pair<Edge, std::vector<VertInd> > val =
-            std::make_pair(e, std::vector<VertInd>());
+        std::pair<Edge, vector<VertInd> > val =
+            std::make_pair(e, vector<VertInd>());
         val.second.reserve(splitVerts.size());
-        typedef typename std::vector<VertCoordPair>::const_iterator SEIt;
+        typedef typename vector<VertCoordPair>::const_iterator SEIt;
         for(SEIt it = splitVerts.begin() + 1; it != splitVerts.end() - 1; ++it)
         {
             val.second.push_back(it->first);
@@ -34,7 +34,7 @@ CDT_INLINE_IF_HEADER_ONLY VerticesTriangles calculateTrianglesByVertex(
 }
 
 template <typename T>
-DuplicatesInfo RemoveDuplicates(std::vector<V2d<T> >& vertices)
+DuplicatesInfo RemoveDuplicates(vector<V2d<T> >& vertices)
 {
     const DuplicatesInfo di = FindDuplicates<T>(
         vertices.begin(), vertices.end(), getX_V2d<T>, getY_V2d<T>);
@@ -43,7 +43,7 @@ DuplicatesInfo RemoveDuplicates(std::vector<V2d<T> >& vertices)
 }
 
 CDT_INLINE_IF_HEADER_ONLY void
-RemapEdges(std::vector<Edge>& edges, const std::vector<std::size_t>& mapping)
+RemapEdges(vector<Edge>& edges, const vector<std::size_t>& mapping)
 {
     RemapEdges(
         edges.begin(),
@@ -56,8 +56,8 @@ RemapEdges(std::vector<Edge>& edges, const std::vector<std::size_t>& mapping)
 
 template <typename T>
 DuplicatesInfo RemoveDuplicatesAndRemapEdges(
-    std::vector<V2d<T> >& vertices,
-    std::vector<Edge>& edges)
+    vector<V2d<T> >& vertices,
+    vector<Edge>& edges)
 {
     return RemoveDuplicatesAndRemapEdges<T>(
         vertices,
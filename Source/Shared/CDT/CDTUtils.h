@@ -87,6 +87,16 @@ using boost::unordered_set;
 } // namespace CDT
 #endif
 
+#include "MemoryTracker.h"
+
+namespace CDT
+{
+/// Vector with its memory tracked under the triangulation tag of the engine
+template <typename T>
+using vector =
+    std::vector<T, Hail::TrackedStdAllocator<T, Hail::eMemoryTag::Triangulation> >;
+} // namespace CDT
+
 namespace CDT
 {
 
@@ -152,7 +162,7 @@ const static TriInd noNeighbor(invalidIndex);
 /// Constant representing no valid vertex for a triangle
 const static VertInd noVertex(invalidIndex);
 
-typedef std::vector<TriInd> TriIndVec;  ///< Vector of triangle indices
+typedef vector<TriInd> TriIndVec;  ///< Vector of triangle indices
 typedef array<VertInd, 3> VerticesArr3; ///< array of three vertex indices
 typedef array<TriInd, 3> NeighborsArr3; ///< array of three neighbors
 
@@ -201,7 +211,7 @@ Box2d<T> envelopBox(
 
 /// Bounding box of a collection of 2D points
 template <typename T>
-CDT_EXPORT Box2d<T> envelopBox(const std::vector<V2d<T> >& vertices);
+CDT_EXPORT Box2d<T> envelopBox(const vector<V2d<T> >& vertices);
 
 /// Edge connecting two vertices: vertex with smaller index is always first
 /// \note: hash Edge is specialized at the bottom
@@ -242,7 +252,7 @@ inline Edge edge_make(VertInd iV1, VertInd iV2)
     return Edge(iV1, iV2);
 }
 
-typedef std::vector<Edge> EdgeVec;                ///< Vector of edges
+typedef vector<Edge> EdgeVec;                ///< Vector of edges
 typedef unordered_set<Edge> EdgeUSet;             ///< Hash table of edges
 typedef unordered_set<TriInd> TriIndUSet;         ///< Hash table of triangles
 typedef unordered_map<TriInd, TriInd> TriIndUMap; ///< Triangle hash map
@@ -305,7 +315,7 @@ struct CDT_EXPORT Triangle
     }
 };
 
-typedef std::vector<Triangle> TriangleVec; ///< Vector of triangles
+typedef vector<Triangle> TriangleVec; ///< Vector of triangles
 
 /// Advance vertex or neighbor index counter-clockwise
 CDT_EXPORT Index ccw(Index i);
@@ -30,7 +30,7 @@ V2d<T> V2d<T>::make(const T x, const T y)
 // Box2d
 //*****************************************************************************
 template <typename T>
-Box2d<T> envelopBox(const std::vector<V2d<T> >& vertices)
+Box2d<T> envelopBox(const vector<V2d<T> >& vertices)
 {
     return envelopBox<T>(
         vertices.begin(), vertices.end(), getX_V2d<T>, getY_V2d<T>);
@@ -11,54 +11,106 @@
 #define CDT_POINTKDTREE_H
 
 #include "CDTUtils.h"
-#include "KDTree.h"
+#include "Containers\KDTree\KDTree2D.h"
 
 namespace CDT
 {
 
-/// KD-tree holding points
-template <
-    typename TCoordType,
-    size_t NumVerticesInLeaf = 32,
-    size_t InitialStackDepth = 32,
-    size_t StackDepthIncrement = 32>
+/// Nearest point locator built from flat, bulk-built KD-trees
+/// @details Bulk-built trees can not take new points, so added points use the
+///          logarithmic method:
+///          - New points go to a small buffer that is searched linearly.
+///          - A full buffer is merged with the full levels below the first
+///            empty level and built into that level. Level i holds at most
+///            BufferSize * 2^i points, so each point is rebuilt O(log n) times.
+///          - Queries search the buffer and the nearest point of every level.
+/// @tparam TCoordType type used for storing point coordinate.
+/// @tparam BufferSize number of added points kept outside of the trees.
+template <typename TCoordType, size_t BufferSize = 32>
 class LocatorKDTree
 {
 public:
+    LocatorKDTree()
+        : m_size(0)
+    {}
     /// Initialize KD-tree with points
-    void initialize(const std::vector<V2d<TCoordType> >& points)
+    void initialize(const vector<V2d<TCoordType> >& points)
     {
-        typedef V2d<TCoordType> V2d_t;
-        V2d_t min = points.front();
-        V2d_t max = min;
-        typedef typename std::vector<V2d_t>::const_iterator Cit;
-        for(Cit it = points.begin(); it != points.end(); ++it)
-        {
-            min = V2d_t::make(std::min(min.x, it->x), std::min(min.y, it->y));
-            max = V2d_t::make(std::max(max.x, it->x), std::max(max.y, it->y));
-        }
-        m_kdTree = KDTree_t(min, max);
-        for(VertInd i(0); i < points.size(); ++i)
-        {
-            m_kdTree.insert(i, points);
-        }
+        m_buffer.clear();
+        m_levels.clear();
+        m_size = static_cast<VertInd>(points.size());
+        if(points.empty())
+            return;
+
+        std::size_t iLevel = 0;
+        while(levelCapacity(iLevel) < points.size())
+            ++iLevel;
+        m_levels.resize(iLevel + 1);
+        m_levels[iLevel].Build(
+            points.data(), static_cast<Hail::uint32>(points.size()));
     }
     /// Add point to KD-tree
-    void addPoint(const VertInd i, const std::vector<V2d<TCoordType> >& points)
+    void addPoint(const VertInd i, const vector<V2d<TCoordType> >& points)
     {
-        m_kdTree.insert(i, points);
+        m_buffer.push_back(static_cast<Hail::uint32>(i));
+        ++m_size;
+        if(m_buffer.size() < BufferSize)
+            return;
+
+        m_mergeIndices.swap(m_buffer);
+        m_buffer.clear();
+        std::size_t iLevel = 0;
+        for(; iLevel < m_levels.size() && !m_levels[iLevel].Empty(); ++iLevel)
+        {
+            const KDTree_t& level = m_levels[iLevel];
+            m_mergeIndices.insert(
+                m_mergeIndices.end(),
+                level.GetPointIndices(),
+                level.GetPointIndices() + level.Size());
+            m_levels[iLevel].Clear();
+        }
+        if(iLevel == m_levels.size())
+            m_levels.resize(iLevel + 1);
+        m_levels[iLevel].Build(
+            points.data(),
+            m_mergeIndices.data(),
+            static_cast<Hail::uint32>(m_mergeIndices.size()));
+        m_mergeIndices.clear();
     }
-    /// Find nearest point using R-tree
+    /// Find nearest point using KD-tree
     VertInd nearPoint(
         const V2d<TCoordType>& pos,
-        const std::vector<V2d<TCoordType> >& points) const
+        const vector<V2d<TCoordType> >& points) const
     {
-        return m_kdTree.nearest(pos, points).second;
+        VertInd nearest(invalidIndex);
+        TCoordType minDistSq = std::numeric_limits<TCoordType>::max();
+        typedef vector<Hail::uint32>::const_iterator Cit;
+        for(Cit it = m_buffer.begin(); it != m_buffer.end(); ++it)
+        {
+            const TCoordType distSq = distanceSquared(pos, points[*it]);
+            if(distSq < minDistSq)
+            {
+                minDistSq = distSq;
+                nearest = VertInd(*it);
+            }
+        }
+        for(std::size_t iLevel = 0; iLevel < m_levels.size(); ++iLevel)
+        {
+            TCoordType distSq;
+            const Hail::uint32 iPoint =
+                m_levels[iLevel].FindNearest(points.data(), pos, &distSq);
+            if(iPoint != KDTree_t::InvalidIndex && distSq < minDistSq)
+            {
+                minDistSq = distSq;
+                nearest = VertInd(iPoint);
+            }
+        }
+        return nearest;
     }
 
     CDT::VertInd size() const
     {
-        return m_kdTree.size();
+        return m_size;
     }
 
     bool empty() const
@@ -67,13 +119,17 @@ public:
     }
 
 private:
-    typedef KDTree::KDTree<
-        TCoordType,
-        NumVerticesInLeaf,
-        InitialStackDepth,
-        StackDepthIncrement>
-        KDTree_t;
-    KDTree_t m_kdTree;
+    typedef Hail::KDTree2D<V2d<TCoordType> > KDTree_t;
+
+    static std::size_t levelCapacity(const std::size_t iLevel)
+    {
+        return BufferSize << iLevel;
+    }
+
+    vector<Hail::uint32> m_buffer;
+    vector<Hail::uint32> m_mergeIndices;
+    vector<KDTree_t> m_levels;
+    VertInd m_size;
 };
 
 } // namespace CDT
@@ -258,7 +258,7 @@ template <typename T, typename TNearPointLocator = LocatorKDTree<T> >
 class CDT_EXPORT Triangulation
 {
 public:
-    typedef std::vector<V2d<T> > V2dVec; ///< Vertices vector
+    typedef vector<V2d<T> > V2dVec; ///< Vertices vector
     V2dVec vertices;                     ///< triangulation's vertices
     TriangleVec triangles;               ///< triangulation's triangles
     EdgeUSet fixedEdges; ///< triangulation's constraints (fixed edges)
@@ -341,7 +341,7 @@ public:
      * Insert vertices into triangulation
      * @param vertices vector of vertices to insert
      */
-    void insertVertices(const std::vector<V2d<T> >& vertices);
+    void insertVertices(const vector<V2d<T> >& vertices);
     /**
      * Insert constraint edges into triangulation for <b/>Constrained Delaunay
      * Triangulation</b> (for example see figure below).
@@ -400,7 +400,7 @@ public:
      * <b>Make sure there are no erroneous duplicates.</b>
      * @tparam edges constraint edges
      */
-    void insertEdges(const std::vector<Edge>& edges);
+    void insertEdges(const vector<Edge>& edges);
     /**
      * Insert constraint edges into triangulation for <b>Conforming Delaunay
      * Triangulation</b> (for example see figure below).
@@ -459,7 +459,7 @@ public:
      * <b>Make sure there are no erroneous duplicates.</b>
      * @tparam edges edges to conform to
      */
-    void conformToEdges(const std::vector<Edge>& edges);
+    void conformToEdges(const vector<Edge>& edges);
     /**
      * Erase triangles adjacent to super triangle
      *
@@ -501,7 +501,7 @@ public:
      *  - 3 for triangles in island and so on...
      * @return vector where element at index i stores depth of i-th triangle
      */
-    std::vector<LayerDepth> calculateTriangleDepths() const;
+    vector<LayerDepth> calculateTriangleDepths() const;
 
     /**
      * @defgroup Advanced Advanced Triangulation Methods
@@ -552,7 +552,7 @@ private:
     void insertVertex(VertInd iVert, VertInd walkStart);
     void ensureDelaunayByEdgeFlips(VertInd iV1, std::stack<TriInd>& triStack);
     /// Flip fixed edges and return a list of flipped fixed edges
-    std::vector<Edge> insertVertex_FlipFixedEdges(VertInd iV1);
+    vector<Edge> insertVertex_FlipFixedEdges(VertInd iV1);
 
     /// State for an iteration of triangulate pseudo-polygon
     typedef tuple<IndexSizeType, IndexSizeType, TriInd, TriInd, Index>
@@ -574,7 +574,7 @@ private:
         Edge edge,
         Edge originalEdge,
         EdgeVec& remaining,
-        std::vector<TriangulatePseudoPolygonTask>& tppIterations);
+        vector<TriangulatePseudoPolygonTask>& tppIterations);
 
     /**
      * Insert an edge or its part into constraint Delaunay triangulation
@@ -592,7 +592,7 @@ private:
         Edge edge,
         Edge originalEdge,
         EdgeVec& remaining,
-        std::vector<TriangulatePseudoPolygonTask>& tppIterations);
+        vector<TriangulatePseudoPolygonTask>& tppIterations);
 
     /// State for iteration of conforming to edge
     typedef tuple<Edge, EdgeVec, BoundaryOverlapCount> ConformToEdgeTask;
@@ -613,7 +613,7 @@ private:
         Edge edge,
         EdgeVec originals,
         BoundaryOverlapCount overlaps,
-        std::vector<ConformToEdgeTask>& remaining);
+        vector<ConformToEdgeTask>& remaining);
 
     /**
      * Iteration of conform to fixed edge.
@@ -630,7 +630,7 @@ private:
         Edge edge,
         const EdgeVec& originals,
         BoundaryOverlapCount overlaps,
-        std::vector<ConformToEdgeTask>& remaining);
+        vector<ConformToEdgeTask>& remaining);
 
     tuple<TriInd, VertInd, VertInd> intersectedTriangle(
         VertInd iA,
@@ -666,17 +666,17 @@ private:
         VertInd iVedge2,
         TriInd newNeighbor);
     void triangulatePseudoPolygon(
-        const std::vector<VertInd>& poly,
+        const vector<VertInd>& poly,
         unordered_map<Edge, TriInd>& outerTris,
         TriInd iT,
         TriInd iN,
-        std::vector<TriangulatePseudoPolygonTask>& iterations);
+        vector<TriangulatePseudoPolygonTask>& iterations);
     void triangulatePseudoPolygonIteration(
-        const std::vector<VertInd>& poly,
+        const vector<VertInd>& poly,
         unordered_map<Edge, TriInd>& outerTris,
-        std::vector<TriangulatePseudoPolygonTask>& iterations);
+        vector<TriangulatePseudoPolygonTask>& iterations);
     IndexSizeType findDelaunayPoint(
-        const std::vector<VertInd>& poly,
+        const vector<VertInd>& poly,
         IndexSizeType iA,
         IndexSizeType iB) const;
     TriInd addTriangle(const Triangle& t); // note: invalidates iterators!
@@ -753,7 +753,7 @@ private:
     unordered_map<TriInd, LayerDepth> peelLayer(
         std::stack<TriInd> seeds,
         LayerDepth layerDepth,
-        std::vector<LayerDepth>& triDepths) const;
+        vector<LayerDepth>& triDepths) const;
 
     void insertVertices_AsProvided(VertInd superGeomVertCount);
     void insertVertices_Randomized(VertInd superGeomVertCount);
@@ -771,7 +771,7 @@ private:
     /// BFS bulk load if necessary
     void tryInitNearestPointLocator();
 
-    std::vector<TriInd> m_dummyTris;
+    vector<TriInd> m_dummyTris;
     TNearPointLocator m_nearPtLocator;
     IndexSizeType m_nTargetVerts;
     SuperGeometryType::Enum m_superGeomType;
@@ -895,7 +895,7 @@ void Triangulation<T, TNearPointLocator>::insertEdges(
     if(isFinalized())
         throw FinalizedError(CDT_SOURCE_LOCATION);
 
-    std::vector<TriangulatePseudoPolygonTask> tppIterations;
+    vector<TriangulatePseudoPolygonTask> tppIterations;
     EdgeVec remaining;
     for(; first != last; ++first)
     {
@@ -924,7 +924,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdges(
 
     tryInitNearestPointLocator();
     // state shared between different runs for performance gains
-    std::vector<ConformToEdgeTask> remaining;
+    vector<ConformToEdgeTask> remaining;
     for(; first != last; ++first)
     {
         // +3 to account for super-triangle vertices
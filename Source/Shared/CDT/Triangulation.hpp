@@ -124,7 +124,7 @@ void Triangulation<T, TNearPointLocator>::eraseDummies()
             *iN = triIndMap[*iN];
     }
     // clear dummy triangles
-    m_dummyTris = std::vector<TriInd>();
+    m_dummyTris = vector<TriInd>();
 }
 
 template <typename T, typename TNearPointLocator>
@@ -155,7 +155,7 @@ void Triangulation<T, TNearPointLocator>::eraseOuterTriangles()
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::eraseOuterTrianglesAndHoles()
 {
-    const std::vector<LayerDepth> triDepths = calculateTriangleDepths();
+    const vector<LayerDepth> triDepths = calculateTriangleDepths();
     TriIndUSet toErase;
     toErase.reserve(triangles.size());
     for(std::size_t iT = 0; iT != triangles.size(); ++iT)
@@ -357,14 +357,14 @@ TriInd Triangulation<T, TNearPointLocator>::addTriangle()
 
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::insertEdges(
-    const std::vector<Edge>& edges)
+    const vector<Edge>& edges)
 {
     insertEdges(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
 }
 
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::conformToEdges(
-    const std::vector<Edge>& edges)
+    const vector<Edge>& edges)
 {
     conformToEdges(edges.begin(), edges.end(), edge_get_v1, edge_get_v2);
 }
@@ -521,7 +521,7 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
     const Edge edge,
     const Edge originalEdge,
     EdgeVec& remaining,
-    std::vector<TriangulatePseudoPolygonTask>& tppIterations)
+    vector<TriangulatePseudoPolygonTask>& tppIterations)
 {
     const VertInd iA = edge.v1();
     VertInd iB = edge.v2();
@@ -554,8 +554,8 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
         return;
     }
     Triangle t = triangles[iT];
-    std::vector<TriInd> intersected(1, iT);
-    std::vector<VertInd> polyL, polyR;
+    vector<TriInd> intersected(1, iT);
+    vector<VertInd> polyL, polyR;
     polyL.reserve(2);
     polyL.push_back(iA);
     polyL.push_back(iVL);
@@ -655,7 +655,7 @@ void Triangulation<T, TNearPointLocator>::insertEdgeIteration(
     if(m_vertTris[iB] == intersected.back())
         pivotVertexTriangleCW(iB);
     // Remove intersected triangles
-    typedef std::vector<TriInd>::const_iterator TriIndCit;
+    typedef vector<TriInd>::const_iterator TriIndCit;
     for(TriIndCit it = intersected.begin(); it != intersected.end(); ++it)
         makeDummy(*it);
     { // Triangulate pseudo-polygons on both sides
@@ -685,7 +685,7 @@ void Triangulation<T, TNearPointLocator>::insertEdge(
     Edge edge,
     const Edge originalEdge,
     EdgeVec& remaining,
-    std::vector<TriangulatePseudoPolygonTask>& tppIterations)
+    vector<TriangulatePseudoPolygonTask>& tppIterations)
 {
     // use iteration over recursion to avoid stack overflows
     remaining.clear();
@@ -703,7 +703,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
     Edge edge,
     const EdgeVec& originals,
     BoundaryOverlapCount overlaps,
-    std::vector<ConformToEdgeTask>& remaining)
+    vector<ConformToEdgeTask>& remaining)
 {
     const VertInd iA = edge.v1();
     VertInd iB = edge.v2();
@@ -841,7 +841,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
     addNewVertex(
         V2d<T>::make((start.x + end.x) / T(2), (start.y + end.y) / T(2)),
         noNeighbor);
-    const std::vector<Edge> flippedFixedEdges =
+    const vector<Edge> flippedFixedEdges =
         insertVertex_FlipFixedEdges(iMid);
 
 #ifdef CDT_CXX11_IS_SUPPORTED
@@ -854,7 +854,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdgeIteration(
 
     // re-introduce fixed edges that were flipped
     // and make sure overlap count is preserved
-    for(std::vector<Edge>::const_iterator it = flippedFixedEdges.begin();
+    for(vector<Edge>::const_iterator it = flippedFixedEdges.begin();
         it != flippedFixedEdges.end();
         ++it)
     {
@@ -891,7 +891,7 @@ void Triangulation<T, TNearPointLocator>::conformToEdge(
     Edge edge,
     EdgeVec originals,
     BoundaryOverlapCount overlaps,
-    std::vector<ConformToEdgeTask>& remaining)
+    vector<ConformToEdgeTask>& remaining)
 {
     // use iteration over recursion to avoid stack overflows
     remaining.clear();
@@ -1032,11 +1032,11 @@ void Triangulation<T, TNearPointLocator>::addNewVertex(
 }
 
 template <typename T, typename TNearPointLocator>
-std::vector<Edge>
+vector<Edge>
 Triangulation<T, TNearPointLocator>::insertVertex_FlipFixedEdges(
     const VertInd iV1)
 {
-    std::vector<Edge> flippedFixedEdges;
+    vector<Edge> flippedFixedEdges;
 
     const V2d<T>& v1 = vertices[iV1];
     const VertInd startVertex = m_nearPtLocator.nearPoint(v1, vertices);
@@ -1600,11 +1600,11 @@ void Triangulation<T, TNearPointLocator>::changeNeighbor(
 
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::triangulatePseudoPolygon(
-    const std::vector<VertInd>& poly,
+    const vector<VertInd>& poly,
     unordered_map<Edge, TriInd>& outerTris,
     TriInd iT,
     TriInd iN,
-    std::vector<TriangulatePseudoPolygonTask>& iterations)
+    vector<TriangulatePseudoPolygonTask>& iterations)
 {
     assert(poly.size() > 2);
     // note: uses iteration instead of recursion to avoid stack overflows
@@ -1623,9 +1623,9 @@ void Triangulation<T, TNearPointLocator>::triangulatePseudoPolygon(
 
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::triangulatePseudoPolygonIteration(
-    const std::vector<VertInd>& poly,
+    const vector<VertInd>& poly,
     unordered_map<Edge, TriInd>& outerTris,
-    std::vector<TriangulatePseudoPolygonTask>& iterations)
+    vector<TriangulatePseudoPolygonTask>& iterations)
 {
     IndexSizeType iA, iB;
     TriInd iT, iParent;
@@ -1694,7 +1694,7 @@ void Triangulation<T, TNearPointLocator>::triangulatePseudoPolygonIteration(
 
 template <typename T, typename TNearPointLocator>
 IndexSizeType Triangulation<T, TNearPointLocator>::findDelaunayPoint(
-    const std::vector<VertInd>& poly,
+    const vector<VertInd>& poly,
     const IndexSizeType iA,
     const IndexSizeType iB) const
 {
@@ -1718,7 +1718,7 @@ IndexSizeType Triangulation<T, TNearPointLocator>::findDelaunayPoint(
 
 template <typename T, typename TNearPointLocator>
 void Triangulation<T, TNearPointLocator>::insertVertices(
-    const std::vector<V2d<T> >& newVertices)
+    const vector<V2d<T> >& newVertices)
 {
     return insertVertices(
         newVertices.begin(), newVertices.end(), getX_V2d<T>, getY_V2d<T>);
@@ -1735,7 +1735,7 @@ unordered_map<TriInd, LayerDepth>
 Triangulation<T, TNearPointLocator>::peelLayer(
     std::stack<TriInd> seeds,
     const LayerDepth layerDepth,
-    std::vector<LayerDepth>& triDepths) const
+    vector<LayerDepth>& triDepths) const
 {
     unordered_map<TriInd, LayerDepth> behindBoundary;
     while(!seeds.empty())
@@ -1768,10 +1768,10 @@ Triangulation<T, TNearPointLocator>::peelLayer(
 }
 
 template <typename T, typename TNearPointLocator>
-std::vector<LayerDepth>
+vector<LayerDepth>
 Triangulation<T, TNearPointLocator>::calculateTriangleDepths() const
 {
-    std::vector<LayerDepth> triDepths(
+    vector<LayerDepth> triDepths(
         triangles.size(), std::numeric_limits<LayerDepth>::max());
     std::stack<TriInd> seeds(TriDeque(1, m_vertTris[0]));
     LayerDepth layerDepth = 0;
@@ -1814,10 +1814,10 @@ void Triangulation<T, TNearPointLocator>::insertVertices_Randomized(
     VertInd superGeomVertCount)
 {
     std::size_t vertexCount = vertices.size() - superGeomVertCount;
-    std::vector<VertInd> ii(vertexCount);
+    vector<VertInd> ii(vertexCount);
     detail::iota(ii.begin(), ii.end(), superGeomVertCount);
     detail::random_shuffle(ii.begin(), ii.end());
-    for(std::vector<VertInd>::iterator it = ii.begin(); it != ii.end(); ++it)
+    for(vector<VertInd>::iterator it = ii.begin(); it != ii.end(); ++it)
     {
         insertVertex(*it);
     }
@@ -1904,19 +1904,19 @@ public:
     }
 #endif
 private:
-    std::vector<T> m_vec;
-    typename std::vector<T>::iterator m_front;
-    typename std::vector<T>::iterator m_back;
+    vector<T> m_vec;
+    typename vector<T>::iterator m_front;
+    typename vector<T>::iterator m_back;
     std::size_t m_size;
 };
 
 template <typename T>
 class less_than_x
 {
-    const std::vector<V2d<T> >& m_vertices;
+    const vector<V2d<T> >& m_vertices;
 
 public:
-    less_than_x(const std::vector<V2d<T> >& vertices)
+    less_than_x(const vector<V2d<T> >& vertices)
         : m_vertices(vertices)
     {}
     bool operator()(const VertInd a, const VertInd b) const
@@ -1928,10 +1928,10 @@ public:
 template <typename T>
 class less_than_y
 {
-    const std::vector<V2d<T> >& m_vertices;
+    const vector<V2d<T> >& m_vertices;
 
 public:
-    less_than_y(const std::vector<V2d<T> >& vertices)
+    less_than_y(const vector<V2d<T> >& vertices)
         : m_vertices(vertices)
     {}
     bool operator()(const VertInd a, const VertInd b) const
@@ -1953,10 +1953,10 @@ void Triangulation<T, TNearPointLocator>::insertVertices_KDTreeBFS(
         static_cast<IndexSizeType>(vertices.size()) - superGeomVertCount;
     if(vertexCount <= 0)
         return;
-    std::vector<VertInd> ii(vertexCount);
+    vector<VertInd> ii(vertexCount);
     detail::iota(ii.begin(), ii.end(), superGeomVertCount);
 
-    typedef std::vector<VertInd>::iterator It;
+    typedef vector<VertInd>::iterator It;
     detail::FixedCapacityQueue<tuple<It, It, V2d<T>, V2d<T>, VertInd> > queue(
         detail::maxQueueLengthBFSKDTree(vertexCount));
     queue.push(make_tuple(ii.begin(), ii.end(), boxMin, boxMax, VertInd(0)));
@@ -61,6 +61,13 @@ void Hail::Camera2D::TransformToCameraSpace(Transform2D& transformToTransform) c
     transformToTransform.SetScale(transformToTransform.GetScale() * m_zoom);
 }
 
+void Hail::Camera2D::GetViewBoundsInPixelSpace(glm::vec2& boundsMin, glm::vec2& boundsMax) const
+{
+    const glm::vec2 halfResolution = glm::vec2(m_screenResolution) * 0.5f;
+    boundsMin = (m_position - halfResolution) / m_zoom;
+    boundsMax = (m_position + halfResolution) / m_zoom;
+}
+
 void Hail::Camera2D::TransformLineToCameraSpaceFromNormalizedSpace(glm::vec3& start, glm::vec3& end) const
 {
     const glm::vec2 gridSpacePos1 = glm::vec2(start) * 2.0f - 1.f;
@@ -51,6 +51,8 @@ namespace Hail
 		void TransformToCameraSpace(Transform2D& transformToTransform) const;
 		void TransformLineToCameraSpaceFromNormalizedSpace(glm::vec3& start, glm::vec3& end) const;
 		void TransformLineToCameraSpaceFromPixelSpace(glm::vec3& start, glm::vec3& end) const;
+		// The area the camera sees in pixel space, the space positions are in before they are transformed to camera space.
+		void GetViewBoundsInPixelSpace(glm::vec2& boundsMin, glm::vec2& boundsMax) const;
 	private:
 		float m_zoom{};
 		glm::vec2 m_position;
@@ -0,0 +1,23 @@
+#pragma once
+#include "Types.h"
+#include "MemoryTracker.h"
+
+namespace Hail
+{
+	// Allocators used by the containers, an allocator is a type with a static Allocate and Deallocate.
+	// The containers only ask for raw memory and construct their elements themselves.
+	struct HeapAllocator
+	{
+		// Tagged with the memory tag scope of the calling thread.
+		static void* Allocate(size_t sizeInBytes, size_t alignment)
+		{
+			return MemoryTracker::Allocate(sizeInBytes, alignment, MemoryTracker::GetCurrentTag(), nullptr);
+		}
+
+		// The size and alignment are kept by the tracker in front of the memory.
+		static void Deallocate(void* pMemory, [[maybe_unused]] size_t sizeInBytes, [[maybe_unused]] size_t alignment)
+		{
+			MemoryTracker::Deallocate(pMemory);
+		}
+	};
+}
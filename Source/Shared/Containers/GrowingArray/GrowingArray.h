@@ -1,10 +1,18 @@
 #pragma once
 #include <initializer_list>
+#include <limits>
+#include <new>
+#include <string.h>
+#include <type_traits>
+#include <utility>
 #include "InternalMessageHandling\InternalMessageHandling.h"
-		
+#include "Containers\ContainerAllocators.h"
+
 namespace Hail
 {
-	template<typename T, typename CountType = size_t>
+	// The memory is allocated uninitialized from the Allocator, only the elements in [0, Size()) are constructed.
+	// Trivially copyable types are moved around with memcpy / memmove, other types are move constructed when the array grows.
+	template<typename T, typename CountType = size_t, typename Allocator = HeapAllocator>
 	class GrowingArray
 	{
 	public:
@@ -33,6 +41,7 @@ namespace Hail
 		inline const T& operator[](const CountType& index) const;
 
 		inline T& Add(const T& object);
+		inline T& Add(T&& object);
 		inline T& Add();
 		inline void AddN(uint32 numberOfItemsToAdd);
 		inline void AddN(const T& object, uint32 numberOfItemsToAdd);
@@ -65,69 +74,83 @@ namespace Hail
 		inline void Resize(CountType newSize);
 
 		inline T* Data() { return m_arrayPointer; }
+		inline const T* Data() const { return m_arrayPointer; }
 
 
 	private:
+		static constexpr bool IsTriviallyCopyable = std::is_trivially_copyable<T>::value;
+		static constexpr bool IsTriviallyDestructible = std::is_trivially_destructible<T>::value;
+
+		static T* AllocateMemory(CountType numberOfItems);
+		static void DeallocateMemory(T* pMemory, CountType numberOfItems);
+		// Constructs the items in [first, last), trivial types are left uninitialized like a new T[] would.
+		static void DefaultConstruct(T* pFirst, T* pLast);
+		static void Destroy(T* pFirst, T* pLast);
+		// Moves the items to uninitialized memory and destroys the source items.
+		static void Relocate(T* pSource, T* pDestination, CountType numberOfItems);
+
 		void DumpAll();
 		void GrowArray();
 		void GrowArray(const CountType growSize);
+		// Grows with doubling until the capacity fits numberOfItems.
+		void EnsureCapacity(size_t numberOfItems);
 
 		CountType m_elementCount;
 		CountType m_capacity;
 		T* m_arrayPointer;
 	};
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray()
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray()
 	{
 		m_arrayPointer = nullptr;
 		m_capacity = 0;
 		m_elementCount = 0;
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::~GrowingArray()
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::~GrowingArray()
 	{
 		DumpAll();
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray(const std::initializer_list<T>& initList) :
-		m_capacity(0),
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray(const std::initializer_list<T>& initList) :
 		m_elementCount(0),
+		m_capacity(0),
 		m_arrayPointer(nullptr)
 	{
 		Prepare((CountType)initList.size());
 
-		for (T object : initList)
-			m_arrayPointer[m_elementCount++] = object;
+		for (const T& object : initList)
+			new (m_arrayPointer + m_elementCount++) T(object);
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray(CountType nrOfRecommendedItems) :
-		m_capacity(nrOfRecommendedItems),
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray(CountType nrOfRecommendedItems) :
 		m_elementCount(0),
+		m_capacity(0),
 		m_arrayPointer(nullptr)
 	{
-		Prepare(m_capacity);
+		Prepare(nrOfRecommendedItems);
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray(CountType nrOfRecommendedItems, const T& objectToFillWith) :
-		m_capacity(nrOfRecommendedItems),
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray(CountType nrOfRecommendedItems, const T& objectToFillWith) :
 		m_elementCount(0),
+		m_capacity(0),
 		m_arrayPointer(nullptr)
 	{
-		Prepare(m_capacity);
+		Prepare(nrOfRecommendedItems);
 		for (m_elementCount = 0; m_elementCount < m_capacity; m_elementCount++)
 		{
-			m_arrayPointer[m_elementCount] = objectToFillWith;
+			new (m_arrayPointer + m_elementCount) T(objectToFillWith);
 		}
 	}
 
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray(const GrowingArray& growingArray)
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray(const GrowingArray& growingArray)
 	{
 		m_arrayPointer = nullptr;
 		m_capacity = 0;
@@ -135,11 +158,10 @@ namespace Hail
 		(*this) = growingArray;
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>::GrowingArray(GrowingArray&& growingArray)
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>::GrowingArray(GrowingArray&& growingArray)
 	{
 		m_capacity = growingArray.m_capacity;
-		m_arrayPointer = growingArray.m_arrayPointer;
 		m_elementCount = growingArray.m_elementCount;
 		m_arrayPointer = growingArray.m_arrayPointer;
 
@@ -148,8 +170,8 @@ namespace Hail
 		growingArray.m_capacity = 0;
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::Prepare(CountType numberOfItemsToInit)
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::Prepare(CountType numberOfItemsToInit)
 	{
 		if (m_arrayPointer && numberOfItemsToInit <= m_capacity)
 			return;
@@ -158,55 +180,73 @@ namespace Hail
 		{
 			m_elementCount = 0;
 			m_capacity = numberOfItemsToInit;
-			m_arrayPointer = new T[m_capacity];
+			m_arrayPointer = AllocateMemory(m_capacity);
 			return;
 		}
 
 		T* oldPointer = m_arrayPointer;
+		const CountType oldCapacity = m_capacity;
 
 		m_capacity = numberOfItemsToInit;
-		m_arrayPointer = new T[m_capacity];
-
-		for (CountType iSlot = 0; iSlot < m_elementCount; ++iSlot)
-		{
-			m_arrayPointer[iSlot] = oldPointer[iSlot];
-		}
-
-		delete[] oldPointer;
+		m_arrayPointer = AllocateMemory(m_capacity);
+		Relocate(oldPointer, m_arrayPointer, m_elementCount);
+		DeallocateMemory(oldPointer, oldCapacity);
 	}
 
-	template<typename T, typename CountType>
-	inline void GrowingArray<T, CountType>::PrepareAndFill(CountType numberOfItemsToInit)
+	template <typename T, typename CountType, typename Allocator>
+	inline void GrowingArray<T, CountType, Allocator>::PrepareAndFill(CountType numberOfItemsToInit)
 	{
 		Prepare(numberOfItemsToInit);
+		if (numberOfItemsToInit > m_elementCount)
+			DefaultConstruct(m_arrayPointer + m_elementCount, m_arrayPointer + numberOfItemsToInit);
+		else
+			Destroy(m_arrayPointer + numberOfItemsToInit, m_arrayPointer + m_elementCount);
 		m_elementCount = numberOfItemsToInit;
 	}
 
-	template<typename T, typename CountType>
-	inline void GrowingArray<T, CountType>::Fill()
+	template <typename T, typename CountType, typename Allocator>
+	inline void GrowingArray<T, CountType, Allocator>::Fill()
 	{
+		if (!m_arrayPointer)
+			return;
+		DefaultConstruct(m_arrayPointer + m_elementCount, m_arrayPointer + m_capacity);
 		m_elementCount = m_capacity;
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>& GrowingArray<typename T, typename CountType>::operator=(const GrowingArray& growingArray)
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>& GrowingArray<T, CountType, Allocator>::operator=(const GrowingArray& growingArray)
 	{
+		if (this == &growingArray)
+			return (*this);
+
 		DumpAll();
 		if (growingArray.m_capacity)
 			Prepare(growingArray.m_capacity);
 
-		m_elementCount = growingArray.m_elementCount;
-		for (CountType iSlot = 0; iSlot < m_elementCount; ++iSlot)
+		if constexpr (IsTriviallyCopyable)
+		{
+			if (growingArray.m_elementCount)
+				memcpy(m_arrayPointer, growingArray.m_arrayPointer, sizeof(T) * growingArray.m_elementCount);
+			m_elementCount = growingArray.m_elementCount;
+		}
+		else
 		{
-			m_arrayPointer[iSlot] = growingArray.m_arrayPointer[iSlot];
+			for (; m_elementCount < growingArray.m_elementCount; ++m_elementCount)
+			{
+				new (m_arrayPointer + m_elementCount) T(growingArray.m_arrayPointer[m_elementCount]);
+			}
 		}
 
 		return (*this);
 	}
 
-	template <typename T, typename CountType>
-	GrowingArray<typename T, typename CountType>& GrowingArray<typename T, typename CountType>::operator=(GrowingArray&& growingArray)
+	template <typename T, typename CountType, typename Allocator>
+	GrowingArray<T, CountType, Allocator>& GrowingArray<T, CountType, Allocator>::operator=(GrowingArray&& growingArray)
 	{
+		if (this == &growingArray)
+			return (*this);
+
+		DumpAll();
 		m_capacity = growingArray.m_capacity;
 		m_elementCount = growingArray.m_elementCount;
 		m_arrayPointer = growingArray.m_arrayPointer;
@@ -217,153 +257,192 @@ namespace Hail
 		return (*this);
 	}
 
-	template <typename T, typename CountType>
-	T& GrowingArray<typename T, typename CountType>::operator[](const CountType& index)
+	template <typename T, typename CountType, typename Allocator>
+	T& GrowingArray<T, CountType, Allocator>::operator[](const CountType& index)
 	{
 		H_ASSERT(index < m_elementCount, "Index is out of range.");
 		return m_arrayPointer[index];
 	}
 
-	template <typename T, typename CountType>
-	const T& GrowingArray<typename T, typename CountType>::operator[](const CountType& index) const
+	template <typename T, typename CountType, typename Allocator>
+	const T& GrowingArray<T, CountType, Allocator>::operator[](const CountType& index) const
 	{
 		H_ASSERT(index < m_elementCount, "Index is out of range.");
 		return m_arrayPointer[index];
 	}
 
-	template <typename T, typename CountType>
-	T& GrowingArray<typename T, typename CountType>::Add(const T& object)
+	template <typename T, typename CountType, typename Allocator>
+	T& GrowingArray<T, CountType, Allocator>::Add(const T& object)
 	{
-		if (!m_arrayPointer)
-			Prepare(m_capacity != 0 ? m_capacity : 8);
-
-		if (m_elementCount + 1 > (m_capacity))
-			GrowArray();
-
-		m_arrayPointer[m_elementCount] = object;
+		if (m_elementCount + 1 > m_capacity)
+		{
+			// The object can be an item in this array, so it is copied before the memory is moved.
+			T objectCopy(object);
+			EnsureCapacity(m_elementCount + 1);
+			new (m_arrayPointer + m_elementCount) T(std::move(objectCopy));
+		}
+		else
+		{
+			new (m_arrayPointer + m_elementCount) T(object);
+		}
 		++m_elementCount;
 		return GetLast();
 	}
 
-	template <typename T, typename CountType>
-	T& GrowingArray<typename T, typename CountType>::Add()
+	template <typename T, typename CountType, typename Allocator>
+	T& GrowingArray<T, CountType, Allocator>::Add(T&& object)
 	{
-		Add(T());
+		if (m_elementCount + 1 > m_capacity)
+		{
+			T objectToAdd(std::move(object));
+			EnsureCapacity(m_elementCount + 1);
+			new (m_arrayPointer + m_elementCount) T(std::move(objectToAdd));
+		}
+		else
+		{
+			new (m_arrayPointer + m_elementCount) T(std::move(object));
+		}
+		++m_elementCount;
 		return GetLast();
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::AddN(uint32 numberOfItemsToAdd)
+	template <typename T, typename CountType, typename Allocator>
+	T& GrowingArray<T, CountType, Allocator>::Add()
 	{
-		if (!m_arrayPointer)
-			Prepare(m_capacity != 0 ? m_capacity : 8);
+		EnsureCapacity(m_elementCount + 1);
+		new (m_arrayPointer + m_elementCount) T();
+		++m_elementCount;
+		return GetLast();
+	}
 
-		if (m_elementCount + numberOfItemsToAdd > (m_capacity))
-			GrowArray(m_elementCount + numberOfItemsToAdd * 2);
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::AddN(uint32 numberOfItemsToAdd)
+	{
+		EnsureCapacity(m_elementCount + numberOfItemsToAdd);
 
-		for (size_t i = m_elementCount; i < m_capacity; i++)
-			m_arrayPointer[m_elementCount] = {};
+		for (CountType i = m_elementCount; i < m_elementCount + numberOfItemsToAdd; i++)
+			new (m_arrayPointer + i) T();
 
 		m_elementCount += numberOfItemsToAdd;
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::AddN(const T& object, uint32 numberOfItemsToAdd)
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::AddN(const T& object, uint32 numberOfItemsToAdd)
 	{
-		if (!m_arrayPointer)
-			Prepare(m_capacity != 0 ? m_capacity : 8);
-
-		if (m_elementCount + numberOfItemsToAdd > (m_capacity))
-			GrowArray(m_elementCount + numberOfItemsToAdd * 2);
-
-		for (size_t i = m_elementCount; i < m_capacity; i++)
-			m_arrayPointer[m_elementCount] = object;
+		if (m_elementCount + numberOfItemsToAdd > m_capacity)
+		{
+			T objectCopy(object);
+			EnsureCapacity(m_elementCount + numberOfItemsToAdd);
+			for (CountType i = m_elementCount; i < m_elementCount + numberOfItemsToAdd; i++)
+				new (m_arrayPointer + i) T(objectCopy);
+		}
+		else
+		{
+			for (CountType i = m_elementCount; i < m_elementCount + numberOfItemsToAdd; i++)
+				new (m_arrayPointer + i) T(object);
+		}
 
 		m_elementCount += numberOfItemsToAdd;
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::Insert(CountType index, const T& object)
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::Insert(CountType index, const T& object)
 	{
-		if (!m_arrayPointer)
-			Prepare(8);
+		H_ASSERT(index <= m_elementCount, "Index is out of range.");
+		if (index == m_elementCount)
+		{
+			Add(object);
+			return;
+		}
 
-		T tempObject = m_arrayPointer[m_elementCount - 1];
+		T objectCopy(object);
+		EnsureCapacity(m_elementCount + 1);
 
-		if (index != m_elementCount)
+		if constexpr (IsTriviallyCopyable)
 		{
+			memmove(m_arrayPointer + index + 1, m_arrayPointer + index, sizeof(T) * (m_elementCount - index));
+			new (m_arrayPointer + index) T(std::move(objectCopy));
+		}
+		else
+		{
+			new (m_arrayPointer + m_elementCount) T(std::move(m_arrayPointer[m_elementCount - 1]));
 			for (CountType iData = m_elementCount - 1; iData > index; --iData)
 			{
-				m_arrayPointer[iData] = m_arrayPointer[iData - 1];
+				m_arrayPointer[iData] = std::move(m_arrayPointer[iData - 1]);
 			}
+			m_arrayPointer[index] = std::move(objectCopy);
 		}
-		m_arrayPointer[index] = object;
-		Add(tempObject);
+		++m_elementCount;
 	}
 
 
-	template <typename T, typename CountType>
-	bool GrowingArray<typename T, typename CountType>::RemoveCyclic(const T& object)
+	template <typename T, typename CountType, typename Allocator>
+	bool GrowingArray<T, CountType, Allocator>::RemoveCyclic(const T& object)
 	{
 		if (!m_arrayPointer)
 			return false;
 
-		const CountType ItemSlot = Find(object);
+		const int ItemSlot = Find(object);
 		if (ItemSlot != -1)
 		{
-			RemoveCyclicAtIndex(ItemSlot);
+			RemoveCyclicAtIndex((CountType)ItemSlot);
 		}
 		return true;
 	}
 
-	template <typename T, typename CountType>
-	bool GrowingArray<typename T, typename CountType>::RemoveCyclicAtIndex(CountType itemNumber)
+	template <typename T, typename CountType, typename Allocator>
+	bool GrowingArray<T, CountType, Allocator>::RemoveCyclicAtIndex(CountType itemNumber)
 	{
 		H_ASSERT(m_arrayPointer, "Uninitialized GrowingArray.");
 		if (!m_arrayPointer)
 			return false;
 
 		H_ASSERT(itemNumber < m_elementCount, "Index is out of range.");
-		if (m_elementCount != 1)
-		{
-			m_arrayPointer[itemNumber] = m_arrayPointer[m_elementCount - 1];
-			--m_elementCount;
-		}
-		else
-		{
-			RemoveAll();
-		}
+		if (itemNumber != m_elementCount - 1)
+			m_arrayPointer[itemNumber] = std::move(m_arrayPointer[m_elementCount - 1]);
+
+		--m_elementCount;
+		Destroy(m_arrayPointer + m_elementCount, m_arrayPointer + m_elementCount + 1);
 		return true;
 	}
 
-	template <typename T, typename CountType>
-	bool GrowingArray<T, CountType>::RemoveAtIndex(CountType itemNumber)
+	template <typename T, typename CountType, typename Allocator>
+	bool GrowingArray<T, CountType, Allocator>::RemoveAtIndex(CountType itemNumber)
 	{
 		if (!m_arrayPointer)
 			return false;
 		H_ASSERT(itemNumber < m_elementCount, "Index is out of range.");
 		--m_elementCount;
-		for (unsigned int i = itemNumber; i < m_elementCount; ++i)
+		if constexpr (IsTriviallyCopyable)
 		{
-			m_arrayPointer[i] = m_arrayPointer[i + 1];
+			memmove(m_arrayPointer + itemNumber, m_arrayPointer + itemNumber + 1, sizeof(T) * (m_elementCount - itemNumber));
+		}
+		else
+		{
+			for (CountType i = itemNumber; i < m_elementCount; ++i)
+			{
+				m_arrayPointer[i] = std::move(m_arrayPointer[i + 1]);
+			}
+			Destroy(m_arrayPointer + m_elementCount, m_arrayPointer + m_elementCount + 1);
 		}
 		return true;
 	}
 
-	template<typename T, typename CountType>
-	inline bool GrowingArray<T, CountType>::RemoveLast()
+	template <typename T, typename CountType, typename Allocator>
+	inline bool GrowingArray<T, CountType, Allocator>::RemoveLast()
 	{
 		if (!m_arrayPointer)
 			return false;
 		if (m_elementCount > 0)
 		{
 			m_elementCount--;
+			Destroy(m_arrayPointer + m_elementCount, m_arrayPointer + m_elementCount + 1);
 		}
 		return true;
 	}
 
-	template <typename T, typename CountType>
-	int GrowingArray<typename T, typename CountType>::Find(const T& object) const
+	template <typename T, typename CountType, typename Allocator>
+	int GrowingArray<T, CountType, Allocator>::Find(const T& object) const
 	{
 		if (!m_arrayPointer)
 			return -1;
@@ -379,40 +458,42 @@ namespace Hail
 		return -1;
 	}
 
-	template <typename T, typename CountType>
-	T& GrowingArray<typename T, typename CountType>::GetLast()
+	template <typename T, typename CountType, typename Allocator>
+	T& GrowingArray<T, CountType, Allocator>::GetLast()
 	{
 		H_ASSERT(!Empty(), "GrowingArray is empty.");
 		return m_arrayPointer[m_elementCount - 1];
 	}
 
-	template <typename T, typename CountType>
-	const T& GrowingArray<typename T, typename CountType>::GetLast() const
+	template <typename T, typename CountType, typename Allocator>
+	const T& GrowingArray<T, CountType, Allocator>::GetLast() const
 	{
 		H_ASSERT(!Empty(), "GrowingArray is empty.");
 		return m_arrayPointer[m_elementCount - 1];
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::RemoveAll()
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::RemoveAll()
 	{
+		if (m_arrayPointer)
+			Destroy(m_arrayPointer, m_arrayPointer + m_elementCount);
 		m_elementCount = 0;
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::DeleteAll()
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::DeleteAll()
 	{
 		DumpAll();
 	}
 
-	template <typename T, typename CountType>
-	CountType GrowingArray<typename T, typename CountType>::Size() const
+	template <typename T, typename CountType, typename Allocator>
+	CountType GrowingArray<T, CountType, Allocator>::Size() const
 	{
 		return m_elementCount;
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::Resize(CountType aNewSize)
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::Resize(CountType aNewSize)
 	{
 		if (!m_arrayPointer)
 			Prepare(aNewSize);
@@ -420,49 +501,106 @@ namespace Hail
 	}
 
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::GrowArray()
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::GrowArray()
 	{
 		if (!m_arrayPointer)
 			return;
 		GrowArray(m_capacity * 2);
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::GrowArray(const CountType newSize)
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::GrowArray(const CountType newSize)
 	{
 		if (!m_arrayPointer || newSize <= m_capacity)
 			return;
-		T* tempPointer = m_arrayPointer;
-		const CountType tempCount = m_elementCount;
-		m_arrayPointer = nullptr;
-		m_elementCount = 0;
 		Prepare(newSize);
+	}
 
-		for (; m_elementCount < tempCount; m_elementCount++)
-		{
-			m_arrayPointer[m_elementCount] = tempPointer[m_elementCount];
-		}
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::EnsureCapacity(size_t numberOfItems)
+	{
+		if (numberOfItems <= m_capacity && m_arrayPointer)
+			return;
 
-		delete[] tempPointer;
-		tempPointer = nullptr;
+		// Doubling is clamped to the largest count so small count types can not wrap to 0 and loop forever.
+		constexpr CountType maxCapacity = std::numeric_limits<CountType>::max();
+		H_ASSERT(numberOfItems <= maxCapacity, "Too many items for the count type of the array.");
+		CountType newCapacity = m_capacity != 0 ? m_capacity : 8;
+		while (newCapacity < numberOfItems)
+			newCapacity = newCapacity > maxCapacity / 2 ? maxCapacity : newCapacity * 2;
+		Prepare(newCapacity);
 	}
 
-	template <typename T, typename CountType>
-	void GrowingArray<typename T, typename CountType>::DumpAll()
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::DumpAll()
 	{
 		if (m_arrayPointer)
 		{
-			delete[] m_arrayPointer;
+			Destroy(m_arrayPointer, m_arrayPointer + m_elementCount);
+			DeallocateMemory(m_arrayPointer, m_capacity);
 			m_arrayPointer = nullptr;
 		}
 		m_capacity = 0;
-		RemoveAll();
+		m_elementCount = 0;
 	}
 
-	template<typename T, typename CountType>
-	template<class SearchCondition>
-	inline int GrowingArray<T, CountType>::FindCustomCondition(SearchCondition searchCondition)
+	template <typename T, typename CountType, typename Allocator>
+	T* GrowingArray<T, CountType, Allocator>::AllocateMemory(CountType numberOfItems)
+	{
+		// Always hand out a valid pointer, a prepared array with a capacity of 0 is still seen as initialized.
+		const size_t sizeInBytes = sizeof(T) * (numberOfItems != 0 ? numberOfItems : 1);
+		return static_cast<T*>(Allocator::Allocate(sizeInBytes, alignof(T)));
+	}
+
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::DeallocateMemory(T* pMemory, CountType numberOfItems)
+	{
+		const size_t sizeInBytes = sizeof(T) * (numberOfItems != 0 ? numberOfItems : 1);
+		Allocator::Deallocate(pMemory, sizeInBytes, alignof(T));
+	}
+
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::DefaultConstruct(T* pFirst, T* pLast)
+	{
+		if constexpr (!std::is_trivially_default_constructible<T>::value)
+		{
+			for (; pFirst < pLast; ++pFirst)
+				new (pFirst) T();
+		}
+	}
+
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::Destroy(T* pFirst, T* pLast)
+	{
+		if constexpr (!IsTriviallyDestructible)
+		{
+			for (; pFirst < pLast; ++pFirst)
+				pFirst->~T();
+		}
+	}
+
+	template <typename T, typename CountType, typename Allocator>
+	void GrowingArray<T, CountType, Allocator>::Relocate(T* pSource, T* pDestination, CountType numberOfItems)
+	{
+		if constexpr (IsTriviallyCopyable)
+		{
+			if (numberOfItems)
+				memcpy(pDestination, pSource, sizeof(T) * numberOfItems);
+		}
+		else
+		{
+			for (CountType i = 0; i < numberOfItems; ++i)
+			{
+				new (pDestination + i) T(std::move(pSource[i]));
+				pSource[i].~T();
+			}
+		}
+	}
+
+	template <typename T, typename CountType, typename Allocator>
+	template <class SearchCondition>
+	inline int GrowingArray<T, CountType, Allocator>::FindCustomCondition(SearchCondition searchCondition)
 	{
 		if (!m_elementCount)
 			return -1;
@@ -476,29 +614,30 @@ namespace Hail
 		return -1;
 	}
 
-	template<typename T, typename CountType>
-	template<class Comparer>
-	inline void GrowingArray<T, CountType>::Sort(Comparer compareFunc)
+	template <typename T, typename CountType, typename Allocator>
+	template <class Comparer>
+	inline void GrowingArray<T, CountType, Allocator>::Sort(Comparer compareFunc)
 	{
 		// currently implemented with a Bubble sort from online, I will update this later with a linear sort if below 128 entries, otherwise it should be a quicksort
+		if (m_elementCount < 2)
+			return;
 		CountType n = m_elementCount;
 
 		// Outer loop that corresponds to the number of elements to be sorted
-		for (int i = 0; i < n - 1; i++) 
+		for (int i = 0; i < n - 1; i++)
 		{
 			// Last i elements are already in place
-			for (int j = 0; j < n - i - 1; j++) 
+			for (int j = 0; j < n - i - 1; j++)
 			{
 				// Comparing adjacent elements
 				if (compareFunc(m_arrayPointer[j], m_arrayPointer[j + 1]))
 				{
-					// Should maybe be done with stl::swap especially if T is an expensive object to create a copy of and should be moved, but ehh, fuck stl amiright? 
-					const T jVal = m_arrayPointer[j];
-					m_arrayPointer[j] = m_arrayPointer[j + 1];
-					m_arrayPointer[j + 1] = jVal;
+					T jVal = std::move(m_arrayPointer[j]);
+					m_arrayPointer[j] = std::move(m_arrayPointer[j + 1]);
+					m_arrayPointer[j + 1] = std::move(jVal);
 				}
 			}
 		}
 	}
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,370 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "Types.h"
+#include "MathUtils.h"
+#include "JobSystem.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	// Static 2D KD-tree over an external array of points, any point type with an x and y member works (glm::vec2, CDT::V2d).
+	// The tree only stores point indices, ordered so every leaf is a contiguous range, and the nodes in depth first order
+	// so the left child of a node is always the next node. Build splits every range at the median with nth_element, O(n log n).
+	// Queries are const and use a fixed stack so any number of threads can query the same tree at the same time,
+	// the points passed to a query have to be the points the tree was built from.
+	template<typename PointType>
+	class KDTree2D
+	{
+	public:
+		using CoordType = std::remove_cv_t<decltype(std::declval<PointType>().x)>;
+		static constexpr uint32 LeafSize = 16u;
+		static constexpr uint32 InvalidIndex = MAX_UINT;
+
+		void Build(const PointType* pPoints, uint32 numberOfPoints);
+		// Builds the tree from a subset of the points, the indices are into pPoints.
+		void Build(const PointType* pPoints, const uint32* pPointIndices, uint32 numberOfIndices);
+		// Keeps the memory for the next build.
+		void Clear();
+
+		uint32 Size() const { return (uint32)m_indices.Size(); }
+		bool Empty() const { return m_indices.Empty(); }
+		// The indices the tree was built from, in leaf order.
+		const uint32* GetPointIndices() const { return m_indices.Data(); }
+
+		// Returns InvalidIndex if the tree is empty.
+		uint32 FindNearest(const PointType* pPoints, const PointType& position, CoordType* pDistanceSquaredOut = nullptr) const;
+		// Fills up to k indices sorted from the nearest to the furthest point, returns how many were found.
+		uint32 FindKNearest(const PointType* pPoints, const PointType& position, uint32 k, uint32* pIndicesOut, CoordType* pDistancesSquaredOut) const;
+		// Calls callback(pointIndex, distanceSquared) for every point closer than the radius, in no particular order.
+		template<typename Callback>
+		void ForEachInRadius(const PointType* pPoints, const PointType& position, CoordType radius, Callback&& callback) const;
+		// Adds the index of every point closer than the radius.
+		void FindInRadius(const PointType* pPoints, const PointType& position, CoordType radius, GrowingArray<uint32>& indicesOut) const;
+
+		// Batch queries split the queries over the workers of the job system, a null job system runs them on the calling thread.
+		// Like every ParallelFor they can not be called from inside a job.
+		// The result of query i is written to [i * k, i * k + k) and pNumberOfFoundOut[i] is how many of them were found.
+		void FindKNearestBatch(JobSystem* pJobSystem, const PointType* pPoints, const PointType* pQueries, uint32 numberOfQueries, uint32 k,
+			uint32* pIndicesOut, CoordType* pDistancesSquaredOut, uint32* pNumberOfFoundOut) const;
+		// Calls callback(queryIndex, pointIndex, distanceSquared), the callbacks of different queries run at the same time on different threads.
+		template<typename Callback>
+		void ForEachInRadiusBatch(JobSystem* pJobSystem, const PointType* pPoints, const PointType* pQueries, uint32 numberOfQueries, CoordType radius, Callback& callback) const;
+
+	private:
+		struct Node
+		{
+			CoordType m_split;
+			// 0 for leaves.
+			uint32 m_rightChild;
+			uint32 m_begin;
+			uint32 m_end;
+			uint32 m_axis;
+		};
+		struct StackEntry
+		{
+			uint32 m_node;
+			CoordType m_distanceSquared;
+		};
+		// Ranges are split at the median so the depth is at most 32 and at most one entry is pushed per level.
+		static constexpr uint32 MaxStackSize = 64u;
+		// Enough jobs per worker to even out queries that take longer than others.
+		static constexpr uint32 JobsPerWorker = 4u;
+
+		template<typename Callback>
+		struct RadiusBatch
+		{
+			const KDTree2D* m_pTree;
+			const PointType* m_pPoints;
+			const PointType* m_pQueries;
+			uint32 m_numberOfQueries;
+			uint32 m_queriesPerJob;
+			CoordType m_radius;
+			Callback* m_pCallback;
+
+			static void Run(void* pUserData, uint32 jobIndex);
+		};
+		struct KNearestBatch
+		{
+			const KDTree2D* m_pTree;
+			const PointType* m_pPoints;
+			const PointType* m_pQueries;
+			uint32 m_numberOfQueries;
+			uint32 m_queriesPerJob;
+			uint32 m_k;
+			uint32* m_pIndicesOut;
+			CoordType* m_pDistancesSquaredOut;
+			uint32* m_pNumberOfFoundOut;
+
+			static void Run(void* pUserData, uint32 jobIndex);
+		};
+
+		uint32 BuildNode(const PointType* pPoints, uint32 begin, uint32 end);
+		// Visits the points closer than maxDistanceSquared, the visitor may lower maxDistanceSquared to prune the search.
+		template<typename Visitor>
+		void Search(const PointType* pPoints, const PointType& position, CoordType& maxDistanceSquared, Visitor&& visitor) const;
+
+		static CoordType GetCoord(const PointType& point, uint32 axis) { return axis == 0u ? point.x : point.y; }
+		static CoordType DistanceSquared(const PointType& a, const PointType& b)
+		{
+			const CoordType dx = a.x - b.x;
+			const CoordType dy = a.y - b.y;
+			return dx * dx + dy * dy;
+		}
+		static uint32 GetNumberOfJobs(JobSystem* pJobSystem, uint32 numberOfQueries)
+		{
+			if (!pJobSystem)
+				return numberOfQueries ? 1u : 0u;
+			return Math::Min(numberOfQueries, (pJobSystem->GetNumberOfWorkers() + 1u) * JobsPerWorker);
+		}
+
+		GrowingArray<uint32> m_indices;
+		GrowingArray<Node> m_nodes;
+	};
+
+	template<typename PointType>
+	void KDTree2D<PointType>::Build(const PointType* pPoints, uint32 numberOfPoints)
+	{
+		m_indices.PrepareAndFill(numberOfPoints);
+		for (uint32 i = 0; i < numberOfPoints; i++)
+			m_indices[i] = i;
+
+		m_nodes.RemoveAll();
+		if (numberOfPoints)
+		{
+			m_nodes.Prepare(2u * (numberOfPoints / (LeafSize / 2u)) + 1u);
+			BuildNode(pPoints, 0u, numberOfPoints);
+		}
+	}
+
+	template<typename PointType>
+	void KDTree2D<PointType>::Build(const PointType* pPoints, const uint32* pPointIndices, uint32 numberOfIndices)
+	{
+		m_indices.PrepareAndFill(numberOfIndices);
+		if (numberOfIndices)
+			memcpy(m_indices.Data(), pPointIndices, numberOfIndices * sizeof(uint32));
+
+		m_nodes.RemoveAll();
+		if (numberOfIndices)
+		{
+			m_nodes.Prepare(2u * (numberOfIndices / (LeafSize / 2u)) + 1u);
+			BuildNode(pPoints, 0u, numberOfIndices);
+		}
+	}
+
+	template<typename PointType>
+	void KDTree2D<PointType>::Clear()
+	{
+		m_indices.RemoveAll();
+		m_nodes.RemoveAll();
+	}
+
+	template<typename PointType>
+	uint32 KDTree2D<PointType>::BuildNode(const PointType* pPoints, uint32 begin, uint32 end)
+	{
+		const uint32 nodeIndex = (uint32)m_nodes.Size();
+		m_nodes.Add(Node{ CoordType(0), 0u, begin, end, 0u });
+		if (end - begin <= LeafSize)
+			return nodeIndex;
+
+		uint32* pIndices = m_indices.Data();
+		CoordType minX = pPoints[pIndices[begin]].x;
+		CoordType minY = pPoints[pIndices[begin]].y;
+		CoordType maxX = minX;
+		CoordType maxY = minY;
+		for (uint32 i = begin + 1u; i < end; i++)
+		{
+			const PointType& point = pPoints[pIndices[i]];
+			minX = Math::Min(minX, point.x);
+			maxX = Math::Max(maxX, point.x);
+			minY = Math::Min(minY, point.y);
+			maxY = Math::Max(maxY, point.y);
+		}
+
+		// Split the longest side at the median, points left of the median are <= the split and points right of it are >=.
+		const uint32 axis = (maxX - minX) >= (maxY - minY) ? 0u : 1u;
+		const uint32 middle = begin + (end - begin) / 2u;
+		std::nth_element(pIndices + begin, pIndices + middle, pIndices + end, [pPoints, axis](uint32 a, uint32 b)
+			{
+				return GetCoord(pPoints[a], axis) < GetCoord(pPoints[b], axis);
+			});
+		const CoordType split = GetCoord(pPoints[pIndices[middle]], axis);
+
+		BuildNode(pPoints, begin, middle);
+		const uint32 rightChild = BuildNode(pPoints, middle, end);
+
+		Node& node = m_nodes[nodeIndex];
+		node.m_split = split;
+		node.m_rightChild = rightChild;
+		node.m_axis = axis;
+		return nodeIndex;
+	}
+
+	template<typename PointType>
+	template<typename Visitor>
+	void KDTree2D<PointType>::Search(const PointType* pPoints, const PointType& position, CoordType& maxDistanceSquared, Visitor&& visitor) const
+	{
+		if (m_nodes.Empty())
+			return;
+
+		StackEntry stack[MaxStackSize];
+		uint32 stackSize = 0u;
+		stack[stackSize++] = StackEntry{ 0u, CoordType(0) };
+		const Node* pNodes = m_nodes.Data();
+		const uint32* pIndices = m_indices.Data();
+		while (stackSize)
+		{
+			const StackEntry entry = stack[--stackSize];
+			if (entry.m_distanceSquared >= maxDistanceSquared)
+				continue;
+
+			uint32 nodeIndex = entry.m_node;
+			while (pNodes[nodeIndex].m_rightChild)
+			{
+				const Node& node = pNodes[nodeIndex];
+				const CoordType difference = GetCoord(position, node.m_axis) - node.m_split;
+				const uint32 nearChild = difference < CoordType(0) ? nodeIndex + 1u : node.m_rightChild;
+				const uint32 farChild = difference < CoordType(0) ? node.m_rightChild : nodeIndex + 1u;
+				// The far side is at least the distance to the split plane away.
+				const CoordType farDistanceSquared = difference * difference;
+				if (farDistanceSquared < maxDistanceSquared)
+				{
+					H_ASSERT(stackSize < MaxStackSize, "KD-tree search stack overflow.");
+					stack[stackSize++] = StackEntry{ farChild, farDistanceSquared };
+				}
+				nodeIndex = nearChild;
+			}
+
+			const Node& leaf = pNodes[nodeIndex];
+			for (uint32 i = leaf.m_begin; i < leaf.m_end; i++)
+			{
+				const uint32 pointIndex = pIndices[i];
+				const CoordType distanceSquared = DistanceSquared(pPoints[pointIndex], position);
+				if (distanceSquared < maxDistanceSquared)
+					visitor(pointIndex, distanceSquared);
+			}
+		}
+	}
+
+	template<typename PointType>
+	uint32 KDTree2D<PointType>::FindNearest(const PointType* pPoints, const PointType& position, CoordType* pDistanceSquaredOut) const
+	{
+		uint32 nearestIndex = InvalidIndex;
+		CoordType maxDistanceSquared = std::numeric_limits<CoordType>::max();
+		Search(pPoints, position, maxDistanceSquared, [&nearestIndex, &maxDistanceSquared](uint32 pointIndex, CoordType distanceSquared)
+			{
+				nearestIndex = pointIndex;
+				maxDistanceSquared = distanceSquared;
+			});
+
+		if (pDistanceSquaredOut)
+			*pDistanceSquaredOut = maxDistanceSquared;
+		return nearestIndex;
+	}
+
+	template<typename PointType>
+	uint32 KDTree2D<PointType>::FindKNearest(const PointType* pPoints, const PointType& position, uint32 k, uint32* pIndicesOut, CoordType* pDistancesSquaredOut) const
+	{
+		if (k == 0u)
+			return 0u;
+
+		uint32 numberOfFound = 0u;
+		CoordType maxDistanceSquared = std::numeric_limits<CoordType>::max();
+		Search(pPoints, position, maxDistanceSquared, [&](uint32 pointIndex, CoordType distanceSquared)
+			{
+				// Insertion into the sorted output, the furthest point falls off when the output is full.
+				uint32 insertIndex = numberOfFound < k ? numberOfFound++ : k - 1u;
+				while (insertIndex > 0u && pDistancesSquaredOut[insertIndex - 1u] > distanceSquared)
+				{
+					pIndicesOut[insertIndex] = pIndicesOut[insertIndex - 1u];
+					pDistancesSquaredOut[insertIndex] = pDistancesSquaredOut[insertIndex - 1u];
+					--insertIndex;
+				}
+				pIndicesOut[insertIndex] = pointIndex;
+				pDistancesSquaredOut[insertIndex] = distanceSquared;
+
+				if (numberOfFound == k)
+					maxDistanceSquared = pDistancesSquaredOut[k - 1u];
+			});
+		return numberOfFound;
+	}
+
+	template<typename PointType>
+	template<typename Callback>
+	void KDTree2D<PointType>::ForEachInRadius(const PointType* pPoints, const PointType& position, CoordType radius, Callback&& callback) const
+	{
+		CoordType maxDistanceSquared = radius * radius;
+		Search(pPoints, position, maxDistanceSquared, callback);
+	}
+
+	template<typename PointType>
+	void KDTree2D<PointType>::FindInRadius(const PointType* pPoints, const PointType& position, CoordType radius, GrowingArray<uint32>& indicesOut) const
+	{
+		ForEachInRadius(pPoints, position, radius, [&indicesOut](uint32 pointIndex, CoordType)
+			{
+				indicesOut.Add(pointIndex);
+			});
+	}
+
+	template<typename PointType>
+	void KDTree2D<PointType>::KNearestBatch::Run(void* pUserData, uint32 jobIndex)
+	{
+		const KNearestBatch& batch = *(const KNearestBatch*)pUserData;
+		const uint32 firstQuery = jobIndex * batch.m_queriesPerJob;
+		const uint32 lastQuery = Math::Min(firstQuery + batch.m_queriesPerJob, batch.m_numberOfQueries);
+		for (uint32 iQuery = firstQuery; iQuery < lastQuery; iQuery++)
+		{
+			batch.m_pNumberOfFoundOut[iQuery] = batch.m_pTree->FindKNearest(batch.m_pPoints, batch.m_pQueries[iQuery], batch.m_k,
+				batch.m_pIndicesOut + (size_t)iQuery * batch.m_k, batch.m_pDistancesSquaredOut + (size_t)iQuery * batch.m_k);
+		}
+	}
+
+	template<typename PointType>
+	void KDTree2D<PointType>::FindKNearestBatch(JobSystem* pJobSystem, const PointType* pPoints, const PointType* pQueries, uint32 numberOfQueries, uint32 k,
+		uint32* pIndicesOut, CoordType* pDistancesSquaredOut, uint32* pNumberOfFoundOut) const
+	{
+		const uint32 numberOfJobs = GetNumberOfJobs(pJobSystem, numberOfQueries);
+		if (numberOfJobs == 0u)
+			return;
+
+		KNearestBatch batch{ this, pPoints, pQueries, numberOfQueries, (numberOfQueries + numberOfJobs - 1u) / numberOfJobs,
+			k, pIndicesOut, pDistancesSquaredOut, pNumberOfFoundOut };
+		if (pJobSystem)
+			pJobSystem->ParallelFor(numberOfJobs, &KNearestBatch::Run, &batch);
+		else
+			KNearestBatch::Run(&batch, 0u);
+	}
+
+	template<typename PointType>
+	template<typename Callback>
+	void KDTree2D<PointType>::RadiusBatch<Callback>::Run(void* pUserData, uint32 jobIndex)
+	{
+		const RadiusBatch& batch = *(const RadiusBatch*)pUserData;
+		const uint32 firstQuery = jobIndex * batch.m_queriesPerJob;
+		const uint32 lastQuery = Math::Min(firstQuery + batch.m_queriesPerJob, batch.m_numberOfQueries);
+		for (uint32 iQuery = firstQuery; iQuery < lastQuery; iQuery++)
+		{
+			batch.m_pTree->ForEachInRadius(batch.m_pPoints, batch.m_pQueries[iQuery], batch.m_radius, [&batch, iQuery](uint32 pointIndex, CoordType distanceSquared)
+				{
+					(*batch.m_pCallback)(iQuery, pointIndex, distanceSquared);
+				});
+		}
+	}
+
+	template<typename PointType>
+	template<typename Callback>
+	void KDTree2D<PointType>::ForEachInRadiusBatch(JobSystem* pJobSystem, const PointType* pPoints, const PointType* pQueries, uint32 numberOfQueries, CoordType radius, Callback& callback) const
+	{
+		const uint32 numberOfJobs = GetNumberOfJobs(pJobSystem, numberOfQueries);
+		if (numberOfJobs == 0u)
+			return;
+
+		RadiusBatch<Callback> batch{ this, pPoints, pQueries, numberOfQueries, (numberOfQueries + numberOfJobs - 1u) / numberOfJobs, radius, &callback };
+		if (pJobSystem)
+			pJobSystem->ParallelFor(numberOfJobs, &RadiusBatch<Callback>::Run, &batch);
+		else
+			RadiusBatch<Callback>::Run(&batch, 0u);
+	}
+}
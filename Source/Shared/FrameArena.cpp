@@ -0,0 +1,193 @@
+#include "Shared_PCH.h"
+#include "FrameArena.h"
+#include "Threading.h"
+#include "MathUtils.h"
+#include "MemoryTracker.h"
+
+using namespace Hail;
+
+FrameArena* FrameArena::m_pInstance = nullptr;
+
+namespace Hail
+{
+	constexpr uint32 locInvalidSubArena = MAX_UINT;
+
+	// Releases the sub-arena of a thread when the thread exits so a restarted thread does not use up a new sub-arena.
+	struct ThreadSubArenaHandle
+	{
+		~ThreadSubArenaHandle()
+		{
+			if (m_subArenaIndex != locInvalidSubArena && FrameArena::IsInitialized())
+				FrameArena::GetInstance().ReleaseSubArena(m_subArenaIndex);
+		}
+
+		uint32 m_subArenaIndex = locInvalidSubArena;
+	};
+
+	thread_local ThreadSubArenaHandle tl_subArenaHandle;
+}
+
+void Hail::FrameArena::Initialize(size_t blockSizeInBytes, uint32 numberOfFramesInFlight)
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should create the frame arena.");
+	H_ASSERT(!m_pInstance, "Can not create the main instance more than once.");
+	H_ASSERT(numberOfFramesInFlight != 0 && numberOfFramesInFlight <= MaxNumberOfFramesInFlight, "Invalid number of frames in flight.");
+	m_pInstance = new FrameArena();
+	m_pInstance->m_blockSize = blockSizeInBytes;
+	m_pInstance->m_numberOfFramesInFlight = numberOfFramesInFlight;
+
+	for (uint32 iSubArena = 0; iSubArena < MaxNumberOfThreads; iSubArena++)
+	{
+		SubArena& subArena = m_pInstance->m_subArenas[iSubArena];
+		for (uint32 iBlock = 0; iBlock < MaxNumberOfFramesInFlight; iBlock++)
+			subArena.m_pBlocks[iBlock] = nullptr;
+		subArena.m_currentBlock = 0;
+		subArena.m_offset = 0;
+		subArena.m_peakThisFrame = 0;
+		subArena.m_overflowThisFrame = 0;
+		subArena.m_threadID = MAX_UINT64;
+		subArena.m_bInUse = false;
+		subArena.m_usedLastFrame = 0;
+		subArena.m_highWaterMark = 0;
+		subArena.m_overflowLastFrame = 0;
+	}
+}
+
+void Hail::FrameArena::Deinitialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should destroy the frame arena.");
+	H_ASSERT(m_pInstance, "Programming error, deleting a non valid instance.");
+	for (uint32 iSubArena = 0; iSubArena < MaxNumberOfThreads; iSubArena++)
+	{
+		SubArena& subArena = m_pInstance->m_subArenas[iSubArena];
+		for (uint32 iBlock = 0; iBlock < MaxNumberOfFramesInFlight; iBlock++)
+		{
+			if (subArena.m_pBlocks[iBlock])
+				m_pInstance->ResetBlock(subArena, iBlock);
+			MemoryTracker::Deallocate(subArena.m_pBlocks[iBlock]);
+			subArena.m_pBlocks[iBlock] = nullptr;
+		}
+	}
+	SAFEDELETE(m_pInstance);
+}
+
+void Hail::FrameArena::BeginFrame()
+{
+	SubArena& subArena = GetThreadSubArena();
+
+	const size_t usedLastFrame = Math::Max(subArena.m_peakThisFrame, subArena.m_offset);
+	subArena.m_usedLastFrame.store(usedLastFrame, std::memory_order_relaxed);
+	subArena.m_overflowLastFrame.store(subArena.m_overflowThisFrame, std::memory_order_relaxed);
+	if (usedLastFrame + subArena.m_overflowThisFrame > subArena.m_highWaterMark.load(std::memory_order_relaxed))
+		subArena.m_highWaterMark.store(usedLastFrame + subArena.m_overflowThisFrame, std::memory_order_relaxed);
+
+	subArena.m_currentBlock = (subArena.m_currentBlock + 1) % m_numberOfFramesInFlight;
+	ResetBlock(subArena, subArena.m_currentBlock);
+	subArena.m_offset = 0;
+	subArena.m_peakThisFrame = 0;
+	subArena.m_overflowThisFrame = 0;
+}
+
+void* Hail::FrameArena::Allocate(size_t sizeInBytes, size_t alignment)
+{
+	SubArena& subArena = GetThreadSubArena();
+
+	const size_t alignedOffset = (subArena.m_offset + alignment - 1) & ~(alignment - 1);
+	if (alignedOffset + sizeInBytes <= m_blockSize)
+	{
+		subArena.m_offset = alignedOffset + sizeInBytes;
+		subArena.m_peakThisFrame = Math::Max(subArena.m_peakThisFrame, subArena.m_offset);
+		return subArena.m_pBlocks[subArena.m_currentBlock] + alignedOffset;
+	}
+
+	void* pMemory = MemoryTracker::Allocate(sizeInBytes, alignment, eMemoryTag::FrameArena, nullptr);
+	subArena.m_overflowAllocations[subArena.m_currentBlock].Add(pMemory);
+	subArena.m_overflowThisFrame += sizeInBytes;
+	return pMemory;
+}
+
+FrameArena::Marker Hail::FrameArena::GetMarker()
+{
+	SubArena& subArena = GetThreadSubArena();
+	Marker marker;
+	marker.m_subArenaIndex = tl_subArenaHandle.m_subArenaIndex;
+	marker.m_blockIndex = subArena.m_currentBlock;
+	marker.m_offset = subArena.m_offset;
+	return marker;
+}
+
+void Hail::FrameArena::FreeToMarker(const Marker& marker)
+{
+	SubArena& subArena = GetThreadSubArena();
+	H_ASSERT(marker.m_subArenaIndex == tl_subArenaHandle.m_subArenaIndex, "Marker is from a different thread.");
+	H_ASSERT(marker.m_blockIndex == subArena.m_currentBlock && marker.m_offset <= subArena.m_offset, "Marker is from a different frame.");
+	subArena.m_offset = marker.m_offset;
+}
+
+void Hail::FrameArena::GetStats(GrowingArray<Stats>& statsOut) const
+{
+	statsOut.RemoveAll();
+	for (uint32 iSubArena = 0; iSubArena < MaxNumberOfThreads; iSubArena++)
+	{
+		const SubArena& subArena = m_subArenas[iSubArena];
+		if (!subArena.m_bInUse.load(std::memory_order_acquire))
+			continue;
+
+		Stats& stats = statsOut.Add();
+		stats.m_threadID = subArena.m_threadID.load(std::memory_order_relaxed);
+		stats.m_blockSize = m_blockSize;
+		stats.m_usedLastFrame = subArena.m_usedLastFrame.load(std::memory_order_relaxed);
+		stats.m_highWaterMark = subArena.m_highWaterMark.load(std::memory_order_relaxed);
+		stats.m_overflowLastFrame = subArena.m_overflowLastFrame.load(std::memory_order_relaxed);
+		stats.m_numberOfFramesInFlight = m_numberOfFramesInFlight;
+	}
+}
+
+FrameArena::SubArena& Hail::FrameArena::GetThreadSubArena()
+{
+	if (tl_subArenaHandle.m_subArenaIndex != locInvalidSubArena)
+		return m_subArenas[tl_subArenaHandle.m_subArenaIndex];
+
+	for (uint32 iSubArena = 0; iSubArena < MaxNumberOfThreads; iSubArena++)
+	{
+		SubArena& subArena = m_subArenas[iSubArena];
+		bool bExpectedInUse = false;
+		if (!subArena.m_bInUse.compare_exchange_strong(bExpectedInUse, true, std::memory_order_acq_rel))
+			continue;
+
+		// The blocks of a released sub-arena are kept and reused by the next thread.
+		for (uint32 iBlock = 0; iBlock < m_numberOfFramesInFlight; iBlock++)
+		{
+			if (!subArena.m_pBlocks[iBlock])
+				subArena.m_pBlocks[iBlock] = (uint8*)H_TRACKED_ALLOCATE(m_blockSize, __STDCPP_DEFAULT_NEW_ALIGNMENT__, eMemoryTag::FrameArena);
+		}
+		subArena.m_threadID.store(GetCurrentThreadID(), std::memory_order_relaxed);
+		subArena.m_highWaterMark.store(0, std::memory_order_relaxed);
+		tl_subArenaHandle.m_subArenaIndex = iSubArena;
+		return subArena;
+	}
+
+	H_ASSERT(false, "Too many threads are using the frame arena, increase MaxNumberOfThreads.");
+	return m_subArenas[0];
+}
+
+void Hail::FrameArena::ResetBlock(SubArena& subArena, uint32 blockIndex)
+{
+	GrowingArray<void*>& overflowAllocations = subArena.m_overflowAllocations[blockIndex];
+	for (uint32 i = 0; i < overflowAllocations.Size(); i++)
+		MemoryTracker::Deallocate(overflowAllocations[i]);
+	overflowAllocations.RemoveAll();
+}
+
+void Hail::FrameArena::ReleaseSubArena(uint32 subArenaIndex)
+{
+	SubArena& subArena = m_subArenas[subArenaIndex];
+	for (uint32 iBlock = 0; iBlock < m_numberOfFramesInFlight; iBlock++)
+		ResetBlock(subArena, iBlock);
+	subArena.m_currentBlock = 0;
+	subArena.m_offset = 0;
+	subArena.m_peakThisFrame = 0;
+	subArena.m_overflowThisFrame = 0;
+	subArena.m_threadID.store(MAX_UINT64, std::memory_order_relaxed);
+	subArena.m_bInUse.store(false, std::memory_order_release);
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <atomic>
+#include "Types.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	// Linear allocator for memory that only has to live for the current frame.
+	// Every thread that allocates gets its own sub-arena so allocating never locks, a sub-arena has one block per frame in flight
+	// and the block is reset when the thread that owns it starts a new frame on that block again.
+	// Memory from a frame is valid until the owning thread has called BeginFrame numberOfFramesInFlight times.
+	class FrameArena
+	{
+	public:
+		static constexpr uint32 MaxNumberOfThreads = 8u;
+		static constexpr uint32 MaxNumberOfFramesInFlight = 4u;
+
+		static void Initialize(size_t blockSizeInBytes, uint32 numberOfFramesInFlight);
+		static void Deinitialize();
+		static FrameArena& GetInstance() { return *m_pInstance; }
+		static bool IsInitialized() { return m_pInstance != nullptr; }
+
+		// Called by every thread that uses the arena at the start of its frame, moves the thread to its next block.
+		void BeginFrame();
+
+		// If the block is full the memory is allocated from the heap and freed when the block is reset.
+		void* Allocate(size_t sizeInBytes, size_t alignment);
+
+		template<typename T>
+		T* Allocate(size_t numberOfItems) { return static_cast<T*>(Allocate(sizeof(T) * numberOfItems, alignof(T))); }
+
+		struct Marker
+		{
+			uint32 m_subArenaIndex;
+			uint32 m_blockIndex;
+			size_t m_offset;
+		};
+		// Everything allocated by this thread after the marker is freed by FreeToMarker, must be used during the same frame.
+		Marker GetMarker();
+		void FreeToMarker(const Marker& marker);
+
+		class ScopedMarker
+		{
+		public:
+			ScopedMarker() : m_marker(FrameArena::GetInstance().GetMarker()) {}
+			~ScopedMarker() { FrameArena::GetInstance().FreeToMarker(m_marker); }
+		private:
+			Marker m_marker;
+		};
+
+		struct Stats
+		{
+			uint64 m_threadID;
+			size_t m_blockSize;
+			size_t m_usedLastFrame;
+			size_t m_highWaterMark;
+			size_t m_overflowLastFrame;
+			uint32 m_numberOfFramesInFlight;
+		};
+		// Fills the stats of all sub-arenas that are in use, can be called from any thread.
+		void GetStats(GrowingArray<Stats>& statsOut) const;
+
+	private:
+		struct SubArena
+		{
+			uint8* m_pBlocks[MaxNumberOfFramesInFlight];
+			GrowingArray<void*> m_overflowAllocations[MaxNumberOfFramesInFlight];
+			uint32 m_currentBlock;
+			size_t m_offset;
+			size_t m_peakThisFrame;
+			size_t m_overflowThisFrame;
+
+			std::atomic_uint64_t m_threadID;
+			std::atomic_bool m_bInUse;
+			std::atomic_size_t m_usedLastFrame;
+			std::atomic_size_t m_highWaterMark;
+			std::atomic_size_t m_overflowLastFrame;
+		};
+
+		static FrameArena* m_pInstance;
+
+		// Returns the sub-arena of the calling thread, claims a free one the first time a thread uses the arena.
+		SubArena& GetThreadSubArena();
+		void ResetBlock(SubArena& subArena, uint32 blockIndex);
+
+		friend struct ThreadSubArenaHandle;
+		void ReleaseSubArena(uint32 subArenaIndex);
+
+		size_t m_blockSize = 0;
+		uint32 m_numberOfFramesInFlight = 0;
+		SubArena m_subArenas[MaxNumberOfThreads];
+	};
+
+	// Allocator for the containers that takes the memory from the frame arena of the calling thread.
+	// Deallocation does nothing, so a container using it must not outlive the frame it allocated in.
+	struct FrameArenaAllocator
+	{
+		static void* Allocate(size_t sizeInBytes, size_t alignment) { return FrameArena::GetInstance().Allocate(sizeInBytes, alignment); }
+		static void Deallocate(void* pMemory, size_t sizeInBytes, size_t alignment) {}
+	};
+
+	template<typename T>
+	using FrameArray = GrowingArray<T, size_t, FrameArenaAllocator>;
+}
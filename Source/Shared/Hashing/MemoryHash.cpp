@@ -0,0 +1,22 @@
+#include "Shared_PCH.h"
+#include "MemoryHash.h"
+#include "Hashing\xxh64_en.hpp"
+
+using namespace Hail;
+
+namespace
+{
+	constexpr uint64 locHashChunkSize = 4096u;
+}
+
+uint64 Hail::HashMemory(const void* pData, uint64 sizeInBytes)
+{
+	const char* pBytes = (const char*)pData;
+	uint64 hash = 0;
+	for (uint64 offset = 0; offset < sizeInBytes; offset += locHashChunkSize)
+	{
+		const uint64 chunkSize = (sizeInBytes - offset) < locHashChunkSize ? (sizeInBytes - offset) : locHashChunkSize;
+		hash = xxh64::hash(pBytes + offset, chunkSize, hash);
+	}
+	return hash;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include "Types.h"
+
+namespace Hail
+{
+	// xxh64 of a buffer of any size, used to tell if a source file changed since a cached asset was made from it.
+	// The constexpr xxh64 is recursive, so the buffer is hashed in chunks with every chunk seeded by the hash of the previous one.
+	uint64 HashMemory(const void* pData, uint64 sizeInBytes);
+}
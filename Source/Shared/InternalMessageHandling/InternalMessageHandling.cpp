@@ -33,14 +33,7 @@ void Hail::AssertMessage(const char* expr_str, bool expression, const char* file
 
 void Hail::CreateMessage(const char* message, const char* fileName, int line, eMessageType type)
 {
-	InternalMessage errorMessage;
-	errorMessage.m_type = type;
-	errorMessage.m_fileName = fileName;
-	errorMessage.m_message = message;
-	errorMessage.m_systemTimeLastHappened = GetGlobalTimer()->GetSystemTime();
-	errorMessage.m_numberOfOccurences = 1;
-	errorMessage.m_codeLine = line;
-	InternalMessageLogger::GetInstance().InsertMessage(errorMessage);
+	InternalMessageLogger::GetInstance().InsertMessage(message, fileName, (uint16)line, type, GetGlobalTimer()->GetSystemTime());
 	//TODO: Make a global setting or something for if console should be enabled or not.
 	Debug_PrintConsoleConstChar(message);
 }
\ No newline at end of file
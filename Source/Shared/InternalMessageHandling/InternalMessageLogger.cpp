@@ -2,10 +2,33 @@
 #include "InternalMessageLogger.h"
 #include "InternalMessageHandling.h"
 #include "Hashing\xxh64_en.hpp"
+#include "MathUtils.h"
+#include "PerformanceCounters.h"
 using namespace Hail;
 
 InternalMessageLogger* InternalMessageLogger::m_pInstance = nullptr;
 
+namespace Hail
+{
+	constexpr uint32 locInvalidProducerRing = MAX_UINT;
+	constexpr uint32 locMinMessageLookupSize = 64u;
+	constexpr uint32 locRecordAlignment = 8u;
+
+	// Releases the ring of a thread when the thread exits so a restarted thread does not use up a new ring.
+	struct ThreadProducerRingHandle
+	{
+		~ThreadProducerRingHandle()
+		{
+			if (m_ringIndex != locInvalidProducerRing && InternalMessageLogger::IsInitialized())
+				InternalMessageLogger::GetInstance().ReleaseProducerRing(m_ringIndex);
+		}
+
+		uint32 m_ringIndex = locInvalidProducerRing;
+	};
+
+	thread_local ThreadProducerRingHandle tl_producerRingHandle;
+}
+
 void Hail::InternalMessageLogger::Initialize()
 {
 	H_ASSERT(GetIsMainThread(), "Only main thread should create the logger.");
@@ -19,72 +42,104 @@ void Hail::InternalMessageLogger::Deinitialize()
 	SAFEDELETE(m_pInstance);
 }
 
-void Hail::InternalMessageLogger::InsertMessage(InternalMessage message)
+Hail::InternalMessageLogger::InternalMessageLogger()
+	: m_bHasUpdatedMessageList(false)
 {
-	m_signal.Signal();
-	GrowingArray<InternalMessage>& m_insertMessageList = m_incomingMessages[m_currentIncomingMessageBuffer];
-	message.m_stringHash = xxh64::hash(message.m_message.Data(), message.m_message.Length(), message.m_message.Length());
-	bool bMessageExists = false;
-	for (uint32 i = 0; i < m_insertMessageList.Size(); i++)
+	for (uint32 i = 0; i < MaxNumberOfProducers; i++)
 	{
-		if (m_insertMessageList[i].m_stringHash == message.m_stringHash)
-		{
-			m_insertMessageList[i].m_numberOfOccurences++;
-			m_insertMessageList[i].m_systemTimeLastHappened = message.m_systemTimeLastHappened;
-			bMessageExists = true;
-		}
+		ProducerRing& ring = m_producerRings[i];
+		ring.m_pBuffer = nullptr;
+		ring.m_writePosition.store(0u);
+		ring.m_readPosition.store(0u);
+		ring.m_numberOfDroppedMessages.store(0u);
+		ring.m_bInUse.store(false);
 	}
-	if (bMessageExists)
+	RebuildLookup(m_messagesLookup, m_messages, 0u, locMinMessageLookupSize);
+	RebuildLookup(m_updateMessagesLookup, m_allMessages, 0u, locMinMessageLookupSize);
+}
+
+Hail::InternalMessageLogger::~InternalMessageLogger()
+{
+	for (uint32 i = 0; i < MaxNumberOfProducers; i++)
+		SAFEDELETE_ARRAY(m_producerRings[i].m_pBuffer);
+}
+
+void Hail::InternalMessageLogger::InsertMessage(const char* message, const char* fileName, uint16 codeLine, eMessageType type, uint64 systemTime)
+{
+	ProducerRing* pRing = GetThreadProducerRing();
+	if (!pRing)
+	{
+		m_numberOfDroppedMessagesWithoutRing.fetch_add(1u, std::memory_order_relaxed);
+		return;
+	}
+
+	MessageRecord record;
+	record.m_systemTime = systemTime;
+	record.m_codeLine = codeLine;
+	record.m_type = type;
+	record.m_messageLength = (uint16)Math::Min((uint32)strlen(message), MaxMessageLength);
+	record.m_fileNameLength = (uint16)Math::Min((uint32)strlen(fileName), MaxMessageLength);
+	record.m_stringHash = xxh64::hash(message, record.m_messageLength, record.m_messageLength);
+	// The strings are stored null terminated so the consumer can use them directly.
+	const uint32 unalignedSize = sizeof(MessageRecord) + record.m_messageLength + 1u + record.m_fileNameLength + 1u;
+	record.m_recordSize = (unalignedSize + locRecordAlignment - 1u) & ~(locRecordAlignment - 1u);
+
+	uint64 writePosition = pRing->m_writePosition.load(std::memory_order_relaxed);
+	const uint64 readPosition = pRing->m_readPosition.load(std::memory_order_acquire);
+	uint32 offset = (uint32)(writePosition % ProducerRingSizeInBytes);
+	const uint32 bytesUntilEnd = ProducerRingSizeInBytes - offset;
+	// A record never wraps, if it does not fit before the end of the ring the rest of the ring is skipped.
+	const uint32 bytesNeeded = record.m_recordSize > bytesUntilEnd ? record.m_recordSize + bytesUntilEnd : record.m_recordSize;
+	if (writePosition - readPosition + bytesNeeded > ProducerRingSizeInBytes)
 	{
-		m_signal.Wait();
+		pRing->m_numberOfDroppedMessages.fetch_add(1u, std::memory_order_relaxed);
 		return;
 	}
 
-	m_insertMessageList.Add(message);
-	m_signal.Wait();
+	if (record.m_recordSize > bytesUntilEnd)
+	{
+		// The consumer skips the end of the ring by itself if there is no room for a padding record.
+		if (bytesUntilEnd >= sizeof(MessageRecord))
+		{
+			MessageRecord paddingRecord{};
+			paddingRecord.m_recordSize = bytesUntilEnd;
+			paddingRecord.m_type = eMessageType::Count;
+			memcpy(pRing->m_pBuffer + offset, &paddingRecord, sizeof(MessageRecord));
+		}
+		writePosition += bytesUntilEnd;
+		offset = 0u;
+	}
+
+	uint8* pRecord = pRing->m_pBuffer + offset;
+	memcpy(pRecord, &record, sizeof(MessageRecord));
+	char* pStrings = (char*)(pRecord + sizeof(MessageRecord));
+	memcpy(pStrings, message, record.m_messageLength);
+	pStrings[record.m_messageLength] = '\0';
+	memcpy(pStrings + record.m_messageLength + 1u, fileName, record.m_fileNameLength);
+	pStrings[record.m_messageLength + 1u + record.m_fileNameLength] = '\0';
+
+	pRing->m_writePosition.store(writePosition + record.m_recordSize, std::memory_order_release);
 }
 
 void Hail::InternalMessageLogger::Update()
 {
 	H_ASSERT(GetIsMainThread(), "Only main thread should update the logger.");
 	AssertLock::Guard assertLock = m_assertLock.AssertLockFunction();
-	m_bHasUpdatedMessageList = false;
 
-	// Fetch and swap the read buffer index.
-	m_signal.Signal();
-	uint32 readBufferIndex = m_currentIncomingMessageBuffer;
-	m_currentIncomingMessageBuffer = (m_currentIncomingMessageBuffer + 1) % 2;
-	m_signal.Wait();
+	const uint32 numberOfMessagesBeforeUpdate = m_allMessages.Size();
+	m_updateMessagesOffset = numberOfMessagesBeforeUpdate;
+	RebuildLookup(m_updateMessagesLookup, m_allMessages, m_updateMessagesOffset, locMinMessageLookupSize);
 
-	const GrowingArray<InternalMessage>& m_readMessageList = m_incomingMessages[readBufferIndex];
-
-	m_bHasUpdatedMessageList = m_readMessageList.Size() > 0;
-	GrowingArray<const InternalMessage*> messagesToAdd;
-	for (uint32 i = 0; i < m_readMessageList.Size(); i++)
+	// Rings released by a thread can still have messages in them, so every ring that has been written to is read.
+	// The buffer of a ring is only read after seeing a write position that was published after the buffer was created.
+	for (uint32 i = 0; i < MaxNumberOfProducers; i++)
 	{
-		bool bMessageExists = false;
-		const InternalMessage& readMessage = m_readMessageList[i];
-
-		m_allMessages.Add(readMessage);
-
-		for (uint32 iExistingMessages = 0; iExistingMessages < m_messages.Size(); iExistingMessages++)
-		{
-			InternalMessage& existingMessage = m_messages[iExistingMessages];
-			if (readMessage.m_stringHash == existingMessage.m_stringHash)
-			{
-				existingMessage.m_numberOfOccurences += readMessage.m_numberOfOccurences;
-				existingMessage.m_systemTimeLastHappened = readMessage.m_systemTimeLastHappened;
-				bMessageExists = true;
-				break;
-			}
-		}
-		if (!bMessageExists)
-			messagesToAdd.Add(&readMessage);
+		ProducerRing& ring = m_producerRings[i];
+		if (ring.m_writePosition.load(std::memory_order_acquire) != ring.m_readPosition.load(std::memory_order_relaxed))
+			ReadProducerRing(ring);
 	}
-	for (uint32 i = 0; i < messagesToAdd.Size(); i++)
-		m_messages.Add(*messagesToAdd[i]);
 
-	m_incomingMessages[readBufferIndex].RemoveAll();
+	m_bHasUpdatedMessageList = m_allMessages.Size() != numberOfMessagesBeforeUpdate;
 }
 
 const GrowingArray<InternalMessage>& Hail::InternalMessageLogger::GetUniqueueMessages() const
@@ -101,5 +156,149 @@ void Hail::InternalMessageLogger::ClearMessages()
 {
 	H_ASSERT(GetIsMainThread(), "Only main thread should clear the logger.");
 	m_messages.RemoveAll();
-	m_incomingMessages[(m_currentIncomingMessageBuffer + 1) % 2].RemoveAll();
+	RebuildLookup(m_messagesLookup, m_messages, 0u, locMinMessageLookupSize);
+}
+
+uint32 Hail::InternalMessageLogger::GetNumberOfDroppedMessages() const
+{
+	uint32 numberOfDroppedMessages = m_numberOfDroppedMessagesWithoutRing.load(std::memory_order_relaxed);
+	for (uint32 i = 0; i < MaxNumberOfProducers; i++)
+		numberOfDroppedMessages += m_producerRings[i].m_numberOfDroppedMessages.load(std::memory_order_relaxed);
+	return numberOfDroppedMessages;
+}
+
+InternalMessageLogger::ProducerRing* Hail::InternalMessageLogger::GetThreadProducerRing()
+{
+	if (tl_producerRingHandle.m_ringIndex != locInvalidProducerRing)
+		return &m_producerRings[tl_producerRingHandle.m_ringIndex];
+
+	for (uint32 iRing = 0; iRing < MaxNumberOfProducers; iRing++)
+	{
+		ProducerRing& ring = m_producerRings[iRing];
+		bool bExpectedInUse = false;
+		if (!ring.m_bInUse.compare_exchange_strong(bExpectedInUse, true, std::memory_order_acq_rel))
+			continue;
+
+		// The buffer of a released ring is kept and reused by the next thread.
+		if (!ring.m_pBuffer)
+			ring.m_pBuffer = new uint8[ProducerRingSizeInBytes];
+		tl_producerRingHandle.m_ringIndex = iRing;
+		return &ring;
+	}
+	return nullptr;
+}
+
+void Hail::InternalMessageLogger::ReleaseProducerRing(uint32 ringIndex)
+{
+	m_producerRings[ringIndex].m_bInUse.store(false, std::memory_order_release);
+}
+
+void Hail::InternalMessageLogger::ReadProducerRing(ProducerRing& ring)
+{
+	uint64 readPosition = ring.m_readPosition.load(std::memory_order_relaxed);
+	const uint64 writePosition = ring.m_writePosition.load(std::memory_order_acquire);
+	while (readPosition < writePosition)
+	{
+		const uint32 offset = (uint32)(readPosition % ProducerRingSizeInBytes);
+		const uint32 bytesUntilEnd = ProducerRingSizeInBytes - offset;
+		if (bytesUntilEnd < sizeof(MessageRecord))
+		{
+			readPosition += bytesUntilEnd;
+			continue;
+		}
+
+		MessageRecord record;
+		memcpy(&record, ring.m_pBuffer + offset, sizeof(MessageRecord));
+		if (record.m_type != eMessageType::Count)
+		{
+			const char* pMessage = (const char*)(ring.m_pBuffer + offset + sizeof(MessageRecord));
+			AddMessage(record, pMessage, pMessage + record.m_messageLength + 1u);
+		}
+		readPosition += record.m_recordSize;
+	}
+	ring.m_readPosition.store(readPosition, std::memory_order_release);
+}
+
+void Hail::InternalMessageLogger::AddMessage(const MessageRecord& record, const char* pMessage, const char* pFileName)
+{
+	H_COUNTER_ADD("Logger messages", 1);
+	const uint32 updateIndex = FindMessage(m_allMessages, m_updateMessagesLookup, m_updateMessagesOffset, record.m_stringHash);
+	if (updateIndex != MAX_UINT)
+	{
+		m_allMessages[updateIndex].m_numberOfOccurences++;
+		m_allMessages[updateIndex].m_systemTimeLastHappened = record.m_systemTime;
+	}
+	else
+	{
+		InternalMessage& message = m_allMessages.Add();
+		message.m_systemTimeLastHappened = record.m_systemTime;
+		message.m_numberOfOccurences = 1u;
+		message.m_codeLine = record.m_codeLine;
+		message.m_type = record.m_type;
+		message.m_message = pMessage;
+		message.m_fileName = pFileName;
+		message.m_stringHash = record.m_stringHash;
+		InsertInLookup(m_updateMessagesLookup, m_allMessages, m_updateMessagesOffset, m_allMessages.Size() - 1u);
+	}
+
+	const uint32 uniqueIndex = FindMessage(m_messages, m_messagesLookup, 0u, record.m_stringHash);
+	if (uniqueIndex != MAX_UINT)
+	{
+		m_messages[uniqueIndex].m_numberOfOccurences++;
+		m_messages[uniqueIndex].m_systemTimeLastHappened = record.m_systemTime;
+	}
+	else
+	{
+		m_messages.Add(m_allMessages[updateIndex != MAX_UINT ? updateIndex : m_allMessages.Size() - 1u]);
+		m_messages.GetLast().m_numberOfOccurences = 1u;
+		InsertInLookup(m_messagesLookup, m_messages, 0u, m_messages.Size() - 1u);
+	}
+}
+
+uint32 Hail::InternalMessageLogger::FindMessage(const GrowingArray<InternalMessage>& list, const GrowingArray<uint32>& lookup, uint32 listOffset, uint64 hash)
+{
+	const uint32 lookupMask = lookup.Size() - 1u;
+	uint32 slot = (uint32)hash & lookupMask;
+	while (lookup[slot] != 0u)
+	{
+		const uint32 index = listOffset + lookup[slot] - 1u;
+		if (list[index].m_stringHash == hash)
+			return index;
+		slot = (slot + 1u) & lookupMask;
+	}
+	return MAX_UINT;
+}
+
+void Hail::InternalMessageLogger::InsertInLookup(GrowingArray<uint32>& lookup, const GrowingArray<InternalMessage>& list, uint32 listOffset, uint32 indexInList)
+{
+	// Keep the lookup at most half full so the probing stays short.
+	if ((list.Size() - listOffset) * 2u > lookup.Size())
+	{
+		RebuildLookup(lookup, list, listOffset, lookup.Size() * 2u);
+		return;
+	}
+
+	const uint32 lookupMask = lookup.Size() - 1u;
+	uint32 slot = (uint32)list[indexInList].m_stringHash & lookupMask;
+	while (lookup[slot] != 0u)
+		slot = (slot + 1u) & lookupMask;
+	lookup[slot] = indexInList - listOffset + 1u;
+}
+
+void Hail::InternalMessageLogger::RebuildLookup(GrowingArray<uint32>& lookup, const GrowingArray<InternalMessage>& list, uint32 listOffset, uint32 lookupSize)
+{
+	H_ASSERT((lookupSize & (lookupSize - 1u)) == 0u, "Lookup size must be a power of two");
+	lookup.RemoveAll();
+	lookup.PrepareAndFill(lookupSize);
+	for (uint32 i = 0; i < lookupSize; i++)
+		lookup[i] = 0u;
+
+	const uint32 lookupMask = lookupSize - 1u;
+	for (uint32 i = listOffset; i < list.Size(); i++)
+	{
+		uint32 slot = (uint32)list[i].m_stringHash & lookupMask;
+		while (lookup[slot] != 0u)
+			slot = (slot + 1u) & lookupMask;
+		lookup[slot] = i - listOffset + 1u;
+	}
 }
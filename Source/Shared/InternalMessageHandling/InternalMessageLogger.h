@@ -2,7 +2,6 @@
 #include "InternalMessageHandling.h"
 #include "Threading.h"
 #include "Containers\GrowingArray\GrowingArray.h"
-#include "Containers\StaticArray\StaticArray.h"
 
 namespace Hail
 {
@@ -20,35 +19,83 @@ namespace Hail
 	class InternalMessageLogger
 	{
 	public:
+		static constexpr uint32 MaxNumberOfProducers = 16u;
+		static constexpr uint32 ProducerRingSizeInBytes = 64u * 1024u;
+		// Longer messages are cut when they are inserted.
+		static constexpr uint32 MaxMessageLength = 1024u;
+
 		// Operations that should only happen on the main thread, will assert if not followed.
 		static void Initialize();
 		static void Deinitialize();
 		static InternalMessageLogger& GetInstance() { return *m_pInstance; }
+		static bool IsInitialized() { return m_pInstance != nullptr; }
 
-		// Flips the doublebuffers
+		// Reads the messages from all producers and merges duplicates.
 		void Update();
 		const GrowingArray<InternalMessage>& GetUniqueueMessages() const;
 		const GrowingArray<InternalMessage>& GetAllMessages() const;
 		void ClearMessages();
 
-		// Thread safe operation.
-		void InsertMessage(InternalMessage message);
+		// Thread safe and wait free, every thread writes to its own ring. If the ring is full the message is dropped.
+		void InsertMessage(const char* message, const char* fileName, uint16 codeLine, eMessageType type, uint64 systemTime);
 
 		bool HasRecievedNewMessages() const { return m_bHasUpdatedMessageList; }
+		// Number of messages dropped because a ring was full or there were too many threads logging.
+		uint32 GetNumberOfDroppedMessages() const;
 
 	private:
+		// Header of a message in a ring, followed by the message and the file name. Records are 8 byte aligned.
+		struct MessageRecord
+		{
+			uint64 m_systemTime;
+			uint64 m_stringHash;
+			uint32 m_recordSize;
+			uint16 m_codeLine;
+			uint16 m_messageLength;
+			uint16 m_fileNameLength;
+			// eMessageType::Count marks padding at the end of the ring.
+			eMessageType m_type;
+		};
+
+		// Single producer single consumer ring of message records.
+		struct ProducerRing
+		{
+			uint8* m_pBuffer;
+			std::atomic_uint64_t m_writePosition;
+			std::atomic_uint64_t m_readPosition;
+			std::atomic_uint32_t m_numberOfDroppedMessages;
+			std::atomic_bool m_bInUse;
+		};
 
 		static InternalMessageLogger* m_pInstance;
 
-		//Double buffering insertions of messages to make it threadsafe
-		uint32 m_currentIncomingMessageBuffer{};
-		StaticArray<GrowingArray<InternalMessage>, 2> m_incomingMessages;
+		InternalMessageLogger();
+		~InternalMessageLogger();
+
+		// Returns nullptr if all rings are claimed by other threads.
+		ProducerRing* GetThreadProducerRing();
+		friend struct ThreadProducerRingHandle;
+		void ReleaseProducerRing(uint32 ringIndex);
+
+		void ReadProducerRing(ProducerRing& ring);
+		void AddMessage(const MessageRecord& record, const char* pMessage, const char* pFileName);
+		// Returns the index of the message with the hash in the list, or MAX_UINT if it is not in the list.
+		static uint32 FindMessage(const GrowingArray<InternalMessage>& list, const GrowingArray<uint32>& lookup, uint32 listOffset, uint64 hash);
+		static void InsertInLookup(GrowingArray<uint32>& lookup, const GrowingArray<InternalMessage>& list, uint32 listOffset, uint32 indexInList);
+		static void RebuildLookup(GrowingArray<uint32>& lookup, const GrowingArray<InternalMessage>& list, uint32 listOffset, uint32 lookupSize);
+
+		ProducerRing m_producerRings[MaxNumberOfProducers];
+		std::atomic_uint32_t m_numberOfDroppedMessagesWithoutRing{ 0u };
+
 		GrowingArray<InternalMessage> m_messages;
 		GrowingArray<InternalMessage> m_allMessages;
+		// Open addressed tables of message index + 1, 0 is an empty slot. Size is a power of two.
+		GrowingArray<uint32> m_messagesLookup;
+		// Lookup for the messages added to m_allMessages in the current update, so each update has one entry per message.
+		GrowingArray<uint32> m_updateMessagesLookup;
+		uint32 m_updateMessagesOffset = 0u;
 
-		BinarySemaphore m_signal;
 		AssertLock m_assertLock;
 		bool m_bHasUpdatedMessageList;
 	};
 }
- 
\ No newline at end of file
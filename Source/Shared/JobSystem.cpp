@@ -0,0 +1,113 @@
+#include "Shared_PCH.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+
+using namespace Hail;
+
+void Hail::JobSystem::Init(uint32 numberOfWorkers)
+{
+	H_ASSERT(m_workers.Empty(), "Job system is already initialized.");
+	if (numberOfWorkers == 0u)
+	{
+		const uint32 numberOfHardwareThreads = std::thread::hardware_concurrency();
+		numberOfWorkers = numberOfHardwareThreads > 1u ? numberOfHardwareThreads - 1u : 1u;
+	}
+
+	m_bStop.store(false);
+	m_workers.Prepare(numberOfWorkers);
+	for (uint32 i = 0; i < numberOfWorkers; i++)
+		m_workers.Add(new std::thread(&JobSystem::WorkerLoop, this));
+}
+
+void Hail::JobSystem::Cleanup()
+{
+	m_bStop.store(true);
+	m_loopGeneration.fetch_add(1u);
+	WakeAllWaitingOnAddress(m_loopGeneration);
+	for (uint32 i = 0; i < m_workers.Size(); i++)
+	{
+		m_workers[i]->join();
+		SAFEDELETE(m_workers[i]);
+	}
+	m_workers.RemoveAll();
+	m_loopGeneration.store(0u);
+}
+
+void Hail::JobSystem::ParallelFor(uint32 numberOfJobs, ParallelJobFunction pFunction, void* pUserData)
+{
+	if (numberOfJobs == 0u)
+		return;
+
+	if (m_workers.Empty() || numberOfJobs == 1u)
+	{
+		for (uint32 i = 0; i < numberOfJobs; i++)
+			pFunction(pUserData, i);
+		return;
+	}
+
+	ScopedLock<Mutex> lock(m_parallelForLock);
+	m_pFunction = pFunction;
+	m_pUserData = pUserData;
+	m_numberOfJobs = numberOfJobs;
+	m_nextJobIndex.store(0u, std::memory_order_relaxed);
+	m_numberOfFinishedJobs.store(0u, std::memory_order_relaxed);
+	m_loopGeneration.fetch_add(1u);
+	WakeAllWaitingOnAddress(m_loopGeneration);
+
+	RunJobs();
+
+	uint32 numberOfFinishedJobs = m_numberOfFinishedJobs.load(std::memory_order_acquire);
+	while (numberOfFinishedJobs != numberOfJobs)
+	{
+		WaitForAddressChange(m_numberOfFinishedJobs, numberOfFinishedJobs);
+		numberOfFinishedJobs = m_numberOfFinishedJobs.load(std::memory_order_acquire);
+	}
+
+	// Ends the loop, a worker that wakes up after this sees an even generation and does not read the loop parameters.
+	// Workers that already look at the loop are waited on before the parameters can be changed by the next loop.
+	m_loopGeneration.fetch_add(1u);
+	while (m_numberOfBusyWorkers.load() != 0u)
+		SpinPause();
+}
+
+void Hail::JobSystem::WorkerLoop()
+{
+	if (Profiler::IsInitialized())
+		Profiler::GetInstance().SetThreadName("Job worker");
+	uint32 seenGeneration = 0u;
+	while (true)
+	{
+		uint32 generation = m_loopGeneration.load();
+		while (generation == seenGeneration)
+		{
+			WaitForAddressChange(m_loopGeneration, seenGeneration);
+			generation = m_loopGeneration.load();
+		}
+		seenGeneration = generation;
+
+		if (m_bStop.load())
+			return;
+		if ((generation & 1u) == 0u)
+			continue;
+
+		m_numberOfBusyWorkers.fetch_add(1u);
+		if (m_loopGeneration.load() == generation)
+			RunJobs();
+		m_numberOfBusyWorkers.fetch_sub(1u);
+	}
+}
+
+void Hail::JobSystem::RunJobs()
+{
+	H_PROFILE_FUNCTION();
+	while (true)
+	{
+		const uint32 jobIndex = m_nextJobIndex.fetch_add(1u, std::memory_order_relaxed);
+		if (jobIndex >= m_numberOfJobs)
+			return;
+
+		m_pFunction(m_pUserData, jobIndex);
+		if (m_numberOfFinishedJobs.fetch_add(1u, std::memory_order_acq_rel) + 1u == m_numberOfJobs)
+			WakeAllWaitingOnAddress(m_numberOfFinishedJobs);
+	}
+}
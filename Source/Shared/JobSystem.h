@@ -0,0 +1,41 @@
+#pragma once
+#include <thread>
+#include "Threading.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	using ParallelJobFunction = void(*)(void* pUserData, uint32 jobIndex);
+
+	// Fixed pool of worker threads that runs parallel loops. One loop runs at a time, the thread calling ParallelFor
+	// works on the loop together with the workers and returns when every job of the loop is done.
+	class JobSystem
+	{
+	public:
+		// 0 workers uses one worker per hardware thread except the calling thread.
+		void Init(uint32 numberOfWorkers);
+		void Cleanup();
+
+		// Calls the function once for every job index. Jobs must not call ParallelFor themselves.
+		void ParallelFor(uint32 numberOfJobs, ParallelJobFunction pFunction, void* pUserData);
+		uint32 GetNumberOfWorkers() const { return m_workers.Size(); }
+
+	private:
+		void WorkerLoop();
+		void RunJobs();
+
+		GrowingArray<std::thread*> m_workers;
+		Mutex m_parallelForLock;
+		// Odd while a loop is running, workers park on it between loops.
+		std::atomic_uint32_t m_loopGeneration{ 0u };
+		// Workers that are looking at the current loop, the loop parameters are not changed until it is 0.
+		std::atomic_uint32_t m_numberOfBusyWorkers{ 0u };
+		std::atomic_uint32_t m_nextJobIndex{ 0u };
+		std::atomic_uint32_t m_numberOfFinishedJobs{ 0u };
+		std::atomic_bool m_bStop{ false };
+
+		ParallelJobFunction m_pFunction = nullptr;
+		void* m_pUserData = nullptr;
+		uint32 m_numberOfJobs = 0u;
+	};
+}
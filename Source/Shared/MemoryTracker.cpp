@@ -0,0 +1,454 @@
+#include "Shared_PCH.h"
+#include "MemoryTracker.h"
+#include "Threading.h"
+#include "MathUtils.h"
+
+#include <new>
+#include <stdio.h>
+
+#ifdef DEBUG
+#ifdef PLATFORM_WINDOWS
+#include <windows.h>
+#else
+#include <execinfo.h>
+#endif
+#endif
+
+using namespace Hail;
+
+MemoryTracker::TagCounters MemoryTracker::m_tagCounters[(uint32)eMemoryTag::Count];
+std::atomic_uint64_t MemoryTracker::m_numberOfSteadyStateViolations{ 0u };
+float MemoryTracker::m_allocationHistory[HistorySize];
+uint64 MemoryTracker::m_numberOfFrames = 0u;
+uint64 MemoryTracker::m_leakTrackingStart = 0u;
+
+namespace Hail
+{
+	const char* locMemoryTagNames[(uint32)eMemoryTag::Count] =
+	{
+		"General",
+		"Strings",
+		"Textures",
+		"Rendering",
+		"Resources",
+		"Scripting",
+		"Triangulation",
+		"Frame arena",
+		"Components",
+	};
+
+#ifdef DEBUG
+	struct LiveAllocationList;
+	// Frames of the call stack kept for allocations without a callsite, so their leaks can still be told apart.
+	constexpr uint32 locMaxNumberOfStackFrames = 8u;
+#endif
+
+	// Placed right before the memory handed out, the header is padded to the alignment so the memory keeps its alignment.
+	struct AllocationHeader
+	{
+#ifdef DEBUG
+		AllocationHeader* m_pNext;
+		AllocationHeader* m_pPrevious;
+		LiveAllocationList* m_pList;
+		uint64 m_sequenceNumber;
+		// Hash of the callsite, or of the call stack when the allocation has no callsite.
+		uint64 m_callsiteHash;
+		void* m_stackFrames[locMaxNumberOfStackFrames];
+		bool m_bLeakExempt;
+#endif
+		const MemoryCallsite* m_pCallsite;
+		uint64 m_sizeInBytes;
+		uint32 m_alignment;
+		eMemoryTag m_tag;
+	};
+
+#ifdef DEBUG
+	// The live allocations made by one thread, newest first. Each thread links in to its own list so threads do not serialize
+	// on one lock, the lock is only contended when memory is freed by another thread than the one that allocated it.
+	struct LiveAllocationList
+	{
+		Mutex m_lock;
+		AllocationHeader* m_pFirst = nullptr;
+		LiveAllocationList* m_pNextList = nullptr;
+	};
+	// Lists are never freed, memory of a thread can be freed by other threads after the thread has exited.
+	std::atomic<LiveAllocationList*> g_pFirstLiveAllocationList{ nullptr };
+	std::atomic_uint64_t g_allocationSequenceNumber{ 0u };
+	thread_local LiveAllocationList* tl_pLiveAllocationList = nullptr;
+
+	LiveAllocationList* GetLiveAllocationListOfThread()
+	{
+		if (tl_pLiveAllocationList)
+			return tl_pLiveAllocationList;
+
+		LiveAllocationList* pList = new LiveAllocationList();
+		LiveAllocationList* pFirstList = g_pFirstLiveAllocationList.load(std::memory_order_relaxed);
+		do
+		{
+			pList->m_pNextList = pFirstList;
+		} while (!g_pFirstLiveAllocationList.compare_exchange_weak(pFirstList, pList, std::memory_order_release, std::memory_order_relaxed));
+		tl_pLiveAllocationList = pList;
+		return pList;
+	}
+
+	void CaptureCallStack(AllocationHeader* pHeader)
+	{
+		for (uint32 i = 0; i < locMaxNumberOfStackFrames; i++)
+			pHeader->m_stackFrames[i] = nullptr;
+#ifdef PLATFORM_WINDOWS
+		// Skips this function and MemoryTracker::Allocate.
+		const uint32 numberOfFrames = CaptureStackBackTrace(2u, locMaxNumberOfStackFrames, pHeader->m_stackFrames, nullptr);
+#else
+		void* frames[locMaxNumberOfStackFrames + 2u];
+		const int numberOfCapturedFrames = backtrace(frames, locMaxNumberOfStackFrames + 2u);
+		const uint32 numberOfFrames = numberOfCapturedFrames > 2 ? (uint32)numberOfCapturedFrames - 2u : 0u;
+		for (uint32 i = 0; i < numberOfFrames; i++)
+			pHeader->m_stackFrames[i] = frames[i + 2u];
+#endif
+		pHeader->m_callsiteHash = xxh64::hash((const char*)pHeader->m_stackFrames, numberOfFrames * sizeof(void*), 0u);
+	}
+#endif
+
+	thread_local eMemoryTag tl_memoryTag = eMemoryTag::General;
+	thread_local const MemoryCallsite* tl_pMemoryCallsite = nullptr;
+	thread_local bool tl_bSteadyStateCheck = false;
+	thread_local bool tl_bLeakExempt = false;
+
+	size_t GetHeaderOffset(size_t alignment)
+	{
+		return (sizeof(AllocationHeader) + alignment - 1u) & ~(alignment - 1u);
+	}
+}
+
+const char* Hail::GetMemoryTagName(eMemoryTag tag)
+{
+	return tag < eMemoryTag::Count ? locMemoryTagNames[(uint32)tag] : "Invalid";
+}
+
+void Hail::MemoryTracker::Initialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should initialize the memory tracker.");
+	m_numberOfFrames = 0u;
+	for (uint32 iTag = 0; iTag < (uint32)eMemoryTag::Count; iTag++)
+	{
+		TagCounters& counters = m_tagCounters[iTag];
+		counters.m_totalAllocationsLastFrameEnd = counters.m_totalAllocations.load(std::memory_order_relaxed);
+		counters.m_allocationsLastFrame = 0u;
+		counters.m_maxAllocationsInAFrame = 0u;
+	}
+#ifdef DEBUG
+	m_leakTrackingStart = g_allocationSequenceNumber.load(std::memory_order_relaxed);
+#endif
+}
+
+void Hail::MemoryTracker::Deinitialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should deinitialize the memory tracker.");
+	SetSteadyStateCheck(false);
+	DumpLeaks();
+}
+
+void* Hail::MemoryTracker::Allocate(size_t sizeInBytes, size_t alignment, eMemoryTag tag, const MemoryCallsite* pCallsite)
+{
+	if (!pCallsite)
+		pCallsite = tl_pMemoryCallsite;
+	CheckSteadyState(tag, pCallsite);
+
+	alignment = Math::Max<size_t>(alignment, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+	const size_t headerOffset = GetHeaderOffset(alignment);
+	uint8* pRawMemory = nullptr;
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		pRawMemory = (uint8*)::operator new(headerOffset + sizeInBytes, std::align_val_t(alignment));
+	else
+		pRawMemory = (uint8*)::operator new(headerOffset + sizeInBytes);
+
+	uint8* pMemory = pRawMemory + headerOffset;
+	AllocationHeader* pHeader = (AllocationHeader*)pMemory - 1;
+	pHeader->m_pCallsite = pCallsite;
+	pHeader->m_sizeInBytes = sizeInBytes;
+	pHeader->m_alignment = (uint32)alignment;
+	pHeader->m_tag = tag;
+#ifdef DEBUG
+	pHeader->m_sequenceNumber = g_allocationSequenceNumber.fetch_add(1u, std::memory_order_relaxed) + 1u;
+	pHeader->m_bLeakExempt = tl_bLeakExempt;
+	if (pCallsite)
+		pHeader->m_callsiteHash = pCallsite->m_hash;
+	else
+		CaptureCallStack(pHeader);
+
+	LiveAllocationList* pList = GetLiveAllocationListOfThread();
+	pHeader->m_pList = pList;
+	{
+		ScopedLock<Mutex> lock(pList->m_lock);
+		pHeader->m_pPrevious = nullptr;
+		pHeader->m_pNext = pList->m_pFirst;
+		if (pList->m_pFirst)
+			pList->m_pFirst->m_pPrevious = pHeader;
+		pList->m_pFirst = pHeader;
+	}
+#endif
+
+	CountAllocation(tag, sizeInBytes);
+	return pMemory;
+}
+
+void Hail::MemoryTracker::Deallocate(void* pMemory)
+{
+	if (!pMemory)
+		return;
+
+	AllocationHeader* pHeader = (AllocationHeader*)pMemory - 1;
+	H_ASSERT(pHeader->m_tag < eMemoryTag::Count, "Deallocating memory that was not allocated by the memory tracker.");
+#ifdef DEBUG
+	{
+		LiveAllocationList* pList = pHeader->m_pList;
+		ScopedLock<Mutex> lock(pList->m_lock);
+		if (pHeader->m_pPrevious)
+			pHeader->m_pPrevious->m_pNext = pHeader->m_pNext;
+		else
+			pList->m_pFirst = pHeader->m_pNext;
+		if (pHeader->m_pNext)
+			pHeader->m_pNext->m_pPrevious = pHeader->m_pPrevious;
+	}
+#endif
+
+	TagCounters& counters = m_tagCounters[(uint32)pHeader->m_tag];
+	counters.m_liveBytes.fetch_sub(pHeader->m_sizeInBytes, std::memory_order_relaxed);
+	counters.m_liveAllocations.fetch_sub(1u, std::memory_order_relaxed);
+
+	const size_t alignment = pHeader->m_alignment;
+	uint8* pRawMemory = (uint8*)pMemory - GetHeaderOffset(alignment);
+	if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		::operator delete(pRawMemory, std::align_val_t(alignment));
+	else
+		::operator delete(pRawMemory);
+}
+
+void Hail::MemoryTracker::RecordSubAllocation(eMemoryTag tag)
+{
+	CheckSteadyState(tag, tl_pMemoryCallsite);
+	m_tagCounters[(uint32)tag].m_totalAllocations.fetch_add(1u, std::memory_order_relaxed);
+}
+
+eMemoryTag Hail::MemoryTracker::GetCurrentTag()
+{
+	return tl_memoryTag;
+}
+
+const MemoryCallsite* Hail::MemoryTracker::GetCurrentCallsite()
+{
+	return tl_pMemoryCallsite;
+}
+
+void Hail::MemoryTracker::SetSteadyStateCheck(bool bEnabled)
+{
+	tl_bSteadyStateCheck = bEnabled;
+}
+
+bool Hail::MemoryTracker::IsSteadyStateCheckEnabled()
+{
+	return tl_bSteadyStateCheck;
+}
+
+void Hail::MemoryTracker::EndFrame()
+{
+	H_ASSERT(GetIsMainThread(), "Frames are ended by the main thread.");
+	uint64 allocationsInFrame = 0u;
+	for (uint32 iTag = 0; iTag < (uint32)eMemoryTag::Count; iTag++)
+	{
+		TagCounters& counters = m_tagCounters[iTag];
+		const uint64 totalAllocations = counters.m_totalAllocations.load(std::memory_order_relaxed);
+		counters.m_allocationsLastFrame = totalAllocations - counters.m_totalAllocationsLastFrameEnd;
+		counters.m_totalAllocationsLastFrameEnd = totalAllocations;
+		counters.m_maxAllocationsInAFrame = Math::Max(counters.m_maxAllocationsInAFrame, counters.m_allocationsLastFrame);
+		allocationsInFrame += counters.m_allocationsLastFrame;
+	}
+	m_allocationHistory[m_numberOfFrames % HistorySize] = (float)allocationsInFrame;
+	m_numberOfFrames++;
+}
+
+MemoryTracker::TagStats Hail::MemoryTracker::GetTagStats(eMemoryTag tag)
+{
+	const TagCounters& counters = m_tagCounters[(uint32)tag];
+	TagStats stats;
+	stats.m_pName = GetMemoryTagName(tag);
+	stats.m_liveBytes = counters.m_liveBytes.load(std::memory_order_relaxed);
+	stats.m_peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+	stats.m_liveAllocations = counters.m_liveAllocations.load(std::memory_order_relaxed);
+	stats.m_totalAllocations = counters.m_totalAllocations.load(std::memory_order_relaxed);
+	stats.m_allocationsLastFrame = counters.m_allocationsLastFrame;
+	stats.m_maxAllocationsInAFrame = counters.m_maxAllocationsInAFrame;
+	return stats;
+}
+
+uint64 Hail::MemoryTracker::GetTotalLiveBytes()
+{
+	uint64 liveBytes = 0u;
+	for (uint32 iTag = 0; iTag < (uint32)eMemoryTag::Count; iTag++)
+		liveBytes += m_tagCounters[iTag].m_liveBytes.load(std::memory_order_relaxed);
+	return liveBytes;
+}
+
+uint64 Hail::MemoryTracker::GetAllocationsLastFrame()
+{
+	uint64 allocations = 0u;
+	for (uint32 iTag = 0; iTag < (uint32)eMemoryTag::Count; iTag++)
+		allocations += m_tagCounters[iTag].m_allocationsLastFrame;
+	return allocations;
+}
+
+uint32 Hail::MemoryTracker::GetAllocationHistory(float* pHistoryOut, uint32 maxNumberOfFrames)
+{
+	const uint32 numberOfFrames = (uint32)Math::Min<uint64>(Math::Min<uint64>(m_numberOfFrames, HistorySize), maxNumberOfFrames);
+	const uint64 firstFrame = m_numberOfFrames - numberOfFrames;
+	for (uint32 iFrame = 0; iFrame < numberOfFrames; iFrame++)
+		pHistoryOut[iFrame] = m_allocationHistory[(firstFrame + iFrame) % HistorySize];
+	return numberOfFrames;
+}
+
+uint64 Hail::MemoryTracker::DumpLeaks()
+{
+#ifdef DEBUG
+	struct LeakGroup
+	{
+		const MemoryCallsite* m_pCallsite;
+		uint64 m_callsiteHash;
+		void* m_stackFrames[locMaxNumberOfStackFrames];
+		eMemoryTag m_tag;
+		uint64 m_numberOfAllocations;
+		uint64 m_numberOfBytes;
+	};
+	// Fixed size so dumping does not allocate, leaks from further callsites are only part of the totals.
+	constexpr uint32 maxNumberOfGroups = 64u;
+	LeakGroup groups[maxNumberOfGroups];
+	uint32 numberOfGroups = 0u;
+	uint64 numberOfLeaks = 0u;
+	uint64 numberOfLeakedBytes = 0u;
+
+	for (LiveAllocationList* pList = g_pFirstLiveAllocationList.load(std::memory_order_acquire); pList; pList = pList->m_pNextList)
+	{
+		ScopedLock<Mutex> lock(pList->m_lock);
+		for (const AllocationHeader* pHeader = pList->m_pFirst; pHeader; pHeader = pHeader->m_pNext)
+		{
+			if (pHeader->m_sequenceNumber <= m_leakTrackingStart || pHeader->m_bLeakExempt)
+				continue;
+
+			numberOfLeaks++;
+			numberOfLeakedBytes += pHeader->m_sizeInBytes;
+			uint32 iGroup = 0;
+			for (; iGroup < numberOfGroups; iGroup++)
+			{
+				if (groups[iGroup].m_callsiteHash == pHeader->m_callsiteHash && groups[iGroup].m_tag == pHeader->m_tag)
+					break;
+			}
+			if (iGroup == numberOfGroups)
+			{
+				if (numberOfGroups == maxNumberOfGroups)
+					continue;
+				LeakGroup& group = groups[numberOfGroups++];
+				group.m_pCallsite = pHeader->m_pCallsite;
+				group.m_callsiteHash = pHeader->m_callsiteHash;
+				memcpy(group.m_stackFrames, pHeader->m_stackFrames, sizeof(group.m_stackFrames));
+				group.m_tag = pHeader->m_tag;
+				group.m_numberOfAllocations = 0u;
+				group.m_numberOfBytes = 0u;
+			}
+			groups[iGroup].m_numberOfAllocations++;
+			groups[iGroup].m_numberOfBytes += pHeader->m_sizeInBytes;
+		}
+	}
+
+	if (numberOfLeaks == 0u)
+		return 0u;
+
+	// Printed directly as the message logger is already shut down when the tracker is.
+	printf("Memory leaks: %llu allocations, %llu bytes\n", numberOfLeaks, numberOfLeakedBytes);
+	for (uint32 iGroup = 0; iGroup < numberOfGroups; iGroup++)
+	{
+		const LeakGroup& group = groups[iGroup];
+		if (group.m_pCallsite)
+		{
+			printf("  %s: %llu allocations, %llu bytes from %s(%u) [%016llx]\n", GetMemoryTagName(group.m_tag), group.m_numberOfAllocations,
+				group.m_numberOfBytes, group.m_pCallsite->m_pFile, group.m_pCallsite->m_line, group.m_callsiteHash);
+			continue;
+		}
+
+		// Without a callsite the call stack is printed, the addresses can be resolved in the debugger.
+		printf("  %s: %llu allocations, %llu bytes from call stack [%016llx]\n", GetMemoryTagName(group.m_tag), group.m_numberOfAllocations,
+			group.m_numberOfBytes, group.m_callsiteHash);
+		for (uint32 iFrame = 0; iFrame < locMaxNumberOfStackFrames && group.m_stackFrames[iFrame]; iFrame++)
+			printf("    %p\n", group.m_stackFrames[iFrame]);
+	}
+	return numberOfLeaks;
+#else
+	return 0u;
+#endif
+}
+
+void Hail::MemoryTracker::CountAllocation(eMemoryTag tag, uint64 sizeInBytes)
+{
+	TagCounters& counters = m_tagCounters[(uint32)tag];
+	const uint64 liveBytes = counters.m_liveBytes.fetch_add(sizeInBytes, std::memory_order_relaxed) + sizeInBytes;
+	counters.m_liveAllocations.fetch_add(1u, std::memory_order_relaxed);
+	counters.m_totalAllocations.fetch_add(1u, std::memory_order_relaxed);
+
+	uint64 peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+	while (liveBytes > peakBytes && !counters.m_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+	{
+	}
+}
+
+void Hail::MemoryTracker::CheckSteadyState([[maybe_unused]] eMemoryTag tag, [[maybe_unused]] const MemoryCallsite* pCallsite)
+{
+	if (!tl_bSteadyStateCheck)
+		return;
+
+	m_numberOfSteadyStateViolations.fetch_add(1u, std::memory_order_relaxed);
+#ifdef DEBUG
+	// The assert can allocate, so the check is off while it is reported.
+	tl_bSteadyStateCheck = false;
+	char message[256];
+	if (pCallsite)
+		snprintf(message, sizeof(message), "Allocation in steady state, tag %s from %s(%u).", GetMemoryTagName(tag), pCallsite->m_pFile, pCallsite->m_line);
+	else
+		snprintf(message, sizeof(message), "Allocation in steady state, tag %s.", GetMemoryTagName(tag));
+	H_ASSERT(false, message);
+	tl_bSteadyStateCheck = true;
+#endif
+}
+
+Hail::MemoryTagScope::MemoryTagScope(eMemoryTag tag, const MemoryCallsite* pCallsite)
+{
+	m_previousTag = tl_memoryTag;
+	m_pPreviousCallsite = tl_pMemoryCallsite;
+	tl_memoryTag = tag;
+	tl_pMemoryCallsite = pCallsite;
+}
+
+Hail::MemoryTagScope::~MemoryTagScope()
+{
+	tl_memoryTag = m_previousTag;
+	tl_pMemoryCallsite = m_pPreviousCallsite;
+}
+
+Hail::MemorySteadyStateExemptScope::MemorySteadyStateExemptScope()
+{
+	m_bWasEnabled = tl_bSteadyStateCheck;
+	tl_bSteadyStateCheck = false;
+}
+
+Hail::MemorySteadyStateExemptScope::~MemorySteadyStateExemptScope()
+{
+	tl_bSteadyStateCheck = m_bWasEnabled;
+}
+
+Hail::MemoryLeakExemptScope::MemoryLeakExemptScope()
+{
+	m_bWasExempt = tl_bLeakExempt;
+	tl_bLeakExempt = true;
+}
+
+Hail::MemoryLeakExemptScope::~MemoryLeakExemptScope()
+{
+	tl_bLeakExempt = m_bWasExempt;
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <atomic>
+#include "Types.h"
+#include "Hashing\xxh64_en.hpp"
+
+namespace Hail
+{
+	enum class eMemoryTag : uint8
+	{
+		General,
+		Strings,
+		Textures,
+		Rendering,
+		Resources,
+		Scripting,
+		Triangulation,
+		FrameArena,
+		Components,
+		Count
+	};
+	const char* GetMemoryTagName(eMemoryTag tag);
+
+	// Where an allocation was made, the hash is of the file and line so allocations from the same place can be grouped.
+	struct MemoryCallsite
+	{
+		const char* m_pFile;
+		uint32 m_line;
+		uint64 m_hash;
+	};
+
+	// Tagged allocation layer used by the container allocators and the loaders, every allocation is counted per tag.
+	// The counters are static so memory allocated before Initialize or freed after Deinitialize is still counted correctly.
+	// In DEBUG every live allocation is also linked in a list of the allocating thread so the allocations still live at shutdown
+	// can be dumped as leaks.
+	class MemoryTracker
+	{
+	public:
+		static constexpr uint32 HistorySize = 240u;
+
+		// Allocations made after Initialize and still live in Deinitialize are reported as leaks in DEBUG.
+		static void Initialize();
+		static void Deinitialize();
+
+		// Callsite can be nullptr, the callsite of the current tag scope is then used. Without a tag scope DEBUG builds use a hash
+		// of the call stack, so container allocations made outside a tag scope can still be told apart in the leak dump.
+		static void* Allocate(size_t sizeInBytes, size_t alignment, eMemoryTag tag, const MemoryCallsite* pCallsite);
+		static void Deallocate(void* pMemory);
+		// For allocators that hand out memory from a buffer they got from the tracker, the bytes are already counted by the buffer
+		// so only the allocation is counted for the per frame numbers and the steady state check.
+		static void RecordSubAllocation(eMemoryTag tag);
+
+		// Set by MemoryTagScope, allocations that do not pass a tag of their own use the tag of the calling thread.
+		static eMemoryTag GetCurrentTag();
+		static const MemoryCallsite* GetCurrentCallsite();
+
+		// Asserts on every allocation made by the calling thread while enabled, used to keep the game loop free from allocations
+		// once it has warmed up.
+		static void SetSteadyStateCheck(bool bEnabled);
+		static bool IsSteadyStateCheckEnabled();
+		static uint64 GetNumberOfSteadyStateViolations() { return m_numberOfSteadyStateViolations.load(std::memory_order_relaxed); }
+
+		// Called by the main thread when a frame ends.
+		static void EndFrame();
+
+		struct TagStats
+		{
+			const char* m_pName;
+			uint64 m_liveBytes;
+			uint64 m_peakBytes;
+			uint64 m_liveAllocations;
+			uint64 m_totalAllocations;
+			uint64 m_allocationsLastFrame;
+			uint64 m_maxAllocationsInAFrame;
+		};
+		static TagStats GetTagStats(eMemoryTag tag);
+		static uint64 GetTotalLiveBytes();
+		static uint64 GetAllocationsLastFrame();
+		// Total allocations of every frame in the history, oldest frame first.
+		static uint32 GetAllocationHistory(float* pHistoryOut, uint32 maxNumberOfFrames);
+
+		// Prints the allocations made after Initialize that are still live grouped by callsite, returns the number of leaked allocations.
+		// Only tracks allocations in DEBUG, returns 0 otherwise.
+		static uint64 DumpLeaks();
+
+	private:
+		struct TagCounters
+		{
+			std::atomic_uint64_t m_liveBytes;
+			std::atomic_uint64_t m_peakBytes;
+			std::atomic_uint64_t m_liveAllocations;
+			std::atomic_uint64_t m_totalAllocations;
+			// Only touched by the main thread in EndFrame.
+			uint64 m_totalAllocationsLastFrameEnd;
+			uint64 m_allocationsLastFrame;
+			uint64 m_maxAllocationsInAFrame;
+		};
+
+		static void CountAllocation(eMemoryTag tag, uint64 sizeInBytes);
+		static void CheckSteadyState(eMemoryTag tag, const MemoryCallsite* pCallsite);
+
+		static TagCounters m_tagCounters[(uint32)eMemoryTag::Count];
+		static std::atomic_uint64_t m_numberOfSteadyStateViolations;
+		static float m_allocationHistory[HistorySize];
+		static uint64 m_numberOfFrames;
+		static uint64 m_leakTrackingStart;
+	};
+
+	// Sets the tag of the allocations made by the calling thread until the scope ends.
+	class MemoryTagScope
+	{
+	public:
+		MemoryTagScope(eMemoryTag tag, const MemoryCallsite* pCallsite);
+		~MemoryTagScope();
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		eMemoryTag m_previousTag;
+		const MemoryCallsite* m_pPreviousCallsite;
+	};
+
+	// Lets the allocations in the scope through while the steady state check is enabled, for work that is known to allocate.
+	class MemorySteadyStateExemptScope
+	{
+	public:
+		MemorySteadyStateExemptScope();
+		~MemorySteadyStateExemptScope();
+		MemorySteadyStateExemptScope(const MemorySteadyStateExemptScope&) = delete;
+		MemorySteadyStateExemptScope& operator=(const MemorySteadyStateExemptScope&) = delete;
+
+	private:
+		bool m_bWasEnabled;
+	};
+
+	// Allocations made in the scope are not reported as leaks, for memory that is meant to live until the program exits.
+	class MemoryLeakExemptScope
+	{
+	public:
+		MemoryLeakExemptScope();
+		~MemoryLeakExemptScope();
+		MemoryLeakExemptScope(const MemoryLeakExemptScope&) = delete;
+		MemoryLeakExemptScope& operator=(const MemoryLeakExemptScope&) = delete;
+
+	private:
+		bool m_bWasExempt;
+	};
+
+	// Allocator for std containers that routes their memory through the tracker with a fixed tag.
+	template<typename T, eMemoryTag Tag>
+	struct TrackedStdAllocator
+	{
+		using value_type = T;
+		template<typename U>
+		struct rebind { using other = TrackedStdAllocator<U, Tag>; };
+
+		TrackedStdAllocator() = default;
+		template<typename U>
+		TrackedStdAllocator(const TrackedStdAllocator<U, Tag>&) {}
+
+		T* allocate(size_t numberOfElements) { return (T*)MemoryTracker::Allocate(numberOfElements * sizeof(T), alignof(T), Tag, nullptr); }
+		void deallocate(T* pMemory, size_t) { MemoryTracker::Deallocate(pMemory); }
+
+		template<typename U>
+		bool operator==(const TrackedStdAllocator<U, Tag>&) const { return true; }
+		template<typename U>
+		bool operator!=(const TrackedStdAllocator<U, Tag>&) const { return false; }
+	};
+}
+
+#define H_MEMORY_CONCAT_INTERNAL(a, b) a##b
+#define H_MEMORY_CONCAT(a, b) H_MEMORY_CONCAT_INTERNAL(a, b)
+// Pointer to a callsite for the current file and line, the hash is computed at compile time.
+#define H_MEMORY_CALLSITE() []() { static constexpr Hail::MemoryCallsite callsite{ __FILE__, __LINE__, xxh64::hash(__FILE__, __LINE__) }; return &callsite; }()
+#define H_MEMORY_TAG_SCOPE(tag) Hail::MemoryTagScope H_MEMORY_CONCAT(memoryTagScope, __LINE__)(tag, H_MEMORY_CALLSITE())
+#define H_TRACKED_ALLOCATE(sizeInBytes, alignment, tag) Hail::MemoryTracker::Allocate(sizeInBytes, alignment, tag, H_MEMORY_CALLSITE())
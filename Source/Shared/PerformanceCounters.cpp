@@ -0,0 +1,311 @@
+#include "Shared_PCH.h"
+#include "PerformanceCounters.h"
+#include "MathUtils.h"
+#include "Utility\InOutStream.h"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+
+using namespace Hail;
+
+PerformanceCounters* PerformanceCounters::m_pInstance = nullptr;
+
+namespace Hail
+{
+	constexpr uint32 locInvalidThreadSlot = MAX_UINT;
+
+	// Releases the slot of a thread when the thread exits, the values stay in the slot and the next thread keeps adding to them.
+	struct ThreadSlotHandle
+	{
+		~ThreadSlotHandle()
+		{
+			if (m_slotIndex != locInvalidThreadSlot && PerformanceCounters::IsInitialized())
+				PerformanceCounters::GetInstance().ReleaseThreadSlot(m_slotIndex);
+		}
+
+		uint32 m_slotIndex = locInvalidThreadSlot;
+	};
+
+	thread_local ThreadSlotHandle tl_threadSlotHandle;
+}
+
+namespace
+{
+	float GetPercentile(const GrowingArray<float>& sortedValues, float percentile)
+	{
+		const uint32 index = (uint32)(percentile * (float)(sortedValues.Size() - 1u) + 0.5f);
+		return sortedValues[Math::Min(index, sortedValues.Size() - 1u)];
+	}
+}
+
+void Hail::PerformanceCounters::Initialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should create the performance counters.");
+	H_ASSERT(!m_pInstance, "Can not create the main instance more than once.");
+	m_pInstance = new PerformanceCounters();
+	m_pInstance->m_numberOfCounters = 0u;
+	for (uint32 iSlot = 0; iSlot < MaxNumberOfThreads; iSlot++)
+	{
+		ThreadSlot& threadSlot = m_pInstance->m_threadSlots[iSlot];
+		for (uint32 iCounter = 0; iCounter < MaxNumberOfCounters; iCounter++)
+			threadSlot.m_values[iCounter] = 0;
+		threadSlot.m_bInUse = false;
+	}
+}
+
+void Hail::PerformanceCounters::Deinitialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should destroy the performance counters.");
+	H_ASSERT(m_pInstance, "Programming error, deleting a non valid instance.");
+	SAFEDELETE(m_pInstance);
+}
+
+uint32 Hail::PerformanceCounters::Register(const char* pName, eCounterType type)
+{
+	ScopedLock<Mutex> lock(m_registerLock);
+	const uint32 numberOfCounters = m_numberOfCounters.load(std::memory_order_relaxed);
+	for (uint32 iCounter = 0; iCounter < numberOfCounters; iCounter++)
+	{
+		if (strcmp(m_counters[iCounter].m_pName, pName) == 0)
+		{
+			H_ASSERT(m_counters[iCounter].m_type == type, "Counter is registered with two different types.");
+			return iCounter;
+		}
+	}
+
+	if (numberOfCounters == MaxNumberOfCounters)
+	{
+		H_WARNING("Too many performance counters, increase MaxNumberOfCounters.");
+		return MAX_UINT;
+	}
+
+	Counter& counter = m_counters[numberOfCounters];
+	counter.m_pName = pName;
+	counter.m_type = type;
+	counter.m_gaugeValue = 0;
+	counter.m_totalLastFrame = 0;
+	// Frames before the counter existed are shown as zero.
+	memset(counter.m_history, 0, sizeof(counter.m_history));
+	m_numberOfCounters.store(numberOfCounters + 1u, std::memory_order_release);
+	return numberOfCounters;
+}
+
+void Hail::PerformanceCounters::Add(uint32 handle, int64 value)
+{
+	ThreadSlot* pThreadSlot = GetThreadSlot();
+	if (handle >= MaxNumberOfCounters || !pThreadSlot)
+		return;
+
+	// Only the owning thread writes to its slot, so there is no need for a locked read-modify-write.
+	std::atomic_int64_t& slotValue = pThreadSlot->m_values[handle];
+	slotValue.store(slotValue.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void Hail::PerformanceCounters::Set(uint32 handle, int64 value)
+{
+	if (handle >= MaxNumberOfCounters)
+		return;
+
+	m_counters[handle].m_gaugeValue.store(value, std::memory_order_relaxed);
+}
+
+void Hail::PerformanceCounters::EndFrame(float frameTimeMs)
+{
+	H_ASSERT(GetIsMainThread(), "Frames are ended by the main thread.");
+	const uint32 historyIndex = (uint32)(m_numberOfFrames % HistorySize);
+	const uint32 numberOfCounters = GetNumberOfCounters();
+	for (uint32 iCounter = 0; iCounter < numberOfCounters; iCounter++)
+	{
+		Counter& counter = m_counters[iCounter];
+		if (counter.m_type == eCounterType::Gauge)
+		{
+			counter.m_history[historyIndex] = counter.m_gaugeValue.load(std::memory_order_relaxed);
+			continue;
+		}
+
+		int64 total = 0;
+		for (uint32 iSlot = 0; iSlot < MaxNumberOfThreads; iSlot++)
+			total += m_threadSlots[iSlot].m_values[iCounter].load(std::memory_order_relaxed);
+		counter.m_history[historyIndex] = total - counter.m_totalLastFrame;
+		counter.m_totalLastFrame = total;
+	}
+	m_frameTimesMs[historyIndex] = frameTimeMs;
+	m_numberOfFrames++;
+}
+
+PerformanceCounters::CounterStats Hail::PerformanceCounters::GetCounterStats(uint32 handle) const
+{
+	const Counter& counter = m_counters[handle];
+	CounterStats stats{};
+	stats.m_pName = counter.m_pName;
+	stats.m_type = counter.m_type;
+
+	const uint32 numberOfFrames = GetNumberOfFramesInHistory();
+	if (numberOfFrames == 0u)
+		return stats;
+
+	stats.m_lastValue = counter.m_history[GetHistoryIndex(numberOfFrames - 1u)];
+	stats.m_minValue = stats.m_lastValue;
+	stats.m_maxValue = stats.m_lastValue;
+	int64 sum = 0;
+	for (uint32 iFrame = 0; iFrame < numberOfFrames; iFrame++)
+	{
+		const int64 value = counter.m_history[GetHistoryIndex(iFrame)];
+		stats.m_minValue = Math::Min(stats.m_minValue, value);
+		stats.m_maxValue = Math::Max(stats.m_maxValue, value);
+		sum += value;
+	}
+	stats.m_averageValue = (double)sum / (double)numberOfFrames;
+	return stats;
+}
+
+PerformanceCounters::FrameTimeStats Hail::PerformanceCounters::GetFrameTimeStats() const
+{
+	FrameTimeStats stats{};
+	GrowingArray<float> frameTimes;
+	GetFrameTimeHistory(frameTimes);
+	stats.m_numberOfFrames = frameTimes.Size();
+	if (frameTimes.Empty())
+		return stats;
+
+	float sum = 0.f;
+	for (uint32 iFrame = 0; iFrame < frameTimes.Size(); iFrame++)
+		sum += frameTimes[iFrame];
+	stats.m_averageMs = sum / (float)frameTimes.Size();
+
+	std::sort(frameTimes.Data(), frameTimes.Data() + frameTimes.Size());
+	stats.m_p50Ms = GetPercentile(frameTimes, 0.5f);
+	stats.m_p90Ms = GetPercentile(frameTimes, 0.9f);
+	stats.m_p99Ms = GetPercentile(frameTimes, 0.99f);
+	stats.m_maxMs = frameTimes[frameTimes.Size() - 1u];
+	return stats;
+}
+
+void Hail::PerformanceCounters::GetCounterHistory(uint32 handle, GrowingArray<float>& historyOut) const
+{
+	historyOut.RemoveAll();
+	const uint32 numberOfFrames = GetNumberOfFramesInHistory();
+	for (uint32 iFrame = 0; iFrame < numberOfFrames; iFrame++)
+		historyOut.Add((float)m_counters[handle].m_history[GetHistoryIndex(iFrame)]);
+}
+
+void Hail::PerformanceCounters::GetFrameTimeHistory(GrowingArray<float>& historyOut) const
+{
+	historyOut.RemoveAll();
+	const uint32 numberOfFrames = GetNumberOfFramesInHistory();
+	for (uint32 iFrame = 0; iFrame < numberOfFrames; iFrame++)
+		historyOut.Add(m_frameTimesMs[GetHistoryIndex(iFrame)]);
+}
+
+bool Hail::PerformanceCounters::WriteReport(const FilePath& filePath, ePerformanceReportFormat format) const
+{
+	switch (format)
+	{
+	case ePerformanceReportFormat::Csv:
+		return WriteCsv(filePath);
+	case ePerformanceReportFormat::Json:
+		return WriteJson(filePath);
+	default:
+		return false;
+	}
+}
+
+PerformanceCounters::ThreadSlot* Hail::PerformanceCounters::GetThreadSlot()
+{
+	if (tl_threadSlotHandle.m_slotIndex != locInvalidThreadSlot)
+		return &m_threadSlots[tl_threadSlotHandle.m_slotIndex];
+
+	for (uint32 iSlot = 0; iSlot < MaxNumberOfThreads; iSlot++)
+	{
+		bool bExpectedInUse = false;
+		if (!m_threadSlots[iSlot].m_bInUse.compare_exchange_strong(bExpectedInUse, true, std::memory_order_acq_rel))
+			continue;
+
+		tl_threadSlotHandle.m_slotIndex = iSlot;
+		return &m_threadSlots[iSlot];
+	}
+	return nullptr;
+}
+
+uint32 Hail::PerformanceCounters::GetNumberOfFramesInHistory() const
+{
+	return (uint32)Math::Min<uint64>(m_numberOfFrames, HistorySize);
+}
+
+uint32 Hail::PerformanceCounters::GetHistoryIndex(uint32 frameInHistory) const
+{
+	const uint64 firstFrame = m_numberOfFrames - GetNumberOfFramesInHistory();
+	return (uint32)((firstFrame + frameInHistory) % HistorySize);
+}
+
+void Hail::PerformanceCounters::ReleaseThreadSlot(uint32 slotIndex)
+{
+	m_threadSlots[slotIndex].m_bInUse.store(false, std::memory_order_release);
+}
+
+bool Hail::PerformanceCounters::WriteCsv(const FilePath& filePath) const
+{
+	InOutStream outStream;
+	if (!outStream.OpenFile(filePath, FILE_OPEN_TYPE::WRITE, false))
+	{
+		H_WARNING("Failed to open the performance report for writing.");
+		return false;
+	}
+
+	char text[256];
+	int textLength = snprintf(text, sizeof(text), "frame,frame time ms");
+	outStream.Write(text, sizeof(char), textLength);
+	const uint32 numberOfCounters = GetNumberOfCounters();
+	for (uint32 iCounter = 0; iCounter < numberOfCounters; iCounter++)
+	{
+		textLength = snprintf(text, sizeof(text), ",%s", m_counters[iCounter].m_pName);
+		outStream.Write(text, sizeof(char), textLength);
+	}
+
+	const uint32 numberOfFrames = GetNumberOfFramesInHistory();
+	const uint64 firstFrame = m_numberOfFrames - numberOfFrames;
+	for (uint32 iFrame = 0; iFrame < numberOfFrames; iFrame++)
+	{
+		const uint32 historyIndex = GetHistoryIndex(iFrame);
+		textLength = snprintf(text, sizeof(text), "\n%llu,%.3f", firstFrame + iFrame, m_frameTimesMs[historyIndex]);
+		outStream.Write(text, sizeof(char), textLength);
+		for (uint32 iCounter = 0; iCounter < numberOfCounters; iCounter++)
+		{
+			textLength = snprintf(text, sizeof(text), ",%lld", m_counters[iCounter].m_history[historyIndex]);
+			outStream.Write(text, sizeof(char), textLength);
+		}
+	}
+	outStream.Write("\n", sizeof(char), 1u);
+	outStream.CloseFile();
+	return true;
+}
+
+bool Hail::PerformanceCounters::WriteJson(const FilePath& filePath) const
+{
+	InOutStream outStream;
+	if (!outStream.OpenFile(filePath, FILE_OPEN_TYPE::WRITE, false))
+	{
+		H_WARNING("Failed to open the performance report for writing.");
+		return false;
+	}
+
+	char text[512];
+	const FrameTimeStats frameTimeStats = GetFrameTimeStats();
+	int textLength = snprintf(text, sizeof(text), "{\n\t\"frames\": %u,\n\t\"frameTimeMs\": { \"average\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n\t\"counters\": {",
+		frameTimeStats.m_numberOfFrames, frameTimeStats.m_averageMs, frameTimeStats.m_p50Ms, frameTimeStats.m_p90Ms, frameTimeStats.m_p99Ms, frameTimeStats.m_maxMs);
+	outStream.Write(text, sizeof(char), textLength);
+
+	const uint32 numberOfCounters = GetNumberOfCounters();
+	for (uint32 iCounter = 0; iCounter < numberOfCounters; iCounter++)
+	{
+		const CounterStats stats = GetCounterStats(iCounter);
+		textLength = snprintf(text, sizeof(text), "%s\n\t\t\"%s\": { \"type\": \"%s\", \"last\": %lld, \"min\": %lld, \"max\": %lld, \"average\": %.3f }",
+			iCounter == 0u ? "" : ",", stats.m_pName, stats.m_type == eCounterType::Counter ? "counter" : "gauge", stats.m_lastValue, stats.m_minValue, stats.m_maxValue, stats.m_averageValue);
+		outStream.Write(text, sizeof(char), textLength);
+	}
+	textLength = snprintf(text, sizeof(text), "\n\t}\n}\n");
+	outStream.Write(text, sizeof(char), textLength);
+	outStream.CloseFile();
+	return true;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <atomic>
+#include "Types.h"
+#include "Threading.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	class FilePath;
+
+	enum class eCounterType : uint8
+	{
+		// Summed over a frame and starts from zero every frame, like the number of sprite commands.
+		Counter,
+		// Keeps the last set value, like the bytes in use by an allocator.
+		Gauge
+	};
+
+	enum class ePerformanceReportFormat : uint8
+	{
+		None,
+		// One row per frame in the history with the frame time and every counter.
+		Csv,
+		// Frame time percentiles and the min, max and average of every counter.
+		Json
+	};
+
+	// Registry of named per frame counters and gauges with a rolling history.
+	// Every thread adds to its own slot so adding never locks, the main thread sums the slots when a frame ends.
+	class PerformanceCounters
+	{
+	public:
+		static constexpr uint32 MaxNumberOfCounters = 64u;
+		static constexpr uint32 MaxNumberOfThreads = 16u;
+		static constexpr uint32 HistorySize = 240u;
+
+		static void Initialize();
+		static void Deinitialize();
+		static PerformanceCounters& GetInstance() { return *m_pInstance; }
+		static bool IsInitialized() { return m_pInstance != nullptr; }
+
+		// Registering the same name again returns the same handle, the name has to outlive the registry.
+		uint32 Register(const char* pName, eCounterType type);
+		void Add(uint32 handle, int64 value);
+		void Set(uint32 handle, int64 value);
+
+		// Called by the main thread when a frame ends, moves the values of the frame to the history.
+		void EndFrame(float frameTimeMs);
+
+		struct CounterStats
+		{
+			const char* m_pName;
+			eCounterType m_type;
+			int64 m_lastValue;
+			int64 m_minValue;
+			int64 m_maxValue;
+			double m_averageValue;
+		};
+		struct FrameTimeStats
+		{
+			float m_averageMs;
+			float m_p50Ms;
+			float m_p90Ms;
+			float m_p99Ms;
+			float m_maxMs;
+			uint32 m_numberOfFrames;
+		};
+		// The stats and history only cover the frames in the history and are read from the main thread.
+		uint32 GetNumberOfCounters() const { return m_numberOfCounters.load(std::memory_order_acquire); }
+		CounterStats GetCounterStats(uint32 handle) const;
+		FrameTimeStats GetFrameTimeStats() const;
+		// Fills the history oldest frame first.
+		void GetCounterHistory(uint32 handle, GrowingArray<float>& historyOut) const;
+		void GetFrameTimeHistory(GrowingArray<float>& historyOut) const;
+
+		bool WriteReport(const FilePath& filePath, ePerformanceReportFormat format) const;
+
+	private:
+		struct Counter
+		{
+			const char* m_pName;
+			eCounterType m_type;
+			std::atomic_int64_t m_gaugeValue;
+			// Sum of all thread slots when the last frame ended.
+			int64 m_totalLastFrame;
+			int64 m_history[HistorySize];
+		};
+		struct ThreadSlot
+		{
+			// Only grows, a frame value is the difference to the total of the last frame so the slots never have to be reset.
+			std::atomic_int64_t m_values[MaxNumberOfCounters];
+			std::atomic_bool m_bInUse;
+		};
+
+		static PerformanceCounters* m_pInstance;
+
+		// Returns nullptr when all slots are in use, values from that thread are then not counted.
+		ThreadSlot* GetThreadSlot();
+		uint32 GetNumberOfFramesInHistory() const;
+		uint32 GetHistoryIndex(uint32 frameInHistory) const;
+
+		friend struct ThreadSlotHandle;
+		void ReleaseThreadSlot(uint32 slotIndex);
+
+		bool WriteCsv(const FilePath& filePath) const;
+		bool WriteJson(const FilePath& filePath) const;
+
+		Mutex m_registerLock;
+		Counter m_counters[MaxNumberOfCounters];
+		std::atomic_uint32_t m_numberOfCounters;
+		ThreadSlot m_threadSlots[MaxNumberOfThreads];
+		float m_frameTimesMs[HistorySize];
+		uint64 m_numberOfFrames = 0u;
+	};
+}
+
+#ifndef HAIL_DISABLE_PERFORMANCE_COUNTERS
+// Name has to be a string that outlives the registry, like a string literal.
+#define H_COUNTER_ADD(name, value) do { if (Hail::PerformanceCounters::IsInitialized()) { \
+	static const Hail::uint32 counterHandle = Hail::PerformanceCounters::GetInstance().Register(name, Hail::eCounterType::Counter); \
+	Hail::PerformanceCounters::GetInstance().Add(counterHandle, (Hail::int64)(value)); } } while (false)
+#define H_GAUGE_SET(name, value) do { if (Hail::PerformanceCounters::IsInitialized()) { \
+	static const Hail::uint32 gaugeHandle = Hail::PerformanceCounters::GetInstance().Register(name, Hail::eCounterType::Gauge); \
+	Hail::PerformanceCounters::GetInstance().Set(gaugeHandle, (Hail::int64)(value)); } } while (false)
+#else
+#define H_COUNTER_ADD(name, value)
+#define H_GAUGE_SET(name, value)
+#endif
@@ -0,0 +1,255 @@
+#include "Shared_PCH.h"
+#include "Profiler.h"
+#include "Threading.h"
+#include "MathUtils.h"
+#include "Utility\InOutStream.h"
+
+#include <stdio.h>
+
+using namespace Hail;
+
+Profiler* Profiler::m_pInstance = nullptr;
+
+namespace Hail
+{
+	constexpr uint32 locInvalidThreadBuffer = MAX_UINT;
+	constexpr uint64 locZoneBufferMask = Profiler::ZoneBufferSize - 1u;
+	static_assert((Profiler::ZoneBufferSize & locZoneBufferMask) == 0u, "The zone buffer size has to be a power of two.");
+
+	// Releases the buffer of a thread when the thread exits so a restarted thread does not use up a new buffer.
+	struct ThreadBufferHandle
+	{
+		~ThreadBufferHandle()
+		{
+			if (m_threadBufferIndex != locInvalidThreadBuffer && Profiler::IsInitialized())
+				Profiler::GetInstance().ReleaseThreadBuffer(m_threadBufferIndex);
+		}
+
+		uint32 m_threadBufferIndex = locInvalidThreadBuffer;
+	};
+
+	thread_local ThreadBufferHandle tl_threadBufferHandle;
+	thread_local uint32 tl_zoneDepth = 0u;
+}
+
+void Hail::Profiler::Initialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should create the profiler.");
+	H_ASSERT(!m_pInstance, "Can not create the main instance more than once.");
+	m_pInstance = new Profiler();
+	m_pInstance->m_startTimeNs = GetTimeNs();
+	m_pInstance->m_numberOfFrames = 0u;
+	m_pInstance->m_bPaused = false;
+	for (uint32 iFrame = 0; iFrame < FrameHistorySize; iFrame++)
+		m_pInstance->m_frameStartsNs[iFrame] = 0u;
+
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+	{
+		ThreadBuffer& threadBuffer = m_pInstance->m_threadBuffers[iThread];
+		threadBuffer.m_pZones = nullptr;
+		threadBuffer.m_writeIndex = 0u;
+		threadBuffer.m_threadID = MAX_UINT64;
+		threadBuffer.m_pName = nullptr;
+		threadBuffer.m_bInUse = false;
+	}
+	m_pInstance->SetThreadName("Main thread");
+}
+
+void Hail::Profiler::Deinitialize()
+{
+	H_ASSERT(GetIsMainThread(), "Only main thread should destroy the profiler.");
+	H_ASSERT(m_pInstance, "Programming error, deleting a non valid instance.");
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+		SAFEDELETE_ARRAY(m_pInstance->m_threadBuffers[iThread].m_pZones);
+	SAFEDELETE(m_pInstance);
+}
+
+void Hail::Profiler::MarkFrame()
+{
+	H_ASSERT(GetIsMainThread(), "Frames are marked by the main thread.");
+	if (IsPaused())
+		return;
+
+	const uint64 frameIndex = m_numberOfFrames.load(std::memory_order_relaxed);
+	m_frameStartsNs[frameIndex % FrameHistorySize].store(GetTimeNs(), std::memory_order_relaxed);
+	m_numberOfFrames.store(frameIndex + 1u, std::memory_order_release);
+}
+
+void Hail::Profiler::SetThreadName(const char* pName)
+{
+	if (ThreadBuffer* pThreadBuffer = GetThreadBuffer())
+		pThreadBuffer->m_pName.store(pName, std::memory_order_relaxed);
+}
+
+void Hail::Profiler::RecordZone(const char* pName, uint64 startNs, uint64 endNs, uint32 depth)
+{
+	if (IsPaused())
+		return;
+
+	ThreadBuffer* pThreadBuffer = GetThreadBuffer();
+	if (!pThreadBuffer)
+		return;
+
+	// Only the owning thread writes to the buffer, the write index is published after the zone so readers never see a half written zone as new.
+	const uint64 writeIndex = pThreadBuffer->m_writeIndex.load(std::memory_order_relaxed);
+	Zone& zone = pThreadBuffer->m_pZones[writeIndex & locZoneBufferMask];
+	zone.m_pName = pName;
+	zone.m_startNs = startNs;
+	zone.m_endNs = endNs;
+	zone.m_depth = depth;
+	zone.m_threadIndex = tl_threadBufferHandle.m_threadBufferIndex;
+	pThreadBuffer->m_writeIndex.store(writeIndex + 1u, std::memory_order_release);
+}
+
+uint32 Hail::Profiler::GetNumberOfCapturedFrames() const
+{
+	const uint64 numberOfFrames = m_numberOfFrames.load(std::memory_order_acquire);
+	// A frame needs the start of the next frame as its end.
+	return numberOfFrames == 0u ? 0u : (uint32)Math::Min<uint64>(numberOfFrames - 1u, FrameHistorySize - 1u);
+}
+
+bool Hail::Profiler::GetFrameZones(uint32 framesAgo, GrowingArray<Zone>& zonesOut, uint64& frameStartNsOut, uint64& frameEndNsOut) const
+{
+	zonesOut.RemoveAll();
+	if (framesAgo >= GetNumberOfCapturedFrames())
+		return false;
+
+	const uint64 lastFrameIndex = m_numberOfFrames.load(std::memory_order_acquire) - 1u;
+	frameStartNsOut = m_frameStartsNs[(lastFrameIndex - framesAgo - 1u) % FrameHistorySize].load(std::memory_order_relaxed);
+	frameEndNsOut = m_frameStartsNs[(lastFrameIndex - framesAgo) % FrameHistorySize].load(std::memory_order_relaxed);
+
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+	{
+		const ThreadBuffer& threadBuffer = m_threadBuffers[iThread];
+		if (threadBuffer.m_bInUse.load(std::memory_order_acquire))
+			CopyZones(threadBuffer, frameStartNsOut, frameEndNsOut, zonesOut);
+	}
+	return true;
+}
+
+void Hail::Profiler::GetThreads(GrowingArray<ThreadInfo>& threadsOut) const
+{
+	threadsOut.RemoveAll();
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+	{
+		const ThreadBuffer& threadBuffer = m_threadBuffers[iThread];
+		if (!threadBuffer.m_bInUse.load(std::memory_order_acquire))
+			continue;
+
+		ThreadInfo& threadInfo = threadsOut.Add();
+		threadInfo.m_pName = threadBuffer.m_pName.load(std::memory_order_relaxed);
+		threadInfo.m_threadID = threadBuffer.m_threadID.load(std::memory_order_relaxed);
+		threadInfo.m_threadIndex = iThread;
+	}
+}
+
+bool Hail::Profiler::ExportChromeTrace(const FilePath& filePath) const
+{
+	InOutStream outStream;
+	if (!outStream.OpenFile(filePath, FILE_OPEN_TYPE::WRITE, false))
+	{
+		H_WARNING("Failed to open the profiler trace file for writing.");
+		return false;
+	}
+
+	char line[512];
+	int lineLength = snprintf(line, sizeof(line), "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	outStream.Write(line, sizeof(char), lineLength);
+
+	bool bFirstEvent = true;
+	GrowingArray<Zone> zones;
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+	{
+		const ThreadBuffer& threadBuffer = m_threadBuffers[iThread];
+		if (!threadBuffer.m_bInUse.load(std::memory_order_acquire))
+			continue;
+
+		const char* pThreadName = threadBuffer.m_pName.load(std::memory_order_relaxed);
+		if (pThreadName)
+		{
+			lineLength = snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+				bFirstEvent ? "" : ",\n", iThread, pThreadName);
+			outStream.Write(line, sizeof(char), lineLength);
+			bFirstEvent = false;
+		}
+
+		zones.RemoveAll();
+		CopyZones(threadBuffer, 0u, MAX_UINT64, zones);
+		for (uint32 iZone = 0; iZone < zones.Size(); iZone++)
+		{
+			// Chrome traces are in microseconds.
+			const Zone& zone = zones[iZone];
+			lineLength = snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				bFirstEvent ? "" : ",\n", zone.m_pName, iThread, (zone.m_startNs - m_startTimeNs) * 0.001, (zone.m_endNs - zone.m_startNs) * 0.001);
+			outStream.Write(line, sizeof(char), lineLength);
+			bFirstEvent = false;
+		}
+	}
+
+	lineLength = snprintf(line, sizeof(line), "\n]}\n");
+	outStream.Write(line, sizeof(char), lineLength);
+	outStream.CloseFile();
+	return true;
+}
+
+Profiler::ThreadBuffer* Hail::Profiler::GetThreadBuffer()
+{
+	if (tl_threadBufferHandle.m_threadBufferIndex != locInvalidThreadBuffer)
+		return &m_threadBuffers[tl_threadBufferHandle.m_threadBufferIndex];
+
+	for (uint32 iThread = 0; iThread < MaxNumberOfThreads; iThread++)
+	{
+		ThreadBuffer& threadBuffer = m_threadBuffers[iThread];
+		bool bExpectedInUse = false;
+		if (!threadBuffer.m_bInUse.compare_exchange_strong(bExpectedInUse, true, std::memory_order_acq_rel))
+			continue;
+
+		// The zones of a released buffer are kept and reused by the next thread.
+		if (!threadBuffer.m_pZones)
+			threadBuffer.m_pZones = new Zone[ZoneBufferSize];
+		threadBuffer.m_writeIndex.store(0u, std::memory_order_relaxed);
+		threadBuffer.m_threadID.store(GetCurrentThreadID(), std::memory_order_relaxed);
+		threadBuffer.m_pName.store(nullptr, std::memory_order_relaxed);
+		tl_threadBufferHandle.m_threadBufferIndex = iThread;
+		return &threadBuffer;
+	}
+	return nullptr;
+}
+
+void Hail::Profiler::CopyZones(const ThreadBuffer& threadBuffer, uint64 rangeStartNs, uint64 rangeEndNs, GrowingArray<Zone>& zonesOut) const
+{
+	const uint64 endIndex = threadBuffer.m_writeIndex.load(std::memory_order_acquire);
+	const uint64 startIndex = endIndex > ZoneBufferSize ? endIndex - ZoneBufferSize : 0u;
+	for (uint64 iZone = startIndex; iZone < endIndex; iZone++)
+	{
+		const Zone zone = threadBuffer.m_pZones[iZone & locZoneBufferMask];
+		// The writer may have wrapped around and overwritten the zone while it was copied.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (threadBuffer.m_writeIndex.load(std::memory_order_relaxed) >= iZone + ZoneBufferSize)
+			continue;
+
+		if (zone.m_endNs >= rangeStartNs && zone.m_startNs < rangeEndNs)
+			zonesOut.Add(zone);
+	}
+}
+
+void Hail::Profiler::ReleaseThreadBuffer(uint32 threadIndex)
+{
+	ThreadBuffer& threadBuffer = m_threadBuffers[threadIndex];
+	threadBuffer.m_threadID.store(MAX_UINT64, std::memory_order_relaxed);
+	threadBuffer.m_bInUse.store(false, std::memory_order_release);
+}
+
+Hail::ProfilerScopedZone::ProfilerScopedZone(const char* pName) : m_pName(pName)
+{
+	m_startNs = Profiler::GetTimeNs();
+	tl_zoneDepth++;
+}
+
+Hail::ProfilerScopedZone::~ProfilerScopedZone()
+{
+	const uint64 endNs = Profiler::GetTimeNs();
+	tl_zoneDepth--;
+	if (Profiler::IsInitialized())
+		Profiler::GetInstance().RecordZone(m_pName, m_startNs, endNs, tl_zoneDepth);
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include "Types.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	class FilePath;
+
+	// Hierarchical CPU profiler, every thread records its finished zones to its own ring buffer so recording never locks.
+	// The rings are read while being written, a reader copies the zones and drops the ones the writer may have overwritten during the copy.
+	class Profiler
+	{
+	public:
+		static constexpr uint32 MaxNumberOfThreads = 16u;
+		// Zones per thread, has to be a power of two.
+		static constexpr uint32 ZoneBufferSize = 1u << 15u;
+		static constexpr uint32 FrameHistorySize = 256u;
+
+		static void Initialize();
+		static void Deinitialize();
+		static Profiler& GetInstance() { return *m_pInstance; }
+		static bool IsInitialized() { return m_pInstance != nullptr; }
+
+		static uint64 GetTimeNs() { return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+		// Called by the main thread at the start of every frame.
+		void MarkFrame();
+		// Name shown for the calling thread, the string has to outlive the profiler.
+		void SetThreadName(const char* pName);
+		// Stops recording new zones so a captured frame can be inspected.
+		void SetPaused(bool bPaused) { m_bPaused.store(bPaused, std::memory_order_relaxed); }
+		bool IsPaused() const { return m_bPaused.load(std::memory_order_relaxed); }
+
+		void RecordZone(const char* pName, uint64 startNs, uint64 endNs, uint32 depth);
+
+		struct Zone
+		{
+			const char* m_pName;
+			uint64 m_startNs;
+			uint64 m_endNs;
+			uint32 m_depth;
+			uint32 m_threadIndex;
+		};
+		struct ThreadInfo
+		{
+			const char* m_pName;
+			uint64 m_threadID;
+			uint32 m_threadIndex;
+		};
+		// Number of frames that can be read with GetFrameZones.
+		uint32 GetNumberOfCapturedFrames() const;
+		// Fills the zones of all threads that overlap the frame, 0 frames ago is the last finished frame.
+		bool GetFrameZones(uint32 framesAgo, GrowingArray<Zone>& zonesOut, uint64& frameStartNsOut, uint64& frameEndNsOut) const;
+		void GetThreads(GrowingArray<ThreadInfo>& threadsOut) const;
+
+		// Writes every zone still in the ring buffers as Chrome trace event JSON, opened with chrome://tracing or Perfetto.
+		bool ExportChromeTrace(const FilePath& filePath) const;
+
+	private:
+		struct ThreadBuffer
+		{
+			Zone* m_pZones;
+			std::atomic_uint64_t m_writeIndex;
+			std::atomic_uint64_t m_threadID;
+			std::atomic<const char*> m_pName;
+			std::atomic_bool m_bInUse;
+		};
+
+		static Profiler* m_pInstance;
+
+		// Returns nullptr when all thread buffers are in use, zones from that thread are then not recorded.
+		ThreadBuffer* GetThreadBuffer();
+		// Copies the zones overlapping the range, skips the zones the writer overwrote while they were copied.
+		void CopyZones(const ThreadBuffer& threadBuffer, uint64 rangeStartNs, uint64 rangeEndNs, GrowingArray<Zone>& zonesOut) const;
+
+		friend struct ThreadBufferHandle;
+		void ReleaseThreadBuffer(uint32 threadIndex);
+
+		ThreadBuffer m_threadBuffers[MaxNumberOfThreads];
+		std::atomic_uint64_t m_frameStartsNs[FrameHistorySize];
+		std::atomic_uint64_t m_numberOfFrames;
+		uint64 m_startTimeNs = 0;
+		std::atomic_bool m_bPaused;
+	};
+
+	// Records the time from construction to destruction as a zone, nested zones on the same thread are shown below their parent.
+	class ProfilerScopedZone
+	{
+	public:
+		explicit ProfilerScopedZone(const char* pName);
+		~ProfilerScopedZone();
+		ProfilerScopedZone(const ProfilerScopedZone&) = delete;
+		ProfilerScopedZone& operator=(const ProfilerScopedZone&) = delete;
+
+	private:
+		const char* m_pName;
+		uint64 m_startNs;
+	};
+}
+
+#ifndef HAIL_DISABLE_PROFILER
+#define H_PROFILE_CONCAT_INTERNAL(a, b) a##b
+#define H_PROFILE_CONCAT(a, b) H_PROFILE_CONCAT_INTERNAL(a, b)
+// Name has to be a string that outlives the profiler, like a string literal.
+#define H_PROFILE_SCOPE(name) Hail::ProfilerScopedZone H_PROFILE_CONCAT(profilerZone, __LINE__)(name)
+#define H_PROFILE_FUNCTION() H_PROFILE_SCOPE(__FUNCTION__)
+#define H_PROFILE_FRAME() if (Hail::Profiler::IsInitialized()) Hail::Profiler::GetInstance().MarkFrame()
+#else
+#define H_PROFILE_SCOPE(name)
+#define H_PROFILE_FUNCTION()
+#define H_PROFILE_FRAME()
+#endif
@@ -3,6 +3,7 @@
 #include <string>
 #include "Utilities.h"
 #include "InternalMessageHandling/ErrorHandler.h"
+#include "PerformanceCounters.h"
 
 namespace Hail
 {
@@ -27,6 +28,15 @@ namespace Hail
 		RESTORE_FOCUS = 1 << 9
 	};
 
+	enum class eInputRecordingMode : uint8
+	{
+		None,
+		// Writes the input of every application tick to the recording file on shutdown.
+		Record,
+		// Feeds the input from the recording file and ticks the application with a fixed time step as fast as possible.
+		Replay
+	};
+
 	struct ApplicationMessage
 	{
 		uint32 command = 0;
@@ -54,6 +64,24 @@ namespace Hail
 
 		bool startInFullScreen = false;
 
+		eInputRecordingMode inputRecordingMode = eInputRecordingMode::None;
+		// File name in the user project directory.
+		const wchar_t* inputRecordingFileName = L"InputRecording.hir";
+		// Shuts the engine down when the replay has fed its last tick.
+		bool bShutDownAfterReplay = true;
+
+		// Runs without a window or GPU, rendering goes through the null backend and ImGui is disabled.
+		bool bHeadless = false;
+		// Number of application ticks to run in headless mode before shutting down, 0 runs until shut down.
+		uint32 numberOfHeadlessTicks = 0;
+
+		// Writes the performance counter history to the report file in the user project directory on shutdown.
+		ePerformanceReportFormat performanceReportFormat = ePerformanceReportFormat::None;
+		const wchar_t* performanceReportFileName = L"PerformanceReport";
+
+		// Number of frames and application ticks before the game loop asserts on every heap allocation, 0 turns the check off.
+		uint32 steadyStateAllocationCheckFrame = 0;
+
 		ErrorManager* m_pErrorManager;
 	};
 }
@@ -21,30 +21,33 @@ void Hail::StringMemoryAllocator::Deinitialize()
 {
 	H_ASSERT(GetIsMainThread(), "Only main thread should destroy the allocator.");
 	H_ASSERT(m_pInstance, "Programming error, deleting a non valid instance.");
-	SAFEDELETE_ARRAY(m_pInstance->m_charBlock.m_pBuffer);
-	SAFEDELETE_ARRAY(m_pInstance->m_wCharBlock.m_pBuffer);
+	MemoryTracker::Deallocate(m_pInstance->m_charBlock.m_pBuffer);
+	MemoryTracker::Deallocate(m_pInstance->m_wCharBlock.m_pBuffer);
 	SAFEDELETE(m_pInstance);
 }
 
-void Hail::StringMemoryAllocator::AllocateString(const char* const pString, uint32 length, char** pOwningPointer)
+bool Hail::StringMemoryAllocator::AllocateString(const char* const pString, uint32 length, char** pOwningPointer)
 {
-	m_charBlock.AllocateString(length, pOwningPointer);
+	if (!m_charBlock.AllocateString(length, pOwningPointer))
+		return false;
 	if (pString)
 	{
 		memcpy(*pOwningPointer, pString, length * sizeof(char));
 		(*pOwningPointer)[length] = 0;
 	}
-
+	return true;
 }
 
-void Hail::StringMemoryAllocator::AllocateString(const wchar_t* const pString, uint32 length, wchar_t** pOwningPointer)
+bool Hail::StringMemoryAllocator::AllocateString(const wchar_t* const pString, uint32 length, wchar_t** pOwningPointer)
 {
-	m_wCharBlock.AllocateString(length, pOwningPointer);
+	if (!m_wCharBlock.AllocateString(length, pOwningPointer))
+		return false;
 	if (pString)
 	{
 		memcpy(*pOwningPointer, pString, length * sizeof(wchar_t));
 		(*pOwningPointer)[length] = 0;
 	}
+	return true;
 }
 
 void Hail::StringMemoryAllocator::DeallocateString(char** pToDeAllocate)
@@ -57,3 +60,7 @@ void Hail::StringMemoryAllocator::DeallocateString(wchar_t** pToDeAllocate)
 	m_wCharBlock.DeallocateString(pToDeAllocate);
 }
 
+size_t Hail::StringMemoryAllocator::GetNumberOfAllocatedBytes() const
+{
+	return m_charBlock.m_numberOfAllocatedElements.load(std::memory_order_relaxed) * sizeof(char) + m_wCharBlock.m_numberOfAllocatedElements.load(std::memory_order_relaxed) * sizeof(wchar_t);
+}
@@ -3,6 +3,7 @@
 #include <stdarg.h>
 #include "Containers\GrowingArray\GrowingArray.h"
 #include "Threading.h"
+#include "MemoryTracker.h"
 
 namespace Hail
 {
@@ -13,12 +14,28 @@ namespace Hail
 		static void Deinitialize();
 		static StringMemoryAllocator& GetInstance() { return *m_pInstance; }
 
-		void AllocateString(const char* const pString, uint32 length, char** pOwningPointer);
-		void AllocateString(const wchar_t* const pString, uint32 length, wchar_t** pOwningPointer);
+		// Returns false and sets the owning pointer to nullptr when the block has no room left for the string.
+		bool AllocateString(const char* const pString, uint32 length, char** pOwningPointer);
+		bool AllocateString(const wchar_t* const pString, uint32 length, wchar_t** pOwningPointer);
 
 		void DeallocateString(char** pToDeAllocate);
 		void DeallocateString(wchar_t** pToDeAllocate);
 
+		// Bytes of all live strings including their length headers.
+		size_t GetNumberOfAllocatedBytes() const;
+
+		struct FragmentationStats
+		{
+			// Bytes in the holes left by deallocated strings.
+			size_t m_freeBytes;
+			size_t m_largestFreeBytes;
+			uint32 m_numberOfFreeBlocks;
+			// Bytes after the head that have never been handed out.
+			size_t m_untouchedBytes;
+		};
+		FragmentationStats GetCharFragmentationStats() { return m_charBlock.GetFragmentationStats(); }
+		FragmentationStats GetWCharFragmentationStats() { return m_wCharBlock.GetFragmentationStats(); }
+
 	private:
 		static StringMemoryAllocator* m_pInstance;
 
@@ -28,13 +45,15 @@ namespace Hail
 			// A block organizes string in to a uint32 (length) + sequence of characters * length 
 		public:
 			void Init();
-			void AllocateString(uint32 length, MemoryType** pOwningPointer);
+			bool AllocateString(uint32 length, MemoryType** pOwningPointer);
 			void DeallocateString(MemoryType** pToDeAllocate);
+			FragmentationStats GetFragmentationStats();
 			uint32 GetMemoryBufferLength() { return 0xffffff * sizeof(MemoryType); }
 
 			MemoryType* m_pBuffer;
 			std::atomic_int m_freeOffset;
 			std::atomic_int m_head;
+			std::atomic_size_t m_numberOfAllocatedElements;
 
 			struct TableKey
 			{
@@ -42,7 +61,7 @@ namespace Hail
 				int32 m_nextOffset;
 				uint32 m_freeSize;
 			};
-			BinarySemaphore m_signal;
+			Mutex m_lock;
 		};
 		Block<char> m_charBlock;
 		Block<wchar_t> m_wCharBlock;
@@ -53,7 +72,8 @@ namespace Hail
 	{
 		m_freeOffset = -1;
 		m_head = 0;
-		m_pBuffer = new MemoryType[GetMemoryBufferLength()];
+		m_numberOfAllocatedElements = 0;
+		m_pBuffer = (MemoryType*)H_TRACKED_ALLOCATE(GetMemoryBufferLength() * sizeof(MemoryType), alignof(MemoryType), eMemoryTag::Strings);
 		memset(m_pBuffer, 0, GetMemoryBufferLength());
 		TableKey firstTableKey;
 		firstTableKey.m_nextOffset = -1;
@@ -62,10 +82,11 @@ namespace Hail
 	}
 
 	template<typename MemoryType>
-	inline void StringMemoryAllocator::Block<MemoryType>::AllocateString(uint32 length, MemoryType** pOwningPointer)
+	inline bool StringMemoryAllocator::Block<MemoryType>::AllocateString(uint32 length, MemoryType** pOwningPointer)
 	{
-		m_signal.Signal();
+		m_lock.Lock();
 		H_ASSERT(pOwningPointer);
+		MemoryTracker::RecordSubAllocation(eMemoryTag::Strings);
 
 		uint32 requestedSize = sizeof(uint32) + (length + sizeof(MemoryType));
 
@@ -89,13 +110,20 @@ namespace Hail
 		// No suitable free block -> allocate at head
 		if (currentOffset == -1)
 		{
+			if ((uint32)m_head + requestedSize > GetMemoryBufferLength())
+			{
+				*pOwningPointer = nullptr;
+				m_lock.Unlock();
+				return false;
+			}
 			currentOffset = m_head;
 			m_head += requestedSize;
 
 			memcpy(m_pBuffer + currentOffset, &requestedSize, sizeof(uint32));
 			*pOwningPointer = (MemoryType*)(m_pBuffer + currentOffset + sizeof(uint32));
-			m_signal.Wait();
-			return;
+			m_numberOfAllocatedElements.fetch_add(requestedSize, std::memory_order_relaxed);
+			m_lock.Unlock();
+			return true;
 		}
 
 		// Decide if we split
@@ -141,21 +169,24 @@ namespace Hail
 		memcpy(m_pBuffer + currentOffset, &requestedSize, sizeof(uint32));
 
 		*pOwningPointer = (m_pBuffer + currentOffset + sizeof(uint32));
+		m_numberOfAllocatedElements.fetch_add(requestedSize, std::memory_order_relaxed);
 
-		m_signal.Wait();
+		m_lock.Unlock();
+		return true;
 	}
 
 	template<typename MemoryType>
 	inline void StringMemoryAllocator::Block<MemoryType>::DeallocateString(MemoryType** pToDeAllocate)
 	{
 		H_ASSERT(pToDeAllocate && (*pToDeAllocate));
-		m_signal.Signal();
+		m_lock.Lock();
 
 		MemoryType* rawPtr = (MemoryType*)(*pToDeAllocate);
 		int32 offset = (int32)((rawPtr - (MemoryType*)m_pBuffer)) - sizeof(uint32);
 
 		uint32 blockSize;
 		memcpy(&blockSize, m_pBuffer + offset, sizeof(uint32));
+		m_numberOfAllocatedElements.fetch_sub(blockSize, std::memory_order_relaxed);
 
 		// Create new free block
 		TableKey newFree;
@@ -206,7 +237,23 @@ namespace Hail
 		}
 
 		*pToDeAllocate = nullptr;
-		m_signal.Wait();
+		m_lock.Unlock();
 		return;
 	}
+
+	template<typename MemoryType>
+	inline StringMemoryAllocator::FragmentationStats StringMemoryAllocator::Block<MemoryType>::GetFragmentationStats()
+	{
+		FragmentationStats stats{};
+		ScopedLock<Mutex> lock(m_lock);
+		for (int32 offset = m_freeOffset; offset != -1; offset = ((TableKey*)(m_pBuffer + offset))->m_nextOffset)
+		{
+			const size_t freeBytes = ((TableKey*)(m_pBuffer + offset))->m_freeSize * sizeof(MemoryType);
+			stats.m_freeBytes += freeBytes;
+			stats.m_largestFreeBytes = stats.m_largestFreeBytes > freeBytes ? stats.m_largestFreeBytes : freeBytes;
+			stats.m_numberOfFreeBlocks++;
+		}
+		stats.m_untouchedBytes = (GetMemoryBufferLength() - m_head) * sizeof(MemoryType);
+		return stats;
+	}
 }
@@ -1,26 +1,222 @@
 #include "Shared_PCH.h"
 #include "Threading.h"
+#include <thread>
+#include <climits>
+
+#ifdef PLATFORM_WINDOWS
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 using namespace Hail;
 
 uint64 Hail::g_mainThreadID = MAX_UINT64;
 
-void Hail::BinarySemaphore::Signal()
+namespace
+{
+	// Number of spins before a thread parks on a lock, a lock is usually held for a short time so spinning avoids the OS roundtrip.
+	constexpr uint32 g_lockSpinCount = 128u;
+	constexpr uint32 g_mutexUnlocked = 0u;
+	constexpr uint32 g_mutexLocked = 1u;
+	constexpr uint32 g_mutexLockedWithWaiters = 2u;
+}
+
+void Hail::WaitForAddressChange(std::atomic_uint32_t& address, uint32 expectedValue)
+{
+	static_assert(sizeof(std::atomic_uint32_t) == sizeof(uint32), "The atomic has to be lock free to be used as an address to wait on.");
+#ifdef PLATFORM_WINDOWS
+	::WaitOnAddress(&address, &expectedValue, sizeof(uint32), INFINITE);
+#elif defined(__linux__)
+	syscall(SYS_futex, reinterpret_cast<uint32*>(&address), FUTEX_WAIT_PRIVATE, expectedValue, nullptr, nullptr, 0);
+#else
+	if (address.load(std::memory_order_relaxed) == expectedValue)
+		std::this_thread::yield();
+#endif
+}
+
+void Hail::WakeOneWaitingOnAddress(std::atomic_uint32_t& address)
 {
-	while (true) 
-	{ 
-		if (m_counter.load() == true)
+#ifdef PLATFORM_WINDOWS
+	::WakeByAddressSingle(&address);
+#elif defined(__linux__)
+	syscall(SYS_futex, reinterpret_cast<uint32*>(&address), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+void Hail::WakeAllWaitingOnAddress(std::atomic_uint32_t& address)
+{
+#ifdef PLATFORM_WINDOWS
+	::WakeByAddressAll(&address);
+#elif defined(__linux__)
+	syscall(SYS_futex, reinterpret_cast<uint32*>(&address), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+void Hail::SpinPause()
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	_mm_pause();
+#else
+	std::this_thread::yield();
+#endif
+}
+
+void Hail::Mutex::Lock()
+{
+	uint32 expected = g_mutexUnlocked;
+	if (m_state.compare_exchange_strong(expected, g_mutexLocked, std::memory_order_acquire))
+		return;
+
+	m_numberOfContendedAcquires.fetch_add(1, std::memory_order_relaxed);
+	for (uint32 iSpin = 0; iSpin < g_lockSpinCount; iSpin++)
+	{
+		SpinPause();
+		expected = g_mutexUnlocked;
+		if (m_state.load(std::memory_order_relaxed) == g_mutexUnlocked &&
+			m_state.compare_exchange_weak(expected, g_mutexLocked, std::memory_order_acquire))
+			return;
+	}
+
+	// Marks the lock as having waiters, so the thread releasing the lock knows it has to wake someone up.
+	while (m_state.exchange(g_mutexLockedWithWaiters, std::memory_order_acquire) != g_mutexUnlocked)
+	{
+		m_numberOfParks.fetch_add(1, std::memory_order_relaxed);
+		WaitForAddressChange(m_state, g_mutexLockedWithWaiters);
+	}
+}
+
+bool Hail::Mutex::TryLock()
+{
+	uint32 expected = g_mutexUnlocked;
+	return m_state.compare_exchange_strong(expected, g_mutexLocked, std::memory_order_acquire);
+}
+
+void Hail::Mutex::Unlock()
+{
+	if (m_state.exchange(g_mutexUnlocked, std::memory_order_release) == g_mutexLockedWithWaiters)
+		WakeOneWaitingOnAddress(m_state);
+}
+
+LockStats Hail::Mutex::GetStats() const
+{
+	LockStats stats;
+	stats.m_numberOfContendedAcquires = m_numberOfContendedAcquires.load(std::memory_order_relaxed);
+	stats.m_numberOfParks = m_numberOfParks.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void Hail::ReadWriteLock::LockRead()
+{
+	bool bContended = false;
+	uint32 iSpin = 0;
+	while (true)
+	{
+		uint32 state = m_state.load();
+		if ((state & WriterBit) == 0 && m_numberOfWaitingWriters.load() == 0)
 		{
-			bool expectedResult = true;
-			const bool didWeAcquireTheLock = m_counter.compare_exchange_strong(expectedResult,false);
-			if (didWeAcquireTheLock)
+			if (m_state.compare_exchange_weak(state, state + 1, std::memory_order_acquire))
 				break;
+			continue;
+		}
+
+		if (!bContended)
+		{
+			bContended = true;
+			m_numberOfContendedAcquires.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		if (iSpin < g_lockSpinCount)
+		{
+			iSpin++;
+			SpinPause();
+			continue;
+		}
+
+		// The state is read again after registering as a waiter, so a writer releasing the lock in between is seen.
+		m_numberOfWaitingReaders.fetch_add(1);
+		state = m_state.load();
+		if ((state & WriterBit) || m_numberOfWaitingWriters.load() != 0)
+		{
+			m_numberOfParks.fetch_add(1, std::memory_order_relaxed);
+			WaitForAddressChange(m_state, state);
 		}
+		m_numberOfWaitingReaders.fetch_sub(1);
+	}
+}
+
+void Hail::ReadWriteLock::UnlockRead()
+{
+	const uint32 previousState = m_state.fetch_sub(1, std::memory_order_release);
+	if ((previousState & ~WriterBit) == 1u && m_numberOfWaitingWriters.load() != 0)
+		WakeAllWaitingOnAddress(m_state);
+}
+
+void Hail::ReadWriteLock::LockWrite()
+{
+	uint32 expected = 0u;
+	if (m_state.compare_exchange_strong(expected, WriterBit, std::memory_order_acquire))
+		return;
+
+	m_numberOfContendedAcquires.fetch_add(1, std::memory_order_relaxed);
+	for (uint32 iSpin = 0; iSpin < g_lockSpinCount; iSpin++)
+	{
+		SpinPause();
+		expected = 0u;
+		if (m_state.load(std::memory_order_relaxed) == 0u && m_state.compare_exchange_weak(expected, WriterBit, std::memory_order_acquire))
+			return;
+	}
+
+	// Registering as a waiting writer stops new readers from taking the lock.
+	m_numberOfWaitingWriters.fetch_add(1);
+	while (true)
+	{
+		expected = 0u;
+		if (m_state.compare_exchange_strong(expected, WriterBit, std::memory_order_acquire))
+			break;
+		m_numberOfParks.fetch_add(1, std::memory_order_relaxed);
+		WaitForAddressChange(m_state, expected);
 	}
+	m_numberOfWaitingWriters.fetch_sub(1);
+}
+
+void Hail::ReadWriteLock::UnlockWrite()
+{
+	m_state.fetch_and(~WriterBit, std::memory_order_release);
+	if (m_numberOfWaitingReaders.load() != 0 || m_numberOfWaitingWriters.load() != 0)
+		WakeAllWaitingOnAddress(m_state);
+}
+
+LockStats Hail::ReadWriteLock::GetStats() const
+{
+	LockStats stats;
+	stats.m_numberOfContendedAcquires = m_numberOfContendedAcquires.load(std::memory_order_relaxed);
+	stats.m_numberOfParks = m_numberOfParks.load(std::memory_order_relaxed);
+	return stats;
+}
+
+void Hail::Event::Set()
+{
+	if (m_state.exchange(1u, std::memory_order_release) == 0u)
+		WakeAllWaitingOnAddress(m_state);
+}
+
+void Hail::Event::Reset()
+{
+	m_state.store(0u, std::memory_order_relaxed);
 }
 
-void Hail::BinarySemaphore::Wait()
+void Hail::Event::Wait()
 {
-	m_counter.exchange(true, std::memory_order::memory_order_release);
+	while (m_state.load(std::memory_order_acquire) == 0u)
+		WaitForAddressChange(m_state, 0u);
 }
 
 Hail::AssertLock::AssertLock()
@@ -5,16 +5,107 @@
 
 namespace Hail
 {
-	class BinarySemaphore
-	{
-	public:
-		// Increment tha atomic counter.
-		void Signal();
-		// Decrement the atomic counter and waits for it to be free.
-		void Wait();
-	private:
-		std::atomic_bool m_counter{true};
-	};
+    // Parks the calling thread while the value at the address is equal to the expected value, uses WaitOnAddress on Windows and futex on Linux.
+    // Can return spuriously, so always check the value again in a loop.
+    void WaitForAddressChange(std::atomic_uint32_t& address, uint32 expectedValue);
+    void WakeOneWaitingOnAddress(std::atomic_uint32_t& address);
+    void WakeAllWaitingOnAddress(std::atomic_uint32_t& address);
+    // Tells the CPU we are in a spin loop.
+    void SpinPause();
+
+    // Contention counters of a lock, a contended acquire is one that did not get the lock on the first try and a park is
+    // when a thread had to sleep on the lock after spinning.
+    struct LockStats
+    {
+        uint32 m_numberOfContendedAcquires;
+        uint32 m_numberOfParks;
+    };
+
+    // Mutex that spins for a short while and then parks the thread in the OS until the lock is released.
+    class Mutex
+    {
+    public:
+        void Lock();
+        bool TryLock();
+        void Unlock();
+
+        LockStats GetStats() const;
+
+    private:
+        // 0 unlocked, 1 locked, 2 locked with threads parked on the lock.
+        std::atomic_uint32_t m_state{ 0u };
+        std::atomic_uint32_t m_numberOfContendedAcquires{ 0u };
+        std::atomic_uint32_t m_numberOfParks{ 0u };
+    };
+
+    // Reader-writer lock with writer preference, new readers wait while a writer is waiting so writers can not starve.
+    class ReadWriteLock
+    {
+    public:
+        void LockRead();
+        void UnlockRead();
+        void LockWrite();
+        void UnlockWrite();
+
+        LockStats GetStats() const;
+
+    private:
+        static constexpr uint32 WriterBit = 1u << 31u;
+
+        // Number of readers in the low bits, WriterBit when a writer holds the lock.
+        std::atomic_uint32_t m_state{ 0u };
+        std::atomic_uint32_t m_numberOfWaitingReaders{ 0u };
+        std::atomic_uint32_t m_numberOfWaitingWriters{ 0u };
+        std::atomic_uint32_t m_numberOfContendedAcquires{ 0u };
+        std::atomic_uint32_t m_numberOfParks{ 0u };
+    };
+
+    // Manual reset event, threads calling Wait are parked until the event is set.
+    class Event
+    {
+    public:
+        void Set();
+        void Reset();
+        void Wait();
+        bool IsSet() const { return m_state.load(std::memory_order_acquire) != 0u; }
+
+    private:
+        std::atomic_uint32_t m_state{ 0u };
+    };
+
+    template<typename LockType>
+    class ScopedLock
+    {
+    public:
+        explicit ScopedLock(LockType& lock) : m_lock(lock) { m_lock.Lock(); }
+        ~ScopedLock() { m_lock.Unlock(); }
+        ScopedLock(const ScopedLock&) = delete;
+        ScopedLock& operator=(const ScopedLock&) = delete;
+    private:
+        LockType& m_lock;
+    };
+
+    class ScopedReadLock
+    {
+    public:
+        explicit ScopedReadLock(ReadWriteLock& lock) : m_lock(lock) { m_lock.LockRead(); }
+        ~ScopedReadLock() { m_lock.UnlockRead(); }
+        ScopedReadLock(const ScopedReadLock&) = delete;
+        ScopedReadLock& operator=(const ScopedReadLock&) = delete;
+    private:
+        ReadWriteLock& m_lock;
+    };
+
+    class ScopedWriteLock
+    {
+    public:
+        explicit ScopedWriteLock(ReadWriteLock& lock) : m_lock(lock) { m_lock.LockWrite(); }
+        ~ScopedWriteLock() { m_lock.UnlockWrite(); }
+        ScopedWriteLock(const ScopedWriteLock&) = delete;
+        ScopedWriteLock& operator=(const ScopedWriteLock&) = delete;
+    private:
+        ReadWriteLock& m_lock;
+    };
 
     extern uint64 g_mainThreadID;
     void SetMainThread();
@@ -39,5 +130,3 @@ namespace Hail
     };
 
 }
-
-
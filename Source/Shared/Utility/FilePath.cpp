@@ -63,6 +63,7 @@ FilePath FilePath::ProjectCurrentWorkingDirectory("");
 FilePath FilePath::UserProjectDirectory("");
 FilePath FilePath::ResourceSourceDirectory("");
 FilePath FilePath::AngelscriptDirectory("");
+FilePath FilePath::AngelscriptCompiledDirectory("");
 FilePath FilePath::ShaderResourceDirectory("");
 FilePath FilePath::ShaderCompiledDirectory("");
 FilePath FilePath::TextureResourceSourceDirectory("");
@@ -230,6 +231,15 @@ const FilePath& FilePath::GetAngelscriptDirectory()
     return AngelscriptDirectory;
 }
 
+const FilePath& FilePath::GetAngelscriptCompiledDirectory()
+{
+    if (AngelscriptCompiledDirectory.Length() != 0)
+        return AngelscriptCompiledDirectory;
+
+    AngelscriptCompiledDirectory = GetCurrentWorkingDirectory() + L"resources/scripts/";
+    return AngelscriptCompiledDirectory;
+}
+
 const FilePath& Hail::FilePath::GetShaderResourceDirectory()
 {
     if (ShaderResourceDirectory.Length() != 0)
@@ -518,7 +528,8 @@ void Hail::FilePath::FindExtension(bool useFileObjectsExtension)
         wchar_t currentCharacter = 0;
         while (seperator != 0)
         {
-            if (currentCharacter == g_Wildcard)
+            // Only the last part of the path can have an extension, so directories with a dot in the name stay directories.
+            if (currentCharacter == g_Wildcard || currentCharacter == g_SourceSeparator || currentCharacter == g_Separator)
             {
                 break;
             }
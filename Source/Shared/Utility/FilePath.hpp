@@ -194,6 +194,8 @@ namespace Hail
 		static const FilePath& GetResourceSourceDirectory();
 		// Generated/bin/Scripts
 		static const FilePath& GetAngelscriptDirectory();
+		// Folder of cached compiled script bytecode
+		static const FilePath& GetAngelscriptCompiledDirectory();
 		// Folder of shader resources for import
 		static const FilePath& GetShaderResourceDirectory();
 		// Folder of compiled shaders
@@ -221,6 +223,7 @@ namespace Hail
 		static FilePath ProjectCurrentWorkingDirectory;
 		static FilePath UserProjectDirectory;
 		static FilePath AngelscriptDirectory;
+		static FilePath AngelscriptCompiledDirectory;
 		static FilePath ShaderResourceDirectory;
 		static FilePath ShaderCompiledDirectory;
 		static FilePath TextureResourceSourceDirectory;
@@ -547,14 +547,14 @@ namespace Hail
         {
             if (m_currentFileObject.IsDirectory())
             {
-                m_directoriesToIterateOver.Push(m_basePath + m_currentFileObject);
+                m_directoriesToIterateOver.Push(PathTable::GetInstance().Intern(m_basePath + m_currentFileObject));
             }
         }
         else
         {
             if (m_directoriesToIterateOver.Size() > 0)
             {
-                m_basePath = m_directoriesToIterateOver.Pop();
+                m_basePath = PathTable::GetInstance().ToFilePath(m_directoriesToIterateOver.Pop());
                 InitPath(m_basePath);
                 IterateOverFolderRecursively();
             }
@@ -5,6 +5,7 @@
 #include "Containers\VectorOnStack\VectorOnStack.h"
 #include "String.hpp"
 #include "Utility\FilePath.hpp"
+#include "Utility\PathTable.h"
 
 namespace Hail
 {
@@ -42,7 +43,7 @@ namespace Hail
 
 
 	private:
-		Stack<FilePath> m_directoriesToIterateOver;
+		Stack<PathHandle> m_directoriesToIterateOver;
 	};
 
 	struct SelectAbleFileObject
@@ -0,0 +1,402 @@
+#include "Shared_PCH.h"
+#include "PathTable.h"
+#include "FilePath.hpp"
+#include "Hashing\xxh64_en.hpp"
+
+using namespace Hail;
+
+namespace
+{
+	constexpr uint32 locMinLookupSize = 1024u;
+
+	char locFoldCase(char character)
+	{
+		return (character >= 'A' && character <= 'Z') ? character + ('a' - 'A') : character;
+	}
+
+	uint64 locHashPath(const char* pPath, uint32 length)
+	{
+		char folded[PathTable::MaxPathLength];
+		for (uint32 i = 0; i < length; i++)
+			folded[i] = locFoldCase(pPath[i]);
+		return xxh64::hash(folded, length, 0);
+	}
+
+	bool locIsSamePath(const char* pPathA, const char* pPathB, uint32 length)
+	{
+		for (uint32 i = 0; i < length; i++)
+		{
+			if (locFoldCase(pPathA[i]) != locFoldCase(pPathB[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// Unifies the separators, removes repeated separators and removes a trailing separator or wildcard.
+	uint32 locNormalizePath(const char* pPath, uint32 length, char* pNormalizedOut)
+	{
+		uint32 normalizedLength = 0u;
+		for (uint32 i = 0; i < length && normalizedLength < PathTable::MaxPathLength - 1u; i++)
+		{
+			char character = pPath[i] == '\\' ? '/' : pPath[i];
+			if (character == '/' && normalizedLength != 0u && pNormalizedOut[normalizedLength - 1u] == '/')
+				continue;
+			pNormalizedOut[normalizedLength++] = character;
+		}
+		if (normalizedLength != 0u && pNormalizedOut[normalizedLength - 1u] == '*')
+			normalizedLength--;
+		if (normalizedLength > 1u && pNormalizedOut[normalizedLength - 1u] == '/')
+			normalizedLength--;
+		return normalizedLength;
+	}
+
+	uint32 locWideToUtf8(const wchar_t* pPath, uint32 length, char* pUtf8Out)
+	{
+		uint32 utf8Length = 0u;
+		for (uint32 i = 0; i < length; i++)
+		{
+			uint32 codePoint = (uint32)pPath[i];
+			// UTF-16 surrogate pair
+			if (codePoint >= 0xD800u && codePoint <= 0xDBFFu && i + 1u < length)
+			{
+				const uint32 lowSurrogate = (uint32)pPath[i + 1u];
+				if (lowSurrogate >= 0xDC00u && lowSurrogate <= 0xDFFFu)
+				{
+					codePoint = 0x10000u + ((codePoint - 0xD800u) << 10u) + (lowSurrogate - 0xDC00u);
+					i++;
+				}
+			}
+
+			if (utf8Length + 4u >= PathTable::MaxPathLength)
+				break;
+
+			if (codePoint < 0x80u)
+			{
+				pUtf8Out[utf8Length++] = (char)codePoint;
+			}
+			else if (codePoint < 0x800u)
+			{
+				pUtf8Out[utf8Length++] = (char)(0xC0u | (codePoint >> 6u));
+				pUtf8Out[utf8Length++] = (char)(0x80u | (codePoint & 0x3Fu));
+			}
+			else if (codePoint < 0x10000u)
+			{
+				pUtf8Out[utf8Length++] = (char)(0xE0u | (codePoint >> 12u));
+				pUtf8Out[utf8Length++] = (char)(0x80u | ((codePoint >> 6u) & 0x3Fu));
+				pUtf8Out[utf8Length++] = (char)(0x80u | (codePoint & 0x3Fu));
+			}
+			else
+			{
+				pUtf8Out[utf8Length++] = (char)(0xF0u | (codePoint >> 18u));
+				pUtf8Out[utf8Length++] = (char)(0x80u | ((codePoint >> 12u) & 0x3Fu));
+				pUtf8Out[utf8Length++] = (char)(0x80u | ((codePoint >> 6u) & 0x3Fu));
+				pUtf8Out[utf8Length++] = (char)(0x80u | (codePoint & 0x3Fu));
+			}
+		}
+		return utf8Length;
+	}
+
+	uint32 locUtf8ToWide(const char* pUtf8Path, uint32 length, wchar_t* pPathOut, uint32 maxLength)
+	{
+		uint32 wideLength = 0u;
+		uint32 i = 0u;
+		while (i < length && wideLength + 2u < maxLength)
+		{
+			const uint8 leadByte = (uint8)pUtf8Path[i];
+			uint32 codePoint = leadByte;
+			uint32 numberOfContinuationBytes = 0u;
+			if (leadByte >= 0xF0u)
+			{
+				codePoint = leadByte & 0x07u;
+				numberOfContinuationBytes = 3u;
+			}
+			else if (leadByte >= 0xE0u)
+			{
+				codePoint = leadByte & 0x0Fu;
+				numberOfContinuationBytes = 2u;
+			}
+			else if (leadByte >= 0xC0u)
+			{
+				codePoint = leadByte & 0x1Fu;
+				numberOfContinuationBytes = 1u;
+			}
+			i++;
+			for (uint32 iByte = 0; iByte < numberOfContinuationBytes && i < length; iByte++)
+				codePoint = (codePoint << 6u) | ((uint8)pUtf8Path[i++] & 0x3Fu);
+
+			if (sizeof(wchar_t) == 2u && codePoint >= 0x10000u)
+			{
+				codePoint -= 0x10000u;
+				pPathOut[wideLength++] = (wchar_t)(0xD800u + (codePoint >> 10u));
+				pPathOut[wideLength++] = (wchar_t)(0xDC00u + (codePoint & 0x3FFu));
+			}
+			else
+			{
+				pPathOut[wideLength++] = (wchar_t)codePoint;
+			}
+		}
+		pPathOut[wideLength] = L'\0';
+		return wideLength;
+	}
+}
+
+PathTable& Hail::PathTable::GetInstance()
+{
+	static PathTable instance;
+	return instance;
+}
+
+Hail::PathTable::PathTable()
+{
+	for (uint32 i = 0; i < MaxNumberOfEntryPages; i++)
+		m_pEntryPages[i] = nullptr;
+	for (uint32 i = 0; i < MaxNumberOfStringPages; i++)
+		m_pStringPages[i] = nullptr;
+	RebuildLookup(locMinLookupSize);
+}
+
+Hail::PathTable::~PathTable()
+{
+	for (uint32 i = 0; i < MaxNumberOfEntryPages; i++)
+		SAFEDELETE_ARRAY(m_pEntryPages[i]);
+	for (uint32 i = 0; i < MaxNumberOfStringPages; i++)
+		SAFEDELETE_ARRAY(m_pStringPages[i]);
+}
+
+PathHandle Hail::PathTable::Intern(const FilePath& path)
+{
+	return Intern(path.Data(), path.Length(), path.IsDirectory());
+}
+
+PathHandle Hail::PathTable::Intern(const wchar_t* pPath, uint32 length, bool bIsDirectory)
+{
+	char utf8Path[MaxPathLength];
+	const uint32 utf8Length = locWideToUtf8(pPath, length, utf8Path);
+	return Intern(utf8Path, utf8Length, bIsDirectory);
+}
+
+PathHandle Hail::PathTable::Intern(const char* pUtf8Path, uint32 length, bool bIsDirectory)
+{
+	char normalizedPath[MaxPathLength];
+	const uint32 normalizedLength = locNormalizePath(pUtf8Path, length, normalizedPath);
+	if (normalizedLength == 0u)
+		return InvalidPathHandle;
+	return InternNormalized(normalizedPath, normalizedLength, bIsDirectory);
+}
+
+PathHandle Hail::PathTable::Find(const FilePath& path) const
+{
+	char utf8Path[MaxPathLength];
+	const uint32 utf8Length = locWideToUtf8(path.Data(), path.Length(), utf8Path);
+	return Find(utf8Path, utf8Length);
+}
+
+PathHandle Hail::PathTable::Find(const char* pUtf8Path, uint32 length) const
+{
+	char normalizedPath[MaxPathLength];
+	const uint32 normalizedLength = locNormalizePath(pUtf8Path, length, normalizedPath);
+	if (normalizedLength == 0u)
+		return InvalidPathHandle;
+
+	ScopedReadLock readLock(m_lock);
+	return FindNormalized(normalizedPath, normalizedLength, locHashPath(normalizedPath, normalizedLength));
+}
+
+PathView Hail::PathTable::GetPath(PathHandle handle) const
+{
+	const Entry& entry = GetEntry(handle);
+	PathView view;
+	view.m_pData = entry.m_pPath;
+	view.m_length = entry.m_length;
+	return view;
+}
+
+PathView Hail::PathTable::GetName(PathHandle handle) const
+{
+	const Entry& entry = GetEntry(handle);
+	const uint32 nameEnd = entry.m_extensionOffset == entry.m_length ? entry.m_length : entry.m_extensionOffset - 1u;
+	PathView view;
+	view.m_pData = entry.m_pPath + entry.m_nameOffset;
+	view.m_length = nameEnd - entry.m_nameOffset;
+	return view;
+}
+
+PathView Hail::PathTable::GetExtension(PathHandle handle) const
+{
+	const Entry& entry = GetEntry(handle);
+	PathView view;
+	view.m_pData = entry.m_pPath + entry.m_extensionOffset;
+	view.m_length = entry.m_length - entry.m_extensionOffset;
+	return view;
+}
+
+PathHandle Hail::PathTable::GetParent(PathHandle handle) const
+{
+	return GetEntry(handle).m_parent;
+}
+
+uint64 Hail::PathTable::GetHash(PathHandle handle) const
+{
+	return GetEntry(handle).m_hash;
+}
+
+bool Hail::PathTable::IsDirectory(PathHandle handle) const
+{
+	return GetEntry(handle).m_bIsDirectory;
+}
+
+FilePath Hail::PathTable::ToFilePath(PathHandle handle) const
+{
+	if (handle == InvalidPathHandle)
+		return FilePath();
+
+	const Entry& entry = GetEntry(handle);
+	wchar_t path[MAX_FILE_LENGTH];
+	uint32 length = locUtf8ToWide(entry.m_pPath, entry.m_length, path, MAX_FILE_LENGTH - 1u);
+	// FilePath marks directories with a trailing separator.
+	if (entry.m_bIsDirectory)
+	{
+		path[length++] = g_SourceSeparator;
+		path[length] = g_End;
+	}
+	return FilePath(path);
+}
+
+const PathTable::Entry& Hail::PathTable::GetEntry(PathHandle handle) const
+{
+	H_ASSERT(handle != InvalidPathHandle && handle <= m_numberOfEntries.load(std::memory_order_acquire), "Invalid path handle.");
+	const uint32 index = handle - 1u;
+	return m_pEntryPages[index / EntriesPerPage][index % EntriesPerPage];
+}
+
+PathHandle Hail::PathTable::InternNormalized(const char* pPath, uint32 length, bool bIsDirectory)
+{
+	const uint64 hash = locHashPath(pPath, length);
+	{
+		ScopedReadLock readLock(m_lock);
+		const PathHandle existingHandle = FindNormalized(pPath, length, hash);
+		if (existingHandle != InvalidPathHandle)
+			return existingHandle;
+	}
+
+	uint32 nameOffset = 0u;
+	for (uint32 i = 0; i < length; i++)
+	{
+		if (pPath[i] == '/')
+			nameOffset = i + 1u;
+	}
+
+	// The parents are interned first so every directory of a path gets a handle.
+	const PathHandle parent = nameOffset > 1u ? InternNormalized(pPath, nameOffset - 1u, true) : InvalidPathHandle;
+
+	uint32 extensionOffset = length;
+	if (!bIsDirectory)
+	{
+		for (uint32 i = length; i > nameOffset + 1u; i--)
+		{
+			if (pPath[i - 1u] == '.')
+			{
+				extensionOffset = i;
+				break;
+			}
+		}
+	}
+
+	ScopedWriteLock writeLock(m_lock);
+	// Another thread could have added the path while the lock was released.
+	const PathHandle existingHandle = FindNormalized(pPath, length, hash);
+	if (existingHandle != InvalidPathHandle)
+		return existingHandle;
+
+	const uint32 index = m_numberOfEntries.load(std::memory_order_relaxed);
+	const uint32 page = index / EntriesPerPage;
+	if (page == MaxNumberOfEntryPages)
+	{
+		H_ERROR("Path table is full, increase MaxNumberOfEntryPages.");
+		return InvalidPathHandle;
+	}
+	if (!m_pEntryPages[page])
+		m_pEntryPages[page] = new Entry[EntriesPerPage];
+
+	const char* pStoredPath = AllocateString(pPath, length);
+	if (!pStoredPath)
+		return InvalidPathHandle;
+
+	Entry& entry = m_pEntryPages[page][index % EntriesPerPage];
+	entry.m_hash = hash;
+	entry.m_pPath = pStoredPath;
+	entry.m_length = length;
+	entry.m_nameOffset = (uint16)nameOffset;
+	entry.m_extensionOffset = (uint16)extensionOffset;
+	entry.m_parent = parent;
+	entry.m_bIsDirectory = bIsDirectory;
+
+	const PathHandle handle = index + 1u;
+	const uint32 lookupMask = m_lookup.Size() - 1u;
+	uint32 slot = (uint32)hash & lookupMask;
+	while (m_lookup[slot] != InvalidPathHandle)
+		slot = (slot + 1u) & lookupMask;
+	m_lookup[slot] = handle;
+	m_numberOfEntries.store(handle, std::memory_order_release);
+
+	// Keep the lookup at most half full so the probing stays short.
+	if (handle * 2u > m_lookup.Size())
+		RebuildLookup(m_lookup.Size() * 2u);
+
+	return handle;
+}
+
+PathHandle Hail::PathTable::FindNormalized(const char* pPath, uint32 length, uint64 hash) const
+{
+	const uint32 lookupMask = m_lookup.Size() - 1u;
+	uint32 slot = (uint32)hash & lookupMask;
+	while (m_lookup[slot] != InvalidPathHandle)
+	{
+		const Entry& entry = GetEntry(m_lookup[slot]);
+		if (entry.m_hash == hash && entry.m_length == length && locIsSamePath(entry.m_pPath, pPath, length))
+			return m_lookup[slot];
+		slot = (slot + 1u) & lookupMask;
+	}
+	return InvalidPathHandle;
+}
+
+const char* Hail::PathTable::AllocateString(const char* pPath, uint32 length)
+{
+	if (m_stringPageOffset + length + 1u > StringPageSize)
+	{
+		if (m_numberOfStringPages == MaxNumberOfStringPages)
+		{
+			H_ERROR("Path table is out of string memory, increase MaxNumberOfStringPages.");
+			return nullptr;
+		}
+		m_pStringPages[m_numberOfStringPages++] = new char[StringPageSize];
+		m_stringPageOffset = 0u;
+	}
+
+	char* pStoredPath = m_pStringPages[m_numberOfStringPages - 1u] + m_stringPageOffset;
+	memcpy(pStoredPath, pPath, length);
+	pStoredPath[length] = '\0';
+	m_stringPageOffset += length + 1u;
+	return pStoredPath;
+}
+
+void Hail::PathTable::RebuildLookup(uint32 lookupSize)
+{
+	H_ASSERT((lookupSize & (lookupSize - 1u)) == 0u, "Lookup size must be a power of two");
+	// The table is only freed when the program exits, after the memory tracker has reported the leaks.
+	MemoryLeakExemptScope leakExemptScope;
+	m_lookup.RemoveAll();
+	m_lookup.PrepareAndFill(lookupSize);
+	for (uint32 i = 0; i < lookupSize; i++)
+		m_lookup[i] = InvalidPathHandle;
+
+	const uint32 lookupMask = lookupSize - 1u;
+	const uint32 numberOfEntries = m_numberOfEntries.load(std::memory_order_relaxed);
+	for (uint32 iEntry = 0; iEntry < numberOfEntries; iEntry++)
+	{
+		uint32 slot = (uint32)GetEntry(iEntry + 1u).m_hash & lookupMask;
+		while (m_lookup[slot] != InvalidPathHandle)
+			slot = (slot + 1u) & lookupMask;
+		m_lookup[slot] = iEntry + 1u;
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "Types.h"
+#include "Threading.h"
+#include "Containers\GrowingArray\GrowingArray.h"
+
+namespace Hail
+{
+	class FilePath;
+
+	// Handle to an interned path, 0 is an invalid handle.
+	using PathHandle = uint32;
+	constexpr PathHandle InvalidPathHandle = 0u;
+
+	// UTF-8 view in to the path table, not null terminated unless it is the full path.
+	struct PathView
+	{
+		const char* m_pData = nullptr;
+		uint32 m_length = 0u;
+	};
+
+	// Table of unique normalized paths stored as UTF-8, paths are referred to by a 32 bit handle so
+	// registries and iterators can store and compare paths as integers instead of copying FilePaths.
+	// Paths are normalized to '/' separators without a trailing separator and are compared case insensitive.
+	// Interned paths are never removed, so handles and views stay valid for the lifetime of the program. Thread safe.
+	class PathTable
+	{
+	public:
+		// Created on first use, as the tools use the file iterators without initializing the engine.
+		static PathTable& GetInstance();
+
+		PathHandle Intern(const FilePath& path);
+		PathHandle Intern(const wchar_t* pPath, uint32 length, bool bIsDirectory);
+		PathHandle Intern(const char* pUtf8Path, uint32 length, bool bIsDirectory);
+		// Returns InvalidPathHandle if the path has not been interned.
+		PathHandle Find(const FilePath& path) const;
+		PathHandle Find(const char* pUtf8Path, uint32 length) const;
+
+		// Full path, is null terminated.
+		PathView GetPath(PathHandle handle) const;
+		// Name of the file or directory without the extension.
+		PathView GetName(PathHandle handle) const;
+		// Extension without the dot, empty for directories.
+		PathView GetExtension(PathHandle handle) const;
+		// The handle of the directory of the path, invalid for a root.
+		PathHandle GetParent(PathHandle handle) const;
+		uint64 GetHash(PathHandle handle) const;
+		bool IsDirectory(PathHandle handle) const;
+		FilePath ToFilePath(PathHandle handle) const;
+		uint32 GetNumberOfPaths() const { return m_numberOfEntries.load(std::memory_order_acquire); }
+
+		static constexpr uint32 MaxPathLength = 1024u;
+
+	private:
+		PathTable();
+		~PathTable();
+
+		struct Entry
+		{
+			uint64 m_hash;
+			const char* m_pPath;
+			uint32 m_length;
+			uint16 m_nameOffset;
+			uint16 m_extensionOffset;
+			PathHandle m_parent;
+			bool m_bIsDirectory;
+		};
+
+		// Entries and strings are stored in pages that never move, so a handle can be read without locking.
+		static constexpr uint32 EntriesPerPage = 1024u;
+		static constexpr uint32 MaxNumberOfEntryPages = 1024u;
+		static constexpr uint32 StringPageSize = 64u * 1024u;
+		static constexpr uint32 MaxNumberOfStringPages = 1024u;
+
+		const Entry& GetEntry(PathHandle handle) const;
+		// Expects a normalized path.
+		PathHandle InternNormalized(const char* pPath, uint32 length, bool bIsDirectory);
+		PathHandle FindNormalized(const char* pPath, uint32 length, uint64 hash) const;
+		const char* AllocateString(const char* pPath, uint32 length);
+		void RebuildLookup(uint32 lookupSize);
+
+		mutable ReadWriteLock m_lock;
+		Entry* m_pEntryPages[MaxNumberOfEntryPages];
+		char* m_pStringPages[MaxNumberOfStringPages];
+		uint32 m_numberOfStringPages = 0u;
+		uint32 m_stringPageOffset = StringPageSize;
+		std::atomic_uint32_t m_numberOfEntries{ 0u };
+		// Open addressed table of handles, 0 is an empty slot. Size is a power of two.
+		GrowingArray<PathHandle> m_lookup;
+	};
+}
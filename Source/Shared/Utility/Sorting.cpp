@@ -3,8 +3,6 @@
 
 #include "Engine/RenderCommands.h"
 
-#include "Engine/Rendering/CloudParticleSimulator.h"
-
 using namespace Hail;
 
 
@@ -66,22 +64,4 @@ void Sorting::LinearBubbleTextDepth(GameCommand_Text** pListToSort, uint32 listC
 			}
 		}
 	}
-}
-
-void Sorting::LinearBubbleParticleLookup(SpatialIndexLookup** pListToSort, uint32 listCapacity)
-{
-	for (int i = 0; i < listCapacity - 1; i++)
-	{
-		// Last i elements are already in place
-		for (int j = 0; j < listCapacity - i - 1; j++)
-		{
-			// Comparing adjacent elements
-			if ((*pListToSort)[j].cellKey > (*pListToSort)[j + 1].cellKey)
-			{
-				const SpatialIndexLookup jVal = (*pListToSort)[j];
-				(*pListToSort)[j] = (*pListToSort)[j + 1];
-				(*pListToSort)[j + 1] = jVal;
-			}
-		}
-	}
 }
\ No newline at end of file
@@ -7,6 +7,12 @@
 #include "CDT\CDT.h"
 
 #include "glm\geometric.hpp"
+#include "Hashing\MemoryHash.h"
+#include "MemoryTracker.h"
+#include <algorithm> // std::stable_sort
+#include <atomic>
+#include <thread>
+#include <vector>
 using namespace Hail;
 
 namespace
@@ -422,8 +428,8 @@ namespace
 		}
 
 
-		std::vector<CDT::V2d<float>> points;
-		std::vector<CDT::Edge> edges;
+		CDT::vector<CDT::V2d<float>> points;
+		CDT::vector<CDT::Edge> edges;
 
 		GrowingArray<GrowingArray<Edge>> spanOfEdges;
 
@@ -456,8 +462,8 @@ namespace
 
 		//Remove all tris that contain offCurve vertices, and remap edges.
 		// Create mesh without any off-edges with these vectors
-		std::vector<CDT::V2d<float>> pointsOnCurve;
-		std::vector<CDT::Edge> edgesWithoutOffCurveVerts;
+		CDT::vector<CDT::V2d<float>> pointsOnCurve;
+		CDT::vector<CDT::Edge> edgesWithoutOffCurveVerts;
 
 		// cached offedge information for final mesh
 		GrowingArray<uint16> endPtsWithoutOffEdges;
@@ -566,7 +572,7 @@ namespace
 		GrowingArray<GrowingArray<GlyphCoord>> finalCoords;
 
 		// Loop over all coords to move the ones that are overlapping with convex triangles
-		std::vector<CDT::V2d<float>> pointsInFinalTriangulation;
+		CDT::vector<CDT::V2d<float>> pointsInFinalTriangulation;
 		startIndex = 0;
 		for (int iSpan = 0; iSpan < endPts.Size(); iSpan++)
 		{
@@ -638,7 +644,7 @@ namespace
 			finalEndPoints.Add(previousEndPoint + (finalCoords[i].Size() - 1) + i);
 			previousEndPoint = previousEndPoint + (finalCoords[i].Size() - 1);
 		}
-		std::vector<CDT::Edge> edgesOfFinalTriangulation;
+		CDT::vector<CDT::Edge> edgesOfFinalTriangulation;
 		startIndex = 0;
 		for (int iSpan = 0; iSpan < finalEndPoints.Size(); iSpan++)
 		{
@@ -1077,19 +1083,534 @@ namespace
 		return maxUnicodeValue;
 	}
 
+	// Each set bit in the lower byte of a GPOS value format is one 16 bit field in the value record.
+	uint32 GetValueRecordSize(uint16 valueFormat)
+	{
+		uint32 size = 0;
+		for (uint16 bit = 0; bit < 8; bit++)
+		{
+			if (valueFormat & (1 << bit))
+				size += sizeof(uint16);
+		}
+		return size;
+	}
+
+	int16 ReadValueRecordXAdvance(char* pMemory, uint32 offset, uint16 valueFormat)
+	{
+		constexpr uint16 xPlacementFlag = 0x1;
+		constexpr uint16 yPlacementFlag = 0x2;
+		constexpr uint16 xAdvanceFlag = 0x4;
+		if ((valueFormat & xAdvanceFlag) == 0)
+			return 0;
+
+		if (valueFormat & xPlacementFlag)
+			offset += sizeof(int16);
+		if (valueFormat & yPlacementFlag)
+			offset += sizeof(int16);
+		return ReadInt16(pMemory, offset);
+	}
+
+	// Fills the list with the glyph IDs of the coverage table in coverage index order.
+	void ReadCoverage(char* pCoverage, GrowingArray<uint16>& outGlyphs)
+	{
+		outGlyphs.RemoveAll();
+		uint32 offset = 0;
+		const uint16 coverageFormat = ReadUint16Move(pCoverage, offset);
+		if (coverageFormat == 1)
+		{
+			const uint16 glyphCount = ReadUint16Move(pCoverage, offset);
+			for (uint16 i = 0; i < glyphCount; i++)
+				outGlyphs.Add(ReadUint16Move(pCoverage, offset));
+		}
+		else if (coverageFormat == 2)
+		{
+			const uint16 rangeCount = ReadUint16Move(pCoverage, offset);
+			for (uint16 i = 0; i < rangeCount; i++)
+			{
+				const uint16 startGlyphID = ReadUint16Move(pCoverage, offset);
+				const uint16 endGlyphID = ReadUint16Move(pCoverage, offset);
+				offset += sizeof(uint16); // startCoverageIndex, ranges are stored in coverage order
+				for (uint32 glyphID = startGlyphID; glyphID <= endGlyphID; glyphID++)
+					outGlyphs.Add((uint16)glyphID);
+			}
+		}
+	}
+
+	// Glyphs not in the class definition are left untouched, so fill the list with class 0 first.
+	void ReadClassDef(char* pClassDef, GrowingArray<uint16>& glyphClassesToFill)
+	{
+		uint32 offset = 0;
+		const uint16 classFormat = ReadUint16Move(pClassDef, offset);
+		if (classFormat == 1)
+		{
+			const uint16 startGlyphID = ReadUint16Move(pClassDef, offset);
+			const uint16 glyphCount = ReadUint16Move(pClassDef, offset);
+			for (uint32 i = 0; i < glyphCount; i++)
+			{
+				const uint16 glyphClass = ReadUint16Move(pClassDef, offset);
+				if (startGlyphID + i < glyphClassesToFill.Size())
+					glyphClassesToFill[startGlyphID + i] = glyphClass;
+			}
+		}
+		else if (classFormat == 2)
+		{
+			const uint16 rangeCount = ReadUint16Move(pClassDef, offset);
+			for (uint16 i = 0; i < rangeCount; i++)
+			{
+				const uint16 startGlyphID = ReadUint16Move(pClassDef, offset);
+				const uint16 endGlyphID = ReadUint16Move(pClassDef, offset);
+				const uint16 glyphClass = ReadUint16Move(pClassDef, offset);
+				for (uint32 glyphID = startGlyphID; glyphID <= endGlyphID && glyphID < glyphClassesToFill.Size(); glyphID++)
+					glyphClassesToFill[glyphID] = glyphClass;
+			}
+		}
+	}
+
+	void ReadKernTable(char* pKern, GrowingArray<KerningPair>& outPairs)
+	{
+		uint32 offset = 0;
+		const uint16 version = ReadUint16Move(pKern, offset);
+		// Only the Microsoft version 0 table is supported, the Apple table starts with a 32 bit version of 1.
+		if (version != 0)
+			return;
+
+		const uint16 numberOfSubtables = ReadUint16Move(pKern, offset);
+		for (uint16 iSubtable = 0; iSubtable < numberOfSubtables; iSubtable++)
+		{
+			uint32 subtableOffset = offset + sizeof(uint16); // skip the subtable version
+			const uint16 length = ReadUint16Move(pKern, subtableOffset);
+			const uint16 coverage = ReadUint16Move(pKern, subtableOffset);
+			offset += length;
+
+			const bool bIsHorizontal = coverage & 0x1;
+			const bool bIsMinimum = coverage & 0x2;
+			const bool bIsCrossStream = coverage & 0x4;
+			const uint16 format = coverage >> 8;
+			if (format != 0 || !bIsHorizontal || bIsMinimum || bIsCrossStream)
+				continue;
+
+			const uint16 numberOfPairs = ReadUint16Move(pKern, subtableOffset);
+			subtableOffset += sizeof(uint16) * 3; // searchRange, entrySelector, rangeShift
+			for (uint16 iPair = 0; iPair < numberOfPairs; iPair++)
+			{
+				const uint16 left = ReadUint16Move(pKern, subtableOffset);
+				const uint16 right = ReadUint16Move(pKern, subtableOffset);
+				KerningPair pair;
+				pair.m_glyphPair = ((uint32)left << 16) | right;
+				pair.m_value = ReadInt16Move(pKern, subtableOffset);
+				outPairs.Add(pair);
+			}
+		}
+	}
+
+	void ReadGposPairAdjustment(char* pSubtable, uint16 numberOfGlyphs, TTF_FontStruct& font)
+	{
+		uint32 offset = 0;
+		const uint16 posFormat = ReadUint16Move(pSubtable, offset);
+		const uint16 coverageOffset = ReadUint16Move(pSubtable, offset);
+		const uint16 valueFormat1 = ReadUint16Move(pSubtable, offset);
+		const uint16 valueFormat2 = ReadUint16Move(pSubtable, offset);
+		const uint32 valueRecord1Size = GetValueRecordSize(valueFormat1);
+		const uint32 valueRecord2Size = GetValueRecordSize(valueFormat2);
+
+		GrowingArray<uint16> coverageGlyphs;
+		ReadCoverage(pSubtable + coverageOffset, coverageGlyphs);
+
+		if (posFormat == 1)
+		{
+			const uint16 pairSetCount = ReadUint16Move(pSubtable, offset);
+			for (uint16 iPairSet = 0; iPairSet < pairSetCount && iPairSet < coverageGlyphs.Size(); iPairSet++)
+			{
+				char* pPairSet = pSubtable + ReadUint16Move(pSubtable, offset);
+				uint32 pairOffset = 0;
+				const uint16 pairValueCount = ReadUint16Move(pPairSet, pairOffset);
+				for (uint16 iPair = 0; iPair < pairValueCount; iPair++)
+				{
+					const uint16 secondGlyph = ReadUint16Move(pPairSet, pairOffset);
+					const int16 xAdvance = ReadValueRecordXAdvance(pPairSet, pairOffset, valueFormat1);
+					pairOffset += valueRecord1Size + valueRecord2Size;
+					if (xAdvance == 0)
+						continue;
+
+					KerningPair pair;
+					pair.m_glyphPair = ((uint32)coverageGlyphs[iPairSet] << 16) | secondGlyph;
+					pair.m_value = xAdvance;
+					font.m_kerningPairs.Add(pair);
+				}
+			}
+		}
+		else if (posFormat == 2)
+		{
+			const uint16 classDef1Offset = ReadUint16Move(pSubtable, offset);
+			const uint16 classDef2Offset = ReadUint16Move(pSubtable, offset);
+			const uint16 class1Count = ReadUint16Move(pSubtable, offset);
+			const uint16 class2Count = ReadUint16Move(pSubtable, offset);
+
+			KerningClassTable& classTable = font.m_kerningClassTables.Add();
+			classTable.m_numberOfSecondClasses = class2Count;
+
+			// Glyphs in the coverage that are not in the first class definition belong to class 0.
+			GrowingArray<uint16> firstClasses(numberOfGlyphs, 0u);
+			ReadClassDef(pSubtable + classDef1Offset, firstClasses);
+			classTable.m_firstGlyphClass.PrepareAndFill(numberOfGlyphs);
+			for (uint32 i = 0; i < numberOfGlyphs; i++)
+				classTable.m_firstGlyphClass[i] = KerningClassTable::InvalidClass;
+			for (uint32 i = 0; i < coverageGlyphs.Size(); i++)
+			{
+				if (coverageGlyphs[i] < numberOfGlyphs)
+					classTable.m_firstGlyphClass[coverageGlyphs[i]] = firstClasses[coverageGlyphs[i]];
+			}
+
+			classTable.m_secondGlyphClass.PrepareAndFill(numberOfGlyphs);
+			for (uint32 i = 0; i < numberOfGlyphs; i++)
+				classTable.m_secondGlyphClass[i] = 0;
+			ReadClassDef(pSubtable + classDef2Offset, classTable.m_secondGlyphClass);
+
+			classTable.m_values.PrepareAndFill(class1Count * class2Count);
+			for (uint32 iClass1 = 0; iClass1 < class1Count; iClass1++)
+			{
+				for (uint32 iClass2 = 0; iClass2 < class2Count; iClass2++)
+				{
+					classTable.m_values[iClass1 * class2Count + iClass2] = ReadValueRecordXAdvance(pSubtable, offset, valueFormat1);
+					offset += valueRecord1Size + valueRecord2Size;
+				}
+			}
+		}
+	}
+
+	// Only the pair adjustment lookups are read, these are what the kern feature of a font is built from.
+	void ReadGposTable(char* pGpos, uint16 numberOfGlyphs, TTF_FontStruct& font)
+	{
+		constexpr uint16 pairAdjustmentLookupType = 2;
+		constexpr uint16 extensionLookupType = 9;
+
+		uint32 offset = 0;
+		const uint16 majorVersion = ReadUint16Move(pGpos, offset);
+		if (majorVersion != 1)
+			return;
+		offset += sizeof(uint16) * 3; // minorVersion, scriptListOffset, featureListOffset
+		const uint16 lookupListOffset = ReadUint16Move(pGpos, offset);
+
+		char* pLookupList = pGpos + lookupListOffset;
+		uint32 lookupListReadOffset = 0;
+		const uint16 lookupCount = ReadUint16Move(pLookupList, lookupListReadOffset);
+		for (uint16 iLookup = 0; iLookup < lookupCount; iLookup++)
+		{
+			char* pLookup = pLookupList + ReadUint16Move(pLookupList, lookupListReadOffset);
+			uint32 lookupOffset = 0;
+			const uint16 lookupType = ReadUint16Move(pLookup, lookupOffset);
+			lookupOffset += sizeof(uint16); // lookupFlag
+			const uint16 subTableCount = ReadUint16Move(pLookup, lookupOffset);
+			for (uint16 iSubtable = 0; iSubtable < subTableCount; iSubtable++)
+			{
+				char* pSubtable = pLookup + ReadUint16Move(pLookup, lookupOffset);
+				if (lookupType == pairAdjustmentLookupType)
+				{
+					ReadGposPairAdjustment(pSubtable, numberOfGlyphs, font);
+				}
+				else if (lookupType == extensionLookupType && ReadUint16(pSubtable, 2) == pairAdjustmentLookupType)
+				{
+					ReadGposPairAdjustment(pSubtable + ReadUint32(pSubtable, 4), numberOfGlyphs, font);
+				}
+			}
+		}
+	}
+
+	// Glyphs are triangulated in chunks, every chunk has its own output so the workers never share any data.
+	constexpr uint32 g_glyphsPerChunk = 32u;
+
 	TTF_FontStruct::GlyphData ParseGlyphs(char* pFontMemory, const GrowingArray<uint32>& glyphOffsets, Table glyfTable)
 	{
+		char* pGlyfTable = pFontMemory + glyfTable.offset;
+		const uint32 numberOfGlyphs = glyphOffsets.Size();
+		const uint32 numberOfChunks = (numberOfGlyphs + g_glyphsPerChunk - 1) / g_glyphsPerChunk;
+
+		GrowingArray<TTF_FontStruct::GlyphData> chunks(numberOfChunks);
+		for (uint32 iChunk = 0; iChunk < numberOfChunks; iChunk++)
+		{
+			TTF_FontStruct::GlyphData& chunk = chunks.Add();
+			chunk.m_maxNumbOfPrimitivesForGlyphs = 0;
+			chunk.m_maxNumbOfVerticesForGlyphs = 0;
+		}
+
+		std::atomic_uint32_t nextChunk = 0;
+		auto parseChunks = [&]()
+		{
+			// The workers do not inherit the tag of the calling thread.
+			H_MEMORY_TAG_SCOPE(eMemoryTag::Resources);
+			uint32 iChunk;
+			while ((iChunk = nextChunk.fetch_add(1)) < numberOfChunks)
+			{
+				TTF_FontStruct::GlyphData& chunk = chunks[iChunk];
+				const uint32 lastGlyph = Math::Min((iChunk + 1) * g_glyphsPerChunk, numberOfGlyphs);
+				for (uint32 iGlyph = iChunk * g_glyphsPerChunk; iGlyph < lastGlyph; iGlyph++)
+				{
+					chunk.m_glyphs.Add(ParseGlyph(pGlyfTable, glyphOffsets, glyphOffsets[iGlyph], chunk.m_compoundGlyphs, chunk.m_verts, chunk.m_triangles, chunk.m_maxNumbOfVerticesForGlyphs, chunk.m_maxNumbOfPrimitivesForGlyphs, GlyphTransform()));
+				}
+			}
+		};
+
+		// The calling thread works on the chunks as well.
+		const uint32 numberOfWorkers = Math::Min(Math::Max(std::thread::hardware_concurrency(), 1u), numberOfChunks);
+		std::vector<std::thread> workers;
+		for (uint32 iWorker = 1; iWorker < numberOfWorkers; iWorker++)
+		{
+			workers.emplace_back(parseChunks);
+		}
+		parseChunks();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+
+		// Merge the chunks in glyph order, all offsets in a chunk are local to the chunk and gets moved to the final arrays.
 		TTF_FontStruct::GlyphData glyphData;
 		glyphData.m_maxNumbOfPrimitivesForGlyphs = 0;
 		glyphData.m_maxNumbOfVerticesForGlyphs = 0;
-		//uint32 currentGlyph = 0;
-		for (uint32 iGlyph = 0; iGlyph < glyphOffsets.Size(); iGlyph++)
+		uint32 totalNumberOfCompounds = 0;
+		uint32 totalNumberOfVerts = 0;
+		uint32 totalNumberOfTriangles = 0;
+		for (uint32 iChunk = 0; iChunk < numberOfChunks; iChunk++)
 		{
-			glyphData.m_glyphs.Add(ParseGlyph(pFontMemory + glyfTable.offset, glyphOffsets, glyphOffsets[iGlyph], glyphData.m_compoundGlyphs, glyphData.m_verts, glyphData.m_triangles, glyphData.m_maxNumbOfVerticesForGlyphs, glyphData.m_maxNumbOfPrimitivesForGlyphs, GlyphTransform()));
+			totalNumberOfCompounds += chunks[iChunk].m_compoundGlyphs.Size();
+			totalNumberOfVerts += chunks[iChunk].m_verts.Size();
+			totalNumberOfTriangles += chunks[iChunk].m_triangles.Size();
+		}
+		glyphData.m_glyphs.Prepare(Math::Max(numberOfGlyphs, 1u));
+		glyphData.m_compoundGlyphs.Prepare(Math::Max(totalNumberOfCompounds, 1u));
+		glyphData.m_verts.Prepare(Math::Max(totalNumberOfVerts, 1u));
+		glyphData.m_triangles.Prepare(Math::Max(totalNumberOfTriangles, 1u));
+
+		for (uint32 iChunk = 0; iChunk < numberOfChunks; iChunk++)
+		{
+			const TTF_FontStruct::GlyphData& chunk = chunks[iChunk];
+			const uint32 compoundBase = glyphData.m_compoundGlyphs.Size();
+			const uint32 vertexBase = glyphData.m_verts.Size();
+			const uint32 triangleBase = glyphData.m_triangles.Size();
+
+			auto rebaseGlyph = [&](Glyph glyph)
+			{
+				if (glyph.m_bIsSimpleGlyph)
+				{
+					glyph.m_vertexOffset += vertexBase;
+					glyph.m_indexOffset += triangleBase;
+				}
+				else
+				{
+					glyph.m_vertexOffset += compoundBase;
+				}
+				return glyph;
+			};
+
+			for (uint32 i = 0; i < chunk.m_glyphs.Size(); i++)
+				glyphData.m_glyphs.Add(rebaseGlyph(chunk.m_glyphs[i]));
+
+			for (uint32 i = 0; i < chunk.m_compoundGlyphs.Size(); i++)
+				glyphData.m_compoundGlyphs.Add(rebaseGlyph(chunk.m_compoundGlyphs[i]));
+
+			for (uint32 i = 0; i < chunk.m_verts.Size(); i++)
+				glyphData.m_verts.Add(chunk.m_verts[i]);
+
+			for (uint32 i = 0; i < chunk.m_triangles.Size(); i++)
+			{
+				GlyphTri& triangle = glyphData.m_triangles.Add(chunk.m_triangles[i]);
+				for (uint32 t = 0; t < 3; t++)
+				{
+					triangle.indices[t] += vertexBase;
+				}
+			}
+
+			glyphData.m_maxNumbOfVerticesForGlyphs = Math::Max(glyphData.m_maxNumbOfVerticesForGlyphs, chunk.m_maxNumbOfVerticesForGlyphs);
+			glyphData.m_maxNumbOfPrimitivesForGlyphs = Math::Max(glyphData.m_maxNumbOfPrimitivesForGlyphs, chunk.m_maxNumbOfPrimitivesForGlyphs);
 		}
 		return glyphData;
 	}
 
+	// Compiled font asset, the header is followed by all arrays in the order of the counts in the header.
+	// Every kerning class table is stored as three uint32 counts, the number of second classes and then its arrays.
+	constexpr uint32 g_compiledFontIdentifier = 0x544e4648; // "HFNT"
+	constexpr uint32 g_compiledFontVersion = 1u;
+
+	struct CompiledFontHeader
+	{
+		uint32 m_identifier;
+		uint32 m_version;
+		uint64 m_sourceHash;
+		// Sizes of the structs that are stored as raw memory, a change in layout invalidates the file.
+		uint32 m_glyphSize;
+		uint32 m_glyphTriSize;
+		uint32 m_kerningPairSize;
+		uint32 m_padding;
+		glm::ivec2 m_minGlyphBB;
+		glm::ivec2 m_maxGlyphBB;
+		glm::ivec2 m_glyphExtents;
+		uint16 m_maxNumbOfVerticesForGlyphs;
+		uint16 m_maxNumbOfPrimitivesForGlyphs;
+		uint32 m_numberOfGlyphs;
+		uint32 m_numberOfCompoundGlyphs;
+		uint32 m_numberOfVerts;
+		uint32 m_numberOfTriangles;
+		uint32 m_numberOfRenderVerts;
+		uint32 m_numberOfUnicodeMappings;
+		uint32 m_numberOfKerningPairs;
+		uint32 m_numberOfKerningClassTables;
+	};
+
+	template<typename T>
+	void WriteCompiledArray(InOutStream& stream, const GrowingArray<T>& arrayToWrite)
+	{
+		if (!arrayToWrite.Empty())
+			stream.Write(arrayToWrite.Data(), sizeof(T), arrayToWrite.Size());
+	}
+
+	class CompiledFontReader
+	{
+	public:
+		CompiledFontReader(const uint8* pData, size_t size) : m_pData(pData), m_size(size), m_position(0) {}
+
+		template<typename T>
+		bool Read(T& valueOut)
+		{
+			if (m_position + sizeof(T) > m_size)
+				return false;
+			memcpy(&valueOut, m_pData + m_position, sizeof(T));
+			m_position += sizeof(T);
+			return true;
+		}
+
+		template<typename T>
+		bool ReadArray(GrowingArray<T>& arrayOut, uint32 numberOfElements)
+		{
+			const size_t sizeOfArray = sizeof(T) * numberOfElements;
+			if (m_position + sizeOfArray > m_size)
+				return false;
+			if (numberOfElements == 0)
+				return true;
+			arrayOut.PrepareAndFill(numberOfElements);
+			memcpy(arrayOut.Data(), m_pData + m_position, sizeOfArray);
+			m_position += sizeOfArray;
+			return true;
+		}
+
+		bool IsAtEnd() const { return m_position == m_size; }
+
+	private:
+		const uint8* m_pData;
+		size_t m_size;
+		size_t m_position;
+	};
+
+	bool LoadCompiledFont(const FilePath& compiledFontPath, uint64 sourceHash, TTF_FontStruct& fontOut)
+	{
+		InOutStream stream;
+		if (!stream.OpenFile(compiledFontPath, FILE_OPEN_TYPE::READ, true))
+			return false;
+
+		// The whole asset is read with one call and the arrays are copied straight out of the buffer.
+		GrowingArray<uint8> fileBuffer;
+		const size_t fileSize = stream.GetFileSize();
+		if (fileSize < sizeof(CompiledFontHeader))
+			return false;
+		fileBuffer.PrepareAndFill(fileSize);
+		if (!stream.Read(fileBuffer.Data(), fileSize))
+			return false;
+		stream.CloseFile();
+
+		CompiledFontReader reader(fileBuffer.Data(), fileSize);
+		CompiledFontHeader header;
+		reader.Read(header);
+		if (header.m_identifier != g_compiledFontIdentifier || header.m_version != g_compiledFontVersion || header.m_sourceHash != sourceHash ||
+			header.m_glyphSize != sizeof(Glyph) || header.m_glyphTriSize != sizeof(GlyphTri) || header.m_kerningPairSize != sizeof(KerningPair))
+			return false;
+
+		TTF_FontStruct font;
+		font.minGlyphBB = header.m_minGlyphBB;
+		font.maxGlyphBB = header.m_maxGlyphBB;
+		font.m_glyphExtents = header.m_glyphExtents;
+		font.m_glyphData.m_maxNumbOfVerticesForGlyphs = header.m_maxNumbOfVerticesForGlyphs;
+		font.m_glyphData.m_maxNumbOfPrimitivesForGlyphs = header.m_maxNumbOfPrimitivesForGlyphs;
+
+		bool bValid = reader.ReadArray(font.m_glyphData.m_glyphs, header.m_numberOfGlyphs)
+			&& reader.ReadArray(font.m_glyphData.m_compoundGlyphs, header.m_numberOfCompoundGlyphs)
+			&& reader.ReadArray(font.m_glyphData.m_verts, header.m_numberOfVerts)
+			&& reader.ReadArray(font.m_glyphData.m_triangles, header.m_numberOfTriangles)
+			&& reader.ReadArray(font.m_renderVerts, header.m_numberOfRenderVerts)
+			&& reader.ReadArray(font.m_uniCodeToGlyphID, header.m_numberOfUnicodeMappings)
+			&& reader.ReadArray(font.m_kerningPairs, header.m_numberOfKerningPairs);
+
+		for (uint32 iTable = 0; bValid && iTable < header.m_numberOfKerningClassTables; iTable++)
+		{
+			KerningClassTable& classTable = font.m_kerningClassTables.Add();
+			uint32 numberOfFirstClasses = 0;
+			uint32 numberOfSecondClasses = 0;
+			uint32 numberOfValues = 0;
+			bValid = reader.Read(numberOfFirstClasses) && reader.Read(numberOfSecondClasses) && reader.Read(numberOfValues) && reader.Read(classTable.m_numberOfSecondClasses)
+				&& reader.ReadArray(classTable.m_firstGlyphClass, numberOfFirstClasses)
+				&& reader.ReadArray(classTable.m_secondGlyphClass, numberOfSecondClasses)
+				&& reader.ReadArray(classTable.m_values, numberOfValues);
+		}
+
+		if (!bValid || !reader.IsAtEnd())
+		{
+			H_WARNING("Compiled font asset is corrupt, parsing the source font instead.");
+			return false;
+		}
+
+		fontOut = std::move(font);
+		return true;
+	}
+
+	void SaveCompiledFont(const FilePath& compiledFontPath, uint64 sourceHash, const TTF_FontStruct& font)
+	{
+		InOutStream stream;
+		if (!stream.OpenFile(compiledFontPath, FILE_OPEN_TYPE::WRITE, true))
+		{
+			H_WARNING("Failed to write the compiled font asset.");
+			return;
+		}
+
+		CompiledFontHeader header;
+		memset(&header, 0, sizeof(CompiledFontHeader));
+		header.m_identifier = g_compiledFontIdentifier;
+		header.m_version = g_compiledFontVersion;
+		header.m_sourceHash = sourceHash;
+		header.m_glyphSize = sizeof(Glyph);
+		header.m_glyphTriSize = sizeof(GlyphTri);
+		header.m_kerningPairSize = sizeof(KerningPair);
+		header.m_minGlyphBB = font.minGlyphBB;
+		header.m_maxGlyphBB = font.maxGlyphBB;
+		header.m_glyphExtents = font.m_glyphExtents;
+		header.m_maxNumbOfVerticesForGlyphs = font.m_glyphData.m_maxNumbOfVerticesForGlyphs;
+		header.m_maxNumbOfPrimitivesForGlyphs = font.m_glyphData.m_maxNumbOfPrimitivesForGlyphs;
+		header.m_numberOfGlyphs = font.m_glyphData.m_glyphs.Size();
+		header.m_numberOfCompoundGlyphs = font.m_glyphData.m_compoundGlyphs.Size();
+		header.m_numberOfVerts = font.m_glyphData.m_verts.Size();
+		header.m_numberOfTriangles = font.m_glyphData.m_triangles.Size();
+		header.m_numberOfRenderVerts = font.m_renderVerts.Size();
+		header.m_numberOfUnicodeMappings = font.m_uniCodeToGlyphID.Size();
+		header.m_numberOfKerningPairs = font.m_kerningPairs.Size();
+		header.m_numberOfKerningClassTables = font.m_kerningClassTables.Size();
+		stream.Write(&header, sizeof(CompiledFontHeader));
+
+		WriteCompiledArray(stream, font.m_glyphData.m_glyphs);
+		WriteCompiledArray(stream, font.m_glyphData.m_compoundGlyphs);
+		WriteCompiledArray(stream, font.m_glyphData.m_verts);
+		WriteCompiledArray(stream, font.m_glyphData.m_triangles);
+		WriteCompiledArray(stream, font.m_renderVerts);
+		WriteCompiledArray(stream, font.m_uniCodeToGlyphID);
+		WriteCompiledArray(stream, font.m_kerningPairs);
+
+		for (uint32 iTable = 0; iTable < font.m_kerningClassTables.Size(); iTable++)
+		{
+			const KerningClassTable& classTable = font.m_kerningClassTables[iTable];
+			const uint32 counts[3] = { classTable.m_firstGlyphClass.Size(), classTable.m_secondGlyphClass.Size(), classTable.m_values.Size() };
+			stream.Write(counts, sizeof(uint32), 3);
+			stream.Write(&classTable.m_numberOfSecondClasses, sizeof(uint16));
+			WriteCompiledArray(stream, classTable.m_firstGlyphClass);
+			WriteCompiledArray(stream, classTable.m_secondGlyphClass);
+			WriteCompiledArray(stream, classTable.m_values);
+		}
+	}
 }
 
 TTF_FontStruct Hail::TTF_ParseFontFile(const char* aFileToParse)
@@ -1098,11 +1619,51 @@ TTF_FontStruct Hail::TTF_ParseFontFile(const char* aFileToParse)
 	if (!readStream.OpenFile(FilePath(aFileToParse), FILE_OPEN_TYPE::READ, true))
 	{
 		H_ERROR(StringL::Format("Failed to open fontfile %s:", aFileToParse));
+		return TTF_FontStruct();
 	}
-	char* pFontMemory = new char[readStream.GetFileSize()];
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Resources);
+	char* pFontMemory = (char*)H_TRACKED_ALLOCATE(readStream.GetFileSize(), alignof(char), eMemoryTag::Resources);
 	readStream.Read(pFontMemory, readStream.GetFileSize());
 	readStream.CloseFile();
 
+	TTF_FontStruct font = TTF_ParseFontMemory(pFontMemory);
+	MemoryTracker::Deallocate(pFontMemory);
+	return font;
+}
+
+TTF_FontStruct Hail::TTF_LoadFont(const char* aFileToLoad)
+{
+	const FilePath sourceFontPath = FilePath(aFileToLoad);
+	InOutStream readStream;
+	if (!readStream.OpenFile(sourceFontPath, FILE_OPEN_TYPE::READ, true))
+	{
+		H_ERROR(StringL::Format("Failed to open fontfile %s:", aFileToLoad));
+		return TTF_FontStruct();
+	}
+	const size_t fontFileSize = readStream.GetFileSize();
+	H_MEMORY_TAG_SCOPE(eMemoryTag::Resources);
+	char* pFontMemory = (char*)H_TRACKED_ALLOCATE(fontFileSize, alignof(char), eMemoryTag::Resources);
+	readStream.Read(pFontMemory, fontFileSize);
+	readStream.CloseFile();
+
+	// The compiled asset is stored next to the source font, with the hash of the source font so edits to the font are picked up.
+	StringL compiledFontPath = aFileToLoad;
+	compiledFontPath += ".hfnt";
+	const uint64 sourceHash = HashMemory(pFontMemory, fontFileSize);
+
+	TTF_FontStruct font;
+	if (!LoadCompiledFont(FilePath(compiledFontPath.Data()), sourceHash, font))
+	{
+		font = TTF_ParseFontMemory(pFontMemory);
+		if (!font.m_renderVerts.Empty())
+			SaveCompiledFont(FilePath(compiledFontPath.Data()), sourceHash, font);
+	}
+	MemoryTracker::Deallocate(pFontMemory);
+	return font;
+}
+
+TTF_FontStruct Hail::TTF_ParseFontMemory(char* pFontMemory)
+{
 	FontDirectory directory;
 	memcpy(&directory, pFontMemory, sizeof(FontDirectory));
 
@@ -1237,6 +1798,22 @@ TTF_FontStruct Hail::TTF_ParseFontFile(const char* aFileToParse)
 	}
 
 
+	for (size_t i = 0; i < tables.Size(); i++)
+	{
+		int8 tagString[5]{ 0 };
+		memcpy(tagString, tables[i].tag.un.c, sizeof(uint32));
+		if (StringCompare(tagString, "kern"))
+		{
+			ReadKernTable(pFontMemory + tables[i].offset, font.m_kerningPairs);
+		}
+		else if (StringCompare(tagString, "GPOS"))
+		{
+			ReadGposTable(pFontMemory + tables[i].offset, numberOfGlyphs, font);
+		}
+	}
+	// Pairs from the kern table are added first, a stable sort keeps them in front of duplicate pairs from GPOS.
+	std::stable_sort(font.m_kerningPairs.Data(), font.m_kerningPairs.Data() + font.m_kerningPairs.Size(),
+		[](const KerningPair& a, const KerningPair& b) { return a.m_glyphPair < b.m_glyphPair; });
 
 	// Remap Cmap coords to be more dirt cheap to check in runtime.
 	if (maxUnicodeValue == -1)
@@ -1292,6 +1869,39 @@ TTF_FontStruct Hail::TTF_ParseFontFile(const char* aFileToParse)
 		font.m_renderVerts.Add(packedVert);
 	}
 
-	SAFEDELETE_ARRAY(pFontMemory);
 	return font;
 }
+
+int16 Hail::TTF_GetKerning(const TTF_FontStruct& font, uint16 leftGlyphID, uint16 rightGlyphID)
+{
+	const uint32 glyphPair = ((uint32)leftGlyphID << 16) | rightGlyphID;
+	const GrowingArray<KerningPair>& pairs = font.m_kerningPairs;
+	uint32 low = 0;
+	uint32 high = pairs.Size();
+	while (low < high)
+	{
+		const uint32 middle = (low + high) / 2;
+		if (pairs[middle].m_glyphPair < glyphPair)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	if (low < pairs.Size() && pairs[low].m_glyphPair == glyphPair)
+		return pairs[low].m_value;
+
+	for (uint32 i = 0; i < font.m_kerningClassTables.Size(); i++)
+	{
+		const KerningClassTable& classTable = font.m_kerningClassTables[i];
+		if (leftGlyphID >= classTable.m_firstGlyphClass.Size() || rightGlyphID >= classTable.m_secondGlyphClass.Size())
+			continue;
+
+		const uint16 firstClass = classTable.m_firstGlyphClass[leftGlyphID];
+		if (firstClass == KerningClassTable::InvalidClass)
+			continue;
+
+		// The first subtable that covers the left glyph decides the kerning, even if the value is 0.
+		const uint32 valueIndex = firstClass * classTable.m_numberOfSecondClasses + classTable.m_secondGlyphClass[rightGlyphID];
+		return valueIndex < classTable.m_values.Size() ? classTable.m_values[valueIndex] : 0;
+	}
+	return 0;
+}
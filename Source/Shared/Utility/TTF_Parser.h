@@ -23,6 +23,22 @@ namespace Hail
 		glm::ivec2 m_maxExtent;
 	};
 
+	struct KerningPair
+	{
+		uint32 m_glyphPair; // left glyph ID << 16 | right glyph ID
+		int16 m_value; // In font units
+	};
+
+	// Class based kerning from a GPOS pair adjustment subtable, looked up per glyph instead of being expanded to all pairs.
+	struct KerningClassTable
+	{
+		static constexpr uint16 InvalidClass = 0xffff;
+		GrowingArray<uint16> m_firstGlyphClass; // Per glyph ID, InvalidClass if the glyph is not covered by the subtable
+		GrowingArray<uint16> m_secondGlyphClass; // Per glyph ID
+		uint16 m_numberOfSecondClasses;
+		GrowingArray<int16> m_values; // First class * m_numberOfSecondClasses + second class
+	};
+
 	struct TTF_FontStruct
 	{
 		glm::ivec2 minGlyphBB;
@@ -41,8 +57,20 @@ namespace Hail
 
 		GrowingArray<glm::vec4> m_renderVerts;
 		GrowingArray<uint16> m_uniCodeToGlyphID;
+
+		// Sorted on m_glyphPair, from the kern table and GPOS pair adjustments with glyph pairs.
+		GrowingArray<KerningPair> m_kerningPairs;
+		GrowingArray<KerningClassTable> m_kerningClassTables;
 	};
 
-	// This function works, but is really unoptimized, but not important to fix now. Especially if this is done on a different thread.
+	// Parses and triangulates the font, the glyphs are triangulated in parallel on worker threads.
 	TTF_FontStruct TTF_ParseFontFile(const char* aFileToParse);
+	TTF_FontStruct TTF_ParseFontMemory(char* pFontMemory);
+
+	// Loads the compiled font asset stored next to the font file (aFileToLoad + ".hfnt") if it was compiled from the same font file,
+	// otherwise the font gets parsed and the compiled asset is written for the next load.
+	TTF_FontStruct TTF_LoadFont(const char* aFileToLoad);
+
+	// Returns the horizontal advance adjustment between two glyphs in font units, 0 if the pair is not kerned.
+	int16 TTF_GetKerning(const TTF_FontStruct& font, uint16 leftGlyphID, uint16 rightGlyphID);
 }
\ No newline at end of file